@@ -48,7 +48,7 @@
  */
 
 #include "AFLCloneMutator.hpp"
-#include "AFLDeleteMutator.hpp" //For static choose_block_len method
+#include "AFLMutationOps.hpp"
 #include "RuntimeException.hpp"
 #include <random>
 #include <algorithm>
@@ -120,51 +120,10 @@ void AFLCloneMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseE
         throw RuntimeException("AFLCloneMutator mutate called with zero sized buffer", RuntimeException::USAGE_ERROR);
     }
 
-    //The variable actually_clone determines which strategy is used.
-    int actually_clone = rand->randBelow(4);
-    int clone_from;
-    int clone_len;
-    int clone_to = rand->randBelow(size);
-
-    if (actually_clone) {
-        //Clone a small block of the original data
-
-        clone_len = AFLDeleteMutator::choose_block_len(rand, size);
-        clone_from = rand->randBelow(size - clone_len + 1);
-
-        int newSize = clone_len + size;
-        char* newBuff = newEntry->allocateBuffer(testCaseKey, newSize);
-
-        //Copies a random number of bytes (clone_to) from the original buffer
-        memcpy((void*)newBuff, (void*)buffer, clone_to);
-
-        //Insert some bytes in the middle (cloning from part of the original buffer)
-        memcpy(newBuff + clone_to, buffer + clone_from, clone_len);
-
-        //Now copy the rest of the original byte buffer
-        memcpy(newBuff + clone_to + clone_len, buffer + clone_to, size - clone_to);
-
-    } else {
-        //Clone a large block of the original value
-
-        clone_len = AFLDeleteMutator::choose_block_len(rand, HAVOC_BLK_XL); //This constant is 32768
-        int randomByte = rand->randBelow(255);
-
-        int newSize = clone_len + size;
-        char* newBuff = newEntry->allocateBuffer(testCaseKey, newSize);
-
-        //Insert clone_len bytes at a location clone_to, the inserted bytes
-        //will contain the value in the just determined randomByte
-        
-        //First copy clone_to bytes from the original buffer
-        memcpy((void*)newBuff, (void*)buffer, clone_to);
-
-        //Now copy the new random byte clone_len times
-        memset(newBuff + clone_to, randomByte, clone_len);
-
-        //Now copy the rest of the original buffer
-        memcpy(newBuff + clone_to + clone_len, buffer + clone_to, size - clone_to);
-    }
+    //Either clones a small block of the original data, or inserts a run of one random byte
+    AFLMutationOps::BlockClone clone = AFLMutationOps::chooseClone(size, rand);
+    char* newBuff = newEntry->allocateBuffer(testCaseKey, size + clone.len);
+    AFLMutationOps::writeClone(buffer, size, clone, newBuff);
 
     return;
 }
\ No newline at end of file
@@ -48,6 +48,7 @@
  */
 
 #include "AFLDeleteMutator.hpp"
+#include "AFLMutationOps.hpp"
 #include "RuntimeException.hpp"
 #include <random>
 #include <algorithm>
@@ -119,65 +120,10 @@ void AFLDeleteMutator::mutateTestCase(StorageModule& storage, StorageEntry* base
         throw RuntimeException("AFLDeleteMutator mutate called with zero sized buffer", RuntimeException::USAGE_ERROR);
     }
 
-    if (size < 2) {
-        char* newBuff = newEntry->allocateBuffer(testCaseKey, size);
-        memcpy((void*)newBuff, (void*)buffer, size);
-        return;  //This is the libAFL implementation
-    }
-
-    int del_len = choose_block_len(rand, size - 1);
-    int del_from = rand->randBelow(size - del_len + 1);
-
-    int newSize = size - del_len;
-
-    char* newBuff = newEntry->allocateBuffer(testCaseKey, newSize);
-    memcpy((void*)newBuff, (void*)buffer, del_from);
-    memcpy(newBuff + del_from, buffer + del_from + del_len, newSize - del_from);
+    // Buffers under 2 bytes are copied as they are (this is the libAFL implementation)
+    AFLMutationOps::BlockDelete del = AFLMutationOps::chooseDelete(size, rand);
+    char* newBuff = newEntry->allocateBuffer(testCaseKey, size - del.len);
+    AFLMutationOps::writeDelete(buffer, size, del, newBuff);
 
     return;
 }
-
-/**
- * @brief Helper method to select a random block length
- * 
- * This code was copied from mutator.c, as it was unclear how to call this
- * since it is not in the mutator.h header file
- * 
- * @param rand 
- * @param limit 
- * @return size_t 
- */
-size_t AFLDeleteMutator::choose_block_len(VmfRand* rand, size_t limit) {
-
-    size_t min_value, max_value;
-    switch (rand->randBelow(3)) {
-
-    case 0:
-        min_value = 1;
-        max_value = HAVOC_BLK_SMALL;
-        break;
-    case 1:
-        min_value = HAVOC_BLK_SMALL;
-        max_value = HAVOC_BLK_MEDIUM;
-        break;
-    default:
-        if (rand->randBelow(10)) {
-
-            min_value = HAVOC_BLK_MEDIUM;
-            max_value = HAVOC_BLK_LARGE;
-
-        } else {
-
-            min_value = HAVOC_BLK_LARGE;
-            max_value = HAVOC_BLK_XL;
-
-        }
-
-    }
-
-    if (min_value >= limit) {
-        min_value = 1;
-    }
-
-    return rand->randBetween(min_value, std::min(max_value, limit));
-}
\ No newline at end of file
@@ -86,8 +86,6 @@ public:
     virtual void registerStorageNeeds(StorageRegistry& registry);
     virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
 
-    static size_t choose_block_len(VmfRand* rand, size_t limit);
-    
 private:
     int testCaseKey;
     VmfRand* rand = VmfRand::getInstance();
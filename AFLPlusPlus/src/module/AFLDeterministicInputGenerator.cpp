@@ -0,0 +1,938 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2023 The Charles Stark Draper Laboratory, Inc.
+ * <vader@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+/*****
+ * The following includes code copied from the LibAFL_Legacy repository.
+ * 
+ *       american fuzzy lop++ - fuzzer header
+ *  ------------------------------------
+ *  Originally written by Michal Zalewski
+ *  Now maintained by Marc Heuse <mh@mh-sec.de>,
+ *                    Heiko Eißfeldt <heiko.eissfeldt@hexco.de>,
+ *                    Andrea Fioraldi <andreafioraldi@gmail.com>,
+ *                    Dominik Maier <mail@dmnk.co>
+ *  Copyright 2016, 2017 Google Inc. All rights reserved.
+ *  Copyright 2019-2020 AFLplusplus Project. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *  This is the Library based on AFL++ which can be used to build
+ *  customized fuzzers for a specific target while taking advantage of
+ *  a lot of features that AFL++ already provides.
+ */
+
+#include "AFLDeterministicInputGenerator.hpp"
+#include "AFLMutationOps.hpp"
+#include "Logging.hpp"
+#include "VmfUtil.hpp"
+
+#include <algorithm>
+
+using namespace vmf;
+
+#include "ModuleFactory.hpp"
+REGISTER_MODULE(AFLDeterministicInputGenerator);
+
+/// The number of interesting values of each width
+static const uint32_t NUM_INTERESTING_8 = sizeof(AFLMutationOps::interesting8) / sizeof(AFLMutationOps::interesting8[0]);
+static const uint32_t NUM_INTERESTING_16 = sizeof(AFLMutationOps::interesting16) / sizeof(AFLMutationOps::interesting16[0]);
+static const uint32_t NUM_INTERESTING_32 = sizeof(AFLMutationOps::interesting32) / sizeof(AFLMutationOps::interesting32[0]);
+
+/**
+ * @brief Builder method to support the ModuleFactory
+ * Constructs an instance of this class
+ * @return Module* 
+ */
+Module* AFLDeterministicInputGenerator::build(std::string name)
+{
+    return new AFLDeterministicInputGenerator(name);
+}
+
+/**
+ * @brief Initialization method
+ * Collects the child mutators used for havoc and reads the optional
+ * batchSize, havocPerBatch, tokens, dictionaryFiles, useEffectorMap and
+ * autoExtractTokens parameters
+ * 
+ * @param config 
+ */
+void AFLDeterministicInputGenerator::init(ConfigInterface& config)
+{
+    for(Module* module : config.getSubModules(getModuleName()))
+    {
+        if(MutatorModule::isAnInstance(module))
+        {
+            mutators.push_back(MutatorModule::castTo(module));
+        }
+        else
+        {
+            LOG_WARNING << "AFLDeterministicInputGenerator ignores its child module " << module->getModuleName() << ", which is not a mutator";
+        }
+    }
+
+    batchSize = config.getIntParam(getModuleName(), "batchSize", 256);
+    havocPerBatch = config.getIntParam(getModuleName(), "havocPerBatch", 100);
+    useEffectorMap = config.getBoolParam(getModuleName(), "useEffectorMap", false);
+    autoExtractTokens = config.getBoolParam(getModuleName(), "autoExtractTokens", false);
+
+    if(batchSize <= 0 || havocPerBatch < 0)
+    {
+        throw RuntimeException("AFLDeterministicInputGenerator batchSize must be positive and havocPerBatch non-negative", RuntimeException::CONFIGURATION_ERROR);
+    }
+
+    for(const std::string& path : config.getStringVectorParam(getModuleName(), "dictionaryFiles", {}))
+    {
+        dictionary->loadFile(path);
+    }
+
+    for(const std::string& token : config.getStringVectorParam(getModuleName(), "tokens", {}))
+    {
+        dictionary->addToken(token.data(), token.size());
+    }
+
+    // Candidates refer to tokens by a 16 bit index, and AFL caps its deterministic extras anyway
+    if(dictionary->getUserTokens().size() > MAX_DET_EXTRAS)
+    {
+        LOG_WARNING << "AFLDeterministicInputGenerator only uses the first " << MAX_DET_EXTRAS << " tokens";
+    }
+
+    batch.reserve(batchSize);
+}
+
+/**
+ * @brief Construct a new AFLDeterministicInputGenerator::AFLDeterministicInputGenerator object
+ * 
+ * @param name the name of the module
+ */
+AFLDeterministicInputGenerator::AFLDeterministicInputGenerator(std::string name) :
+    InputGeneratorModule(name)
+{
+    corpusQueued = false;
+    batchSize = 256;
+    havocPerBatch = 100;
+    useEffectorMap = false;
+    autoExtractTokens = false;
+    effectorBuilding = false;
+    effectorFinished = false;
+    effectorEntryId = 0;
+    effectorChecksum = 0;
+    autoCollecting = false;
+    autoFinished = false;
+    autoBaseChecksum = 0;
+    autoPrevChecksum = 0;
+    autoRunStart = 0;
+    autoRunLength = 0;
+}
+
+/**
+ * @brief Destroy the AFLDeterministicInputGenerator::AFLDeterministicInputGenerator object
+ * 
+ */
+AFLDeterministicInputGenerator::~AFLDeterministicInputGenerator()
+{
+
+}
+
+/**
+ * @brief Registers storage needs
+ * This class uses the "TEST_CASE" key.  With useEffectorMap or
+ * autoExtractTokens it also reads "AFL_TRACE_BITS", and with useEffectorMap
+ * it writes "AFL_EFFECTOR_MAP".
+ * 
+ * @param registry 
+ */
+void AFLDeterministicInputGenerator::registerStorageNeeds(StorageRegistry& registry)
+{
+    testCaseKey = registry.registerKey("TEST_CASE", StorageRegistry::BUFFER, StorageRegistry::READ_WRITE);
+
+    if(useEffectorMap || autoExtractTokens)
+    {
+        traceBitsKey = registry.registerKey("AFL_TRACE_BITS", StorageRegistry::BUFFER, StorageRegistry::READ_ONLY);
+    }
+
+    if(useEffectorMap)
+    {
+        effectorMapKey = registry.registerKey("AFL_EFFECTOR_MAP", StorageRegistry::BUFFER, StorageRegistry::READ_WRITE);
+    }
+}
+
+/**
+ * @brief Queues an entry for the deterministic stages, unless it already was
+ */
+void AFLDeterministicInputGenerator::enqueue(StorageEntry* entry)
+{
+    if(queuedIds.insert(entry->getID()).second)
+    {
+        queue.push_back(Cursor{entry->getID(), 0, FLIP1});
+    }
+}
+
+void AFLDeterministicInputGenerator::addNewTestCases(StorageModule& storage)
+{
+    // The seeds may have been saved before this module saw any results
+    if(!corpusQueued)
+    {
+        std::unique_ptr<Iterator> entries = storage.getSavedEntries();
+        while(entries->hasNext())
+        {
+            enqueue(entries->getNext());
+        }
+        corpusQueued = true;
+    }
+
+    addDeterministicTestCases(storage);
+    addHavocTestCases(storage);
+}
+
+bool AFLDeterministicInputGenerator::examineTestCaseResults(StorageModule& storage)
+{
+    if(effectorBuilding || effectorFinished)
+    {
+        recordEffectorResults(storage);
+    }
+
+    if(effectorFinished)
+    {
+        finishEffectorMap(storage);
+    }
+
+    if(autoCollecting || autoFinished)
+    {
+        recordAutoResults(storage);
+        autoFinished = false;
+    }
+
+    std::unique_ptr<Iterator> entries = storage.getNewEntriesThatWillBeSaved();
+    while(entries->hasNext())
+    {
+        enqueue(entries->getNext());
+    }
+
+    // Without havoc there is nothing left to do once every entry is walked
+    return mutators.empty() && queue.empty();
+}
+
+/**
+ * @brief Returns the number of user tokens the token stages use
+ */
+size_t AFLDeterministicInputGenerator::detTokenCount() const
+{
+    return std::min(dictionary->getUserTokens().size(), (size_t)MAX_DET_EXTRAS);
+}
+
+/**
+ * @brief Returns the number of slots a stage has for a test case of the
+ * given size, each slot being one position and one value
+ */
+uint64_t AFLDeterministicInputGenerator::stageSlots(int stage, int size) const
+{
+    uint64_t bits = (uint64_t)size << 3;
+
+    switch(stage)
+    {
+    case FLIP1:
+        return bits;
+    case FLIP2:
+        return bits >= 2 ? bits - 1 : 0;
+    case FLIP4:
+        return bits >= 4 ? bits - 3 : 0;
+    case FLIP8:
+        return size;
+    case FLIP16:
+        return size >= 2 ? size - 1 : 0;
+    case FLIP32:
+        return size >= 4 ? size - 3 : 0;
+    case ARITH8:
+        return (uint64_t)size * 2 * ARITH_MAX;
+    case ARITH16:
+        return size >= 2 ? (uint64_t)(size - 1) * 4 * ARITH_MAX : 0;
+    case ARITH32:
+        return size >= 4 ? (uint64_t)(size - 3) * 4 * ARITH_MAX : 0;
+    case INTEREST8:
+        return (uint64_t)size * NUM_INTERESTING_8;
+    case INTEREST16:
+        return size >= 2 ? (uint64_t)(size - 1) * 2 * NUM_INTERESTING_16 : 0;
+    case INTEREST32:
+        return size >= 4 ? (uint64_t)(size - 3) * 2 * NUM_INTERESTING_32 : 0;
+    case EXTRAS_OVERWRITE:
+        return (uint64_t)size * detTokenCount();
+    case EXTRAS_INSERT:
+        return size < MAX_FILE ? (uint64_t)(size + 1) * detTokenCount() : 0;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Builds the candidate for one slot of a stage
+ * 
+ * @param stage the stage
+ * @param position the bit (flip stages) or byte offset of the slot
+ * @param step which of the values for that position the slot is
+ * @param buff the base test case
+ * @param size its size
+ * @param effectorMap the entry's effector map, or null if every block is effective
+ * @param candidate filled in with the edit
+ * @return true if the candidate should be run, false if an earlier stage
+ * already produced it or it only touches inert blocks
+ */
+bool AFLDeterministicInputGenerator::makeCandidate(int stage, uint32_t position, uint32_t step, const char* buff, int size, const uint8_t* effectorMap, Candidate& candidate) const
+{
+    using namespace AFLMutationOps;
+
+    candidate.offset = position;
+    candidate.kind = STORE;
+    candidate.stage = stage;
+
+    // Everything after the 8/8 flips skips words that lie wholly in inert blocks
+    if(stage > FLIP8 && stage < EXTRAS_OVERWRITE)
+    {
+        uint32_t width = 1;
+        if(stage == FLIP16 || stage == ARITH16 || stage == INTEREST16)
+        {
+            width = 2;
+        }
+        else if(stage == FLIP32 || stage == ARITH32 || stage == INTEREST32)
+        {
+            width = 4;
+        }
+
+        if(!isEffective(effectorMap, position, width))
+        {
+            return false;
+        }
+    }
+
+    switch(stage)
+    {
+    case FLIP1:
+    case FLIP2:
+    case FLIP4:
+        candidate.kind = FLIP_BITS;
+        candidate.width = 1 << (stage - FLIP1);
+        return true;
+    case FLIP8:
+        candidate.width = 1;
+        candidate.value = (uint8_t)~loadWord<1>(buff + position);
+        return true;
+    case FLIP16:
+        candidate.width = 2;
+        candidate.value = (uint16_t)~loadWord<2>(buff + position);
+        return true;
+    case FLIP32:
+        candidate.width = 4;
+        candidate.value = ~loadWord<4>(buff + position);
+        return true;
+    case ARITH8:
+    {
+        uint8_t orig = loadWord<1>(buff + position);
+        uint8_t delta = step / 2 + 1;
+        uint8_t value = (step & 1) ? orig - delta : orig + delta;
+
+        candidate.width = 1;
+        candidate.value = value;
+        return !couldBeBitflip(orig ^ value);
+    }
+    case ARITH16:
+    {
+        // Only the words whose carry crosses into the other byte; ARITH8 did the rest
+        uint16_t orig = loadWord<2>(buff + position);
+        uint16_t swapped = swapWord(orig);
+        uint16_t delta = step / 4 + 1;
+        uint16_t value;
+        bool crosses;
+
+        switch(step & 3)
+        {
+        case 0:
+            value = orig + delta;
+            crosses = (orig & 0xff) + delta > 0xff;
+            break;
+        case 1:
+            value = orig - delta;
+            crosses = (orig & 0xff) < delta;
+            break;
+        case 2:
+            value = swapWord((uint16_t)(swapped + delta));
+            crosses = (orig >> 8) + delta > 0xff;
+            break;
+        default:
+            value = swapWord((uint16_t)(swapped - delta));
+            crosses = (orig >> 8) < delta;
+            break;
+        }
+
+        candidate.width = 2;
+        candidate.value = value;
+        return crosses && !couldBeBitflip(orig ^ value);
+    }
+    case ARITH32:
+    {
+        // Only the dwords whose carry crosses out of the low word; ARITH16 did the rest
+        uint32_t orig = loadWord<4>(buff + position);
+        uint32_t swapped = swapWord(orig);
+        uint32_t delta = step / 4 + 1;
+        uint32_t value;
+        bool crosses;
+
+        switch(step & 3)
+        {
+        case 0:
+            value = orig + delta;
+            crosses = (orig & 0xffff) + delta > 0xffff;
+            break;
+        case 1:
+            value = orig - delta;
+            crosses = (orig & 0xffff) < delta;
+            break;
+        case 2:
+            value = swapWord(swapped + delta);
+            crosses = (swapped & 0xffff) + delta > 0xffff;
+            break;
+        default:
+            value = swapWord(swapped - delta);
+            crosses = (swapped & 0xffff) < delta;
+            break;
+        }
+
+        candidate.width = 4;
+        candidate.value = value;
+        return crosses && !couldBeBitflip(orig ^ value);
+    }
+    case INTEREST8:
+    {
+        uint8_t orig = loadWord<1>(buff + position);
+        uint8_t value = interesting8[step];
+
+        candidate.width = 1;
+        candidate.value = value;
+        return !couldBeBitflip(orig ^ value) && !couldBeArith(orig, value, 1);
+    }
+    case INTEREST16:
+    {
+        uint16_t orig = loadWord<2>(buff + position);
+        uint16_t value = interesting16[step / 2];
+        bool swap = step & 1;
+
+        if(swap)
+        {
+            // A value that reads the same both ways was already tried
+            if(value == swapWord(value))
+            {
+                return false;
+            }
+            value = swapWord(value);
+        }
+
+        candidate.width = 2;
+        candidate.value = value;
+        return !couldBeBitflip(orig ^ value) && !couldBeArith(orig, value, 2) && !couldBeInterest(orig, value, 2, swap);
+    }
+    case INTEREST32:
+    {
+        uint32_t orig = loadWord<4>(buff + position);
+        uint32_t value = interesting32[step / 2];
+        bool swap = step & 1;
+
+        if(swap)
+        {
+            if(value == swapWord(value))
+            {
+                return false;
+            }
+            value = swapWord(value);
+        }
+
+        candidate.width = 4;
+        candidate.value = value;
+        return !couldBeBitflip(orig ^ value) && !couldBeArith(orig, value, 4) && !couldBeInterest(orig, value, 4, swap);
+    }
+    case EXTRAS_OVERWRITE:
+    {
+        std::string_view token = dictionary->getUserTokens().get(step);
+
+        // Skip tokens that do not fit, are already there, or would only overwrite inert blocks
+        candidate.kind = OVERWRITE_TOKEN;
+        candidate.token = step;
+        return token.size() <= (size_t)(size - position) && memcmp(buff + position, token.data(), token.size()) != 0 &&
+               isEffective(effectorMap, position, token.size());
+    }
+    case EXTRAS_INSERT:
+        // Skip tokens that would grow the test case past MAX_FILE
+        candidate.kind = INSERT_TOKEN;
+        candidate.token = step;
+        return (size_t)size + dictionary->getUserTokens().get(step).size() <= MAX_FILE;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Advances a cursor to the next candidate worth running
+ * 
+ * @param lastStage the cursor stops at the start of the stage after this one
+ * @return true if a candidate was found, false once every stage up to lastStage is done
+ */
+bool AFLDeterministicInputGenerator::nextCandidate(Cursor& cursor, int lastStage, const char* buff, int size, const uint8_t* effectorMap, Candidate& candidate) const
+{
+    while(cursor.stage <= lastStage)
+    {
+        uint64_t slots = stageSlots(cursor.stage, size);
+        uint32_t perPosition;
+
+        switch(cursor.stage)
+        {
+        case ARITH8:
+            perPosition = 2 * ARITH_MAX;
+            break;
+        case ARITH16:
+        case ARITH32:
+            perPosition = 4 * ARITH_MAX;
+            break;
+        case INTEREST8:
+            perPosition = NUM_INTERESTING_8;
+            break;
+        case INTEREST16:
+            perPosition = 2 * NUM_INTERESTING_16;
+            break;
+        case INTEREST32:
+            perPosition = 2 * NUM_INTERESTING_32;
+            break;
+        case EXTRAS_OVERWRITE:
+        case EXTRAS_INSERT:
+            perPosition = detTokenCount();
+            break;
+        default:
+            perPosition = 1;
+            break;
+        }
+
+        while(cursor.index < slots)
+        {
+            uint32_t slot = cursor.index++;
+            if(makeCandidate(cursor.stage, slot / perPosition, slot % perPosition, buff, size, effectorMap, candidate))
+            {
+                return true;
+            }
+        }
+
+        cursor.stage++;
+        cursor.index = 0;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Returns the number of candidates a stage runs for a test case
+ * without an effector map, after the skips for earlier stages
+ */
+uint64_t AFLDeterministicInputGenerator::countCandidates(int stage, const char* buff, int size) const
+{
+    Cursor cursor{0, 0, (uint8_t)stage};
+    Candidate candidate;
+    uint64_t count = 0;
+
+    while(nextCandidate(cursor, stage, buff, size, nullptr, candidate))
+    {
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Writes one candidate into a new entry, copying the base once
+ * 
+ * @return unsigned long the ID of the new entry
+ */
+unsigned long AFLDeterministicInputGenerator::emitCandidate(StorageModule& storage, const char* buff, int size, const Candidate& candidate)
+{
+    StorageEntry* newEntry = storage.createNewEntry();
+
+    if(candidate.kind == INSERT_TOKEN)
+    {
+        std::string_view token = dictionary->getUserTokens().get(candidate.token);
+        char* newBuff = newEntry->allocateBuffer(testCaseKey, size + token.size());
+
+        memcpy(newBuff, buff, candidate.offset);
+        memcpy(newBuff + candidate.offset, token.data(), token.size());
+        memcpy(newBuff + candidate.offset + token.size(), buff + candidate.offset, size - candidate.offset);
+        return newEntry->getID();
+    }
+
+    char* newBuff = newEntry->allocateBuffer(testCaseKey, size);
+    memcpy(newBuff, buff, size);
+
+    switch(candidate.kind)
+    {
+    case FLIP_BITS:
+        // AFL's FLIP_BIT order: bit 0 is the most significant bit of byte 0
+        for(uint32_t bit = candidate.offset; bit < candidate.offset + candidate.width; bit++)
+        {
+            newBuff[bit >> 3] ^= (128 >> (bit & 7));
+        }
+        break;
+    case STORE:
+        if(candidate.width == 1)
+        {
+            AFLMutationOps::storeWord<1>(newBuff + candidate.offset, candidate.value);
+        }
+        else if(candidate.width == 2)
+        {
+            AFLMutationOps::storeWord<2>(newBuff + candidate.offset, candidate.value);
+        }
+        else
+        {
+            AFLMutationOps::storeWord<4>(newBuff + candidate.offset, candidate.value);
+        }
+        break;
+    case OVERWRITE_TOKEN:
+    {
+        std::string_view token = dictionary->getUserTokens().get(candidate.token);
+        memcpy(newBuff + candidate.offset, token.data(), token.size());
+        break;
+    }
+    }
+
+    return newEntry->getID();
+}
+
+/**
+ * @brief Emits up to batchSize deterministic candidates, resuming each
+ * queued entry where the last call left it
+ */
+void AFLDeterministicInputGenerator::addDeterministicTestCases(StorageModule& storage)
+{
+    int emitted = 0;
+
+    while(emitted < batchSize && !queue.empty())
+    {
+        Cursor& cursor = queue.front();
+        StorageEntry* baseEntry = storage.getEntryByID(cursor.entryId);
+
+        // The entry may have been removed from the corpus since it was queued.
+        // Entries over MAX_FILE are skipped too, which keeps the slot count of
+        // every stage within the 32 bit cursor index.
+        int size = baseEntry ? baseEntry->getBufferSize(testCaseKey) : 0;
+        if(size <= 0 || size > MAX_FILE)
+        {
+            // Drop the effector map or auto tokens still being collected from its flips
+            if(effectorBuilding)
+            {
+                effectorBuilding = false;
+                pendingFlips.clear();
+            }
+
+            if(autoCollecting)
+            {
+                autoCollecting = false;
+                pendingAutoFlips.clear();
+            }
+
+            queue.pop_front();
+            continue;
+        }
+
+        const char* buff = baseEntry->getBufferPointer(testCaseKey);
+        const uint8_t* effectorMap = nullptr;
+        int lastStage = NUM_STAGES - 1;
+
+        if(autoExtractTokens && cursor.stage == FLIP1 && cursor.index == 0 && !autoCollecting)
+        {
+            // Wait for the results of the previous entry's 1/1 flips
+            if(autoFinished)
+            {
+                return;
+            }
+            startAutoExtraction(baseEntry, size);
+        }
+
+        if(useEffectorMap)
+        {
+            if(cursor.stage < FLIP8)
+            {
+                // Stop before the 8/8 flips, so the map is started below
+                lastStage = FLIP4;
+            }
+            else if(cursor.stage == FLIP8)
+            {
+                if(cursor.index == 0 && !effectorBuilding)
+                {
+                    startEffectorMap(baseEntry, size);
+                }
+
+                // The later stages need the results of every 8/8 flip first
+                if(effectorBuilding)
+                {
+                    lastStage = FLIP8;
+                }
+            }
+            else if(baseEntry->getBufferSize(effectorMapKey) > 0)
+            {
+                effectorMap = (const uint8_t*)baseEntry->getBufferPointer(effectorMapKey);
+            }
+        }
+
+        // Collect the batch first, so the entries are created in one tight loop
+        batch.clear();
+        Candidate candidate;
+        while(emitted + (int)batch.size() < batchSize && nextCandidate(cursor, lastStage, buff, size, effectorMap, candidate))
+        {
+            batch.push_back(candidate);
+        }
+
+        for(const Candidate& next : batch)
+        {
+            unsigned long id = emitCandidate(storage, buff, size, next);
+            if(effectorBuilding && next.stage == FLIP8)
+            {
+                pendingFlips[id] = next.offset;
+            }
+            else if(autoCollecting && next.stage == FLIP1 && (next.offset & 7) == 7)
+            {
+                pendingAutoFlips[id] = next.offset >> 3;
+            }
+        }
+        emitted += batch.size();
+
+        if(autoCollecting && cursor.stage > FLIP1)
+        {
+            autoCollecting = false;
+            autoFinished = true;
+        }
+
+        if(cursor.stage >= NUM_STAGES)
+        {
+            queue.pop_front();
+        }
+        else if(effectorBuilding && cursor.stage > FLIP8)
+        {
+            // Wait for the results of the last 8/8 flips
+            effectorBuilding = false;
+            effectorFinished = true;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Starts the effector map of an entry, if it is long enough and
+ * its coverage is known
+ */
+void AFLDeterministicInputGenerator::startEffectorMap(StorageEntry* baseEntry, int size)
+{
+    int traceSize = baseEntry->getBufferSize(traceBitsKey);
+    if(size < EFF_MIN_LEN || traceSize <= 0)
+    {
+        return;
+    }
+
+    // As in AFL, the first and last blocks are always effective
+    uint32_t blocks = AFLMutationOps::effectorBlocks(size);
+    effectorBits.assign((blocks + 7) >> 3, 0);
+    effectorBits[0] |= 1;
+    effectorBits[(blocks - 1) >> 3] |= 1 << ((blocks - 1) & 7);
+
+    effectorEntryId = baseEntry->getID();
+    effectorChecksum = VmfUtil::hashBuffer(baseEntry->getBufferPointer(traceBitsKey), traceSize);
+    effectorBuilding = true;
+}
+
+/**
+ * @brief Marks the blocks whose 8/8 flips changed the coverage checksum
+ */
+void AFLDeterministicInputGenerator::recordEffectorResults(StorageModule& storage)
+{
+    std::unique_ptr<Iterator> entries = storage.getNewEntries();
+    while(entries->hasNext() && !pendingFlips.empty())
+    {
+        StorageEntry* entry = entries->getNext();
+        auto pending = pendingFlips.find(entry->getID());
+        if(pending == pendingFlips.end())
+        {
+            continue;
+        }
+
+        int traceSize = entry->getBufferSize(traceBitsKey);
+        if(traceSize > 0 && VmfUtil::hashBuffer(entry->getBufferPointer(traceBitsKey), traceSize) != effectorChecksum)
+        {
+            uint32_t block = pending->second >> EFF_MAP_SCALE2;
+            effectorBits[block >> 3] |= 1 << (block & 7);
+        }
+        pendingFlips.erase(pending);
+    }
+
+    pendingFlips.clear();
+}
+
+/**
+ * @brief Stores the finished effector map on its entry, unless nearly every
+ * block is effective, in which case the map would only cost time
+ */
+void AFLDeterministicInputGenerator::finishEffectorMap(StorageModule& storage)
+{
+    effectorFinished = false;
+
+    StorageEntry* baseEntry = storage.getEntryByID(effectorEntryId);
+    int size = baseEntry ? baseEntry->getBufferSize(testCaseKey) : 0;
+    if(size <= 0)
+    {
+        return;
+    }
+
+    uint64_t blocks = AFLMutationOps::effectorBlocks(size);
+    uint64_t effective = 0;
+    for(uint8_t bits : effectorBits)
+    {
+        effective += __builtin_popcount(bits);
+    }
+
+    if(effective * 100 <= blocks * EFF_MAX_PERC)
+    {
+        char* map = baseEntry->allocateBuffer(effectorMapKey, effectorBits.size());
+        memcpy(map, effectorBits.data(), effectorBits.size());
+    }
+}
+
+/**
+ * @brief Starts collecting auto tokens from an entry's 1/1 flips, if its
+ * coverage is known
+ */
+void AFLDeterministicInputGenerator::startAutoExtraction(StorageEntry* baseEntry, int size)
+{
+    int traceSize = baseEntry->getBufferSize(traceBitsKey);
+    if(traceSize <= 0)
+    {
+        return;
+    }
+
+    const char* buff = baseEntry->getBufferPointer(testCaseKey);
+    autoBase.assign(buff, buff + size);
+    autoBaseChecksum = VmfUtil::hashBuffer(baseEntry->getBufferPointer(traceBitsKey), traceSize);
+    autoPrevChecksum = autoBaseChecksum;
+    autoRunLength = 0;
+    autoCollecting = true;
+}
+
+/**
+ * @brief Feeds the checksums of the examined 1/1 flips to the auto token
+ * collector, in byte order
+ */
+void AFLDeterministicInputGenerator::recordAutoResults(StorageModule& storage)
+{
+    autoResults.clear();
+
+    std::unique_ptr<Iterator> entries = storage.getNewEntries();
+    while(entries->hasNext() && autoResults.size() < pendingAutoFlips.size())
+    {
+        StorageEntry* entry = entries->getNext();
+        auto pending = pendingAutoFlips.find(entry->getID());
+        if(pending == pendingAutoFlips.end())
+        {
+            continue;
+        }
+
+        int traceSize = entry->getBufferSize(traceBitsKey);
+        if(traceSize > 0)
+        {
+            autoResults.emplace_back(pending->second, VmfUtil::hashBuffer(entry->getBufferPointer(traceBitsKey), traceSize));
+        }
+    }
+    pendingAutoFlips.clear();
+
+    std::sort(autoResults.begin(), autoResults.end());
+    for(const auto& result : autoResults)
+    {
+        stepAutoExtraction(result.first, result.second);
+    }
+}
+
+/**
+ * @brief Advances the auto token collector by one byte
+ * 
+ * This is AFL's collection logic: a run grows while flipping its bytes
+ * changes the coverage checksum to the same value, and is offered to the
+ * dictionary when the checksum changes again or the buffer ends.
+ * 
+ * @param position the byte whose last bit was flipped
+ * @param checksum the checksum of the coverage of that flip
+ */
+void AFLDeterministicInputGenerator::stepAutoExtraction(uint32_t position, size_t checksum)
+{
+    if(position == autoBase.size() - 1 && checksum == autoPrevChecksum)
+    {
+        // At the end of the buffer and still collecting, so take the last byte and finish the run
+        if(autoRunLength++ == 0)
+        {
+            autoRunStart = position;
+        }
+        dictionary->addAutoToken(autoBase.data() + autoRunStart, autoRunLength);
+    }
+    else if(checksum != autoPrevChecksum)
+    {
+        dictionary->addAutoToken(autoBase.data() + autoRunStart, autoRunLength);
+        autoRunLength = 0;
+        autoPrevChecksum = checksum;
+    }
+
+    // Only bytes whose flip made a difference belong in a token
+    if(checksum != autoBaseChecksum)
+    {
+        if(autoRunLength++ == 0)
+        {
+            autoRunStart = position;
+        }
+    }
+}
+
+/**
+ * @brief Emits havocPerBatch test cases from random child mutators
+ */
+void AFLDeterministicInputGenerator::addHavocTestCases(StorageModule& storage)
+{
+    if(mutators.empty() || havocPerBatch == 0)
+    {
+        return;
+    }
+
+    std::unique_ptr<Iterator> entries = storage.getSavedEntries();
+    int count = entries->getSize();
+    if(count <= 0)
+    {
+        return;
+    }
+
+    for(int i = 0; i < havocPerBatch; i++)
+    {
+        StorageEntry* baseEntry = entries->setIndexTo(rand->randBelow(count));
+        MutatorModule* mutator = mutators[rand->randBelow((int)mutators.size())];
+        mutator->mutateTestCase(storage, baseEntry, storage.createNewEntry(), testCaseKey);
+    }
+}
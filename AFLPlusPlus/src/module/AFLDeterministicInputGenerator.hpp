@@ -0,0 +1,218 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2023 The Charles Stark Draper Laboratory, Inc.
+ * <vader@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#pragma once
+
+// main includes
+#include "InputGeneratorModule.hpp"
+#include "MutatorModule.hpp"
+#include "StorageEntry.hpp"
+#include "RuntimeException.hpp"
+#include "VmfRand.hpp"
+#include "AFLTokenDictionary.hpp"
+#include "config.h"
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace vmf
+{
+/**
+ * @brief Input generator that runs AFL's deterministic stages over each
+ * corpus entry once, interleaved with havoc from its child mutators
+ * 
+ * Every entry that is saved to the corpus is queued and walked through the
+ * stages in AFL's order: bitflip 1/1, 2/1, 4/1, 8/8, 16/8 and 32/8, arith
+ * 8/16/32 by up to ARITH_MAX in both byte orders, interesting 8/16/32 in
+ * both byte orders, and token overwrite and insert.  As in AFL, a candidate
+ * that an earlier stage already produced (per could_be_bitflip,
+ * could_be_arith and could_be_interest) is skipped without being emitted.
+ * Entries larger than MAX_FILE, which AFL never queues, are not walked.
+ * 
+ * Each call emits at most batchSize candidates, resuming from a small
+ * per-entry cursor (stage and index), and then havocPerBatch test cases
+ * from randomly chosen child mutators on random corpus entries.  The
+ * deterministic stages therefore progress across fuzzing loop iterations
+ * without starving havoc.  Without child mutators, the generator reports
+ * that it is done once every queued entry has been walked.
+ * 
+ * With useEffectorMap set, the 8/8 flips of entries of at least EFF_MIN_LEN
+ * bytes also build AFL's effector map: a block of 2^EFF_MAP_SCALE2 bytes is
+ * effective if flipping any of its bytes changed the checksum of the
+ * AFL_TRACE_BITS coverage written by the executor.  Unless more than
+ * EFF_MAX_PERC percent of the blocks are effective, the map is stored as a
+ * bitmap in the entry's AFL_EFFECTOR_MAP buffer, and the later stages skip
+ * candidates that only touch inert blocks.  AFLHavocMutator can use the
+ * same map.
+ * 
+ * The token stages use the first MAX_DET_EXTRAS user tokens of the shared
+ * AFLTokenDictionary.  With autoExtractTokens set, the walking bit flips
+ * also find runs of MIN_AUTO_EXTRA to MAX_AUTO_EXTRA bytes whose flips all
+ * change the AFL_TRACE_BITS checksum to the same new value, as AFL does,
+ * and add them to the dictionary as auto tokens for the token mutators.
+ * 
+ * See https://github.com/AFLplusplus/AFLplusplus/blob/stable/src/afl-fuzz-one.c
+ * 
+ * The following includes code copied from the LibAFL_Legacy repository.
+ * 
+ *       american fuzzy lop++ - fuzzer header
+ *  ------------------------------------
+ *  Originally written by Michal Zalewski
+ *  Now maintained by Marc Heuse <mh@mh-sec.de>,
+ *                    Heiko Eißfeldt <heiko.eissfeldt@hexco.de>,
+ *                    Andrea Fioraldi <andreafioraldi@gmail.com>,
+ *                    Dominik Maier <mail@dmnk.co>
+ *  Copyright 2016, 2017 Google Inc. All rights reserved.
+ *  Copyright 2019-2020 AFLplusplus Project. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *  This is the Library based on AFL++ which can be used to build
+ *  customized fuzzers for a specific target while taking advantage of
+ *  a lot of features that AFL++ already provides.
+ */
+class AFLDeterministicInputGenerator: public InputGeneratorModule
+{
+public:
+
+    /// The deterministic stages, in the order they run
+    enum Stage : uint8_t
+    {
+        FLIP1,
+        FLIP2,
+        FLIP4,
+        FLIP8,
+        FLIP16,
+        FLIP32,
+        ARITH8,
+        ARITH16,
+        ARITH32,
+        INTEREST8,
+        INTEREST16,
+        INTEREST32,
+        EXTRAS_OVERWRITE,
+        EXTRAS_INSERT,
+        NUM_STAGES
+    };
+
+    static Module* build(std::string name);
+    virtual void init(ConfigInterface& config);
+
+    AFLDeterministicInputGenerator(std::string name);
+    virtual ~AFLDeterministicInputGenerator();
+    virtual void registerStorageNeeds(StorageRegistry& registry);
+    virtual void addNewTestCases(StorageModule& storage);
+    virtual bool examineTestCaseResults(StorageModule& storage);
+
+    uint64_t countCandidates(int stage, const char* buff, int size) const;
+
+private:
+    /// Where the deterministic stages resume for one queued entry
+    struct Cursor
+    {
+        unsigned long entryId;
+        uint32_t index;     ///< next slot within the stage
+        uint8_t stage;
+    };
+
+    enum CandidateKind : uint8_t
+    {
+        FLIP_BITS,          ///< flip width bits starting at bit offset
+        STORE,              ///< store the width byte word value at offset
+        OVERWRITE_TOKEN,    ///< overwrite the bytes at offset with a token
+        INSERT_TOKEN        ///< insert a token at offset
+    };
+
+    /// One deterministic edit to a copy of the base test case
+    struct Candidate
+    {
+        uint32_t offset;
+        uint32_t value;
+        uint16_t token;
+        uint8_t width;
+        uint8_t kind;
+        uint8_t stage;
+    };
+
+    void enqueue(StorageEntry* entry);
+    uint64_t stageSlots(int stage, int size) const;
+    bool makeCandidate(int stage, uint32_t position, uint32_t step, const char* buff, int size, const uint8_t* effectorMap, Candidate& candidate) const;
+    bool nextCandidate(Cursor& cursor, int lastStage, const char* buff, int size, const uint8_t* effectorMap, Candidate& candidate) const;
+    unsigned long emitCandidate(StorageModule& storage, const char* buff, int size, const Candidate& candidate);
+    void startEffectorMap(StorageEntry* baseEntry, int size);
+    void recordEffectorResults(StorageModule& storage);
+    void finishEffectorMap(StorageModule& storage);
+    void startAutoExtraction(StorageEntry* baseEntry, int size);
+    void recordAutoResults(StorageModule& storage);
+    void stepAutoExtraction(uint32_t position, size_t checksum);
+    size_t detTokenCount() const;
+    void addDeterministicTestCases(StorageModule& storage);
+    void addHavocTestCases(StorageModule& storage);
+
+    VmfRand* rand = VmfRand::getInstance();
+    std::vector<MutatorModule*> mutators;
+    AFLTokenDictionary* dictionary = AFLTokenDictionary::getInstance();
+
+    std::deque<Cursor> queue;
+    std::unordered_set<unsigned long> queuedIds;
+    std::vector<Candidate> batch;
+    bool corpusQueued;
+
+    int batchSize;
+    int havocPerBatch;
+    bool useEffectorMap;
+    bool autoExtractTokens;
+    int testCaseKey;
+    int traceBitsKey;
+    int effectorMapKey;
+
+    // The effector map being built by the 8/8 flips of the entry at the front of the queue
+    bool effectorBuilding;
+    bool effectorFinished;
+    unsigned long effectorEntryId;
+    size_t effectorChecksum;
+    std::vector<uint8_t> effectorBits;
+    std::unordered_map<unsigned long, uint32_t> pendingFlips;   ///< test case ID to the byte it flipped
+
+    // The auto token run being collected by the 1/1 flips of the entry at the front of the queue
+    bool autoCollecting;
+    bool autoFinished;
+    std::vector<char> autoBase;
+    size_t autoBaseChecksum;
+    size_t autoPrevChecksum;
+    uint32_t autoRunStart;
+    uint32_t autoRunLength;
+    std::unordered_map<unsigned long, uint32_t> pendingAutoFlips;   ///< test case ID to the byte whose last bit it flipped
+    std::vector<std::pair<uint32_t, size_t>> autoResults;
+};
+}
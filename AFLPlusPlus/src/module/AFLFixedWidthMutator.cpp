@@ -0,0 +1,191 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2023 The Charles Stark Draper Laboratory, Inc.
+ * <vader@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+/*****
+ * The following includes code copied from the LibAFL_Legacy repository.
+ * 
+ *       american fuzzy lop++ - fuzzer header
+ *  ------------------------------------
+ *  Originally written by Michal Zalewski
+ *  Now maintained by Marc Heuse <mh@mh-sec.de>,
+ *                    Heiko Eißfeldt <heiko.eissfeldt@hexco.de>,
+ *                    Andrea Fioraldi <andreafioraldi@gmail.com>,
+ *                    Dominik Maier <mail@dmnk.co>
+ *  Copyright 2016, 2017 Google Inc. All rights reserved.
+ *  Copyright 2019-2020 AFLplusplus Project. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *  This is the Library based on AFL++ which can be used to build
+ *  customized fuzzers for a specific target while taking advantage of
+ *  a lot of features that AFL++ already provides.
+ */
+
+#include "AFLFixedWidthMutator.hpp"
+#include "RuntimeException.hpp"
+
+using namespace vmf;
+
+/**
+ * @brief Builder method to support the ModuleFactory
+ * Constructs an instance of this class
+ * @return Module* 
+ */
+template<AFLFixedWidthOp Op, int Width, AFLByteOrder Order>
+Module* AFLFixedWidthMutator<Op, Width, Order>::build(std::string name)
+{
+    return new AFLFixedWidthMutator<Op, Width, Order>(name);
+}
+
+/**
+ * @brief Initialization method
+ * 
+ * @param config 
+ */
+template<AFLFixedWidthOp Op, int Width, AFLByteOrder Order>
+void AFLFixedWidthMutator<Op, Width, Order>::init(ConfigInterface& config)
+{
+
+}
+
+/**
+ * @brief Construct a new AFLFixedWidthMutator object
+ * 
+ * @param name the name of the module
+ */
+template<AFLFixedWidthOp Op, int Width, AFLByteOrder Order>
+AFLFixedWidthMutator<Op, Width, Order>::AFLFixedWidthMutator(std::string name) :
+    MutatorModule(name)
+{
+
+}
+
+/**
+ * @brief Destroy the AFLFixedWidthMutator object
+ * 
+ */
+template<AFLFixedWidthOp Op, int Width, AFLByteOrder Order>
+AFLFixedWidthMutator<Op, Width, Order>::~AFLFixedWidthMutator()
+{
+
+}
+
+/**
+ * @brief Registers storage needs
+ * This class uses only the "TEST_CASE" key
+ * 
+ * @param registry 
+ */
+template<AFLFixedWidthOp Op, int Width, AFLByteOrder Order>
+void AFLFixedWidthMutator<Op, Width, Order>::registerStorageNeeds(StorageRegistry& registry)
+{
+    testCaseKey = registry.registerKey("TEST_CASE", StorageRegistry::BUFFER, StorageRegistry::READ_WRITE);
+}
+
+template<AFLFixedWidthOp Op, int Width, AFLByteOrder Order>
+void AFLFixedWidthMutator<Op, Width, Order>::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
+{
+
+    int size = baseEntry->getBufferSize(testCaseKey);
+    char* buffer = baseEntry->getBufferPointer(testCaseKey);
+
+    if(size <= 0)
+    {
+        throw RuntimeException("AFLFixedWidthMutator mutate called with zero sized buffer", RuntimeException::USAGE_ERROR);
+    }
+
+    char* newBuff = newEntry->allocateBuffer(testCaseKey, size);
+    memcpy((void*)newBuff, (void*)buffer, size);
+
+    if constexpr (Op == AFLFixedWidthOp::FlipBits)
+    {
+        AFLMutationOps::flipBits<Width>(newBuff, size, rand);
+    }
+    else if constexpr (Op == AFLFixedWidthOp::FlipBytes)
+    {
+        AFLMutationOps::flipBytes<Width>(newBuff, size, rand);
+    }
+    else if constexpr (Op == AFLFixedWidthOp::Interesting)
+    {
+        AFLMutationOps::interestingWord<Width, Order>(newBuff, size, rand);
+    }
+    else
+    {
+        AFLMutationOps::addSubWord<Width, Order>(newBuff, size, rand);
+    }
+
+    return;
+}
+
+// Instantiate every specialization here, and register each one under its
+// own module name
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::FlipBits, 1>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::FlipBits, 2>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::FlipBits, 4>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::FlipBytes, 1>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::FlipBytes, 2>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::FlipBytes, 4>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::FlipBytes, 8>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::Interesting, 1>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::Interesting, 2>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::Interesting, 4>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::Interesting, 8>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::Interesting, 2, AFLByteOrder::Swapped>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::Interesting, 4, AFLByteOrder::Swapped>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::Interesting, 8, AFLByteOrder::Swapped>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::AddSub, 1>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::AddSub, 2>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::AddSub, 4>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::AddSub, 8>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::AddSub, 2, AFLByteOrder::Swapped>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::AddSub, 4, AFLByteOrder::Swapped>;
+template class vmf::AFLFixedWidthMutator<AFLFixedWidthOp::AddSub, 8, AFLByteOrder::Swapped>;
+
+#include "ModuleFactory.hpp"
+REGISTER_MODULE(AFLFlipBitMutator);
+REGISTER_MODULE(AFLFlip2BitMutator);
+REGISTER_MODULE(AFLFlip4BitMutator);
+REGISTER_MODULE(AFLFlipByteMutator);
+REGISTER_MODULE(AFLFlip2ByteMutator);
+REGISTER_MODULE(AFLFlip4ByteMutator);
+REGISTER_MODULE(AFLFlip8ByteMutator);
+REGISTER_MODULE(AFLInteresting8Mutator);
+REGISTER_MODULE(AFLInteresting16Mutator);
+REGISTER_MODULE(AFLInteresting32Mutator);
+REGISTER_MODULE(AFLInteresting64Mutator);
+REGISTER_MODULE(AFLInteresting16SwappedMutator);
+REGISTER_MODULE(AFLInteresting32SwappedMutator);
+REGISTER_MODULE(AFLInteresting64SwappedMutator);
+REGISTER_MODULE(AFLRandomByteAddSubMutator);
+REGISTER_MODULE(AFLWordAddSubMutator);
+REGISTER_MODULE(AFLDWordAddSubMutator);
+REGISTER_MODULE(AFLQWordAddSubMutator);
+REGISTER_MODULE(AFLWordAddSubSwappedMutator);
+REGISTER_MODULE(AFLDWordAddSubSwappedMutator);
+REGISTER_MODULE(AFLQWordAddSubSwappedMutator);
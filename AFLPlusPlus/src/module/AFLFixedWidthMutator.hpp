@@ -0,0 +1,138 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2023 The Charles Stark Draper Laboratory, Inc.
+ * <vader@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#pragma once
+
+// main includes
+#include "MutatorModule.hpp"
+#include "StorageEntry.hpp"
+#include "RuntimeException.hpp"
+#include "VmfRand.hpp"
+#include "AFLMutationOps.hpp"
+
+namespace vmf
+{
+/**
+ * @brief The operations AFLFixedWidthMutator can apply
+ */
+enum class AFLFixedWidthOp
+{
+    FlipBits,    ///< Flip Width consecutive bits
+    FlipBytes,   ///< Flip every bit of Width consecutive bytes
+    Interesting, ///< Set a Width byte word to an interesting value
+    AddSub       ///< Subtract and then add a small value to a Width byte word
+};
+
+/**
+ * @brief This mutator applies one fixed-width AFL operation to a random
+ * location in the test case buffer
+ * 
+ * The AFL bit flip, byte flip, interesting value and arithmetic mutators
+ * differ only in the operation, its width and the byte order of the word it
+ * reads and writes, so they are all specializations of this template.  The
+ * operations themselves are in AFLMutationOps.hpp.  If the test case is
+ * smaller than the width, it is copied without mutation (this is the libAFL
+ * implementation).
+ * 
+ * See https://github.com/AFLplusplus/LibAFL-legacy/blob/dev/src/mutator.c
+ * 
+ * The following includes code copied from the LibAFL_Legacy repository.
+ * 
+ *       american fuzzy lop++ - fuzzer header
+ *  ------------------------------------
+ *  Originally written by Michal Zalewski
+ *  Now maintained by Marc Heuse <mh@mh-sec.de>,
+ *                    Heiko Eißfeldt <heiko.eissfeldt@hexco.de>,
+ *                    Andrea Fioraldi <andreafioraldi@gmail.com>,
+ *                    Dominik Maier <mail@dmnk.co>
+ *  Copyright 2016, 2017 Google Inc. All rights reserved.
+ *  Copyright 2019-2020 AFLplusplus Project. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *  This is the Library based on AFL++ which can be used to build
+ *  customized fuzzers for a specific target while taking advantage of
+ *  a lot of features that AFL++ already provides.
+ * 
+ * @tparam Op the operation to apply
+ * @tparam Width the width in bits for FlipBits (1, 2 or 4), otherwise in bytes (1, 2, 4 or 8)
+ * @tparam Order the byte order of the word, for the Interesting and AddSub operations
+ */
+template<AFLFixedWidthOp Op, int Width, AFLByteOrder Order = AFLByteOrder::Native>
+class AFLFixedWidthMutator: public MutatorModule
+{
+    static_assert(Op == AFLFixedWidthOp::FlipBits ? (Width == 1 || Width == 2 || Width == 4)
+                                                  : (Width == 1 || Width == 2 || Width == 4 || Width == 8),
+                  "Unsupported width for this operation");
+    static_assert(Order == AFLByteOrder::Native ||
+                  (Width > 1 && (Op == AFLFixedWidthOp::Interesting || Op == AFLFixedWidthOp::AddSub)),
+                  "Byte order only applies to multi-byte words");
+
+public:
+
+    static Module* build(std::string name);
+    virtual void init(ConfigInterface& config);
+
+    AFLFixedWidthMutator(std::string name);
+    virtual ~AFLFixedWidthMutator();
+    virtual void registerStorageNeeds(StorageRegistry& registry);
+    virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
+
+private:
+    int testCaseKey;
+    VmfRand* rand = VmfRand::getInstance();
+};
+
+// Bit and byte flips
+using AFLFlipBitMutator = AFLFixedWidthMutator<AFLFixedWidthOp::FlipBits, 1>;
+using AFLFlip2BitMutator = AFLFixedWidthMutator<AFLFixedWidthOp::FlipBits, 2>;
+using AFLFlip4BitMutator = AFLFixedWidthMutator<AFLFixedWidthOp::FlipBits, 4>;
+using AFLFlipByteMutator = AFLFixedWidthMutator<AFLFixedWidthOp::FlipBytes, 1>;
+using AFLFlip2ByteMutator = AFLFixedWidthMutator<AFLFixedWidthOp::FlipBytes, 2>;
+using AFLFlip4ByteMutator = AFLFixedWidthMutator<AFLFixedWidthOp::FlipBytes, 4>;
+using AFLFlip8ByteMutator = AFLFixedWidthMutator<AFLFixedWidthOp::FlipBytes, 8>;
+
+// Interesting values
+using AFLInteresting8Mutator = AFLFixedWidthMutator<AFLFixedWidthOp::Interesting, 1>;
+using AFLInteresting16Mutator = AFLFixedWidthMutator<AFLFixedWidthOp::Interesting, 2>;
+using AFLInteresting32Mutator = AFLFixedWidthMutator<AFLFixedWidthOp::Interesting, 4>;
+using AFLInteresting64Mutator = AFLFixedWidthMutator<AFLFixedWidthOp::Interesting, 8>;
+using AFLInteresting16SwappedMutator = AFLFixedWidthMutator<AFLFixedWidthOp::Interesting, 2, AFLByteOrder::Swapped>;
+using AFLInteresting32SwappedMutator = AFLFixedWidthMutator<AFLFixedWidthOp::Interesting, 4, AFLByteOrder::Swapped>;
+using AFLInteresting64SwappedMutator = AFLFixedWidthMutator<AFLFixedWidthOp::Interesting, 8, AFLByteOrder::Swapped>;
+
+// Arithmetic
+using AFLRandomByteAddSubMutator = AFLFixedWidthMutator<AFLFixedWidthOp::AddSub, 1>;
+using AFLWordAddSubMutator = AFLFixedWidthMutator<AFLFixedWidthOp::AddSub, 2>;
+using AFLDWordAddSubMutator = AFLFixedWidthMutator<AFLFixedWidthOp::AddSub, 4>;
+using AFLQWordAddSubMutator = AFLFixedWidthMutator<AFLFixedWidthOp::AddSub, 8>;
+using AFLWordAddSubSwappedMutator = AFLFixedWidthMutator<AFLFixedWidthOp::AddSub, 2, AFLByteOrder::Swapped>;
+using AFLDWordAddSubSwappedMutator = AFLFixedWidthMutator<AFLFixedWidthOp::AddSub, 4, AFLByteOrder::Swapped>;
+using AFLQWordAddSubSwappedMutator = AFLFixedWidthMutator<AFLFixedWidthOp::AddSub, 8, AFLByteOrder::Swapped>;
+}
@@ -0,0 +1,262 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2023 The Charles Stark Draper Laboratory, Inc.
+ * <vader@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+/*****
+ * The following includes code copied from the LibAFL_Legacy repository.
+ * 
+ *       american fuzzy lop++ - fuzzer header
+ *  ------------------------------------
+ *  Originally written by Michal Zalewski
+ *  Now maintained by Marc Heuse <mh@mh-sec.de>,
+ *                    Heiko Eißfeldt <heiko.eissfeldt@hexco.de>,
+ *                    Andrea Fioraldi <andreafioraldi@gmail.com>,
+ *                    Dominik Maier <mail@dmnk.co>
+ *  Copyright 2016, 2017 Google Inc. All rights reserved.
+ *  Copyright 2019-2020 AFLplusplus Project. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *  This is the Library based on AFL++ which can be used to build
+ *  customized fuzzers for a specific target while taking advantage of
+ *  a lot of features that AFL++ already provides.
+ */
+
+#include "AFLHavocMutator.hpp"
+#include "AFLMutationOps.hpp"
+#include "RuntimeException.hpp"
+
+#include <algorithm>
+
+using namespace vmf;
+
+#include "ModuleFactory.hpp"
+REGISTER_MODULE(AFLHavocMutator);
+
+/// The number of distinct operations applyRandomOperation chooses from
+static const int NUM_HAVOC_OPERATIONS = 20;
+
+/**
+ * @brief Builder method to support the ModuleFactory
+ * Constructs an instance of this class
+ * @return Module* 
+ */
+Module* AFLHavocMutator::build(std::string name)
+{
+    return new AFLHavocMutator(name);
+}
+
+/**
+ * @brief Initialization method
+ * Reads the optional stackPow2 parameter, which bounds the stack depth,
+ * and the optional useEffectorMap parameter
+ * 
+ * @param config 
+ */
+void AFLHavocMutator::init(ConfigInterface& config)
+{
+    stackPow2 = config.getIntParam(getModuleName(), "stackPow2", HAVOC_STACK_POW2);
+    useEffectorMap = config.getBoolParam(getModuleName(), "useEffectorMap", false);
+
+    if(stackPow2 < 1 || stackPow2 > 8)
+    {
+        throw RuntimeException("AFLHavocMutator stackPow2 must be between 1 and 8", RuntimeException::CONFIGURATION_ERROR);
+    }
+}
+
+/**
+ * @brief Construct a new AFLHavocMutator::AFLHavocMutator object
+ * 
+ * @param name the name of the module
+ */
+AFLHavocMutator::AFLHavocMutator(std::string name) :
+    MutatorModule(name)
+{
+    stackPow2 = HAVOC_STACK_POW2;
+    useEffectorMap = false;
+}
+
+/**
+ * @brief Destroy the AFLHavocMutator::AFLHavocMutator object
+ * 
+ */
+AFLHavocMutator::~AFLHavocMutator()
+{
+
+}
+
+/**
+ * @brief Registers storage needs
+ * This class uses the "TEST_CASE" key, and with useEffectorMap also reads
+ * "AFL_EFFECTOR_MAP"
+ * 
+ * @param registry 
+ */
+void AFLHavocMutator::registerStorageNeeds(StorageRegistry& registry)
+{
+    testCaseKey = registry.registerKey("TEST_CASE", StorageRegistry::BUFFER, StorageRegistry::READ_WRITE);
+
+    if(useEffectorMap)
+    {
+        effectorMapKey = registry.registerKey("AFL_EFFECTOR_MAP", StorageRegistry::BUFFER, StorageRegistry::READ_ONLY);
+    }
+}
+
+void AFLHavocMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
+{
+
+    int size = baseEntry->getBufferSize(testCaseKey);
+    char* buffer = baseEntry->getBufferPointer(testCaseKey);
+
+    if(size <= 0)
+    {
+        throw RuntimeException("AFLHavocMutator mutate called with zero sized buffer", RuntimeException::USAGE_ERROR);
+    }
+
+    scratch.assign(buffer, buffer + size);
+
+    effectiveBlocks.clear();
+    int mapSize = useEffectorMap ? baseEntry->getBufferSize(effectorMapKey) : 0;
+    if(mapSize > 0)
+    {
+        const uint8_t* map = (const uint8_t*)baseEntry->getBufferPointer(effectorMapKey);
+        uint32_t blocks = std::min(AFLMutationOps::effectorBlocks(size), (uint32_t)mapSize << 3);
+        for(uint32_t block = 0; block < blocks; block++)
+        {
+            if(map[block >> 3] & (1 << (block & 7)))
+            {
+                effectiveBlocks.push_back(block);
+            }
+        }
+    }
+
+    int stackSize = 1 << (1 + rand->randBelow(stackPow2));
+    for(int i = 0; i < stackSize; i++)
+    {
+        applyRandomOperation(size);
+    }
+
+    char* newBuff = newEntry->allocateBuffer(testCaseKey, scratch.size());
+    memcpy((void*)newBuff, (void*)scratch.data(), scratch.size());
+
+    return;
+}
+
+/**
+ * @brief Applies one randomly chosen operation to the scratch buffer
+ * None of the operations leave the buffer empty.
+ * 
+ * @param baseSize the size of the base test case, which the effector map describes
+ */
+void AFLHavocMutator::applyRandomOperation(int baseSize)
+{
+    char* buff = scratch.data();
+    int size = (int)scratch.size();
+
+    // Aim the fixed-size operations at an effective block, until the length changes
+    char* target = buff;
+    int targetSize = size;
+    if(!effectiveBlocks.empty() && size == baseSize && rand->randBelow(EFF_HAVOC_RATE + 1) != 0)
+    {
+        int start = effectiveBlocks[rand->randBelow((int)effectiveBlocks.size())] << EFF_MAP_SCALE2;
+        target = buff + start;
+        targetSize = std::min(size - start, 1 << EFF_MAP_SCALE2);
+    }
+
+    switch(rand->randBelow(NUM_HAVOC_OPERATIONS))
+    {
+    case 0:
+        AFLMutationOps::flipBits<1>(target, targetSize, rand);
+        break;
+    case 1:
+        AFLMutationOps::flipBits<2>(target, targetSize, rand);
+        break;
+    case 2:
+        AFLMutationOps::flipBits<4>(target, targetSize, rand);
+        break;
+    case 3:
+        AFLMutationOps::flipBytes<1>(target, targetSize, rand);
+        break;
+    case 4:
+        AFLMutationOps::flipBytes<2>(target, targetSize, rand);
+        break;
+    case 5:
+        AFLMutationOps::flipBytes<4>(target, targetSize, rand);
+        break;
+    case 6:
+        AFLMutationOps::interestingWord<1>(target, targetSize, rand);
+        break;
+    case 7:
+        AFLMutationOps::interestingWord<2>(target, targetSize, rand);
+        break;
+    case 8:
+        AFLMutationOps::interestingWord<2, AFLByteOrder::Swapped>(target, targetSize, rand);
+        break;
+    case 9:
+        AFLMutationOps::interestingWord<4>(target, targetSize, rand);
+        break;
+    case 10:
+        AFLMutationOps::interestingWord<4, AFLByteOrder::Swapped>(target, targetSize, rand);
+        break;
+    case 11:
+        AFLMutationOps::addSubWord<1>(target, targetSize, rand);
+        break;
+    case 12:
+        AFLMutationOps::addSubWord<2>(target, targetSize, rand);
+        break;
+    case 13:
+        AFLMutationOps::addSubWord<2, AFLByteOrder::Swapped>(target, targetSize, rand);
+        break;
+    case 14:
+        AFLMutationOps::addSubWord<4>(target, targetSize, rand);
+        break;
+    case 15:
+        AFLMutationOps::addSubWord<4, AFLByteOrder::Swapped>(target, targetSize, rand);
+        break;
+    case 16:
+        AFLMutationOps::randomByte(target, targetSize, rand);
+        break;
+    case 17:
+        AFLMutationOps::overwriteCopy(target, targetSize, rand);
+        break;
+    case 18:
+        AFLMutationOps::overwriteFixed(target, targetSize, rand);
+        break;
+    default:
+        // Length-changing operations, split evenly as in AFL
+        if(rand->randBelow(2))
+        {
+            AFLMutationOps::deleteBlock(scratch, rand);
+        }
+        else if(size + HAVOC_BLK_XL < MAX_FILE)
+        {
+            AFLMutationOps::cloneBlock(scratch, rand);
+        }
+        break;
+    }
+}
@@ -35,20 +35,29 @@
 #include "VmfRand.hpp"
 #include "config.h"
 
-// external project includes.
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wwrite-strings"
-#pragma GCC diagnostic pop
+#include <vector>
 
 namespace vmf
 {
 /**
- * @brief This mutator sets a dword to an interesting value.
+ * @brief This mutator applies a random stack of AFL havoc operations
  * 
- * This module is draws heavily upon the libAFL mutator.c
+ * Each call picks a stack depth of 2^(1 + randBelow(stackPow2)) operations,
+ * as AFL's havoc stage does, and applies them one after another to a single
+ * scratch buffer using the in-place operations in AFLMutationOps.hpp.  The
+ * base test case is copied into the scratch buffer once, and the result is
+ * copied into the new entry once, regardless of the depth of the stack.
  * 
- * Uses the specified AFL-style mutation algorithm to mutate the provided
- * input.  createTestCase is the main mutation method.
+ * The operations are the same ones provided by the single-operation AFL
+ * mutator modules, except for splicing, which needs a second test case.
+ * As in AFL, the 16 and 32 bit word operations are applied in both byte
+ * orders, and 64 bit words are not used.
+ * Cloning is skipped when it could grow the buffer past MAX_FILE.
+ * 
+ * With useEffectorMap set, and while the buffer still has its original
+ * length, the fixed-size operations are aimed at a random effective block
+ * of the entry's AFL_EFFECTOR_MAP EFF_HAVOC_RATE times as often as at the
+ * whole buffer.  Entries without a map are mutated uniformly.
  * 
  * See https://github.com/AFLplusplus/LibAFL-legacy/blob/dev/src/mutator.c
  * 
@@ -71,21 +80,30 @@ namespace vmf
  *  customized fuzzers for a specific target while taking advantage of
  *  a lot of features that AFL++ already provides.
  */
-class AFLInteresting32Mutator: public MutatorModule
+class AFLHavocMutator: public MutatorModule
 {
 public:
 
     static Module* build(std::string name);
     virtual void init(ConfigInterface& config);
 
-    AFLInteresting32Mutator(std::string name);
-    virtual ~AFLInteresting32Mutator();
+    AFLHavocMutator(std::string name);
+    virtual ~AFLHavocMutator();
     virtual void registerStorageNeeds(StorageRegistry& registry);
     virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
-    
+
 private:
+    void applyRandomOperation(int baseSize);
+
     int testCaseKey;
+    int effectorMapKey;
+    int stackPow2;
+    bool useEffectorMap;
     VmfRand* rand = VmfRand::getInstance();
-    static const int64_t interesting_32[];
+
+    /// Reused across calls so that only its first use allocates
+    std::vector<char> scratch;
+    /// The effective blocks of the current base entry, empty if it has no effector map
+    std::vector<uint32_t> effectiveBlocks;
 };
 }
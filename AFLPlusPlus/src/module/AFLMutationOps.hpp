@@ -0,0 +1,613 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2023 The Charles Stark Draper Laboratory, Inc.
+ * <vader@draper.com>
+ *
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#pragma once
+
+// main includes
+#include "VmfRand.hpp"
+#include "config.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace vmf
+{
+/**
+ * @brief The byte order an operation reads and writes multi-byte words in
+ *
+ * Swapped is the opposite of the host order, which is how AFL++'s "BE"
+ * variants behave on the little-endian hosts it targets.
+ */
+enum class AFLByteOrder
+{
+    Native,
+    Swapped
+};
+
+/**
+ * @brief In-place implementations of the AFL++ havoc operations
+ *
+ * Each single-operation mutator module and the AFLHavocMutator share these
+ * functions, so that a stack of operations can be applied to one buffer
+ * without going through a module call and a fresh StorageEntry buffer per
+ * operation.  The fixed-size operations take a buffer and its size and
+ * mutate it in place; the operations that change the length take a
+ * std::vector<char> and resize it.  Their random draws are separate
+ * functions (chooseDelete, chooseClone), so that the single-operation
+ * modules can write the same result straight into a new entry's buffer
+ * with writeDelete and writeClone.  All of them expect a non-empty buffer,
+ * and leave it untouched when it is too small for the operation (this is
+ * the libAFL behavior).
+ *
+ * See https://github.com/AFLplusplus/LibAFL-legacy/blob/dev/src/mutator.c
+ *
+ * The following includes code copied from the LibAFL_Legacy repository.
+ *
+ *       american fuzzy lop++ - fuzzer header
+ *  ------------------------------------
+ *  Originally written by Michal Zalewski
+ *  Now maintained by Marc Heuse <mh@mh-sec.de>,
+ *                    Heiko Eißfeldt <heiko.eissfeldt@hexco.de>,
+ *                    Andrea Fioraldi <andreafioraldi@gmail.com>,
+ *                    Dominik Maier <mail@dmnk.co>
+ *  Copyright 2016, 2017 Google Inc. All rights reserved.
+ *  Copyright 2019-2020 AFLplusplus Project. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *  This is the Library based on AFL++ which can be used to build
+ *  customized fuzzers for a specific target while taking advantage of
+ *  a lot of features that AFL++ already provides.
+ */
+namespace AFLMutationOps
+{
+
+/**
+ * @brief Maps a word width in bytes to the unsigned type of that width
+ */
+template<int Width> struct AFLWord;
+template<> struct AFLWord<1> { using type = uint8_t; };
+template<> struct AFLWord<2> { using type = uint16_t; };
+template<> struct AFLWord<4> { using type = uint32_t; };
+template<> struct AFLWord<8> { using type = uint64_t; };
+
+/**
+ * @brief Reverses the bytes of a word
+ */
+template<typename Word>
+inline Word swapWord(Word value)
+{
+    if constexpr (sizeof(Word) == 2) {
+        return __builtin_bswap16(value);
+    } else if constexpr (sizeof(Word) == 4) {
+        return __builtin_bswap32(value);
+    } else if constexpr (sizeof(Word) == 8) {
+        return __builtin_bswap64(value);
+    } else {
+        return value;
+    }
+}
+
+/**
+ * @brief Loads a possibly unaligned word
+ *
+ * The memcpy compiles to a single load, and unlike a pointer cast it is
+ * well defined at any alignment.
+ */
+template<int Width, AFLByteOrder Order = AFLByteOrder::Native>
+inline typename AFLWord<Width>::type loadWord(const char* buff)
+{
+    typename AFLWord<Width>::type value;
+    memcpy(&value, buff, Width);
+    return Order == AFLByteOrder::Swapped ? swapWord(value) : value;
+}
+
+/**
+ * @brief Stores a possibly unaligned word
+ */
+template<int Width, AFLByteOrder Order = AFLByteOrder::Native>
+inline void storeWord(char* buff, typename AFLWord<Width>::type value)
+{
+    if (Order == AFLByteOrder::Swapped) {
+        value = swapWord(value);
+    }
+    memcpy(buff, &value, Width);
+}
+
+// From AFL++ macros (github.com/AFLplusplus/AFLplusplus/blob/stable/include/config.h)
+inline const int8_t interesting8[] = {INTERESTING_8};
+inline const int16_t interesting16[] = {INTERESTING_8, INTERESTING_16};
+inline const int32_t interesting32[] = {INTERESTING_8, INTERESTING_16, INTERESTING_32};
+
+/**
+ * @brief Checks whether an XOR of old and new values is one the bit and
+ * byte flip stages produce (1, 2 or 4 adjacent bits, or 1, 2 or 4 aligned
+ * bytes)
+ *
+ * This is AFL's could_be_bitflip, used to skip deterministic candidates that
+ * an earlier stage already tried.
+ */
+inline bool couldBeBitflip(uint32_t xorVal)
+{
+    uint32_t sh = 0;
+
+    if (!xorVal) {
+        return true;
+    }
+
+    while (!(xorVal & 1)) {
+        sh++;
+        xorVal >>= 1;
+    }
+
+    if (xorVal == 1 || xorVal == 3 || xorVal == 15) {
+        return true;
+    }
+
+    if (sh & 7) {
+        return false;
+    }
+
+    return xorVal == 0xff || xorVal == 0xffff || xorVal == 0xffffffff;
+}
+
+/**
+ * @brief Checks whether the arithmetic stages could turn oldVal into newVal,
+ * for a word of width bytes (AFL's could_be_arith)
+ */
+inline bool couldBeArith(uint32_t oldVal, uint32_t newVal, int width)
+{
+    uint32_t ov = 0, nv = 0, diffs = 0;
+
+    if (oldVal == newVal) {
+        return true;
+    }
+
+    // One-byte adjustments to any byte
+    for (int i = 0; i < width; i++) {
+        uint8_t a = oldVal >> (8 * i), b = newVal >> (8 * i);
+        if (a != b) {
+            diffs++;
+            ov = a;
+            nv = b;
+        }
+    }
+
+    if (diffs == 1 && ((uint8_t)(ov - nv) <= ARITH_MAX || (uint8_t)(nv - ov) <= ARITH_MAX)) {
+        return true;
+    }
+
+    if (width == 1) {
+        return false;
+    }
+
+    // Two-byte adjustments to any word, in either byte order
+    diffs = 0;
+    for (int i = 0; i < width / 2; i++) {
+        uint16_t a = oldVal >> (16 * i), b = newVal >> (16 * i);
+        if (a != b) {
+            diffs++;
+            ov = a;
+            nv = b;
+        }
+    }
+
+    if (diffs == 1) {
+        if ((uint16_t)(ov - nv) <= ARITH_MAX || (uint16_t)(nv - ov) <= ARITH_MAX) {
+            return true;
+        }
+
+        ov = swapWord((uint16_t)ov);
+        nv = swapWord((uint16_t)nv);
+        if ((uint16_t)(ov - nv) <= ARITH_MAX || (uint16_t)(nv - ov) <= ARITH_MAX) {
+            return true;
+        }
+    }
+
+    // Four-byte adjustments, in either byte order
+    if (width == 4) {
+        if ((uint32_t)(oldVal - newVal) <= ARITH_MAX || (uint32_t)(newVal - oldVal) <= ARITH_MAX) {
+            return true;
+        }
+
+        oldVal = swapWord(oldVal);
+        newVal = swapWord(newVal);
+        if ((uint32_t)(oldVal - newVal) <= ARITH_MAX || (uint32_t)(newVal - oldVal) <= ARITH_MAX) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Checks whether the interesting value stages for narrower words
+ * could turn oldVal into newVal (AFL's could_be_interest)
+ *
+ * checkNative asks to also consider native order words of the same width,
+ * which is what the swapped pass of a stage needs.
+ */
+inline bool couldBeInterest(uint32_t oldVal, uint32_t newVal, int width, bool checkNative)
+{
+    if (oldVal == newVal) {
+        return true;
+    }
+
+    // One-byte insertions over oldVal
+    for (int i = 0; i < width; i++) {
+        for (int8_t value : interesting8) {
+            uint32_t tval = (oldVal & ~(0xffu << (i * 8))) | ((uint32_t)(uint8_t)value << (i * 8));
+            if (newVal == tval) {
+                return true;
+            }
+        }
+    }
+
+    if (width == 2 && !checkNative) {
+        return false;
+    }
+
+    // Two-byte insertions over oldVal
+    for (int i = 0; i < width - 1; i++) {
+        for (int16_t value : interesting16) {
+            uint32_t tval = (oldVal & ~(0xffffu << (i * 8))) | ((uint32_t)(uint16_t)value << (i * 8));
+            if (newVal == tval) {
+                return true;
+            }
+
+            if (width > 2) {
+                tval = (oldVal & ~(0xffffu << (i * 8))) | ((uint32_t)swapWord((uint16_t)value) << (i * 8));
+                if (newVal == tval) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    if (width == 4 && checkNative) {
+        for (int32_t value : interesting32) {
+            if (newVal == (uint32_t)value) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Returns the number of effector map blocks for a test case size
+ *
+ * The effector map has one bit per 2^EFF_MAP_SCALE2 byte block, set if
+ * flipping the block's bytes changed the coverage of the test case.
+ */
+inline uint32_t effectorBlocks(uint32_t size)
+{
+    return (size + (1u << EFF_MAP_SCALE2) - 1) >> EFF_MAP_SCALE2;
+}
+
+/**
+ * @brief Checks whether any byte in [offset, offset + len) is in an
+ * effective block; a null map marks every block effective
+ */
+inline bool isEffective(const uint8_t* effectorMap, uint32_t offset, uint32_t len)
+{
+    if (!effectorMap) {
+        return true;
+    }
+
+    uint32_t last = (offset + len - 1) >> EFF_MAP_SCALE2;
+    for (uint32_t block = offset >> EFF_MAP_SCALE2; block <= last; block++) {
+        if (effectorMap[block >> 3] & (1 << (block & 7))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Selects a random block length, favoring small blocks
+ *
+ * @param rand the random number generator
+ * @param limit the largest length that may be returned
+ * @return size_t the block length
+ */
+inline size_t chooseBlockLen(VmfRand* rand, size_t limit)
+{
+    size_t min_value, max_value;
+    switch (rand->randBelow(3)) {
+    case 0:
+        min_value = 1;
+        max_value = HAVOC_BLK_SMALL;
+        break;
+    case 1:
+        min_value = HAVOC_BLK_SMALL;
+        max_value = HAVOC_BLK_MEDIUM;
+        break;
+    default:
+        if (rand->randBelow(10)) {
+            min_value = HAVOC_BLK_MEDIUM;
+            max_value = HAVOC_BLK_LARGE;
+        } else {
+            min_value = HAVOC_BLK_LARGE;
+            max_value = HAVOC_BLK_XL;
+        }
+    }
+
+    if (min_value >= limit) {
+        min_value = 1;
+    }
+
+    return rand->randBetween(min_value, std::min(max_value, limit));
+}
+
+/**
+ * @brief Flips Bits consecutive bits starting at a random bit (Bits is 1, 2 or 4)
+ */
+template<int Bits>
+inline void flipBits(char* buff, int size, VmfRand* rand)
+{
+    int bit = rand->randBelow((size << 3) - 1) + 1;
+    if ((size << 3) - bit < Bits) {
+        return;
+    }
+
+    for (int i = 0; i < Bits; i++, bit++) {
+        buff[bit >> 3] ^= (1 << ((bit - 1) % 8));
+    }
+}
+
+/**
+ * @brief Flips every bit of Width consecutive bytes at a random offset
+ */
+template<int Width>
+inline void flipBytes(char* buff, int size, VmfRand* rand)
+{
+    if (size < Width) {
+        return;
+    }
+
+    int byte = rand->randBelow(size - Width + 1);
+    for (int i = 0; i < Width; i++) {
+        buff[byte + i] ^= 0xff;
+    }
+}
+
+/**
+ * @brief Sets a random Width byte word to an interesting value
+ *
+ * 8 byte words use the 32-bit table, sign extended, as AFL++ has no 64-bit
+ * interesting values.
+ */
+template<int Width, AFLByteOrder Order = AFLByteOrder::Native>
+inline void interestingWord(char* buff, int size, VmfRand* rand)
+{
+    using Word = typename AFLWord<Width>::type;
+
+    if (size < Width) {
+        return;
+    }
+
+    int item;
+    Word value;
+    if constexpr (Width == 1) {
+        item = rand->randBelow(sizeof(interesting8) / sizeof(interesting8[0]));
+        value = (Word)interesting8[item];
+    } else if constexpr (Width == 2) {
+        item = rand->randBelow(sizeof(interesting16) / sizeof(interesting16[0]));
+        value = (Word)interesting16[item];
+    } else {
+        item = rand->randBelow(sizeof(interesting32) / sizeof(interesting32[0]));
+        value = (Word)interesting32[item];
+    }
+
+    storeWord<Width, Order>(buff + rand->randBelow(size - Width + 1), value);
+}
+
+/**
+ * @brief Subtracts and then adds a small random value to a random Width byte word
+ */
+template<int Width, AFLByteOrder Order = AFLByteOrder::Native>
+inline void addSubWord(char* buff, int size, VmfRand* rand)
+{
+    using Word = typename AFLWord<Width>::type;
+
+    if (size < Width) {
+        return;
+    }
+
+    char* word = buff + rand->randBelow(size - Width + 1);
+    Word value = loadWord<Width, Order>(word);
+    value -= 1 + (Word)rand->randBelow(ARITH_MAX);
+    value += 1 + (Word)rand->randBelow(ARITH_MAX);
+    storeWord<Width, Order>(word, value);
+}
+
+/**
+ * @brief XORs a random byte with a random non-zero value
+ */
+inline void randomByte(char* buff, int size, VmfRand* rand)
+{
+    int idx = rand->randBelow(size);
+    buff[idx] ^= 1 + (uint8_t)rand->randBelow(255);
+}
+
+/**
+ * @brief Copies a random block of the buffer over another location in it
+ */
+inline void overwriteCopy(char* buff, int size, VmfRand* rand)
+{
+    if (size < 2) {
+        return;
+    }
+
+    uint32_t copy_len = chooseBlockLen(rand, size - 1);
+    uint32_t copy_from = rand->randBelow((unsigned long)(size - copy_len + 1));
+    uint32_t copy_to = rand->randBelow((unsigned long)(size - copy_len + 1));
+    if (copy_from != copy_to) {
+        memmove(buff + copy_to, buff + copy_from, copy_len);
+    }
+}
+
+/**
+ * @brief Overwrites a random block with a single repeated byte
+ *
+ * The byte is either random or the one preceding the block.
+ */
+inline void overwriteFixed(char* buff, int size, VmfRand* rand)
+{
+    if (size < 2) {
+        return;
+    }
+
+    uint32_t copy_len = chooseBlockLen(rand, size - 1);
+    uint32_t copy_to = rand->randBelow((unsigned long)(size - copy_len + 1));
+    uint32_t strat = rand->randBelow(2);
+    uint32_t copy_from = copy_to ? copy_to - 1 : 0;
+    uint32_t item = strat ? rand->randBelow(256) : buff[copy_from];
+    memset(buff + copy_to, item, copy_len);
+}
+
+/**
+ * @brief A block removal drawn by chooseDelete
+ */
+struct BlockDelete
+{
+    int from;
+    int len;
+};
+
+/**
+ * @brief Draws a random block to remove from a buffer of the given size
+ *
+ * Buffers under 2 bytes get an empty block, and are left as they are.
+ */
+inline BlockDelete chooseDelete(int size, VmfRand* rand)
+{
+    if (size < 2) {
+        return {0, 0};
+    }
+
+    int del_len = chooseBlockLen(rand, size - 1);
+    int del_from = rand->randBelow(size - del_len + 1);
+    return {del_from, del_len};
+}
+
+/**
+ * @brief Writes the buffer without the block into out, which holds size - del.len bytes
+ */
+inline void writeDelete(const char* buff, int size, const BlockDelete& del, char* out)
+{
+    memcpy(out, buff, del.from);
+    memcpy(out + del.from, buff + del.from + del.len, size - del.from - del.len);
+}
+
+/**
+ * @brief Removes a random block from the buffer
+ */
+inline void deleteBlock(std::vector<char>& buff, VmfRand* rand)
+{
+    BlockDelete del = chooseDelete((int)buff.size(), rand);
+    buff.erase(buff.begin() + del.from, buff.begin() + del.from + del.len);
+}
+
+/**
+ * @brief A block insertion drawn by chooseClone
+ */
+struct BlockClone
+{
+    int to;
+    int from;   ///< the start of the cloned block, or -1 for a run of fill
+    int len;
+    char fill;
+};
+
+/**
+ * @brief Draws a random block to insert into a buffer of the given size
+ *
+ * Three times out of four the block is cloned from the buffer itself,
+ * otherwise it is a run of up to HAVOC_BLK_XL copies of a random byte.
+ */
+inline BlockClone chooseClone(int size, VmfRand* rand)
+{
+    int actually_clone = rand->randBelow(4);
+    int clone_to = rand->randBelow(size);
+
+    if (actually_clone) {
+        int clone_len = chooseBlockLen(rand, size);
+        int clone_from = rand->randBelow(size - clone_len + 1);
+        return {clone_to, clone_from, clone_len, 0};
+    }
+
+    int clone_len = chooseBlockLen(rand, HAVOC_BLK_XL);
+    int randomByte = rand->randBelow(255);
+    return {clone_to, -1, clone_len, (char)randomByte};
+}
+
+/**
+ * @brief Writes the buffer with the block inserted into out, which holds size + clone.len bytes
+ */
+inline void writeClone(const char* buff, int size, const BlockClone& clone, char* out)
+{
+    memcpy(out, buff, clone.to);
+    if (clone.from >= 0) {
+        memcpy(out + clone.to, buff + clone.from, clone.len);
+    } else {
+        memset(out + clone.to, clone.fill, clone.len);
+    }
+    memcpy(out + clone.to + clone.len, buff + clone.to, size - clone.to);
+}
+
+/**
+ * @brief Inserts a random block at a random location (see chooseClone)
+ */
+inline void cloneBlock(std::vector<char>& buff, VmfRand* rand)
+{
+    int size = (int)buff.size();
+    BlockClone clone = chooseClone(size, rand);
+
+    if (clone.from >= 0) {
+        // Open the gap first, then fill it from the source block, part of
+        // which may now sit on the far side of the gap
+        buff.resize(size + clone.len);
+        char* data = buff.data();
+        memmove(data + clone.to + clone.len, data + clone.to, size - clone.to);
+        int before = std::clamp(clone.to - clone.from, 0, clone.len);
+        memcpy(data + clone.to, data + clone.from, before);
+        memcpy(data + clone.to + before, data + clone.from + before + clone.len, clone.len - before);
+    } else {
+        buff.insert(buff.begin() + clone.to, clone.len, clone.fill);
+    }
+}
+
+}
+}
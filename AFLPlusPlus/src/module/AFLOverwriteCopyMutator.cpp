@@ -48,13 +48,12 @@
  */
 
 #include "AFLOverwriteCopyMutator.hpp"
-#include "AFLDeleteMutator.hpp" //For static choose_block_len method
+#include "AFLMutationOps.hpp"
 #include "RuntimeException.hpp"
 #include <random>
 #include <algorithm>
 
 using namespace vmf;
-using u32 = uint32_t;
 
 #include "ModuleFactory.hpp"
 REGISTER_MODULE(AFLOverwriteCopyMutator);
@@ -120,21 +119,11 @@ void AFLOverwriteCopyMutator::mutateTestCase(StorageModule& storage, StorageEntr
     {
         throw RuntimeException("AFLOverwriteCopyMutator mutate called with zero sized buffer", RuntimeException::USAGE_ERROR);
     }
+
     char* newBuff = newEntry->allocateBuffer(testCaseKey, size);
-    // Copy base entry to new entry
     memcpy((void*)newBuff, (void*)buffer, size);
 
-    if (size < 2) {
-        return;
-    }
-
-    u32 copy_len = AFLDeleteMutator::choose_block_len(rand, size - 1);
-    u32 copy_from = rand->randBelow((unsigned long)(size - copy_len + 1));
-    u32 copy_to = rand->randBelow((unsigned long)(size - copy_len + 1));
-
-    if (copy_from != copy_to) {
-        memmove(newBuff + copy_to, newBuff + copy_from, copy_len);
-    }
+    AFLMutationOps::overwriteCopy(newBuff, size, rand);
 
     return;
 }
\ No newline at end of file
@@ -48,13 +48,12 @@
  */
 
 #include "AFLOverwriteFixedMutator.hpp"
-#include "AFLDeleteMutator.hpp" //For static choose_block_len method
+#include "AFLMutationOps.hpp"
 #include "RuntimeException.hpp"
 #include <random>
 #include <algorithm>
 
 using namespace vmf;
-using u32 = uint32_t;
 
 #include "ModuleFactory.hpp"
 REGISTER_MODULE(AFLOverwriteFixedMutator);
@@ -120,26 +119,11 @@ void AFLOverwriteFixedMutator::mutateTestCase(StorageModule& storage, StorageEnt
     {
         throw RuntimeException("AFLOverwriteFixedMutator mutate called with zero sized buffer", RuntimeException::USAGE_ERROR);
     }
+
     char* newBuff = newEntry->allocateBuffer(testCaseKey, size);
-    // Copy base entry to new entry
     memcpy((void*)newBuff, (void*)buffer, size);
 
-    if (size < 2) {
-        return;
-    }
-
-    // Choose a random block length
-    u32 copy_len = AFLDeleteMutator::choose_block_len(rand, size - 1);
-    // Choose a random location to copy the block to
-    u32 copy_to = rand->randBelow((unsigned long)(size - copy_len + 1));
-    // Choose a random strategy with 50% chance of each
-    u32 strat = rand->randBelow(2);
-    // Copy from the location before the copy_to location or 0 if copy_to is 0
-    u32 copy_from = copy_to ? copy_to - 1 : 0;
-    // Either repeat the byte at the copy_from location or choose a random byte
-    u32 item = strat ? rand->randBelow(256) : buffer[copy_from];
-
-    memset(newBuff + copy_to, item, copy_len);
+    AFLMutationOps::overwriteFixed(newBuff, size, rand);
 
     return;
 }
\ No newline at end of file
@@ -48,12 +48,12 @@
  */
 
 #include "AFLRandomByteMutator.hpp"
+#include "AFLMutationOps.hpp"
 #include "RuntimeException.hpp"
 #include <random>
 #include <algorithm>
 
 using namespace vmf;
-using u8 = uint8_t;
 
 #include "ModuleFactory.hpp"
 REGISTER_MODULE(AFLRandomByteMutator);
@@ -123,8 +123,7 @@ void AFLRandomByteMutator::mutateTestCase(StorageModule& storage, StorageEntry*
     char* newBuff = newEntry->allocateBuffer(testCaseKey, size);
     memcpy((void*)newBuff, (void*)buffer, size);
 
-    int idx = rand->randBelow(size);
-    newBuff[idx] ^= 1 + (u8)rand->randBelow(255);
+    AFLMutationOps::randomByte(newBuff, size, rand);
 
     return;
 }
\ No newline at end of file
@@ -0,0 +1,483 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2023 The Charles Stark Draper Laboratory, Inc.
+ * <vader@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+/*****
+ * The following includes code copied from the AFLplusplus repository.
+ * 
+ *       american fuzzy lop++ - fuzzer header
+ *  ------------------------------------
+ *  Originally written by Michal Zalewski
+ *  Now maintained by Marc Heuse <mh@mh-sec.de>,
+ *                    Heiko Eißfeldt <heiko.eissfeldt@hexco.de>,
+ *                    Andrea Fioraldi <andreafioraldi@gmail.com>,
+ *                    Dominik Maier <mail@dmnk.co>
+ *  Copyright 2016, 2017 Google Inc. All rights reserved.
+ *  Copyright 2019-2020 AFLplusplus Project. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *  This is the Library based on AFL++ which can be used to build
+ *  customized fuzzers for a specific target while taking advantage of
+ *  a lot of features that AFL++ already provides.
+ */
+
+#include "AFLTokenDictionary.hpp"
+#include "AFLMutationOps.hpp"
+#include "RuntimeException.hpp"
+
+#include <cctype>
+#include <cstring>
+#include <deque>
+#include <fstream>
+
+using namespace vmf;
+
+/**
+ * @brief Construct a new, empty AFLTokenPool
+ */
+AFLTokenPool::AFLTokenPool()
+{
+    starts.push_back(0);
+}
+
+/**
+ * @brief Appends a token, unless it is empty or already in the pool
+ * 
+ * @return true if the token was added
+ */
+bool AFLTokenPool::add(const char* data, size_t len)
+{
+    if(len == 0 || contains(data, len))
+    {
+        return false;
+    }
+
+    byHash.emplace(std::hash<std::string_view>{}(std::string_view(data, len)), (uint32_t)size());
+    bytes.insert(bytes.end(), data, data + len);
+    starts.push_back(bytes.size());
+    return true;
+}
+
+/**
+ * @brief Checks whether the pool holds a token
+ */
+bool AFLTokenPool::contains(const char* data, size_t len) const
+{
+    std::string_view token(data, len);
+    auto range = byHash.equal_range(std::hash<std::string_view>{}(token));
+    for(auto it = range.first; it != range.second; ++it)
+    {
+        if(get(it->second) == token)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Construct a matcher that matches nothing until it is built
+ */
+AFLTokenMatcher::AFLTokenMatcher()
+{
+    build({});
+}
+
+/**
+ * @brief Builds the automaton for a set of tokens
+ * 
+ * The trie is built first, with missing transitions marked, and then a
+ * breadth first walk sets each node's failure link and replaces its missing
+ * transitions with those of its failure node.
+ * 
+ * @param tokens the tokens to find; matches refer to them by index
+ */
+void AFLTokenMatcher::build(const std::vector<std::string_view>& tokens)
+{
+    const uint32_t missing = UINT32_MAX;
+
+    // Class 0 is every byte that occurs in no token
+    memset(byteClass, 0, sizeof(byteClass));
+    numClasses = 1;
+    for(std::string_view token : tokens)
+    {
+        for(char c : token)
+        {
+            if(byteClass[(uint8_t)c] == 0)
+            {
+                byteClass[(uint8_t)c] = numClasses++;
+            }
+        }
+    }
+
+    transitions.assign(numClasses, missing);
+    output.assign(1, -1);
+    tokenLengths.clear();
+
+    for(size_t i = 0; i < tokens.size(); i++)
+    {
+        uint32_t node = 0;
+        for(char c : tokens[i])
+        {
+            uint32_t& next = transitions[node * numClasses + byteClass[(uint8_t)c]];
+            if(next == missing)
+            {
+                next = output.size();
+                output.push_back(-1);
+                transitions.resize(transitions.size() + numClasses, missing);
+            }
+            node = transitions[node * numClasses + byteClass[(uint8_t)c]];
+        }
+
+        if(output[node] < 0)
+        {
+            output[node] = i;
+        }
+        tokenLengths.push_back(tokens[i].size());
+    }
+
+    std::vector<uint32_t> failure(output.size(), 0);
+    outputLink.assign(output.size(), 0);
+    std::deque<uint32_t> pending;
+
+    for(uint32_t c = 0; c < numClasses; c++)
+    {
+        uint32_t& next = transitions[c];
+        if(next == missing)
+        {
+            next = 0;
+        }
+        else
+        {
+            pending.push_back(next);
+        }
+    }
+
+    while(!pending.empty())
+    {
+        uint32_t node = pending.front();
+        pending.pop_front();
+
+        for(uint32_t c = 0; c < numClasses; c++)
+        {
+            uint32_t& next = transitions[node * numClasses + c];
+            uint32_t fallback = transitions[failure[node] * numClasses + c];
+            if(next == missing)
+            {
+                next = fallback;
+            }
+            else
+            {
+                failure[next] = fallback;
+                outputLink[next] = output[fallback] >= 0 ? fallback : outputLink[fallback];
+                pending.push_back(next);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Appends every occurrence of every token in a buffer to matches,
+ * in order of where they end
+ */
+void AFLTokenMatcher::findAll(const char* buff, size_t size, std::vector<Match>& matches) const
+{
+    const uint32_t* table = transitions.data();
+    uint32_t node = 0;
+
+    for(size_t i = 0; i < size; i++)
+    {
+        node = table[node * numClasses + byteClass[(uint8_t)buff[i]]];
+
+        for(uint32_t found = output[node] >= 0 ? node : outputLink[node]; found != 0; found = outputLink[found])
+        {
+            uint32_t token = output[found];
+            matches.push_back({(uint32_t)(i + 1 - tokenLengths[token]), token});
+        }
+    }
+}
+
+/**
+ * @brief Returns the dictionary shared by the AFL modules
+ */
+AFLTokenDictionary* AFLTokenDictionary::getInstance()
+{
+    static AFLTokenDictionary dictionary;
+    return &dictionary;
+}
+
+AFLTokenDictionary::AFLTokenDictionary()
+{
+    matcherStale = false;
+}
+
+/**
+ * @brief Loads the user tokens from an AFL format dictionary file
+ * 
+ * Each line is blank, a # comment, or a token in double quotes, optionally
+ * preceded by a name and an equals sign, as in name="value".  Within the
+ * quotes, \\, \" and \xNN escape bytes, and every other byte must be
+ * printable.  As with afl-fuzz -x, a path of the form file@level also loads
+ * the tokens named name@N for N up to level; without one, only unleveled
+ * tokens are loaded.  Each file is only loaded once.
+ * 
+ * @param path the dictionary file, optionally followed by @level
+ * @throws RuntimeException if the file cannot be read or has a malformed line
+ */
+void AFLTokenDictionary::loadFile(const std::string& path)
+{
+    if(!loadedFiles.insert(path).second)
+    {
+        return;
+    }
+
+    std::string fileName = path;
+    int level = 0;
+    size_t at = path.rfind('@');
+    if(at != std::string::npos && at + 1 < path.size() && isdigit((unsigned char)path[at + 1]))
+    {
+        fileName = path.substr(0, at);
+        level = atoi(path.c_str() + at + 1);
+    }
+
+    std::ifstream file(fileName);
+    if(!file.is_open())
+    {
+        throw RuntimeException("Unable to open dictionary file " + fileName, RuntimeException::CONFIGURATION_ERROR);
+    }
+
+    std::string line;
+    std::string token;
+    int lineNumber = 0;
+    while(std::getline(file, line))
+    {
+        lineNumber++;
+        std::string where = fileName + " line " + std::to_string(lineNumber);
+
+        // Trim the whitespace on both ends, and skip blank and comment lines
+        size_t begin = line.find_first_not_of(" \t\r\n");
+        if(begin == std::string::npos || line[begin] == '#')
+        {
+            continue;
+        }
+        size_t end = line.find_last_not_of(" \t\r\n") + 1;
+
+        if(line[end - 1] != '"')
+        {
+            throw RuntimeException("Malformed name=\"value\" pair in dictionary " + where, RuntimeException::CONFIGURATION_ERROR);
+        }
+
+        // Skip the optional name, and the token entirely if its level is too high
+        size_t pos = begin;
+        while(pos < end && (isalnum((unsigned char)line[pos]) || line[pos] == '_'))
+        {
+            pos++;
+        }
+
+        if(pos < end && line[pos] == '@')
+        {
+            if(atoi(line.c_str() + pos + 1) > level)
+            {
+                continue;
+            }
+            while(++pos < end && isdigit((unsigned char)line[pos]));
+        }
+
+        while(pos < end && (line[pos] == ' ' || line[pos] == '\t' || line[pos] == '='))
+        {
+            pos++;
+        }
+
+        if(pos + 1 >= end || line[pos] != '"')
+        {
+            throw RuntimeException("Malformed name=\"value\" pair in dictionary " + where, RuntimeException::CONFIGURATION_ERROR);
+        }
+
+        token.clear();
+        for(pos++; pos < end - 1; pos++)
+        {
+            unsigned char c = line[pos];
+            if(c == '\\')
+            {
+                pos++;
+                if(pos < end - 1 && (line[pos] == '\\' || line[pos] == '"'))
+                {
+                    token.push_back(line[pos]);
+                }
+                else if(pos + 2 < end && line[pos] == 'x' && isxdigit((unsigned char)line[pos + 1]) && isxdigit((unsigned char)line[pos + 2]))
+                {
+                    token.push_back((char)std::stoi(line.substr(pos + 1, 2), nullptr, 16));
+                    pos += 2;
+                }
+                else
+                {
+                    throw RuntimeException("Invalid escaping (not \\xNN) in dictionary " + where, RuntimeException::CONFIGURATION_ERROR);
+                }
+            }
+            else if(c < 32 || c > 127)
+            {
+                throw RuntimeException("Non-printable characters in dictionary " + where, RuntimeException::CONFIGURATION_ERROR);
+            }
+            else
+            {
+                token.push_back(c);
+            }
+        }
+
+        if(token.empty() || token.size() > MAX_DICT_FILE)
+        {
+            throw RuntimeException("Dictionary tokens must be between 1 and " + std::to_string(MAX_DICT_FILE) + " bytes, in " + where,
+                                   RuntimeException::CONFIGURATION_ERROR);
+        }
+
+        addToken(token.data(), token.size());
+    }
+}
+
+/**
+ * @brief Adds a user token, unless it is empty, longer than MAX_DICT_FILE
+ * or already known
+ * 
+ * @return true if the token was added
+ */
+bool AFLTokenDictionary::addToken(const char* data, size_t len)
+{
+    if(len > MAX_DICT_FILE || !userTokens.add(data, len))
+    {
+        return false;
+    }
+
+    matcherStale = true;
+    return true;
+}
+
+/**
+ * @brief Adds an auto token, unless it is one AFL would not keep
+ * 
+ * As in AFL's maybe_add_auto, tokens must be MIN_AUTO_EXTRA to
+ * MAX_AUTO_EXTRA bytes long, and runs of one byte value, 32 bit interesting
+ * values and known tokens are rejected.  Once USE_AUTO_EXTRAS tokens are
+ * held, new ones are dropped.
+ * 
+ * @return true if the token was added
+ */
+bool AFLTokenDictionary::addAutoToken(const char* data, size_t len)
+{
+    if(len < MIN_AUTO_EXTRA || len > MAX_AUTO_EXTRA || autoTokens.size() >= USE_AUTO_EXTRAS)
+    {
+        return false;
+    }
+
+    if(std::string_view(data, len).find_first_not_of(data[0]) == std::string_view::npos)
+    {
+        return false;
+    }
+
+    if(len == 4)
+    {
+        uint32_t value = AFLMutationOps::loadWord<4>(data);
+        for(int32_t interesting : AFLMutationOps::interesting32)
+        {
+            if(value == (uint32_t)interesting || value == AFLMutationOps::swapWord((uint32_t)interesting))
+            {
+                return false;
+            }
+        }
+    }
+
+    if(userTokens.contains(data, len) || !autoTokens.add(data, len))
+    {
+        return false;
+    }
+
+    matcherStale = true;
+    return true;
+}
+
+/**
+ * @brief Returns token i, counting the user tokens first
+ */
+std::string_view AFLTokenDictionary::get(size_t i) const
+{
+    return i < userTokens.size() ? userTokens.get(i) : autoTokens.get(i - userTokens.size());
+}
+
+/**
+ * @brief Picks a random token index
+ * As AFL's havoc stage does, this picks user and auto tokens equally often
+ * when there are both, whatever their counts.  The dictionary must not be
+ * empty.
+ */
+size_t AFLTokenDictionary::randomToken(VmfRand* rand) const
+{
+    size_t userCount = userTokens.size();
+    size_t autoCount = autoTokens.size();
+
+    if(autoCount == 0 || (userCount > 0 && rand->randBelow(2)))
+    {
+        return rand->randBelow((unsigned long)userCount);
+    }
+
+    return userCount + rand->randBelow((unsigned long)autoCount);
+}
+
+/**
+ * @brief Returns a matcher over every token, rebuilding it if tokens were
+ * added since it was last built; matches index tokens as get() does
+ */
+const AFLTokenMatcher& AFLTokenDictionary::getMatcher()
+{
+    if(matcherStale)
+    {
+        std::vector<std::string_view> tokens;
+        tokens.reserve(size());
+        for(size_t i = 0; i < size(); i++)
+        {
+            tokens.push_back(get(i));
+        }
+
+        matcher.build(tokens);
+        matcherStale = false;
+    }
+
+    return matcher;
+}
+
+/**
+ * @brief Removes every token and forgets which files were loaded
+ */
+void AFLTokenDictionary::clear()
+{
+    userTokens = AFLTokenPool();
+    autoTokens = AFLTokenPool();
+    loadedFiles.clear();
+    matcher.build({});
+    matcherStale = false;
+}
@@ -0,0 +1,147 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2023 The Charles Stark Draper Laboratory, Inc.
+ * <vader@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#pragma once
+
+#include "VmfRand.hpp"
+#include "config.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace vmf
+{
+/**
+ * @brief A set of distinct tokens stored back to back in one buffer
+ * 
+ * Token i occupies bytes [starts[i], starts[i + 1]) of the pool, so picking
+ * a random token is two loads from small arrays rather than a walk over
+ * separately allocated strings.  Tokens are only ever appended, so their
+ * indices are stable.
+ */
+class AFLTokenPool
+{
+public:
+    AFLTokenPool();
+
+    bool add(const char* data, size_t len);
+    bool contains(const char* data, size_t len) const;
+
+    /// The number of tokens in the pool
+    size_t size() const { return starts.size() - 1; }
+    bool empty() const { return starts.size() == 1; }
+
+    /// The bytes of token i, which stay valid until the next add
+    std::string_view get(size_t i) const { return std::string_view(bytes.data() + starts[i], starts[i + 1] - starts[i]); }
+
+private:
+    std::vector<char> bytes;
+    std::vector<uint32_t> starts;
+    std::unordered_multimap<size_t, uint32_t> byHash;   ///< token hash to index, for duplicate checks
+};
+
+/**
+ * @brief An Aho-Corasick automaton that finds every occurrence of a set of
+ * tokens in a buffer in a single pass
+ * 
+ * Bytes that occur in no token share one input class, so the dense
+ * transition table has one row per trie node and one column per distinct
+ * token byte (plus one) rather than 256.  Failure links are folded into the
+ * table when it is built, so the scan does one table load per input byte,
+ * plus one per match reported.
+ */
+class AFLTokenMatcher
+{
+public:
+    /// A token that occurs in the buffer
+    struct Match
+    {
+        uint32_t offset;
+        uint32_t token;     ///< index into the tokens the matcher was built from
+    };
+
+    AFLTokenMatcher();
+
+    void build(const std::vector<std::string_view>& tokens);
+    void findAll(const char* buff, size_t size, std::vector<Match>& matches) const;
+
+private:
+    uint16_t byteClass[256];                ///< 0 for bytes in no token, so up to 257 classes
+    uint32_t numClasses;
+    std::vector<uint32_t> transitions;      ///< node * numClasses + class to the next node
+    std::vector<int32_t> output;            ///< the longest token ending at a node, or -1
+    std::vector<uint32_t> outputLink;       ///< the next node on the suffix chain with an output, or 0
+    std::vector<uint32_t> tokenLengths;
+};
+
+/**
+ * @brief The tokens shared by the AFL modules
+ * 
+ * User tokens come from AFL format dictionary files and from the tokens
+ * lists in the module configurations; AFLDeterministicInputGenerator uses
+ * up to MAX_DET_EXTRAS of them in its deterministic token stages.  Auto
+ * tokens are byte runs the generator extracts from its walking bit flips,
+ * capped at USE_AUTO_EXTRAS.  The token mutators draw from both, and find
+ * the tokens already present in a test case with a matcher over both sets,
+ * which is rebuilt when either grows.
+ */
+class AFLTokenDictionary
+{
+public:
+    static AFLTokenDictionary* getInstance();
+
+    void loadFile(const std::string& path);
+    bool addToken(const char* data, size_t len);
+    bool addAutoToken(const char* data, size_t len);
+
+    const AFLTokenPool& getUserTokens() const { return userTokens; }
+    const AFLTokenPool& getAutoTokens() const { return autoTokens; }
+
+    /// The number of user and auto tokens; index i < getUserTokens().size() is a user token
+    size_t size() const { return userTokens.size() + autoTokens.size(); }
+    std::string_view get(size_t i) const;
+    size_t randomToken(VmfRand* rand) const;
+
+    const AFLTokenMatcher& getMatcher();
+    void clear();
+
+private:
+    AFLTokenDictionary();
+
+    AFLTokenPool userTokens;
+    AFLTokenPool autoTokens;
+    std::unordered_set<std::string> loadedFiles;
+
+    AFLTokenMatcher matcher;
+    bool matcherStale;
+};
+}
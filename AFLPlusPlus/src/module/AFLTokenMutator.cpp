@@ -0,0 +1,262 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2023 The Charles Stark Draper Laboratory, Inc.
+ * <vader@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+/*****
+ * The following includes code copied from the AFLplusplus repository.
+ * 
+ *       american fuzzy lop++ - fuzzer header
+ *  ------------------------------------
+ *  Originally written by Michal Zalewski
+ *  Now maintained by Marc Heuse <mh@mh-sec.de>,
+ *                    Heiko Eißfeldt <heiko.eissfeldt@hexco.de>,
+ *                    Andrea Fioraldi <andreafioraldi@gmail.com>,
+ *                    Dominik Maier <mail@dmnk.co>
+ *  Copyright 2016, 2017 Google Inc. All rights reserved.
+ *  Copyright 2019-2020 AFLplusplus Project. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at:
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *  This is the Library based on AFL++ which can be used to build
+ *  customized fuzzers for a specific target while taking advantage of
+ *  a lot of features that AFL++ already provides.
+ */
+
+#include "AFLTokenMutator.hpp"
+#include "RuntimeException.hpp"
+#include "config.h"
+
+#include <cstring>
+
+using namespace vmf;
+
+/**
+ * @brief Builder method to support the ModuleFactory
+ * Constructs an instance of this class
+ * @return Module* 
+ */
+template<AFLTokenOp Op>
+Module* AFLTokenMutator<Op>::build(std::string name)
+{
+    return new AFLTokenMutator<Op>(name);
+}
+
+/**
+ * @brief Initialization method
+ * Adds the optional dictionaryFiles and tokens parameters to the shared
+ * dictionary
+ * 
+ * @param config 
+ */
+template<AFLTokenOp Op>
+void AFLTokenMutator<Op>::init(ConfigInterface& config)
+{
+    for(const std::string& path : config.getStringVectorParam(getModuleName(), "dictionaryFiles", {}))
+    {
+        dictionary->loadFile(path);
+    }
+
+    for(const std::string& token : config.getStringVectorParam(getModuleName(), "tokens", {}))
+    {
+        dictionary->addToken(token.data(), token.size());
+    }
+}
+
+/**
+ * @brief Construct a new AFLTokenMutator object
+ * 
+ * @param name the name of the module
+ */
+template<AFLTokenOp Op>
+AFLTokenMutator<Op>::AFLTokenMutator(std::string name) :
+    MutatorModule(name)
+{
+
+}
+
+/**
+ * @brief Destroy the AFLTokenMutator object
+ * 
+ */
+template<AFLTokenOp Op>
+AFLTokenMutator<Op>::~AFLTokenMutator()
+{
+
+}
+
+/**
+ * @brief Registers storage needs
+ * This class uses only the "TEST_CASE" key
+ * 
+ * @param registry 
+ */
+template<AFLTokenOp Op>
+void AFLTokenMutator<Op>::registerStorageNeeds(StorageRegistry& registry)
+{
+    testCaseKey = registry.registerKey("TEST_CASE", StorageRegistry::BUFFER, StorageRegistry::READ_WRITE);
+}
+
+template<AFLTokenOp Op>
+void AFLTokenMutator<Op>::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
+{
+
+    int size = baseEntry->getBufferSize(testCaseKey);
+    char* buffer = baseEntry->getBufferPointer(testCaseKey);
+
+    if(size <= 0)
+    {
+        throw RuntimeException("AFLTokenMutator mutate called with zero sized buffer", RuntimeException::USAGE_ERROR);
+    }
+
+    if(dictionary->size() == 0)
+    {
+        copyUnchanged(buffer, size, newEntry, testCaseKey);
+    }
+    else if constexpr (Op == AFLTokenOp::Overwrite)
+    {
+        overwrite(buffer, size, newEntry, testCaseKey, dictionary->randomToken(rand));
+    }
+    else if constexpr (Op == AFLTokenOp::Insert)
+    {
+        insert(buffer, size, newEntry, testCaseKey, dictionary->randomToken(rand));
+    }
+    else
+    {
+        replace(buffer, size, newEntry, testCaseKey);
+    }
+
+    return;
+}
+
+/**
+ * @brief Overwrites the bytes at a random offset with a token
+ */
+template<AFLTokenOp Op>
+void AFLTokenMutator<Op>::overwrite(const char* buffer, int size, StorageEntry* newEntry, int testCaseKey, size_t token)
+{
+    std::string_view value = dictionary->get(token);
+    if(value.size() > (size_t)size)
+    {
+        copyUnchanged(buffer, size, newEntry, testCaseKey);
+        return;
+    }
+
+    int offset = rand->randBelow(size - (int)value.size() + 1);
+
+    char* newBuff = newEntry->allocateBuffer(testCaseKey, size);
+    memcpy(newBuff, buffer, size);
+    memcpy(newBuff + offset, value.data(), value.size());
+}
+
+/**
+ * @brief Inserts a token at a random offset, including the end
+ */
+template<AFLTokenOp Op>
+void AFLTokenMutator<Op>::insert(const char* buffer, int size, StorageEntry* newEntry, int testCaseKey, size_t token)
+{
+    std::string_view value = dictionary->get(token);
+    if(size + value.size() >= MAX_FILE)
+    {
+        copyUnchanged(buffer, size, newEntry, testCaseKey);
+        return;
+    }
+
+    int offset = rand->randBelow(size + 1);
+
+    char* newBuff = newEntry->allocateBuffer(testCaseKey, size + value.size());
+    memcpy(newBuff, buffer, offset);
+    memcpy(newBuff + offset, value.data(), value.size());
+    memcpy(newBuff + offset + value.size(), buffer + offset, size - offset);
+}
+
+/**
+ * @brief Replaces a random token occurrence with a different token
+ * The occurrences are found in one pass over the buffer, however many
+ * tokens the dictionary holds.
+ */
+template<AFLTokenOp Op>
+void AFLTokenMutator<Op>::replace(const char* buffer, int size, StorageEntry* newEntry, int testCaseKey)
+{
+    matches.clear();
+    dictionary->getMatcher().findAll(buffer, size, matches);
+
+    if(matches.empty())
+    {
+        overwrite(buffer, size, newEntry, testCaseKey, dictionary->randomToken(rand));
+        return;
+    }
+
+    const AFLTokenMatcher::Match& match = matches[rand->randBelow((int)matches.size())];
+    size_t token = dictionary->randomToken(rand);
+    if(token == match.token)
+    {
+        // Pick again among the other tokens, if there are any
+        if(dictionary->size() == 1)
+        {
+            copyUnchanged(buffer, size, newEntry, testCaseKey);
+            return;
+        }
+        token = (token + 1 + rand->randBelow((unsigned long)dictionary->size() - 1)) % dictionary->size();
+    }
+
+    std::string_view oldValue = dictionary->get(match.token);
+    std::string_view newValue = dictionary->get(token);
+    size_t newSize = size - oldValue.size() + newValue.size();
+    if(newSize >= MAX_FILE)
+    {
+        copyUnchanged(buffer, size, newEntry, testCaseKey);
+        return;
+    }
+
+    size_t tail = match.offset + oldValue.size();
+    char* newBuff = newEntry->allocateBuffer(testCaseKey, newSize);
+    memcpy(newBuff, buffer, match.offset);
+    memcpy(newBuff + match.offset, newValue.data(), newValue.size());
+    memcpy(newBuff + match.offset + newValue.size(), buffer + tail, size - tail);
+}
+
+/**
+ * @brief Copies the test case without mutation
+ */
+template<AFLTokenOp Op>
+void AFLTokenMutator<Op>::copyUnchanged(const char* buffer, int size, StorageEntry* newEntry, int testCaseKey)
+{
+    char* newBuff = newEntry->allocateBuffer(testCaseKey, size);
+    memcpy(newBuff, buffer, size);
+}
+
+// Instantiate every specialization here, and register each one under its
+// own module name
+template class vmf::AFLTokenMutator<AFLTokenOp::Overwrite>;
+template class vmf::AFLTokenMutator<AFLTokenOp::Insert>;
+template class vmf::AFLTokenMutator<AFLTokenOp::Replace>;
+
+#include "ModuleFactory.hpp"
+REGISTER_MODULE(AFLTokenOverwriteMutator);
+REGISTER_MODULE(AFLTokenInsertMutator);
+REGISTER_MODULE(AFLTokenReplaceMutator);
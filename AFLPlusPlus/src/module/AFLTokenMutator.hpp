@@ -33,28 +33,40 @@
 #include "StorageEntry.hpp"
 #include "RuntimeException.hpp"
 #include "VmfRand.hpp"
+#include "AFLTokenDictionary.hpp"
 
-// external project includes.
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wwrite-strings"
-#pragma GCC diagnostic pop
+#include <vector>
 
 namespace vmf
 {
 /**
- * @brief This mutator flips a random pair of bytes in the test case buffer
- * 
- * Note: If the base test case buffer is smaller than 2 bytes, no
- * mutation will occur (instead the input will just be duplicated)
+ * @brief The operations AFLTokenMutator can apply
+ */
+enum class AFLTokenOp
+{
+    Overwrite,  ///< Overwrite the bytes at a random offset with a token
+    Insert,     ///< Insert a token at a random offset
+    Replace     ///< Replace a token that occurs in the test case with another token
+};
+
+/**
+ * @brief This mutator splices a dictionary token into the test case buffer
  * 
- * This module is draws heavily upon the libAFL mutator.c
+ * The tokens come from the shared AFLTokenDictionary: the AFL format
+ * dictionary files listed in the dictionaryFiles parameter, the tokens
+ * parameter, and any auto tokens AFLDeterministicInputGenerator has
+ * extracted.  As in AFL's havoc stage, user and auto tokens are picked
+ * equally often when there are both.
  * 
- * Uses the specified AFL-style mutation algorithm to mutate the provided
- * input.  createTestCase is the main mutation method.
+ * The replace operation finds every token occurrence in one pass of the
+ * dictionary's Aho-Corasick matcher, replaces a random one with a random
+ * different token, and overwrites instead when no token occurs.  The test
+ * case is copied without mutation if the dictionary is empty, the token
+ * does not fit, or the result would reach MAX_FILE bytes.
  * 
- * See https://github.com/AFLplusplus/LibAFL-legacy/blob/dev/src/mutator.c
+ * See https://github.com/AFLplusplus/AFLplusplus/blob/stable/src/afl-fuzz-one.c
  * 
- * The following includes code copied from the LibAFL_Legacy repository.
+ * The following includes code copied from the AFLplusplus repository.
  * 
  *       american fuzzy lop++ - fuzzer header
  *  ------------------------------------
@@ -72,21 +84,37 @@ namespace vmf
  *  This is the Library based on AFL++ which can be used to build
  *  customized fuzzers for a specific target while taking advantage of
  *  a lot of features that AFL++ already provides.
+ * 
+ * @tparam Op the operation to apply
  */
-class AFLFlip2ByteMutator: public MutatorModule
+template<AFLTokenOp Op>
+class AFLTokenMutator: public MutatorModule
 {
 public:
 
     static Module* build(std::string name);
     virtual void init(ConfigInterface& config);
 
-    AFLFlip2ByteMutator(std::string name);
-    virtual ~AFLFlip2ByteMutator();
+    AFLTokenMutator(std::string name);
+    virtual ~AFLTokenMutator();
     virtual void registerStorageNeeds(StorageRegistry& registry);
     virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
-    
+
 private:
+    void overwrite(const char* buffer, int size, StorageEntry* newEntry, int testCaseKey, size_t token);
+    void insert(const char* buffer, int size, StorageEntry* newEntry, int testCaseKey, size_t token);
+    void replace(const char* buffer, int size, StorageEntry* newEntry, int testCaseKey);
+    void copyUnchanged(const char* buffer, int size, StorageEntry* newEntry, int testCaseKey);
+
     int testCaseKey;
+    AFLTokenDictionary* dictionary = AFLTokenDictionary::getInstance();
     VmfRand* rand = VmfRand::getInstance();
+
+    /// Reused across calls so that only its first use allocates
+    std::vector<AFLTokenMatcher::Match> matches;
 };
+
+using AFLTokenOverwriteMutator = AFLTokenMutator<AFLTokenOp::Overwrite>;
+using AFLTokenInsertMutator = AFLTokenMutator<AFLTokenOp::Insert>;
+using AFLTokenReplaceMutator = AFLTokenMutator<AFLTokenOp::Replace>;
 }
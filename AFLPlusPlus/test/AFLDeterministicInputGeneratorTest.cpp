@@ -0,0 +1,381 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2023 The Charles Stark Draper Laboratory, Inc.
+ * <vader@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+
+#include "gtest/gtest.h"
+#include "ModuleTestHelper.hpp"
+#include "SimpleStorage.hpp"
+#include "AFLDeterministicInputGenerator.hpp"
+#include "AFLMutationOps.hpp"
+#include "AFLTokenDictionary.hpp"
+#include "RuntimeException.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+using vmf::StorageRegistry;
+using vmf::ModuleTestHelper;
+using vmf::TestConfigInterface;
+using vmf::SimpleStorage;
+using vmf::StorageEntry;
+using vmf::AFLDeterministicInputGenerator;
+using vmf::AFLTokenDictionary;
+using vmf::RuntimeException;
+using namespace vmf::AFLMutationOps;
+
+class AFLDeterministicInputGeneratorTest : public ::testing::Test {
+  protected:
+    AFLDeterministicInputGeneratorTest()
+    {
+      storage = new SimpleStorage("storage");
+      registry = new StorageRegistry("TEST_INT", StorageRegistry::INT, StorageRegistry::ASCENDING);
+      metadata = new StorageRegistry();
+      testHelper = new ModuleTestHelper();
+      theGenerator = new AFLDeterministicInputGenerator("AFLDeterministicInputGenerator");
+    }
+
+    ~AFLDeterministicInputGeneratorTest() override {}
+
+    void SetUp() override {
+      AFLTokenDictionary::getInstance()->clear();
+      testCaseKey = registry->registerKey("TEST_CASE", StorageRegistry::BUFFER, StorageRegistry::READ_WRITE);
+      traceBitsKey = registry->registerKey("AFL_TRACE_BITS", StorageRegistry::BUFFER, StorageRegistry::READ_WRITE);
+      effectorMapKey = registry->registerKey("AFL_EFFECTOR_MAP", StorageRegistry::BUFFER, StorageRegistry::READ_WRITE);
+    }
+
+    void TearDown() override {
+      AFLTokenDictionary::getInstance()->clear();
+      delete theGenerator;
+      delete registry;
+      delete metadata;
+      delete storage;
+      delete testHelper;
+    }
+
+    void initGenerator() {
+      try {
+        theGenerator->init(*testHelper->getConfig());
+        theGenerator->registerStorageNeeds(*registry);
+        storage->configure(registry, metadata);
+      }
+      catch (RuntimeException e)
+      {
+        FAIL() << "Exception thrown: " << e.getReason();
+      }
+    }
+
+    StorageEntry* saveSeed(const std::string& contents) {
+      StorageEntry* seed = storage->createNewEntry();
+      memcpy(seed->allocateBuffer(testCaseKey, contents.size()), contents.data(), contents.size());
+      storage->saveEntry(seed);
+      storage->clearNewAndLocalEntries();
+      return seed;
+    }
+
+    // Returns the test cases created since the last clearNewAndLocalEntries
+    std::vector<std::string> newTestCases() {
+      std::vector<std::string> outputs;
+      std::unique_ptr<vmf::Iterator> entries = storage->getNewEntries();
+      while (entries->hasNext()) {
+        StorageEntry* entry = entries->getNext();
+        outputs.emplace_back(entry->getBufferPointer(testCaseKey), entry->getBufferSize(testCaseKey));
+      }
+      return outputs;
+    }
+
+    // Writes the coverage trace of a test case, as 64 copies of one byte; the seeds' traces use 1
+    void writeTrace(StorageEntry* entry, char coverage) {
+      memset(entry->allocateBuffer(traceBitsKey, 64), coverage, 64);
+    }
+
+    // Runs one fuzzing loop iteration, returning the test cases it created.  If given,
+    // coverage stands in for the executor and picks the trace of each test case.
+    std::vector<std::string> runOnce(bool& done, std::function<char(const std::string&)> coverage = nullptr) {
+      theGenerator->addNewTestCases(*storage);
+      std::vector<std::string> outputs = newTestCases();
+
+      if (coverage) {
+        std::unique_ptr<vmf::Iterator> entries = storage->getNewEntries();
+        for (const std::string& output : outputs)
+          writeTrace(entries->getNext(), coverage(output));
+      }
+
+      done = theGenerator->examineTestCaseResults(*storage);
+      storage->clearNewAndLocalEntries();
+      return outputs;
+    }
+
+    AFLDeterministicInputGenerator* theGenerator;
+    SimpleStorage* storage;
+    StorageRegistry* registry;
+    StorageRegistry* metadata;
+    ModuleTestHelper* testHelper;
+    int testCaseKey;
+    int traceBitsKey;
+    int effectorMapKey;
+};
+
+TEST_F(AFLDeterministicInputGeneratorTest, SkipPredicatesMatchAFL)
+{
+    // Walking 1, 2 and 4 bit flips, and 8, 16 and 32 bit flips on byte boundaries
+    EXPECT_TRUE(couldBeBitflip(0x00));
+    EXPECT_TRUE(couldBeBitflip(0x01));
+    EXPECT_TRUE(couldBeBitflip(0x80));
+    EXPECT_TRUE(couldBeBitflip(0x06));
+    EXPECT_TRUE(couldBeBitflip(0xF0));
+    EXPECT_TRUE(couldBeBitflip(0xFF00));
+    EXPECT_TRUE(couldBeBitflip(0x00FFFF00));
+    EXPECT_TRUE(couldBeBitflip(0xFFFFFFFF));
+    EXPECT_FALSE(couldBeBitflip(0x05));
+    EXPECT_FALSE(couldBeBitflip(0x07));
+    EXPECT_FALSE(couldBeBitflip(0x0FF0));
+    EXPECT_FALSE(couldBeBitflip(0x1FE));
+    EXPECT_FALSE(couldBeBitflip(0x00FFFFFF));
+
+    // Byte, word and dword arithmetic by up to ARITH_MAX, in either byte order for words
+    EXPECT_TRUE(couldBeArith(0x00, 0x01, 1));
+    EXPECT_TRUE(couldBeArith(0x00, 0x23, 1));
+    EXPECT_FALSE(couldBeArith(0x00, 0x24, 1));
+    EXPECT_TRUE(couldBeArith(0x00, 0xDD, 1));
+    EXPECT_FALSE(couldBeArith(0x00, 0xDC, 1));
+    EXPECT_TRUE(couldBeArith(0x05, 0x05, 1));   // an unchanged value is never run
+    EXPECT_TRUE(couldBeArith(0x00FF, 0x0100, 2));
+    EXPECT_TRUE(couldBeArith(0xFF00, 0x0001, 2));
+    EXPECT_FALSE(couldBeArith(0x0000, 0x0101, 2));
+    EXPECT_TRUE(couldBeArith(0x0000FFFF, 0x00010000, 4));
+    EXPECT_TRUE(couldBeArith(0xFFFF0000, 0x00000100, 4));
+    EXPECT_FALSE(couldBeArith(0x00000000, 0x00010001, 4));
+
+    // Interesting bytes anywhere, and interesting words in the native order unless asked
+    EXPECT_TRUE(couldBeInterest(0x00, 0x80, 1, true));
+    EXPECT_TRUE(couldBeInterest(0x00, 0x7F, 1, true));
+    EXPECT_FALSE(couldBeInterest(0x00, 0x55, 1, true));
+    EXPECT_TRUE(couldBeInterest(0x0000, 0x03E8, 2, true));
+    EXPECT_FALSE(couldBeInterest(0x0000, 0x03E8, 2, false));
+    EXPECT_TRUE(couldBeInterest(0x0000, 0x0064, 2, false));
+    EXPECT_TRUE(couldBeInterest(0x00000000, 0x80000000, 4, false));
+    EXPECT_TRUE(couldBeInterest(0x00000000, 0xFA0000FA, 4, true));
+    EXPECT_FALSE(couldBeInterest(0x00000000, 0xFA0000FA, 4, false));
+}
+
+TEST_F(AFLDeterministicInputGeneratorTest, CandidatesPerStage)
+{
+    testHelper->getConfig()->setStringVectorParam("AFLDeterministicInputGenerator", "tokens", {"A", "BC"});
+    initGenerator();
+
+    // Every flip runs; 12 additions and 2 subtractions of a zero byte are flips, and so are 7 of its 9 interesting values
+    const char zero[4] = {0, 0, 0, 0};
+    const uint64_t oneByte[AFLDeterministicInputGenerator::NUM_STAGES] = {8, 7, 5, 1, 0, 0, 56, 0, 0, 2, 0, 0, 1, 4};
+    for (int stage = 0; stage < AFLDeterministicInputGenerator::NUM_STAGES; ++stage)
+      EXPECT_EQ(theGenerator->countCandidates(stage, zero, 1), oneByte[stage]) << "stage " << stage;
+
+    // Word arithmetic only runs the subtractions that borrow, and not the one that flips every bit
+    EXPECT_EQ(theGenerator->countCandidates(AFLDeterministicInputGenerator::ARITH16, zero, 2), 68u);
+
+    const uint64_t fourBytes[] = {32, 31, 29, 4, 3, 1};
+    for (int stage = AFLDeterministicInputGenerator::FLIP1; stage <= AFLDeterministicInputGenerator::FLIP32; ++stage)
+      EXPECT_EQ(theGenerator->countCandidates(stage, zero, 4), fourBytes[stage]) << "stage " << stage;
+
+    // A token already in place is not written again, so only "A" is, at both offsets
+    EXPECT_EQ(theGenerator->countCandidates(AFLDeterministicInputGenerator::EXTRAS_OVERWRITE, "BC", 2), 2u);
+
+    // Inserts that would grow the test case past MAX_FILE are skipped, so only "A" is inserted
+    const std::string nearlyFull(MAX_FILE - 1, 'a');
+    EXPECT_EQ(theGenerator->countCandidates(AFLDeterministicInputGenerator::EXTRAS_INSERT, nearlyFull.data(), nearlyFull.size()), (uint64_t)MAX_FILE);
+}
+
+TEST_F(AFLDeterministicInputGeneratorTest, CursorResumesAcrossBatches)
+{
+    const std::string seed("\x00\x7f\x80\xff" "GE", 6);
+    testHelper->getConfig()->setStringVectorParam("AFLDeterministicInputGenerator", "tokens", {"GET", "\xff\xff"});
+    testHelper->getConfig()->setIntParam("AFLDeterministicInputGenerator", "batchSize", 1000000);
+    initGenerator();
+    saveSeed(seed);
+
+    bool done = false;
+    std::vector<std::string> expected = runOnce(done);
+    EXPECT_TRUE(done);
+
+    uint64_t total = 0;
+    for (int stage = 0; stage < AFLDeterministicInputGenerator::NUM_STAGES; ++stage)
+      total += theGenerator->countCandidates(stage, seed.data(), seed.size());
+    EXPECT_EQ(expected.size(), total);
+
+    // A batch size that ends batches in the middle of stages and positions gives the same sequence
+    AFLDeterministicInputGenerator batched("AFLDeterministicInputGenerator");
+    testHelper->getConfig()->setIntParam("AFLDeterministicInputGenerator", "batchSize", 7);
+    batched.init(*testHelper->getConfig());
+    batched.registerStorageNeeds(*registry);
+
+    std::vector<std::string> actual;
+    int calls = 0;
+    done = false;
+    while (!done && calls < 10000) {
+      batched.addNewTestCases(*storage);
+      std::vector<std::string> outputs = newTestCases();
+      EXPECT_LE(outputs.size(), 7u);
+      actual.insert(actual.end(), outputs.begin(), outputs.end());
+      done = batched.examineTestCaseResults(*storage);
+      storage->clearNewAndLocalEntries();
+      calls++;
+    }
+
+    EXPECT_TRUE(done);
+    // The last call finds the cursor at the end of the stages
+    EXPECT_EQ(calls, (int)(total / 7 + 1));
+    EXPECT_EQ(actual, expected);
+}
+
+TEST_F(AFLDeterministicInputGeneratorTest, EffectorMapSkipsInertBlocks)
+{
+    testHelper->getConfig()->setBoolParam("AFLDeterministicInputGenerator", "useEffectorMap", true);
+    initGenerator();
+
+    // Only changes to byte 42, in block 5, reach new coverage
+    std::string seedContents(128, 'a');
+    StorageEntry* seed = saveSeed(seedContents);
+    writeTrace(seed, 1);
+    auto coverage = [](const std::string& output) { return output.size() == 128 && output[42] != 'a' ? 2 : 1; };
+
+    bool done = false;
+    int calls = 0;
+    int withMap = 0;
+    while (!done && calls++ < 100) {
+      bool mapped = seed->getBufferSize(effectorMapKey) > 0;
+      std::vector<std::string> outputs = runOnce(done, coverage);
+      if (!mapped)
+        continue;
+
+      // Once the map is stored, every candidate touches block 0, 5 or 15
+      for (const std::string& output : outputs) {
+        ASSERT_EQ(output.size(), 128u);
+        bool effective = false;
+        for (int i = 0; i < 128; ++i) {
+          int block = i >> EFF_MAP_SCALE2;
+          effective |= output[i] != 'a' && (block == 0 || block == 5 || block == 15);
+        }
+        EXPECT_TRUE(effective);
+        withMap++;
+      }
+    }
+
+    EXPECT_TRUE(done);
+    ASSERT_EQ(seed->getBufferSize(effectorMapKey), 2);
+    const uint8_t* map = (const uint8_t*)seed->getBufferPointer(effectorMapKey);
+    EXPECT_EQ(map[0], 0x21);
+    EXPECT_EQ(map[1], 0x80);
+
+    // The arith and interesting stages of the three effective blocks are all that is left
+    uint64_t unmapped = 0;
+    for (int stage = AFLDeterministicInputGenerator::FLIP16; stage < AFLDeterministicInputGenerator::NUM_STAGES; ++stage)
+      unmapped += theGenerator->countCandidates(stage, seedContents.data(), seedContents.size());
+    EXPECT_GT(withMap, 0);
+    EXPECT_LT((uint64_t)withMap * 4, unmapped);
+}
+
+TEST_F(AFLDeterministicInputGeneratorTest, RemovedEntryDropsItsEffectorMap)
+{
+    testHelper->getConfig()->setBoolParam("AFLDeterministicInputGenerator", "useEffectorMap", true);
+    // The 1, 2 and 4 bit flips of a 128 byte entry, and the first 32 of its 8/8 flips
+    testHelper->getConfig()->setIntParam("AFLDeterministicInputGenerator", "batchSize", 3100);
+    initGenerator();
+
+    StorageEntry* first = saveSeed(std::string(128, 'a'));
+    StorageEntry* second = saveSeed(std::string(128, 'b'));
+    writeTrace(first, 1);
+    writeTrace(second, 1);
+
+    // Flipping byte 10 of the first entry reaches new coverage, so its partial map has block 1
+    auto coverage = [](const std::string& output) { return output[0] == 'a' && output[10] != 'a' ? 2 : 1; };
+
+    bool done = false;
+    runOnce(done, coverage);
+    storage->removeEntry(first);
+
+    int calls = 0;
+    bool walkedFirst = false;
+    while (!done && calls++ < 100) {
+      for (const std::string& output : runOnce(done, coverage))
+        walkedFirst |= std::count(output.begin(), output.end(), 'a') > 64;
+    }
+
+    // The map of the second entry is built from its own flips only, and stored on it
+    EXPECT_TRUE(done);
+    EXPECT_FALSE(walkedFirst);
+    ASSERT_EQ(second->getBufferSize(effectorMapKey), 2);
+    const uint8_t* map = (const uint8_t*)second->getBufferPointer(effectorMapKey);
+    EXPECT_EQ(map[0], 0x01);
+    EXPECT_EQ(map[1], 0x80);
+}
+
+TEST_F(AFLDeterministicInputGeneratorTest, OversizedEntryIsSkipped)
+{
+    initGenerator();
+    saveSeed(std::string(MAX_FILE + 1, 'a'));
+
+    // The walk of an entry this large would overflow the cursor index
+    bool done = false;
+    EXPECT_TRUE(runOnce(done).empty());
+    EXPECT_TRUE(done);
+}
+
+TEST_F(AFLDeterministicInputGeneratorTest, AutoTokensFromBitFlips)
+{
+    testHelper->getConfig()->setBoolParam("AFLDeterministicInputGenerator", "autoExtractTokens", true);
+    // The 184 walking bit flips are split across calls
+    testHelper->getConfig()->setIntParam("AFLDeterministicInputGenerator", "batchSize", 50);
+    initGenerator();
+
+    // Flipping any byte of a run reaches the same new coverage, which differs from run to run
+    const std::string seedContents = "-GIF8-HELLO-ZZZZ-AB-END";
+    const std::string runs         = " 2222 33333 4444 55 666";
+    writeTrace(saveSeed(seedContents), 1);
+    auto coverage = [&](const std::string& output) {
+      for (size_t i = 0; i < output.size() && i < seedContents.size(); ++i)
+        if (output[i] != seedContents[i])
+          return runs[i] == ' ' ? (char)1 : runs[i];
+      return (char)1;
+    };
+
+    bool done = false;
+    int calls = 0;
+    while (!done && calls++ < 100)
+      runOnce(done, coverage);
+    EXPECT_TRUE(done);
+
+    // A run of one byte value and a run shorter than MIN_AUTO_EXTRA are not tokens;
+    // the run at the end of the buffer is
+    const vmf::AFLTokenPool& tokens = AFLTokenDictionary::getInstance()->getAutoTokens();
+    ASSERT_EQ(tokens.size(), 3u);
+    EXPECT_EQ(tokens.get(0), "GIF8");
+    EXPECT_EQ(tokens.get(1), "HELLO");
+    EXPECT_EQ(tokens.get(2), "END");
+}
@@ -0,0 +1,347 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2023 The Charles Stark Draper Laboratory, Inc.
+ * <vader@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+
+#include "gtest/gtest.h"
+#include "ModuleTestHelper.hpp"
+#include "SimpleStorage.hpp"
+#include "AFLFixedWidthMutator.hpp"
+#include "RuntimeException.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace vmf;
+
+// The interesting value tables of the single-width modules this template replaced
+static const int8_t legacyInteresting8Values[] = {INTERESTING_8};
+static const int16_t legacyInteresting16Values[] = {INTERESTING_8, INTERESTING_16};
+static const int32_t legacyInteresting32Values[] = {INTERESTING_8, INTERESTING_16, INTERESTING_32};
+
+/*
+ * The mutation each pre-existing module applied, copied from its own
+ * mutateTestCase, with the word casts replaced by memcpy
+ */
+typedef void (*LegacyMutation)(char* buff, int size, VmfRand* rand);
+
+static void legacyFlipBits(char* buff, int size, VmfRand* rand, int bits)
+{
+    int bit = rand->randBelow((size << 3) - 1) + 1;
+    if ((size << 3) - bit < bits) {
+        return;
+    }
+    for (int i = 0; i < bits; i++, bit++) {
+        buff[bit >> 3] ^= (1 << ((bit - 1) % 8));
+    }
+}
+
+static void legacyFlipBit(char* buff, int size, VmfRand* rand) { legacyFlipBits(buff, size, rand, 1); }
+static void legacyFlip2Bit(char* buff, int size, VmfRand* rand) { legacyFlipBits(buff, size, rand, 2); }
+static void legacyFlip4Bit(char* buff, int size, VmfRand* rand) { legacyFlipBits(buff, size, rand, 4); }
+
+static void legacyFlipByte(char* buff, int size, VmfRand* rand)
+{
+    buff[rand->randBelow(size)] ^= 0xff;
+}
+
+static void legacyFlip2Byte(char* buff, int size, VmfRand* rand)
+{
+    int byte = rand->randBelow(size - 1);
+    buff[byte] ^= 0xff;
+    buff[byte + 1] ^= 0xff;
+}
+
+static void legacyFlip4Byte(char* buff, int size, VmfRand* rand)
+{
+    if (size < 4) {
+        return;
+    }
+    int byte = rand->randBelow(size - 3);
+    for (int i = 0; i < 4; i++) {
+        buff[byte + i] ^= 0xff;
+    }
+}
+
+static void legacyInteresting8(char* buff, int size, VmfRand* rand)
+{
+    int item = rand->randBelow(sizeof(legacyInteresting8Values));
+    buff[rand->randBelow(size)] = legacyInteresting8Values[item];
+}
+
+static void legacyInteresting16(char* buff, int size, VmfRand* rand)
+{
+    if (size < 2) {
+        return;
+    }
+    int item = rand->randBelow(sizeof(legacyInteresting16Values) >> 1);
+    uint16_t value = legacyInteresting16Values[item];
+    memcpy(buff + rand->randBelow(size - 1), &value, 2);
+}
+
+static void legacyInteresting32(char* buff, int size, VmfRand* rand)
+{
+    if (size < 4) {
+        return;
+    }
+    int item = rand->randBelow(sizeof(legacyInteresting32Values) >> 2);
+    uint32_t value = legacyInteresting32Values[item];
+    memcpy(buff + rand->randBelow(size - 3), &value, 4);
+}
+
+static void legacyRandomByteAddSub(char* buff, int size, VmfRand* rand)
+{
+    int byte = rand->randBelow(size);
+    buff[byte] -= 1 + (uint8_t)rand->randBelow(ARITH_MAX);
+    buff[byte] += 1 + (uint8_t)rand->randBelow(ARITH_MAX);
+}
+
+static void legacyWordAddSub(char* buff, int size, VmfRand* rand)
+{
+    if (size < 2) {
+        return;
+    }
+    int byte = rand->randBelow(size - 1);
+    uint16_t value;
+    memcpy(&value, buff + byte, 2);
+    value -= 1 + (uint16_t)rand->randBelow(ARITH_MAX);
+    value += 1 + (uint16_t)rand->randBelow(ARITH_MAX);
+    memcpy(buff + byte, &value, 2);
+}
+
+static void legacyDWordAddSub(char* buff, int size, VmfRand* rand)
+{
+    if (size < 4) {
+        return;
+    }
+    int byte = rand->randBelow(size - 3);
+    uint32_t value;
+    memcpy(&value, buff + byte, 4);
+    value -= 1 + (uint32_t)rand->randBelow(ARITH_MAX);
+    value += 1 + (uint32_t)rand->randBelow(ARITH_MAX);
+    memcpy(buff + byte, &value, 4);
+}
+
+class AFLFixedWidthMutatorTest : public ::testing::Test {
+  protected:
+    AFLFixedWidthMutatorTest()
+    {
+      storage = new SimpleStorage("storage");
+      registry = new StorageRegistry("TEST_INT", StorageRegistry::INT, StorageRegistry::ASCENDING);
+      metadata = new StorageRegistry();
+      testHelper = new ModuleTestHelper();
+    }
+
+    ~AFLFixedWidthMutatorTest() override {}
+
+    void SetUp() override {
+      testCaseKey = registry->registerKey("TEST_CASE", StorageRegistry::BUFFER, StorageRegistry::READ_WRITE);
+      storage->configure(registry, metadata);
+    }
+
+    void TearDown() override {
+      delete registry;
+      delete metadata;
+      delete storage;
+      delete testHelper;
+    }
+
+    // Returns the output of one call to the mutator on the input
+    template<class Mutator>
+    std::string mutate(const char* name, const std::string& input) {
+      Mutator mutator(name);
+      mutator.init(*testHelper->getConfig());
+      mutator.registerStorageNeeds(*registry);
+
+      StorageEntry* baseEntry = storage->createNewEntry();
+      memcpy(baseEntry->allocateBuffer(testCaseKey, input.size()), input.data(), input.size());
+      StorageEntry* newEntry = storage->createNewEntry();
+
+      std::string output;
+      try {
+        mutator.mutateTestCase(*storage, baseEntry, newEntry, testCaseKey);
+        output.assign(newEntry->getBufferPointer(testCaseKey), newEntry->getBufferSize(testCaseKey));
+      }
+      catch (RuntimeException e)
+      {
+        ADD_FAILURE() << "Exception thrown: " << e.getReason();
+      }
+
+      storage->clearNewAndLocalEntries();
+      return output;
+    }
+
+    // Checks that a module gives the output of the module it replaced, for the same seeds
+    template<class Mutator>
+    void expectLegacyOutput(const char* name, LegacyMutation legacy) {
+      for (int size = 2; size <= 17; ++size) {
+        std::string input;
+        for (int i = 0; i < size; ++i)
+          input.push_back((char)(i * 37 + 11));
+
+        for (unsigned int seed = 1; seed <= 20; ++seed) {
+          rand->randInit(seed);
+          std::string expected = input;
+          legacy(&expected[0], size, rand);
+
+          rand->randInit(seed);
+          EXPECT_EQ(mutate<Mutator>(name, input), expected) << name << " size " << size << " seed " << seed;
+        }
+      }
+    }
+
+    // Checks that a swapped module gives the byte-reversed result of its native module
+    template<class Swapped, class Native, int Width>
+    void expectSwappedOrder(const char* name) {
+      std::string input;
+      for (int i = 0; i < Width; ++i)
+        input.push_back((char)(i * 37 + 11));
+      std::string reversed(input.rbegin(), input.rend());
+
+      for (unsigned int seed = 1; seed <= 20; ++seed) {
+        rand->randInit(seed);
+        std::string expected = mutate<Native>("Native", reversed);
+        std::reverse(expected.begin(), expected.end());
+
+        rand->randInit(seed);
+        EXPECT_EQ(mutate<Swapped>(name, input), expected) << name << " seed " << seed;
+      }
+    }
+
+    // Checks that an 8 byte word operation only writes one word, at any offset including the last
+    template<class Mutator>
+    void expectWordInBounds(const char* name) {
+      for (int size = 8; size <= 12; ++size) {
+        std::string input;
+        for (int i = 0; i < size; ++i)
+          input.push_back((char)(i * 37 + 11));
+
+        bool lastWord = false;
+        for (int i = 0; i < 200; ++i) {
+          std::string output = mutate<Mutator>(name, input);
+          ASSERT_EQ(output.size(), input.size()) << name;
+
+          int first = size, last = -1;
+          for (int j = 0; j < size; ++j) {
+            if (output[j] != input[j]) {
+              first = std::min(first, j);
+              last = j;
+            }
+          }
+          EXPECT_LT(last - first, 8) << name << " size " << size;
+          // The word at the last offset has its first or last byte there
+          lastWord |= first == size - 8 || last == size - 1;
+        }
+        EXPECT_TRUE(lastWord) << name << " size " << size;
+      }
+    }
+
+    // Checks that an input shorter than the word is copied unchanged
+    template<class Mutator>
+    void expectShortInputCopied(const char* name, int width) {
+      std::string input;
+      for (int i = 0; i < width - 1; ++i)
+        input.push_back((char)(i * 37 + 11));
+
+      for (int i = 0; i < 20; ++i)
+        EXPECT_EQ(mutate<Mutator>(name, input), input) << name;
+    }
+
+    StorageModule* storage;
+    StorageRegistry* registry;
+    StorageRegistry* metadata;
+    ModuleTestHelper* testHelper;
+    VmfRand* rand = VmfRand::getInstance();
+    int testCaseKey;
+};
+
+TEST_F(AFLFixedWidthMutatorTest, ExistingModulesKeepTheirOutput)
+{
+    expectLegacyOutput<AFLFlipBitMutator>("AFLFlipBitMutator", legacyFlipBit);
+    expectLegacyOutput<AFLFlip2BitMutator>("AFLFlip2BitMutator", legacyFlip2Bit);
+    expectLegacyOutput<AFLFlip4BitMutator>("AFLFlip4BitMutator", legacyFlip4Bit);
+    expectLegacyOutput<AFLFlipByteMutator>("AFLFlipByteMutator", legacyFlipByte);
+    expectLegacyOutput<AFLFlip2ByteMutator>("AFLFlip2ByteMutator", legacyFlip2Byte);
+    expectLegacyOutput<AFLFlip4ByteMutator>("AFLFlip4ByteMutator", legacyFlip4Byte);
+    expectLegacyOutput<AFLInteresting8Mutator>("AFLInteresting8Mutator", legacyInteresting8);
+    expectLegacyOutput<AFLInteresting16Mutator>("AFLInteresting16Mutator", legacyInteresting16);
+    expectLegacyOutput<AFLInteresting32Mutator>("AFLInteresting32Mutator", legacyInteresting32);
+    expectLegacyOutput<AFLRandomByteAddSubMutator>("AFLRandomByteAddSubMutator", legacyRandomByteAddSub);
+    expectLegacyOutput<AFLWordAddSubMutator>("AFLWordAddSubMutator", legacyWordAddSub);
+    expectLegacyOutput<AFLDWordAddSubMutator>("AFLDWordAddSubMutator", legacyDWordAddSub);
+}
+
+TEST_F(AFLFixedWidthMutatorTest, SwappedModulesStoreBigEndian)
+{
+    expectSwappedOrder<AFLInteresting16SwappedMutator, AFLInteresting16Mutator, 2>("AFLInteresting16SwappedMutator");
+    expectSwappedOrder<AFLInteresting32SwappedMutator, AFLInteresting32Mutator, 4>("AFLInteresting32SwappedMutator");
+    expectSwappedOrder<AFLInteresting64SwappedMutator, AFLInteresting64Mutator, 8>("AFLInteresting64SwappedMutator");
+    expectSwappedOrder<AFLWordAddSubSwappedMutator, AFLWordAddSubMutator, 2>("AFLWordAddSubSwappedMutator");
+    expectSwappedOrder<AFLDWordAddSubSwappedMutator, AFLDWordAddSubMutator, 4>("AFLDWordAddSubSwappedMutator");
+    expectSwappedOrder<AFLQWordAddSubSwappedMutator, AFLQWordAddSubMutator, 8>("AFLQWordAddSubSwappedMutator");
+
+    // Read most significant byte first, the words hold what the operation wrote
+    for (int i = 0; i < 50; ++i) {
+      std::string output = mutate<AFLInteresting16SwappedMutator>("AFLInteresting16SwappedMutator", std::string(2, '\0'));
+      int16_t value = (int16_t)(((uint8_t)output[0] << 8) | (uint8_t)output[1]);
+      EXPECT_NE(std::find(std::begin(legacyInteresting16Values), std::end(legacyInteresting16Values), value), std::end(legacyInteresting16Values));
+
+      // 0x0100 moves by less than ARITH_MAX, so its high byte stays near 1
+      output = mutate<AFLWordAddSubSwappedMutator>("AFLWordAddSubSwappedMutator", std::string("\x01\x00", 2));
+      int word = ((uint8_t)output[0] << 8) | (uint8_t)output[1];
+      EXPECT_LT(std::abs(word - 0x100), ARITH_MAX);
+    }
+}
+
+TEST_F(AFLFixedWidthMutatorTest, EightByteWordsStayInBounds)
+{
+    expectWordInBounds<AFLFlip8ByteMutator>("AFLFlip8ByteMutator");
+    expectWordInBounds<AFLInteresting64Mutator>("AFLInteresting64Mutator");
+    expectWordInBounds<AFLInteresting64SwappedMutator>("AFLInteresting64SwappedMutator");
+    expectWordInBounds<AFLQWordAddSubMutator>("AFLQWordAddSubMutator");
+    expectWordInBounds<AFLQWordAddSubSwappedMutator>("AFLQWordAddSubSwappedMutator");
+}
+
+TEST_F(AFLFixedWidthMutatorTest, ShortInputsAreCopied)
+{
+    expectShortInputCopied<AFLFlip2ByteMutator>("AFLFlip2ByteMutator", 2);
+    expectShortInputCopied<AFLFlip4ByteMutator>("AFLFlip4ByteMutator", 4);
+    expectShortInputCopied<AFLFlip8ByteMutator>("AFLFlip8ByteMutator", 8);
+    expectShortInputCopied<AFLInteresting16Mutator>("AFLInteresting16Mutator", 2);
+    expectShortInputCopied<AFLInteresting32Mutator>("AFLInteresting32Mutator", 4);
+    expectShortInputCopied<AFLInteresting64Mutator>("AFLInteresting64Mutator", 8);
+    expectShortInputCopied<AFLInteresting16SwappedMutator>("AFLInteresting16SwappedMutator", 2);
+    expectShortInputCopied<AFLInteresting32SwappedMutator>("AFLInteresting32SwappedMutator", 4);
+    expectShortInputCopied<AFLInteresting64SwappedMutator>("AFLInteresting64SwappedMutator", 8);
+    expectShortInputCopied<AFLWordAddSubMutator>("AFLWordAddSubMutator", 2);
+    expectShortInputCopied<AFLDWordAddSubMutator>("AFLDWordAddSubMutator", 4);
+    expectShortInputCopied<AFLQWordAddSubMutator>("AFLQWordAddSubMutator", 8);
+    expectShortInputCopied<AFLWordAddSubSwappedMutator>("AFLWordAddSubSwappedMutator", 2);
+    expectShortInputCopied<AFLDWordAddSubSwappedMutator>("AFLDWordAddSubSwappedMutator", 4);
+    expectShortInputCopied<AFLQWordAddSubSwappedMutator>("AFLQWordAddSubSwappedMutator", 8);
+}
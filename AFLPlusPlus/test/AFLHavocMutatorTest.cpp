@@ -0,0 +1,340 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2023 The Charles Stark Draper Laboratory, Inc.
+ * <vader@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+
+#include "gtest/gtest.h"
+#include "ModuleTestHelper.hpp"
+#include "SimpleStorage.hpp"
+#include "AFLHavocMutator.hpp"
+#include "AFLMutationOps.hpp"
+#include "RuntimeException.hpp"
+#include <cstring>
+#include <string>
+#include <vector>
+
+using vmf::StorageModule;
+using vmf::StorageRegistry;
+using vmf::ModuleTestHelper;
+using vmf::SimpleStorage;
+using vmf::StorageEntry;
+using vmf::VmfRand;
+using vmf::AFLByteOrder;
+using vmf::AFLHavocMutator;
+using vmf::RuntimeException;
+using namespace vmf::AFLMutationOps;
+
+// The fixed-size operations of AFLHavocMutator, in the order it draws them
+static void (*const havocFixedOps[])(char*, int, VmfRand*) = {
+    flipBits<1>, flipBits<2>, flipBits<4>,
+    flipBytes<1>, flipBytes<2>, flipBytes<4>,
+    interestingWord<1>, interestingWord<2>, interestingWord<2, AFLByteOrder::Swapped>,
+    interestingWord<4>, interestingWord<4, AFLByteOrder::Swapped>,
+    addSubWord<1>, addSubWord<2>, addSubWord<2, AFLByteOrder::Swapped>,
+    addSubWord<4>, addSubWord<4, AFLByteOrder::Swapped>,
+    randomByte, overwriteCopy, overwriteFixed
+};
+static const int numHavocFixedOps = sizeof(havocFixedOps) / sizeof(havocFixedOps[0]);
+
+// Replays one call of AFLHavocMutator on an entry without an effector map, from the same draws
+static std::string replayHavoc(const std::string& input, int stackPow2, VmfRand* rand)
+{
+    std::vector<char> buff(input.begin(), input.end());
+
+    int stackSize = 1 << (1 + rand->randBelow(stackPow2));
+    for (int i = 0; i < stackSize; i++) {
+        int size = (int)buff.size();
+        int op = rand->randBelow(numHavocFixedOps + 1);
+        if (op < numHavocFixedOps)
+            havocFixedOps[op](buff.data(), size, rand);
+        else if (rand->randBelow(2))
+            deleteBlock(buff, rand);
+        else if (size + HAVOC_BLK_XL < MAX_FILE)
+            cloneBlock(buff, rand);
+    }
+
+    return std::string(buff.begin(), buff.end());
+}
+
+// Where the block cloneBlock copied came from, relative to the insert point
+enum CloneSource { RANDOM_BYTES, BEFORE, AFTER, OVERLAPPING };
+
+class AFLHavocMutatorTest : public ::testing::Test {
+  protected:
+    AFLHavocMutatorTest()
+    {
+      storage = new SimpleStorage("storage");
+      registry = new StorageRegistry("TEST_INT", StorageRegistry::INT, StorageRegistry::ASCENDING);
+      metadata = new StorageRegistry();
+      testHelper = new ModuleTestHelper();
+      theMutator = new AFLHavocMutator("AFLHavocMutator");
+    }
+
+    ~AFLHavocMutatorTest() override {}
+
+    void SetUp() override {
+      testCaseKey = registry->registerKey("TEST_CASE", StorageRegistry::BUFFER, StorageRegistry::READ_WRITE);
+      effectorMapKey = registry->registerKey("AFL_EFFECTOR_MAP", StorageRegistry::BUFFER, StorageRegistry::READ_WRITE);
+      storage->configure(registry, metadata);
+    }
+
+    void TearDown() override {
+      delete theMutator;
+      delete registry;
+      delete metadata;
+      delete storage;
+      delete testHelper;
+    }
+
+    void initMutator(int stackPow2) {
+      try {
+        testHelper->getConfig()->setIntParam("AFLHavocMutator", "stackPow2", stackPow2);
+        theMutator->init(*testHelper->getConfig());
+        theMutator->registerStorageNeeds(*registry);
+      }
+      catch (RuntimeException e)
+      {
+        FAIL() << "Exception thrown: " << e.getReason();
+      }
+    }
+
+    // Returns the output of one call to the mutator on the input
+    std::string mutate(const std::string& input) {
+      StorageEntry* baseEntry = storage->createNewEntry();
+      memcpy(baseEntry->allocateBuffer(testCaseKey, input.size()), input.data(), input.size());
+      return mutate(baseEntry);
+    }
+
+    // Returns the output of one call to the mutator on a base entry
+    std::string mutate(StorageEntry* baseEntry) {
+      StorageEntry* newEntry = storage->createNewEntry();
+
+      std::string output;
+      try {
+        theMutator->mutateTestCase(*storage, baseEntry, newEntry, testCaseKey);
+        output.assign(newEntry->getBufferPointer(testCaseKey), newEntry->getBufferSize(testCaseKey));
+      }
+      catch (RuntimeException e)
+      {
+        ADD_FAILURE() << "Exception thrown: " << e.getReason();
+      }
+
+      storage->clearNewAndLocalEntries();
+      return output;
+    }
+
+    // Checks cloneBlock against a vector insert from the same draws, and returns where the block came from
+    CloneSource expectClone(const std::vector<char>& original, unsigned int seed) {
+      int size = (int)original.size();
+      std::vector<char> expected(original);
+      CloneSource source = RANDOM_BYTES;
+
+      rand->randInit(seed);
+      int actuallyClone = rand->randBelow(4);
+      int cloneTo = rand->randBelow(size);
+      if (actuallyClone) {
+        int cloneLen = chooseBlockLen(rand, size);
+        int cloneFrom = rand->randBelow(size - cloneLen + 1);
+        expected.insert(expected.begin() + cloneTo, original.begin() + cloneFrom, original.begin() + cloneFrom + cloneLen);
+
+        if (cloneFrom + cloneLen <= cloneTo)
+          source = BEFORE;
+        else if (cloneFrom >= cloneTo)
+          source = AFTER;
+        else
+          source = OVERLAPPING;
+      } else {
+        int cloneLen = chooseBlockLen(rand, HAVOC_BLK_XL);
+        expected.insert(expected.begin() + cloneTo, cloneLen, (char)rand->randBelow(255));
+      }
+
+      rand->randInit(seed);
+      std::vector<char> actual(original);
+      cloneBlock(actual, rand);
+      EXPECT_EQ(actual, expected) << "seed " << seed;
+
+      // AFLCloneMutator writes the same bytes into a new buffer
+      rand->randInit(seed);
+      BlockClone clone = chooseClone(size, rand);
+      std::vector<char> written(size + clone.len);
+      writeClone(original.data(), size, clone, written.data());
+      EXPECT_EQ(written, expected) << "seed " << seed;
+
+      return source;
+    }
+
+    AFLHavocMutator* theMutator;
+    StorageModule* storage;
+    StorageRegistry* registry;
+    StorageRegistry* metadata;
+    ModuleTestHelper* testHelper;
+    VmfRand* rand = VmfRand::getInstance();
+    int testCaseKey;
+    int effectorMapKey;
+};
+
+TEST_F(AFLHavocMutatorTest, StackPow2OutOfRangeIsAConfigurationError)
+{
+    for (int stackPow2 : {0, 9}) {
+      testHelper->getConfig()->setIntParam("AFLHavocMutator", "stackPow2", stackPow2);
+      try {
+        theMutator->init(*testHelper->getConfig());
+        ADD_FAILURE() << "stackPow2 " << stackPow2 << " was accepted";
+      }
+      catch (RuntimeException e)
+      {
+        EXPECT_EQ(e.getErrorCode(), RuntimeException::CONFIGURATION_ERROR);
+      }
+    }
+
+    for (int stackPow2 : {1, 8}) {
+      testHelper->getConfig()->setIntParam("AFLHavocMutator", "stackPow2", stackPow2);
+      EXPECT_NO_THROW(theMutator->init(*testHelper->getConfig()));
+    }
+}
+
+TEST_F(AFLHavocMutatorTest, AppliesAStackOfOperations)
+{
+    std::vector<std::string> inputs = {"x", "ab", std::string(7, '\0'), "The quick brown fox jumps over the lazy dog"};
+
+    // The stack depth is 2^(1 + randBelow(stackPow2)), for every allowed stackPow2
+    for (int stackPow2 : {1, 4, 8}) {
+      initMutator(stackPow2);
+      for (const std::string& input : inputs) {
+        for (unsigned int seed = 1; seed <= 20; ++seed) {
+          rand->randInit(seed);
+          std::string expected = replayHavoc(input, stackPow2, rand);
+
+          rand->randInit(seed);
+          EXPECT_EQ(mutate(input), expected) << "stackPow2 " << stackPow2 << " size " << input.size() << " seed " << seed;
+        }
+      }
+    }
+}
+
+TEST_F(AFLHavocMutatorTest, OneByteInputs)
+{
+    initMutator(HAVOC_STACK_POW2);
+    for (int i = 0; i < 500; ++i)
+      EXPECT_FALSE(mutate("x").empty());
+
+    // A clone of a single byte can only come from the byte itself
+    std::vector<char> original = {'x'};
+    for (unsigned int seed = 1; seed <= 50; ++seed) {
+      CloneSource source = expectClone(original, seed);
+      EXPECT_TRUE(source == RANDOM_BYTES || source == AFTER);
+    }
+}
+
+TEST_F(AFLHavocMutatorTest, CloneBlockFromAnySource)
+{
+    std::vector<char> original;
+    for (int i = 0; i < 200; ++i)
+      original.push_back((char)i);
+
+    int counts[4] = {0, 0, 0, 0};
+    for (unsigned int seed = 1; seed <= 2000; ++seed)
+      counts[expectClone(original, seed)]++;
+
+    // Blocks before, after and across the insert point are all copied as they were
+    EXPECT_GT(counts[RANDOM_BYTES], 0);
+    EXPECT_GT(counts[BEFORE], 0);
+    EXPECT_GT(counts[AFTER], 0);
+    EXPECT_GT(counts[OVERLAPPING], 0);
+}
+
+TEST_F(AFLHavocMutatorTest, DeleteBlockMatchesWriteDelete)
+{
+    for (int size : {1, 2, 200}) {
+      std::vector<char> original;
+      for (int i = 0; i < size; ++i)
+        original.push_back((char)i);
+
+      for (unsigned int seed = 1; seed <= 200; ++seed) {
+        rand->randInit(seed);
+        std::vector<char> actual(original);
+        deleteBlock(actual, rand);
+
+        // AFLDeleteMutator writes the same bytes into a new buffer
+        rand->randInit(seed);
+        BlockDelete del = chooseDelete(size, rand);
+        std::vector<char> written(size - del.len);
+        writeDelete(original.data(), size, del, written.data());
+        EXPECT_EQ(written, actual) << "size " << size << " seed " << seed;
+        EXPECT_EQ(del.len == 0, size < 2);
+      }
+    }
+}
+
+TEST_F(AFLHavocMutatorTest, NeverGrowsPastMaxFile)
+{
+    initMutator(HAVOC_STACK_POW2);
+
+    // Cloning is skipped until deletions make room for a whole HAVOC_BLK_XL block
+    std::string input(MAX_FILE - 1, 'a');
+    for (int i = 0; i < 50; ++i)
+      EXPECT_LT((long)mutate(input).size(), MAX_FILE);
+}
+
+TEST_F(AFLHavocMutatorTest, EffectorMapTargetsEffectiveBlocks)
+{
+    testHelper->getConfig()->setBoolParam("AFLHavocMutator", "useEffectorMap", true);
+    initMutator(1);
+
+    // Two 128 byte entries, one with a map in which only block 5 (bytes 40 to 47) is effective
+    std::string zeros(128, '\0');
+    StorageEntry* mapped = storage->createNewEntry();
+    memcpy(mapped->allocateBuffer(testCaseKey, 128), zeros.data(), 128);
+    const char map[] = {0x20, 0x00};
+    memcpy(mapped->allocateBuffer(effectorMapKey, sizeof(map)), map, sizeof(map));
+    storage->saveEntry(mapped);
+
+    StorageEntry* unmapped = storage->createNewEntry();
+    memcpy(unmapped->allocateBuffer(testCaseKey, 128), zeros.data(), 128);
+    storage->saveEntry(unmapped);
+
+    // Counts the outputs of the same length that change block 5, and those that only change other bytes
+    auto countTargets = [&](StorageEntry* baseEntry, int& inBlock, int& outside) {
+      inBlock = outside = 0;
+      for (int i = 0; i < 2000; ++i) {
+        std::string output = mutate(baseEntry);
+        if (output.size() != 128 || output == zeros)
+          continue;
+        if (output.compare(40, 8, zeros, 40, 8) != 0)
+          inBlock++;
+        else
+          outside++;
+      }
+    };
+
+    int inBlock, outside;
+    countTargets(mapped, inBlock, outside);
+    EXPECT_GT(inBlock, 4 * outside);
+
+    countTargets(unmapped, inBlock, outside);
+    EXPECT_GT(outside, 4 * inBlock);
+}
@@ -0,0 +1,403 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2023 The Charles Stark Draper Laboratory, Inc.
+ * <vader@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+
+#include "gtest/gtest.h"
+#include "ModuleTestHelper.hpp"
+#include "SimpleStorage.hpp"
+#include "AFLTokenDictionary.hpp"
+#include "AFLTokenMutator.hpp"
+#include "RuntimeException.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using vmf::StorageRegistry;
+using vmf::ModuleTestHelper;
+using vmf::TestConfigInterface;
+using vmf::SimpleStorage;
+using vmf::StorageModule;
+using vmf::StorageEntry;
+using vmf::AFLTokenMatcher;
+using vmf::AFLTokenDictionary;
+using vmf::AFLTokenReplaceMutator;
+using vmf::AFLTokenInsertMutator;
+using vmf::AFLTokenOverwriteMutator;
+using vmf::MutatorModule;
+using vmf::RuntimeException;
+
+class AFLTokenDictionaryTest : public ::testing::Test {
+  protected:
+    AFLTokenDictionaryTest()
+    {
+      storage = new SimpleStorage("storage");
+      registry = new StorageRegistry("TEST_INT", StorageRegistry::INT, StorageRegistry::ASCENDING);
+      metadata = new StorageRegistry();
+      testHelper = new ModuleTestHelper();
+      dictionary = AFLTokenDictionary::getInstance();
+    }
+
+    ~AFLTokenDictionaryTest() override {}
+
+    void SetUp() override {
+      testCaseKey = registry->registerKey("TEST_CASE", StorageRegistry::BUFFER, StorageRegistry::READ_WRITE);
+      storage->configure(registry, metadata);
+      dictionary->clear();
+    }
+
+    void TearDown() override {
+      dictionary->clear();
+      for (const std::string& path : files)
+        std::remove(path.c_str());
+      delete registry;
+      delete metadata;
+      delete storage;
+      delete testHelper;
+    }
+
+    // Writes a dictionary file that is removed when the test ends
+    std::string writeDictionary(const std::string& name, const std::string& contents) {
+      std::string path = ::testing::TempDir() + name;
+      std::ofstream(path) << contents;
+      files.push_back(path);
+      return path;
+    }
+
+    bool hasUserToken(const std::string& token) {
+      return dictionary->getUserTokens().contains(token.data(), token.size());
+    }
+
+    void expectConfigurationError(const std::string& path) {
+      try {
+        dictionary->loadFile(path);
+        FAIL() << "Expected a configuration error from " << path;
+      }
+      catch (RuntimeException e)
+      {
+        EXPECT_EQ(e.getErrorCode(), RuntimeException::CONFIGURATION_ERROR);
+      }
+    }
+
+    bool addAutoToken(const std::string& token) {
+      return dictionary->addAutoToken(token.data(), token.size());
+    }
+
+    // Returns the output of one call to the mutator on the input
+    std::string mutate(MutatorModule& mutator, const std::string& input) {
+      StorageEntry* baseEntry = storage->createNewEntry();
+      StorageEntry* modEntry = storage->createNewEntry();
+      memcpy(baseEntry->allocateBuffer(testCaseKey, input.size()), input.data(), input.size());
+
+      std::string output;
+      try {
+        mutator.mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+        output.assign(modEntry->getBufferPointer(testCaseKey), modEntry->getBufferSize(testCaseKey));
+      }
+      catch (RuntimeException e)
+      {
+        ADD_FAILURE() << "Exception thrown: " << e.getReason();
+      }
+
+      storage->clearNewAndLocalEntries();
+      return output;
+    }
+
+    AFLTokenDictionary* dictionary;
+    SimpleStorage* storage;
+    StorageRegistry* registry;
+    StorageRegistry* metadata;
+    ModuleTestHelper* testHelper;
+    std::vector<std::string> files;
+    int testCaseKey;
+};
+
+TEST_F(AFLTokenDictionaryTest, MatcherFindsOverlappingAndNestedTokens)
+{
+    AFLTokenMatcher matcher;
+    matcher.build({"he", "she", "his", "hers"});
+
+    // "she" and "he" end at the same byte, and "he" starts "hers"
+    const std::string text = "ushers";
+    std::vector<AFLTokenMatcher::Match> matches;
+    matcher.findAll(text.data(), text.size(), matches);
+
+    ASSERT_EQ(matches.size(), 3u);
+    EXPECT_EQ(matches[0].offset, 1u);
+    EXPECT_EQ(matches[0].token, 1u);
+    EXPECT_EQ(matches[1].offset, 2u);
+    EXPECT_EQ(matches[1].token, 0u);
+    EXPECT_EQ(matches[2].offset, 2u);
+    EXPECT_EQ(matches[2].token, 3u);
+
+    // Matches are appended, and "she" overlaps the end of "his"
+    matcher.findAll("hishe", 5, matches);
+    ASSERT_EQ(matches.size(), 6u);
+    EXPECT_EQ(matches[3].offset, 0u);
+    EXPECT_EQ(matches[3].token, 2u);
+    EXPECT_EQ(matches[4].offset, 2u);
+    EXPECT_EQ(matches[4].token, 1u);
+    EXPECT_EQ(matches[5].offset, 3u);
+    EXPECT_EQ(matches[5].token, 0u);
+
+    matches.clear();
+    matcher.findAll("xyz", 3, matches);
+    EXPECT_TRUE(matches.empty());
+}
+
+TEST_F(AFLTokenDictionaryTest, MatcherFindsRepeatedTokens)
+{
+    AFLTokenMatcher matcher;
+    matcher.build({"aa", "a\xff"});
+
+    std::vector<AFLTokenMatcher::Match> matches;
+    matcher.findAll("aaa\xff", 4, matches);
+
+    ASSERT_EQ(matches.size(), 3u);
+    EXPECT_EQ(matches[0].offset, 0u);
+    EXPECT_EQ(matches[1].offset, 1u);
+    EXPECT_EQ(matches[2].offset, 2u);
+    EXPECT_EQ(matches[2].token, 1u);
+}
+
+TEST_F(AFLTokenDictionaryTest, MatcherKeepsEveryByteValueDistinct)
+{
+    // Tokens that use all 256 byte values need 257 input classes
+    std::string allBytes;
+    for(int i = 0; i < 256; i++)
+    {
+        allBytes.push_back((char)i);
+    }
+    const std::string tail("\xff\xffq", 3);
+    AFLTokenMatcher matcher;
+    matcher.build({allBytes, tail});
+
+    std::vector<AFLTokenMatcher::Match> matches;
+    matcher.findAll("\x00\x00q", 3, matches);
+    EXPECT_TRUE(matches.empty());
+
+    matcher.findAll(tail.data(), tail.size(), matches);
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_EQ(matches[0].offset, 0u);
+    EXPECT_EQ(matches[0].token, 1u);
+
+    matches.clear();
+    matcher.findAll(allBytes.data(), allBytes.size(), matches);
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_EQ(matches[0].offset, 0u);
+    EXPECT_EQ(matches[0].token, 0u);
+}
+
+TEST_F(AFLTokenDictionaryTest, LoadFileUnescapesTokens)
+{
+    std::string path = writeDictionary("escaped.dict",
+        "# a comment, then a blank line\n"
+        "\n"
+        "plain=\"GET\"\n"
+        "  quote = \"a\\\"b\"  \r\n"
+        "\"back\\\\slash\"\n"
+        "hex=\"\\x00\\xFF\\x7f\"\n");
+
+    dictionary->loadFile(path);
+
+    EXPECT_EQ(dictionary->getUserTokens().size(), 4u);
+    EXPECT_TRUE(hasUserToken("GET"));
+    EXPECT_TRUE(hasUserToken("a\"b"));
+    EXPECT_TRUE(hasUserToken("back\\slash"));
+    EXPECT_TRUE(hasUserToken(std::string("\x00\xff\x7f", 3)));
+
+    // A file is only loaded once
+    dictionary->loadFile(path);
+    EXPECT_EQ(dictionary->getUserTokens().size(), 4u);
+}
+
+TEST_F(AFLTokenDictionaryTest, LoadFileFiltersLevels)
+{
+    std::string contents =
+        "base=\"zero\"\n"
+        "low@1=\"one\"\n"
+        "high@2=\"two\"\n";
+    std::string path = writeDictionary("leveled.dict", contents);
+
+    dictionary->loadFile(path);
+    EXPECT_EQ(dictionary->getUserTokens().size(), 1u);
+    EXPECT_TRUE(hasUserToken("zero"));
+
+    dictionary->loadFile(path + "@1");
+    EXPECT_EQ(dictionary->getUserTokens().size(), 2u);
+    EXPECT_TRUE(hasUserToken("one"));
+    EXPECT_FALSE(hasUserToken("two"));
+
+    dictionary->clear();
+    dictionary->loadFile(path + "@2");
+    EXPECT_EQ(dictionary->getUserTokens().size(), 3u);
+}
+
+TEST_F(AFLTokenDictionaryTest, LoadFileRejectsMalformedLines)
+{
+    expectConfigurationError(writeDictionary("unquoted.dict", "name=value\n"));
+    expectConfigurationError(writeDictionary("unopened.dict", "name=value\"\n"));
+    expectConfigurationError(writeDictionary("empty.dict", "name=\"\"\n"));
+    expectConfigurationError(writeDictionary("escape.dict", "\"a\\qb\"\n"));
+    expectConfigurationError(writeDictionary("hex.dict", "\"\\x4\"\n"));
+    expectConfigurationError(writeDictionary("binary.dict", "\"a\tb\"\n"));
+    expectConfigurationError(writeDictionary("long.dict", "\"" + std::string(MAX_DICT_FILE + 1, 'a') + "\"\n"));
+    expectConfigurationError(::testing::TempDir() + "missing.dict");
+
+    // Tokens on the lines before a malformed one are kept
+    expectConfigurationError(writeDictionary("partial.dict", "\"kept\"\nbroken\n"));
+    EXPECT_TRUE(hasUserToken("kept"));
+}
+
+TEST_F(AFLTokenDictionaryTest, ReplaceOverwritesWithoutOccurrences)
+{
+    AFLTokenReplaceMutator theMutator("AFLTokenReplaceMutator");
+    TestConfigInterface* config = testHelper->getConfig();
+    config->setStringVectorParam("AFLTokenReplaceMutator", "tokens", {"XY"});
+    theMutator.init(*config);
+    theMutator.registerStorageNeeds(*registry);
+
+    // No token occurs, so the only token is written somewhere over the input
+    const std::string input = "abcdef";
+    for (int run = 0; run < 20; ++run) {
+      StorageEntry* baseEntry = storage->createNewEntry();
+      StorageEntry* modEntry = storage->createNewEntry();
+      memcpy(baseEntry->allocateBuffer(testCaseKey, input.size()), input.data(), input.size());
+
+      try {
+        theMutator.mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+      }
+      catch (RuntimeException e)
+      {
+        FAIL() << "Exception thrown: " << e.getReason();
+      }
+
+      std::string output(modEntry->getBufferPointer(testCaseKey), modEntry->getBufferSize(testCaseKey));
+      ASSERT_EQ(output.size(), input.size());
+      size_t offset = output.find("XY");
+      ASSERT_NE(offset, std::string::npos) << output;
+      EXPECT_EQ(output.substr(0, offset), input.substr(0, offset));
+      EXPECT_EQ(output.substr(offset + 2), input.substr(offset + 2));
+    }
+
+    // With an occurrence, it is replaced by a different token
+    dictionary->addToken("Z", 1);
+    StorageEntry* baseEntry = storage->createNewEntry();
+    StorageEntry* modEntry = storage->createNewEntry();
+    memcpy(baseEntry->allocateBuffer(testCaseKey, 4), "aXYb", 4);
+    theMutator.mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+    EXPECT_EQ(std::string(modEntry->getBufferPointer(testCaseKey), modEntry->getBufferSize(testCaseKey)), "aZb");
+}
+
+TEST_F(AFLTokenDictionaryTest, AutoTokensAreFiltered)
+{
+    EXPECT_TRUE(addAutoToken("GIF"));
+    EXPECT_TRUE(addAutoToken(std::string(MAX_AUTO_EXTRA - 1, 'a') + "b"));
+
+    // Outside MIN_AUTO_EXTRA to MAX_AUTO_EXTRA bytes
+    EXPECT_FALSE(addAutoToken("GI"));
+    EXPECT_FALSE(addAutoToken(std::string(MAX_AUTO_EXTRA, 'a') + "b"));
+
+    // One byte value repeated
+    EXPECT_FALSE(addAutoToken("zzzz"));
+
+    // 32 bit interesting values, in either byte order, but not other 4 byte tokens
+    EXPECT_FALSE(addAutoToken(std::string("\xe8\x03\x00\x00", 4)));
+    EXPECT_FALSE(addAutoToken(std::string("\x00\x00\x03\xe8", 4)));
+    EXPECT_FALSE(addAutoToken(std::string("\xff\xff\xff\x7f", 4)));
+    EXPECT_TRUE(addAutoToken(std::string("\xe9\x03\x00\x00", 4)));
+
+    // Known user and auto tokens
+    dictionary->addToken("GET", 3);
+    EXPECT_FALSE(addAutoToken("GET"));
+    EXPECT_FALSE(addAutoToken("GIF"));
+    EXPECT_EQ(dictionary->getAutoTokens().size(), 3u);
+
+    // Nothing is added past USE_AUTO_EXTRAS tokens
+    for (int i = 0; dictionary->getAutoTokens().size() < USE_AUTO_EXTRAS; ++i)
+      ASSERT_TRUE(addAutoToken("auto" + std::to_string(i)));
+    EXPECT_FALSE(addAutoToken("one more"));
+    EXPECT_EQ(dictionary->getAutoTokens().size(), (size_t)USE_AUTO_EXTRAS);
+}
+
+TEST_F(AFLTokenDictionaryTest, InsertPlacesTokenAnywhere)
+{
+    AFLTokenInsertMutator theMutator("AFLTokenInsertMutator");
+    testHelper->getConfig()->setStringVectorParam("AFLTokenInsertMutator", "tokens", {"XY"});
+    theMutator.init(*testHelper->getConfig());
+    theMutator.registerStorageNeeds(*registry);
+
+    const std::string input = "abcd";
+    bool atStart = false, atEnd = false;
+    for (int run = 0; run < 100; ++run) {
+      std::string output = mutate(theMutator, input);
+      ASSERT_EQ(output.size(), input.size() + 2);
+      size_t offset = output.find("XY");
+      ASSERT_NE(offset, std::string::npos) << output;
+      EXPECT_EQ(output.substr(0, offset) + output.substr(offset + 2), input);
+      atStart |= offset == 0;
+      atEnd |= offset == input.size();
+    }
+    EXPECT_TRUE(atStart);
+    EXPECT_TRUE(atEnd);
+
+    // The result may not reach MAX_FILE bytes
+    const std::string large(MAX_FILE - 2, 'a');
+    EXPECT_EQ(mutate(theMutator, large), large);
+}
+
+TEST_F(AFLTokenDictionaryTest, OverwriteKeepsTheSize)
+{
+    AFLTokenOverwriteMutator theMutator("AFLTokenOverwriteMutator");
+    theMutator.init(*testHelper->getConfig());
+    theMutator.registerStorageNeeds(*registry);
+
+    // With no tokens the input is copied
+    const std::string input = "abcdef";
+    EXPECT_EQ(mutate(theMutator, input), input);
+
+    // Auto tokens are used when there are no user tokens
+    ASSERT_TRUE(addAutoToken("XYZ"));
+    bool atStart = false, atEnd = false;
+    for (int run = 0; run < 100; ++run) {
+      std::string output = mutate(theMutator, input);
+      ASSERT_EQ(output.size(), input.size());
+      size_t offset = output.find("XYZ");
+      ASSERT_NE(offset, std::string::npos) << output;
+      EXPECT_EQ(output.substr(0, offset), input.substr(0, offset));
+      EXPECT_EQ(output.substr(offset + 3), input.substr(offset + 3));
+      atStart |= offset == 0;
+      atEnd |= offset == input.size() - 3;
+    }
+    EXPECT_TRUE(atStart);
+    EXPECT_TRUE(atEnd);
+
+    // A token longer than the input does not fit
+    EXPECT_EQ(mutate(theMutator, "ab"), "ab");
+}
@@ -0,0 +1,299 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+
+#include "gtest/gtest.h"
+#include "ModuleTestHelper.hpp"
+#include "SimpleStorage.hpp"
+#include "RadamsaAdaptiveInputGenerator.hpp"
+#include "RuntimeException.hpp"
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+using vmf::StorageRegistry;
+using vmf::ModuleTestHelper;
+using vmf::TestConfigInterface;
+using vmf::ConfigInterface;
+using vmf::SimpleStorage;
+using vmf::StorageModule;
+using vmf::StorageEntry;
+using vmf::Module;
+using vmf::MutatorModule;
+using vmf::RadamsaAdaptiveInputGenerator;
+using vmf::RuntimeException;
+
+namespace
+{
+// Copies its input, appending a byte unless it is told to leave the input unchanged
+class AppendingMutator : public MutatorModule
+{
+public:
+    AppendingMutator(std::string name, bool changesInput) : MutatorModule(name), changesInput(changesInput) {}
+
+    void init(ConfigInterface& config) override {}
+    void registerStorageNeeds(StorageRegistry& registry) override {}
+
+    void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey) override
+    {
+        const int size = baseEntry->getBufferSize(testCaseKey);
+        char* newBuffer = newEntry->allocateBuffer(testCaseKey, changesInput ? size + 1 : size);
+        memcpy(newBuffer, baseEntry->getBufferPointer(testCaseKey), size);
+        if (changesInput) newBuffer[size] = 'x';
+    }
+
+    bool changesInput;
+};
+
+// Copies its input followed by a null terminator, as the Radamsa mutators write their outputs, flipping the first byte
+// unless it is told to leave the input unchanged
+class TerminatingMutator : public MutatorModule
+{
+public:
+    TerminatingMutator(std::string name, bool changesInput) : MutatorModule(name), changesInput(changesInput) {}
+
+    void init(ConfigInterface& config) override {}
+    void registerStorageNeeds(StorageRegistry& registry) override {}
+
+    void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey) override
+    {
+        const int size = baseEntry->getBufferSize(testCaseKey);
+        char* newBuffer = newEntry->allocateBuffer(testCaseKey, size + 1);
+        memcpy(newBuffer, baseEntry->getBufferPointer(testCaseKey), size);
+        if (changesInput) newBuffer[0] ^= 0x20;
+        newBuffer[size] = '\0';
+    }
+
+    bool changesInput;
+};
+
+// Hands the generator the mutators of the test as its children
+class ChildModulesConfig : public TestConfigInterface
+{
+public:
+    std::vector<Module*> getSubModules(std::string parentModuleName) override { return children; }
+
+    std::vector<Module*> children;
+};
+}
+
+class RadamsaAdaptiveInputGeneratorTest : public ::testing::Test {
+  protected:
+    RadamsaAdaptiveInputGeneratorTest()
+    {
+      storage = new SimpleStorage("storage");
+      registry = new StorageRegistry("TEST_INT", StorageRegistry::INT, StorageRegistry::ASCENDING);
+      metadata = new StorageRegistry();
+      theGenerator = new RadamsaAdaptiveInputGenerator("RadamsaAdaptiveInputGenerator");
+    }
+
+    ~RadamsaAdaptiveInputGeneratorTest() override {}
+
+    void SetUp() override {
+      testCaseKey = registry->registerKey("TEST_CASE", StorageRegistry::BUFFER, StorageRegistry::READ_WRITE);
+      sortKey = registry->registerKey("TEST_INT", StorageRegistry::INT, StorageRegistry::READ_WRITE);
+      hasNewCoverageTag = registry->registerTag("HAS_NEW_COVERAGE", StorageRegistry::WRITE_ONLY);
+      theGenerator->registerStorageNeeds(*registry);
+      storage->configure(registry, metadata);
+
+      StorageEntry* seed = storage->createNewEntry();
+      memcpy(seed->allocateBuffer(testCaseKey, 4), "seed", 4);
+      seed->setValue(sortKey, 0);
+      storage->saveEntry(seed);
+      storage->clearNewAndLocalEntries();
+    }
+
+    void TearDown() override {
+      delete theGenerator;
+      delete registry;
+      delete metadata;
+      delete storage;
+    }
+
+    // Runs one generation, optionally tagging every test case of the changing mutator with new coverage
+    void runRound(bool rewardChanges = false) {
+      theGenerator->addNewTestCases(*storage);
+
+      std::unique_ptr<vmf::Iterator> entries = storage->getNewEntries();
+      while (entries->hasNext()) {
+        StorageEntry* entry = entries->getNext();
+        if (rewardChanges && entry->getBufferSize(testCaseKey) == 5)
+          entry->addTag(hasNewCoverageTag);
+      }
+
+      theGenerator->examineTestCaseResults(*storage);
+      storage->clearNewAndLocalEntries();
+    }
+
+    AppendingMutator mutatorA{"ChangingMutator", true};
+    AppendingMutator mutatorB{"IdentityMutator", false};
+    ChildModulesConfig config;
+    RadamsaAdaptiveInputGenerator* theGenerator;
+    SimpleStorage* storage;
+    StorageRegistry* registry;
+    StorageRegistry* metadata;
+    int testCaseKey;
+    int sortKey;
+    int hasNewCoverageTag;
+};
+
+TEST_F(RadamsaAdaptiveInputGeneratorTest, RequiresMutators)
+{
+    try {
+        theGenerator->init(config);
+        FAIL() << "Expected a configuration error";
+    }
+    catch (RuntimeException e)
+    {
+        EXPECT_EQ(e.getErrorCode(), RuntimeException::CONFIGURATION_ERROR);
+    }
+
+    config.children = {&mutatorA};
+    config.setIntParam("RadamsaAdaptiveInputGenerator", "decayInterval", 0);
+    EXPECT_THROW(theGenerator->init(config), RuntimeException);
+    EXPECT_THROW(theGenerator->SetMutationsPerCall(0), RuntimeException);
+}
+
+TEST_F(RadamsaAdaptiveInputGeneratorTest, UnchangedOutputsLoseWeight)
+{
+    config.children = {&mutatorA, &mutatorB};
+    config.setIntParam("RadamsaAdaptiveInputGenerator", "decayInterval", 1000000);
+    theGenerator->init(config);
+
+    for(int round = 0; round < 10; ++round) runRound();
+
+    const auto& stats = theGenerator->GetMutatorStats();
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].Score, RadamsaAdaptiveInputGenerator::InitialScore);
+    EXPECT_EQ(stats[0].Unchanged, 0u);
+    EXPECT_EQ(stats[1].Score, RadamsaAdaptiveInputGenerator::MinScore);
+    EXPECT_EQ(stats[1].Unchanged, stats[1].Executions);
+    EXPECT_EQ(stats[0].Executions + stats[1].Executions, 1000u);
+
+    // The identity mutator now has 1/17 of the weight
+    const uint64_t before = stats[1].Executions;
+    for(int round = 0; round < 10; ++round) runRound();
+    EXPECT_LT(stats[1].Executions - before, 150u);
+}
+
+TEST_F(RadamsaAdaptiveInputGeneratorTest, NullTerminatedCopiesAreUnchanged)
+{
+    TerminatingMutator terminatedChange{"TerminatedChangeMutator", true};
+    TerminatingMutator terminatedCopy{"TerminatedCopyMutator", false};
+    config.children = {&terminatedChange, &terminatedCopy, &mutatorA};
+    config.setIntParam("RadamsaAdaptiveInputGenerator", "decayInterval", 1000000);
+    theGenerator->init(config);
+
+    for(int round = 0; round < 10; ++round) runRound();
+
+    // Only the input followed by a single null terminator counts as unchanged, not a changed input or an appended byte
+    const auto& stats = theGenerator->GetMutatorStats();
+    ASSERT_EQ(stats.size(), 3u);
+    EXPECT_EQ(stats[0].Unchanged, 0u);
+    EXPECT_EQ(stats[0].Score, RadamsaAdaptiveInputGenerator::InitialScore);
+    EXPECT_GT(stats[1].Executions, 0u);
+    EXPECT_EQ(stats[1].Unchanged, stats[1].Executions);
+    EXPECT_EQ(stats[1].Score, RadamsaAdaptiveInputGenerator::MinScore);
+    EXPECT_EQ(stats[2].Unchanged, 0u);
+    EXPECT_EQ(stats[2].Score, RadamsaAdaptiveInputGenerator::InitialScore);
+}
+
+TEST_F(RadamsaAdaptiveInputGeneratorTest, CoverageRaisesScore)
+{
+    config.children = {&mutatorA, &mutatorB};
+    theGenerator->init(config);
+
+    runRound(true);
+
+    const auto& stats = theGenerator->GetMutatorStats();
+    EXPECT_EQ(stats[0].NewCoverage, stats[0].Executions);
+    EXPECT_EQ(stats[1].NewCoverage, 0u);
+    EXPECT_EQ(stats[0].Score, RadamsaAdaptiveInputGenerator::MaxScore);
+    EXPECT_EQ(stats[0].SinceReward, 0u);
+
+    // Entries from other modules are not credited to any mutator
+    StorageEntry* foreign = storage->createNewEntry();
+    foreign->addTag(hasNewCoverageTag);
+    theGenerator->examineTestCaseResults(*storage);
+    EXPECT_EQ(stats[0].NewCoverage + stats[1].NewCoverage, stats[0].Executions);
+}
+
+TEST_F(RadamsaAdaptiveInputGeneratorTest, ScoresDecayWithoutCoverage)
+{
+    config.children = {&mutatorA};
+    config.setIntParam("RadamsaAdaptiveInputGenerator", "decayInterval", 10);
+    config.setIntParam("RadamsaAdaptiveInputGenerator", "mutationsPerCall", 25);
+    theGenerator->init(config);
+
+    const auto& stats = theGenerator->GetMutatorStats();
+
+    runRound();
+    EXPECT_EQ(stats[0].Executions, 25u);
+    EXPECT_EQ(stats[0].Score, RadamsaAdaptiveInputGenerator::InitialScore / 4u);
+    EXPECT_EQ(stats[0].SinceReward, 5u);
+
+    runRound();
+    runRound();
+    EXPECT_EQ(stats[0].Score, RadamsaAdaptiveInputGenerator::MinScore);
+}
+
+TEST_F(RadamsaAdaptiveInputGeneratorTest, FavorsTheStartOfTheSortedEntries)
+{
+    // Nine more entries, which sort after the seed in the order they are saved
+    for (int i = 1; i < 10; ++i) {
+        StorageEntry* entry = storage->createNewEntry();
+        memcpy(entry->allocateBuffer(testCaseKey, 4), ("ent" + std::to_string(i)).data(), 4);
+        entry->setValue(sortKey, i);
+        storage->saveEntry(entry);
+    }
+    storage->clearNewAndLocalEntries();
+
+    config.children = {&mutatorA};
+    config.setIntParam("RadamsaAdaptiveInputGenerator", "mutationsPerCall", 1);
+    theGenerator->init(config);
+
+    // Each test case starts with the four bytes of its base entry
+    std::map<std::string, int> counts;
+    for (int round = 0; round < 2000; ++round) {
+        theGenerator->addNewTestCases(*storage);
+        std::unique_ptr<vmf::Iterator> entries = storage->getNewEntries();
+        while (entries->hasNext())
+            counts[std::string(entries->getNext()->getBufferPointer(testCaseKey), 4)]++;
+        theGenerator->examineTestCaseResults(*storage);
+        storage->clearNewAndLocalEntries();
+    }
+
+    // The first half of the entries is picked three times as often as the second half, and every entry is picked
+    const int firstHalf = counts["seed"] + counts["ent1"] + counts["ent2"] + counts["ent3"] + counts["ent4"];
+    const int secondHalf = counts["ent5"] + counts["ent6"] + counts["ent7"] + counts["ent8"] + counts["ent9"];
+    EXPECT_EQ(firstHalf + secondHalf, 2000);
+    EXPECT_GT(firstHalf, 2 * secondHalf);
+    EXPECT_GT(counts["seed"], 4 * counts["ent9"]);
+    EXPECT_GT(counts["ent9"], 0);
+}
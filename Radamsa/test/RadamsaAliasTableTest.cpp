@@ -0,0 +1,90 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+
+#include "gtest/gtest.h"
+#include "RadamsaAliasTable.hpp"
+#include "RuntimeException.hpp"
+#include <vector>
+
+using vmf::RadamsaAliasTable;
+using vmf::RuntimeException;
+using vmf::VmfRand;
+
+class RadamsaAliasTableTest : public ::testing::Test {
+  protected:
+    RadamsaAliasTableTest() = default;
+    ~RadamsaAliasTableTest() = default;
+
+    static std::vector<size_t> countSamples(const RadamsaAliasTable& table, size_t samples) {
+      std::vector<size_t> counts(table.GetSize(), 0);
+      for(size_t i{0}; i < samples; ++i)
+        ++counts[table.Sample(VmfRand::getInstance())];
+      return counts;
+    }
+};
+
+TEST_F(RadamsaAliasTableTest, SamplesInProportion)
+{
+    const std::vector<uint32_t> weights{1, 16, 0, 3, 256, 16};
+    RadamsaAliasTable table;
+    table.Build(weights);
+
+    EXPECT_EQ(table.GetSize(), weights.size());
+    EXPECT_EQ(table.GetTotalWeight(), 292u);
+
+    constexpr size_t samples{292u * 2000u};
+    const std::vector<size_t> counts = countSamples(table, samples);
+    for(size_t i{0}; i < weights.size(); ++i) {
+        // Within 10% (or a few samples) of the expected count
+        const double expected = static_cast<double>(samples) * weights[i] / 292.0;
+        EXPECT_NEAR(static_cast<double>(counts[i]), expected, expected * 0.1 + 50.0) << i;
+    }
+    EXPECT_EQ(counts[2], 0u);
+}
+
+TEST_F(RadamsaAliasTableTest, SingleAndUniformWeights)
+{
+    RadamsaAliasTable table;
+
+    table.Build({0, 0, 7, 0});
+    for(size_t count : countSamples(table, 1000)) EXPECT_TRUE(count == 0 || count == 1000);
+    EXPECT_EQ(countSamples(table, 1000)[2], 1000u);
+
+    // Rebuilding reuses the table
+    table.Build({5, 5, 5, 5});
+    for(size_t count : countSamples(table, 40000)) EXPECT_NEAR(static_cast<double>(count), 10000.0, 1000.0);
+}
+
+TEST_F(RadamsaAliasTableTest, RejectsEmptyWeights)
+{
+    RadamsaAliasTable table;
+
+    EXPECT_THROW(table.Build({}), RuntimeException);
+    EXPECT_THROW(table.Build({0, 0}), RuntimeException);
+}
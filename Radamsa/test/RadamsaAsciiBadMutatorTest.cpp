@@ -240,3 +240,43 @@ TEST_F(RadamsaAsciiBadMutatorTest, TwoChunks)
     EXPECT_EQ(modBuff[modBuff_len - 1], '\0');
     // Content tests would go here
 }
+
+TEST_F(RadamsaAsciiBadMutatorTest, BinaryWithStrings)
+{
+    // Strings between runs of binary bytes, as in an executable; only the strings are ever changed
+    string buffString = "HEADER";
+    for(int i{0}; i < 50; ++i) {
+        buffString += string("\x01\x02\xff\xfe", 4) + "str" + std::to_string(i);
+    }
+    string binaryBytes;
+    for(char c : buffString) {
+        if (c == '\x01' || c == '\x02' || c == '\xff' || c == '\xfe') binaryBytes += c;
+    }
+
+    StorageEntry* baseEntry = storage->createNewEntry();
+    const size_t buff_len = buffString.length();
+    char* buff = baseEntry->allocateBuffer(testCaseKey, buff_len);
+    std::copy(buffString.begin(), buffString.end(), buff);
+
+    for(int run{0}; run < 20; ++run) {
+        StorageEntry* modEntry = storage->createNewEntry();
+        try{
+            theMutator->mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+        } 
+        catch (BaseException e)
+        {
+            FAIL() << "Exception thrown: " << e.getReason();
+        }
+
+        const size_t modBuff_len = modEntry->getBufferSize(testCaseKey);
+        const char* modBuff = modEntry->getBufferPointer(testCaseKey);
+        EXPECT_EQ(modBuff[modBuff_len - 1], '\0');
+
+        string modBinaryBytes;
+        for(size_t i{0}; i + 1 < modBuff_len; ++i) {
+            const char c = modBuff[i];
+            if (c == '\x01' || c == '\x02' || c == '\xff' || c == '\xfe') modBinaryBytes += c;
+        }
+        EXPECT_EQ(modBinaryBytes, binaryBytes);
+    }
+}
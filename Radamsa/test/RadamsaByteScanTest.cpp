@@ -0,0 +1,231 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+
+#include "gtest/gtest.h"
+#include "RadamsaByteScan.hpp"
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+using vmf::RadamsaByteScan;
+
+class RadamsaByteScanTest : public ::testing::Test {
+  protected:
+    using ByteClass = RadamsaByteScan::ByteClass;
+    using Path = RadamsaByteScan::Path;
+
+    const std::vector<ByteClass> classes{ByteClass::Newline, ByteClass::Digit, ByteClass::Printable, ByteClass::Texty, ByteClass::HighBit, ByteClass::Structural, ByteClass::CodePointStart};
+    const std::vector<Path> paths{Path::Scalar, Path::SSE2, Path::AVX2};
+
+    RadamsaByteScanTest() = default;
+    ~RadamsaByteScanTest() = default;
+
+    void SetUp() override {
+      originalPath = RadamsaByteScan::GetActivePath();
+    }
+
+    void TearDown() override {
+      RadamsaByteScan::SetActivePath(originalPath);
+    }
+
+    static std::vector<char> makeBuffer(size_t size, unsigned int seed) {
+      // Mostly text with some newlines, digits and high-bit bytes so that every class has both matches and gaps
+      std::mt19937 gen(seed);
+      std::uniform_int_distribution<int> dist(0, 255);
+      std::vector<char> buffer(size);
+      for(size_t i{0}; i < size; ++i) {
+        const int r = dist(gen);
+        if (r < 16) buffer[i] = '\n';
+        else if (r < 48) buffer[i] = static_cast<char>('0' + (r % 10));
+        else if (r < 64) buffer[i] = static_cast<char>(0x80 + (r - 48) * 5);   // continuation and lead bytes
+        else if (r < 68) buffer[i] = static_cast<char>(r % 32);
+        else buffer[i] = static_cast<char>(' ' + (r % 95));
+      }
+      return buffer;
+    }
+
+    Path originalPath;
+};
+
+TEST_F(RadamsaByteScanTest, ClassMembership)
+{
+    EXPECT_TRUE(RadamsaByteScan::IsInClass('\n', ByteClass::Newline));
+    EXPECT_FALSE(RadamsaByteScan::IsInClass('\r', ByteClass::Newline));
+    EXPECT_TRUE(RadamsaByteScan::IsInClass('0', ByteClass::Digit));
+    EXPECT_TRUE(RadamsaByteScan::IsInClass('9', ByteClass::Digit));
+    EXPECT_FALSE(RadamsaByteScan::IsInClass('/', ByteClass::Digit));
+    EXPECT_FALSE(RadamsaByteScan::IsInClass(':', ByteClass::Digit));
+    EXPECT_TRUE(RadamsaByteScan::IsInClass(' ', ByteClass::Printable));
+    EXPECT_TRUE(RadamsaByteScan::IsInClass('~', ByteClass::Printable));
+    EXPECT_FALSE(RadamsaByteScan::IsInClass(0x7F, ByteClass::Printable));
+    EXPECT_FALSE(RadamsaByteScan::IsInClass('\t', ByteClass::Printable));
+    EXPECT_TRUE(RadamsaByteScan::IsInClass('\t', ByteClass::Texty));
+    EXPECT_TRUE(RadamsaByteScan::IsInClass('\r', ByteClass::Texty));
+    EXPECT_FALSE(RadamsaByteScan::IsInClass('\0', ByteClass::Texty));
+    EXPECT_TRUE(RadamsaByteScan::IsInClass(0x80, ByteClass::HighBit));
+    EXPECT_FALSE(RadamsaByteScan::IsInClass(0x7F, ByteClass::HighBit));
+    EXPECT_TRUE(RadamsaByteScan::IsInClass('a', ByteClass::CodePointStart));
+    EXPECT_TRUE(RadamsaByteScan::IsInClass(0xC3, ByteClass::CodePointStart));
+    EXPECT_TRUE(RadamsaByteScan::IsInClass(0xF0, ByteClass::CodePointStart));
+    EXPECT_TRUE(RadamsaByteScan::IsInClass(0xFF, ByteClass::CodePointStart));
+    EXPECT_FALSE(RadamsaByteScan::IsInClass(0x80, ByteClass::CodePointStart));
+    EXPECT_FALSE(RadamsaByteScan::IsInClass(0xBF, ByteClass::CodePointStart));
+
+    const std::string structural = "()[]{}<>\"'\\";
+    for(int byte{0}; byte < 256; ++byte) {
+        const bool expected = structural.find(static_cast<char>(byte)) != std::string::npos;
+        EXPECT_EQ(expected, RadamsaByteScan::IsInClass(static_cast<uint8_t>(byte), ByteClass::Structural)) << byte;
+    }
+}
+
+TEST_F(RadamsaByteScanTest, ScalarPathAlwaysSupported)
+{
+    EXPECT_TRUE(RadamsaByteScan::IsPathSupported(Path::Scalar));
+    EXPECT_TRUE(RadamsaByteScan::SetActivePath(Path::Scalar));
+    EXPECT_EQ(RadamsaByteScan::GetActivePath(), Path::Scalar);
+}
+
+TEST_F(RadamsaByteScanTest, PathsMatchReference)
+{
+    // Sizes and start offsets straddle the 64-byte block size and the 16/32-byte vector widths
+    const std::vector<size_t> sizes{0, 1, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 200, 1000};
+
+    for(Path path : paths) {
+        if (!RadamsaByteScan::SetActivePath(path)) continue;
+
+        for(size_t size : sizes) {
+            const std::vector<char> buffer = makeBuffer(size, static_cast<unsigned int>(size));
+
+            size_t expectedNewlines{0};
+            for(char c : buffer) expectedNewlines += (c == '\n');
+            EXPECT_EQ(RadamsaByteScan::CountByte(buffer.data(), size, '\n'), expectedNewlines);
+
+            for(ByteClass byteClass : classes) {
+                size_t expectedCount{0};
+                std::vector<uint64_t> expectedBitmask(RadamsaByteScan::GetBitmaskWordCount(size), 0);
+                for(size_t i{0}; i < size; ++i) {
+                    if (RadamsaByteScan::IsInClass(static_cast<uint8_t>(buffer[i]), byteClass)) {
+                        ++expectedCount;
+                        expectedBitmask[i / 64] |= uint64_t{1} << (i % 64);
+                    }
+                }
+                EXPECT_EQ(RadamsaByteScan::CountInClass(buffer.data(), size, byteClass), expectedCount);
+
+                std::vector<uint64_t> bitmask(RadamsaByteScan::GetBitmaskWordCount(size), ~uint64_t{0});
+                RadamsaByteScan::GetClassBitmask(buffer.data(), size, byteClass, bitmask.data());
+                EXPECT_EQ(bitmask, expectedBitmask);
+
+                // The paired scan must agree with two single scans
+                std::vector<uint64_t> firstBitmask(bitmask.size(), ~uint64_t{0});
+                std::vector<uint64_t> secondBitmask(bitmask.size(), ~uint64_t{0});
+                std::vector<uint64_t> printableBitmask(bitmask.size(), ~uint64_t{0});
+                RadamsaByteScan::GetClassBitmask(buffer.data(), size, ByteClass::Printable, printableBitmask.data());
+                RadamsaByteScan::GetClassBitmasks(buffer.data(), size, byteClass, firstBitmask.data(), ByteClass::Printable, secondBitmask.data());
+                EXPECT_EQ(firstBitmask, expectedBitmask);
+                EXPECT_EQ(secondBitmask, printableBitmask);
+
+                for(size_t start{0}; start <= size; start += 5) {
+                    size_t expectedNext{start};
+                    while (expectedNext < size && !RadamsaByteScan::IsInClass(static_cast<uint8_t>(buffer[expectedNext]), byteClass)) ++expectedNext;
+                    size_t expectedEnd{start};
+                    while (expectedEnd < size && RadamsaByteScan::IsInClass(static_cast<uint8_t>(buffer[expectedEnd]), byteClass)) ++expectedEnd;
+
+                    EXPECT_EQ(RadamsaByteScan::FindNextInClass(buffer.data(), size, start, byteClass), expectedNext);
+                    EXPECT_EQ(RadamsaByteScan::FindEndOfRun(buffer.data(), size, start, byteClass), expectedEnd);
+                }
+            }
+
+            for(size_t start{0}; start <= size; start += 3) {
+                size_t expectedNext{start};
+                while (expectedNext < size && buffer[expectedNext] != '\n') ++expectedNext;
+                EXPECT_EQ(RadamsaByteScan::FindNextByte(buffer.data(), size, start, '\n'), expectedNext);
+            }
+        }
+    }
+}
+
+TEST_F(RadamsaByteScanTest, LongRuns)
+{
+    // A run longer than several blocks must be skipped as a whole
+    std::vector<char> buffer(1000, '7');
+    buffer[777] = 'x';
+
+    for(Path path : paths) {
+        if (!RadamsaByteScan::SetActivePath(path)) continue;
+
+        EXPECT_EQ(RadamsaByteScan::FindEndOfRun(buffer.data(), buffer.size(), 3, ByteClass::Digit), 777u);
+        EXPECT_EQ(RadamsaByteScan::FindNextInClass(buffer.data(), buffer.size(), 0, ByteClass::Printable), 0u);
+        EXPECT_EQ(RadamsaByteScan::FindNextByte(buffer.data(), buffer.size(), 0, 'x'), 777u);
+        EXPECT_EQ(RadamsaByteScan::FindNextByte(buffer.data(), buffer.size(), 778, 'x'), buffer.size());
+        EXPECT_EQ(RadamsaByteScan::CountInClass(buffer.data(), buffer.size(), ByteClass::Digit), 999u);
+    }
+}
+
+// Microbenchmark of the scan rate of each path; run with --gtest_also_run_disabled_tests
+TEST_F(RadamsaByteScanTest, DISABLED_ScanRateBenchmark)
+{
+    constexpr size_t bufferSize{64u << 20};
+    constexpr size_t repetitions{8u};
+    const std::vector<char> buffer = makeBuffer(bufferSize, 1);
+
+    for(Path path : paths) {
+        if (!RadamsaByteScan::SetActivePath(path)) continue;
+
+        const char* pathName = (path == Path::Scalar) ? "Scalar" : (path == Path::SSE2) ? "SSE2" : "AVX2";
+        size_t sink{0};
+
+        auto report = [&](const char* scanName, auto&& scan) {
+            const auto begin = std::chrono::steady_clock::now();
+            for(size_t i{0}; i < repetitions; ++i) sink += scan();
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+            const double gigabytes = static_cast<double>(bufferSize * repetitions) / (1024.0 * 1024.0 * 1024.0);
+            std::cout << pathName << " " << scanName << ": " << gigabytes / elapsed.count() << " GB/s" << std::endl;
+        };
+
+        std::vector<uint64_t> bitmask(RadamsaByteScan::GetBitmaskWordCount(bufferSize));
+
+        report("CountByte('\\n')", [&]() { return RadamsaByteScan::CountByte(buffer.data(), bufferSize, '\n'); });
+        report("FindNextByte(0xFF)", [&]() { return RadamsaByteScan::FindNextByte(buffer.data(), bufferSize, 0, 0xFF); });
+        report("CountInClass(Digit)", [&]() { return RadamsaByteScan::CountInClass(buffer.data(), bufferSize, ByteClass::Digit); });
+        report("FindEndOfRun(Texty)", [&]() {
+            // Walk every texty run in the buffer
+            size_t runs{0};
+            for(size_t pos{0}; pos < bufferSize; ++runs)
+                pos = RadamsaByteScan::FindEndOfRun(buffer.data(), bufferSize, pos, ByteClass::Texty) + 1;
+            return runs;
+        });
+        report("GetClassBitmask(HighBit)", [&]() {
+            RadamsaByteScan::GetClassBitmask(buffer.data(), bufferSize, ByteClass::HighBit, bitmask.data());
+            return static_cast<size_t>(bitmask[0]);
+        });
+
+        EXPECT_GT(sink, 0u);
+    }
+}
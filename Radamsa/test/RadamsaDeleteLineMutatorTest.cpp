@@ -40,6 +40,7 @@ using vmf::TestConfigInterface;
 using vmf::SimpleStorage;
 using vmf::StorageEntry;
 using vmf::RadamsaDeleteLineMutator;
+using vmf::RadamsaDeleteFieldRecordMutator;
 using vmf::BaseException;
 using vmf::RuntimeException;
 
@@ -232,4 +233,80 @@ TEST_F(RadamsaDeleteLineMutatorTest, ThreeLines)
     EXPECT_TRUE(modString == "4\n5\n\0" | 
                 modString == "5\n6\n\0" | 
                 modString == "4\n6\n\0");
-}
\ No newline at end of file
+}
+
+TEST_F(RadamsaDeleteLineMutatorTest, StreamingThreeLines)
+{
+    // A threshold of one byte puts every input through the streaming mode
+    config->setIntParam("RadamsaDeleteLineMutator", "streamingThreshold", 1);
+    theMutator->init(*config);
+
+    std::string buffString = "4\n5\n6\ntail";
+    const size_t buff_len = buffString.length();
+    StorageEntry* baseEntry = storage->createNewEntry();
+    char* buff = baseEntry->allocateBuffer(testCaseKey, buff_len);
+    for(size_t i{0}; i < buff_len; ++i) {
+        buff[i] = buffString[i];
+    }
+
+    for(int run{0}; run < 20; ++run) {
+        StorageEntry* modEntry = storage->createNewEntry();
+        char* modBuff;
+
+        try{
+            theMutator->mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+            modBuff = modEntry->getBufferPointer(testCaseKey);
+        } 
+        catch (BaseException e)
+        {
+            FAIL() << "Exception thrown: " << e.getReason();
+        }
+
+        // test buff len
+        EXPECT_EQ(buff_len - 2 + 1, modEntry->getBufferSize(testCaseKey));
+        // test buff contents
+        std::string modString = std::string(modBuff);
+        EXPECT_TRUE(modString == "4\n5\ntail" || 
+                    modString == "5\n6\ntail" || 
+                    modString == "4\n6\ntail") << "modString = \"" + modString + "\"";
+    }
+}
+
+TEST_F(RadamsaDeleteLineMutatorTest, FieldSeparatorRecords)
+{
+    RadamsaDeleteFieldRecordMutator fieldMutator("RadamsaDeleteFieldRecordMutator");
+
+    std::string buffString = "a,b;c|tail";
+    const size_t buff_len = buffString.length();
+    StorageEntry* baseEntry = storage->createNewEntry();
+    char* buff = baseEntry->allocateBuffer(testCaseKey, buff_len);
+    for(size_t i{0}; i < buff_len; ++i) {
+        buff[i] = buffString[i];
+    }
+
+    // Run the indexed mode first, then force the streaming mode
+    for(int threshold : {0, 1}) {
+        config->setIntParam("RadamsaDeleteFieldRecordMutator", "streamingThreshold", threshold);
+        fieldMutator.init(*config);
+
+        for(int run{0}; run < 20; ++run) {
+            StorageEntry* modEntry = storage->createNewEntry();
+            char* modBuff;
+
+            try{
+                fieldMutator.mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+                modBuff = modEntry->getBufferPointer(testCaseKey);
+            }
+            catch (BaseException e)
+            {
+                FAIL() << "Exception thrown: " << e.getReason();
+            }
+
+            EXPECT_EQ(buff_len - 2 + 1, modEntry->getBufferSize(testCaseKey));
+            std::string modString = std::string(modBuff);
+            EXPECT_TRUE(modString == "b;c|tail" ||
+                        modString == "a,c|tail" ||
+                        modString == "a,b;tail") << "modString = \"" + modString + "\"";
+        }
+    }
+}
@@ -267,4 +267,45 @@ TEST_F(RadamsaDeleteNodeMutatorTest, TwoChildren_OneGrandchild)
         modString == "GH(IJ)(MN)" ||    // grandchild delete
         modString == "\0"               // root delete
     );
-}
\ No newline at end of file
+}
+TEST_F(RadamsaDeleteNodeMutatorTest, BracketedSyntax)
+{
+    // Real-world text parses into bracket groups, strings and text runs instead of throwing
+    config->setStringParam("RadamsaDeleteNodeMutator", "syntax", "bracketed");
+    theMutator->init(*config);
+
+    std::string buffString = "{\"key\": [1, 2, 3], \"other\": {\"nested\": true}}";
+    StorageEntry* baseEntry = storage->createNewEntry();
+    const size_t buff_len = buffString.length();
+    char* buff = baseEntry->allocateBuffer(testCaseKey, buff_len);
+    for(size_t i{0}; i < buff_len; ++i) {
+        buff[i] = buffString[i];
+    }
+
+    for(int run{0}; run < 20; ++run) {
+        StorageEntry* modEntry = storage->createNewEntry();
+
+        try{
+            theMutator->mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+        }
+        catch (BaseException e)
+        {
+            FAIL() << "Exception thrown: " << e.getReason();
+        }
+
+        // a deleted node takes its bytes with it and nothing else changes
+        std::string modString = std::string(modEntry->getBufferPointer(testCaseKey));
+        EXPECT_LT(modString.length(), buff_len) << "modString: " + modString;
+        EXPECT_EQ(modString.length() + 1, modEntry->getBufferSize(testCaseKey));
+    }
+
+    try{
+        config->setStringParam("RadamsaDeleteNodeMutator", "syntax", "xml");
+        theMutator->init(*config);
+        ADD_FAILURE() << "No exception thrown";
+    }
+    catch (RuntimeException e)
+    {
+        EXPECT_EQ(e.getErrorCode(), e.CONFIGURATION_ERROR);
+    }
+}
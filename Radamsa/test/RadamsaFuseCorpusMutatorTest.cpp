@@ -0,0 +1,222 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2024 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+
+#include "gtest/gtest.h"
+#include "ModuleTestHelper.hpp"
+#include "SimpleStorage.hpp"
+#include "RadamsaFuseCorpusMutator.hpp"
+#include "RuntimeException.hpp"
+#include "RadamsaFuse_helpers.hpp"
+#include <random>
+
+using vmf::StorageModule;
+using vmf::StorageRegistry;
+using vmf::ModuleTestHelper;
+using vmf::TestConfigInterface;
+using vmf::SimpleStorage;
+using vmf::StorageEntry;
+using vmf::RadamsaFuseCorpusMutator;
+using vmf::BaseException;
+using vmf::RuntimeException;
+using std::string;
+
+class RadamsaFuseCorpusMutatorTest : public ::testing::Test {
+  protected:
+    RadamsaFuseCorpusMutator* theMutator;
+    StorageModule* storage;
+    StorageRegistry* registry;
+    StorageRegistry* metadata;
+    ModuleTestHelper* testHelper;
+    TestConfigInterface* config;
+    int testCaseKey;
+
+    RadamsaFuseCorpusMutatorTest() 
+    {
+      storage = new SimpleStorage("storage");
+      registry = new StorageRegistry("TEST_INT", StorageRegistry::INT, StorageRegistry::ASCENDING);
+      metadata = new StorageRegistry();
+      testHelper = new ModuleTestHelper();
+      theMutator = new RadamsaFuseCorpusMutator("RadamsaFuseCorpusMutator");
+      config = testHelper -> getConfig();
+    }
+
+    ~RadamsaFuseCorpusMutatorTest() override {}
+
+    void SetUp() override {
+      testCaseKey = registry->registerKey(
+          "TEST_CASE", 
+          StorageRegistry::BUFFER, 
+          StorageRegistry::READ_WRITE
+      );
+      storage->configure(registry, metadata);
+      theMutator->init(*config);
+      theMutator->registerStorageNeeds(*registry);
+      theMutator->registerMetadataNeeds(*metadata);
+    }
+
+    void TearDown() override {
+      delete registry;
+      delete metadata;
+      delete storage;
+    }
+
+    static string makeText(size_t size, unsigned int seed) {
+      std::mt19937 gen(seed);
+      std::uniform_int_distribution<int> dist('a', 'z');
+      string text(size, '\0');
+      for(size_t i{0}; i < size; ++i) {
+        text[i] = static_cast<char>(dist(gen));
+      }
+      return text;
+    }
+
+    StorageEntry* makeEntry(const string& contents) {
+      StorageEntry* entry = storage->createNewEntry();
+      char* buff = entry->allocateBuffer(testCaseKey, contents.size());
+      std::copy(contents.begin(), contents.end(), buff);
+      return entry;
+    }
+
+    string mutate(StorageEntry* baseEntry) {
+      StorageEntry* modEntry = storage->createNewEntry();
+      try{
+          theMutator->mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+      } 
+      catch (BaseException e)
+      {
+          ADD_FAILURE() << "Exception thrown: " << e.getReason();
+          return "";
+      }
+
+      const size_t modBuff_len = modEntry->getBufferSize(testCaseKey);
+      const char* modBuff = modEntry->getBufferPointer(testCaseKey);
+      EXPECT_EQ(modBuff[modBuff_len - 1], '\0');
+      return string(modBuff, modBuff_len - 1);
+    }
+
+    // True if mod is a prefix of first followed by a suffix of second
+    static bool isPrefixSuffixFuse(const string& mod, const string& first, const string& second) {
+      size_t prefix{0};
+      while(prefix < mod.size() && prefix < first.size() && mod[prefix] == first[prefix]) ++prefix;
+      size_t suffix{0};
+      while(suffix < mod.size() && suffix < second.size() &&
+            mod[mod.size() - 1 - suffix] == second[second.size() - 1 - suffix]) ++suffix;
+      return prefix + suffix >= mod.size();
+    }
+};
+
+TEST_F(RadamsaFuseCorpusMutatorTest, EmptyCorpus)
+{
+    // Without other entries the buffer is fused with itself
+    const string buffString = "ghijklmnop";
+    StorageEntry* baseEntry = makeEntry(buffString);
+
+    const string modString = mutate(baseEntry);
+    ASSERT_PRED2(isSubset, modString, buffString);
+    EXPECT_PRED2(isValidSelfFuse, modString, buffString);
+}
+
+TEST_F(RadamsaFuseCorpusMutatorTest, BaseEntryIsNotItsOwnPartner)
+{
+    const string buffString = makeText(300, 1);
+    StorageEntry* baseEntry = makeEntry(buffString);
+    storage->saveEntry(baseEntry);
+
+    for(int run{0}; run < 10; ++run) {
+        const string modString = mutate(baseEntry);
+        EXPECT_PRED2(isValidSelfFuse, modString, buffString);
+    }
+}
+
+TEST_F(RadamsaFuseCorpusMutatorTest, SharedContext)
+{
+    const string shared = makeText(64, 2);
+    const string partnerString = makeText(400, 3) + shared + makeText(400, 4);
+    const string buffString = makeText(300, 5) + shared + makeText(300, 6);
+
+    storage->saveEntry(makeEntry(makeText(1000, 7)));
+    storage->saveEntry(makeEntry(partnerString));
+    StorageEntry* baseEntry = makeEntry(buffString);
+
+    for(int run{0}; run < 20; ++run) {
+        const string modString = mutate(baseEntry);
+        EXPECT_TRUE(isPrefixSuffixFuse(modString, buffString, partnerString));
+
+        // The jump happens inside the shared region, so the output keeps the heads and tails around it
+        EXPECT_EQ(modString.compare(0, 300, buffString, 0, 300), 0);
+        ASSERT_GE(modString.size(), 400u);
+        EXPECT_EQ(modString.compare(modString.size() - 400, 400, partnerString, partnerString.size() - 400, 400), 0);
+    }
+    EXPECT_EQ(theMutator->GetIndex().GetIndexedEntryCount(), 2u);
+}
+
+TEST_F(RadamsaFuseCorpusMutatorTest, UnrelatedCorpus)
+{
+    // Nothing is shared, so the buffer is fused with a random saved entry at whatever context they have in common
+    const string partnerString = "0123456789";
+    const string buffString = "abcdefghij";
+    storage->saveEntry(makeEntry(partnerString));
+    StorageEntry* baseEntry = makeEntry(buffString);
+
+    for(int run{0}; run < 10; ++run) {
+        const string modString = mutate(baseEntry);
+        EXPECT_TRUE(isPrefixSuffixFuse(modString, buffString, partnerString));
+    }
+}
+
+TEST_F(RadamsaFuseCorpusMutatorTest, RemovedPartner)
+{
+    const string shared = makeText(64, 8);
+    StorageEntry* partner = makeEntry(makeText(100, 9) + shared);
+    storage->saveEntry(partner);
+    StorageEntry* baseEntry = makeEntry(shared + makeText(100, 10));
+
+    mutate(baseEntry);
+    EXPECT_EQ(theMutator->GetIndex().GetIndexedEntryCount(), 1u);
+
+    storage->removeEntry(partner);
+    const string modString = mutate(baseEntry);
+    EXPECT_EQ(theMutator->GetIndex().GetIndexedEntryCount(), 0u);
+    EXPECT_PRED2(isValidSelfFuse, modString, shared + makeText(100, 10));
+}
+
+TEST_F(RadamsaFuseCorpusMutatorTest, MaxIndexSize)
+{
+    EXPECT_THROW(theMutator->SetMaxIndexSize(0), RuntimeException);
+
+    config->setIntParam("RadamsaFuseCorpusMutator", "maxIndexSize", 4096);
+    theMutator->init(*config);
+    EXPECT_EQ(theMutator->GetIndex().GetByteBudget(), 4096u);
+
+    for(unsigned int seed{20}; seed < 30; ++seed) {
+        storage->saveEntry(makeEntry(makeText(2000, seed)));
+    }
+    mutate(makeEntry(makeText(100, 40)));
+    EXPECT_LT(theMutator->GetIndex().GetIndexedEntryCount(), 10u);
+}
@@ -195,4 +195,42 @@ TEST_F(RadamsaFuseThisMutatorTest, TenBytes)
     EXPECT_EQ(modBuff[modBuff_len - 1], '\0');
     ASSERT_PRED2(isSubset, modString, buffString);
     EXPECT_PRED2(isValidSelfFuse, modString, buffString);
-}
\ No newline at end of file
+}
+TEST_F(RadamsaFuseThisMutatorTest, LargeInput)
+{
+    // Large enough that materializing every suffix, as the search once did, would take gigabytes
+    string buffString;
+    for(size_t i{0}; buffString.size() < 64 * 1024; ++i) {
+        buffString += "<item id=\"" + std::to_string(i % 97) + "\">value</item>\n";
+    }
+
+    StorageEntry* baseEntry = storage->createNewEntry();
+    StorageEntry* modEntry = storage->createNewEntry();
+
+    const size_t buff_len = buffString.length();
+    char* buff = baseEntry->allocateBuffer(testCaseKey, buff_len);
+    std::copy(buffString.begin(), buffString.end(), buff);
+
+    for(int run{0}; run < 10; ++run) {
+        try{
+            theMutator->mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+        } 
+        catch (BaseException e)
+        {
+            FAIL() << "Exception thrown: " << e.getReason();
+        }
+
+        const size_t modBuff_len = modEntry->getBufferSize(testCaseKey);
+        const string modString(modEntry->getBufferPointer(testCaseKey), modBuff_len - 1);
+
+        // modString is buff[0, i) + buff[j, end) exactly when its common prefix and common suffix with buff overlap
+        size_t prefix{0};
+        while(prefix < modString.size() && prefix < buff_len && modString[prefix] == buffString[prefix]) ++prefix;
+        size_t suffix{0};
+        while(suffix < modString.size() && suffix < buff_len &&
+              modString[modString.size() - 1 - suffix] == buffString[buff_len - 1 - suffix]) ++suffix;
+        EXPECT_GE(prefix + suffix, modString.size());
+
+        modEntry = storage->createNewEntry();
+    }
+}
@@ -243,4 +243,50 @@ TEST_F(RadamsaInsertLineMutatorTest, ThreeLines)
         modString == "GHI\nL\nJK\nL\n" ||  // 1323
         modString == "GHI\nJK\nL\nL\n"     // 1233
     ) << "modString = \"" + modString + "\"";
-}
\ No newline at end of file
+}
+
+TEST_F(RadamsaInsertLineMutatorTest, StreamingThreeLines)
+{
+    // A threshold of one byte puts every input through the streaming mode
+    config->setIntParam("RadamsaInsertLineMutator", "streamingThreshold", 1);
+    theMutator->init(*config);
+
+    std::string buffString = "GHI\nJK\nL\n";
+    const size_t buff_len = buffString.length();
+    StorageEntry* baseEntry = storage->createNewEntry();
+    char* buff = baseEntry->allocateBuffer(testCaseKey, buff_len);
+    for(size_t i{0}; i < buff_len; ++i) {
+        buff[i] = buffString[i];
+    }
+
+    for(int run{0}; run < 20; ++run) {
+        StorageEntry* modEntry = storage->createNewEntry();
+        char* modBuff;
+
+        try{
+            theMutator->mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+            modBuff = modEntry->getBufferPointer(testCaseKey);
+        } 
+        catch (BaseException e)
+        {
+            FAIL() << "Exception thrown: " << e.getReason();
+        }
+
+        size_t modBuff_len = modEntry->getBufferSize(testCaseKey);
+        std::string modString = std::string(modBuff);
+
+        // test buff len
+        EXPECT_EQ(modBuff_len, modString.length() + 1);
+        EXPECT_TRUE(
+            modString == "GHI\nGHI\nJK\nL\n" ||
+            modString == "GHI\nJK\nGHI\nL\n" ||
+            modString == "GHI\nJK\nL\nGHI\n" ||
+            modString == "JK\nGHI\nJK\nL\n" ||
+            modString == "GHI\nJK\nJK\nL\n" ||
+            modString == "GHI\nJK\nL\nJK\n" ||
+            modString == "L\nGHI\nJK\nL\n" ||
+            modString == "GHI\nL\nJK\nL\n" ||
+            modString == "GHI\nJK\nL\nL\n"
+        ) << "modString = \"" + modString + "\"";
+    }
+}
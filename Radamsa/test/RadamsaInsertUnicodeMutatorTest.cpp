@@ -32,6 +32,9 @@
 #include "SimpleStorage.hpp"
 #include "RadamsaInsertUnicodeMutator.hpp"
 #include "RuntimeException.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
 
 using vmf::StorageModule;
 using vmf::StorageRegistry;
@@ -173,4 +176,40 @@ TEST_F(RadamsaInsertUnicodeMutatorTest, TwoBytes)
         EXPECT_EQ(modBuff[modBuff_len - 2], buff[buff_len - 1]);
         EXPECT_EQ(modBuff[modBuff_len - 3], buff[buff_len - 2]);
     }
-}
\ No newline at end of file
+}
+
+TEST_F(RadamsaInsertUnicodeMutatorTest, CodePointBoundariesOnly)
+{
+    // Two-, three- and four-byte code points; no insertion may split one of them
+    const std::string buffString = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80z";
+    const std::vector<size_t> boundaries{0, 1, 3, 6, 10};
+
+    theMutator->SetCodePointBoundariesOnly(true);
+    ASSERT_TRUE(theMutator->GetCodePointBoundariesOnly());
+
+    StorageEntry* baseEntry = storage->createNewEntry();
+    char* buff = baseEntry->allocateBuffer(testCaseKey, buffString.length());
+    std::copy(buffString.begin(), buffString.end(), buff);
+
+    for(int i = 0; i < 200; ++i) {
+        StorageEntry* modEntry = storage->createNewEntry();
+        try{
+            theMutator->mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+        }
+        catch (BaseException e)
+        {
+            FAIL() << "Exception thrown: " << e.getReason();
+        }
+
+        const std::string output(modEntry->getBufferPointer(testCaseKey), modEntry->getBufferSize(testCaseKey) - 1);
+        ASSERT_GT(output.size(), buffString.size());
+        const size_t inserted = output.size() - buffString.size();
+
+        bool atBoundary = false;
+        for(size_t boundary : boundaries) {
+            atBoundary |= output.compare(0, boundary, buffString, 0, boundary) == 0 &&
+                          output.compare(boundary + inserted, std::string::npos, buffString, boundary) == 0;
+        }
+        EXPECT_TRUE(atBoundary) << i;
+    }
+}
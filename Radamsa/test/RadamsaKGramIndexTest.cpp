@@ -0,0 +1,194 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+
+#include "gtest/gtest.h"
+#include "SimpleStorage.hpp"
+#include "RadamsaKGramIndex.hpp"
+#include "VmfRand.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using vmf::StorageModule;
+using vmf::StorageRegistry;
+using vmf::SimpleStorage;
+using vmf::StorageEntry;
+using vmf::RadamsaKGramIndex;
+using vmf::VmfRand;
+
+class RadamsaKGramIndexTest : public ::testing::Test {
+  protected:
+    RadamsaKGramIndexTest()
+    {
+      storage = new SimpleStorage("storage");
+      registry = new StorageRegistry("TEST_INT", StorageRegistry::INT, StorageRegistry::ASCENDING);
+      metadata = new StorageRegistry();
+    }
+
+    ~RadamsaKGramIndexTest() override {}
+
+    void SetUp() override {
+      testCaseKey = registry->registerKey(
+          "TEST_CASE",
+          StorageRegistry::BUFFER,
+          StorageRegistry::READ_WRITE
+      );
+      storage->configure(registry, metadata);
+    }
+
+    void TearDown() override {
+      delete registry;
+      delete metadata;
+      delete storage;
+    }
+
+    static std::string makeText(size_t size, unsigned int seed) {
+      std::mt19937 gen(seed);
+      std::uniform_int_distribution<int> dist(0, 255);
+      std::string text(size, '\0');
+      for(size_t i{0}; i < size; ++i) {
+        text[i] = static_cast<char>(dist(gen));
+      }
+      return text;
+    }
+
+    StorageEntry* saveEntry(const std::string& contents) {
+      StorageEntry* entry = storage->createNewEntry();
+      char* buff = entry->allocateBuffer(testCaseKey, contents.size());
+      std::copy(contents.begin(), contents.end(), buff);
+      storage->saveEntry(entry);
+      return entry;
+    }
+
+    RadamsaKGramIndex index;
+    VmfRand* rand = VmfRand::getInstance();
+    StorageModule* storage;
+    StorageRegistry* registry;
+    StorageRegistry* metadata;
+    int testCaseKey;
+};
+
+TEST_F(RadamsaKGramIndexTest, FindsSharedContext)
+{
+    const std::string shared = makeText(256, 1);
+    const std::string partner = makeText(1000, 2) + shared + makeText(1000, 3);
+    const std::string base = makeText(500, 4) + shared + makeText(500, 5);
+
+    index.AddEntry(7, partner.data(), partner.size());
+    index.AddEntry(8, makeText(2000, 6).data(), 2000);
+    EXPECT_EQ(index.GetIndexedEntryCount(), 2u);
+
+    for(int run{0}; run < 20; ++run) {
+      const auto match = index.FindMatch(base.data(), base.size(), 0, rand);
+      ASSERT_TRUE(match.has_value());
+      EXPECT_EQ(match->EntryId, 7u);
+      EXPECT_EQ(base.compare(match->BaseOffset, RadamsaKGramIndex::GramLength, partner, match->PartnerOffset, RadamsaKGramIndex::GramLength), 0);
+    }
+
+    // An entry never matches itself
+    EXPECT_FALSE(index.FindMatch(base.data(), base.size(), 7, rand).has_value());
+    EXPECT_FALSE(index.FindMatch(base.data(), RadamsaKGramIndex::GramLength - 1, 0, rand).has_value());
+}
+
+TEST_F(RadamsaKGramIndexTest, RemoveEntry)
+{
+    const std::string first = makeText(4000, 10);
+    const std::string second = makeText(4000, 11);
+
+    index.AddEntry(1, first.data(), first.size());
+    const size_t bytesForFirst = index.GetBytesHeld();
+    index.AddEntry(2, second.data(), second.size());
+    EXPECT_GT(index.GetGramCount(), 0u);
+
+    index.RemoveEntry(2);
+    EXPECT_EQ(index.GetBytesHeld(), bytesForFirst);
+    EXPECT_EQ(index.GetIndexedEntryCount(), 1u);
+    EXPECT_FALSE(index.FindMatch(second.data(), second.size(), 0, rand).has_value());
+    EXPECT_TRUE(index.FindMatch(first.data(), first.size(), 0, rand).has_value());
+
+    index.RemoveEntry(1);
+    EXPECT_EQ(index.GetBytesHeld(), 0u);
+    EXPECT_EQ(index.GetGramCount(), 0u);
+    EXPECT_FALSE(index.GetRandomEntry(0, rand).has_value());
+}
+
+TEST_F(RadamsaKGramIndexTest, FollowsSavedEntries)
+{
+    StorageEntry* first = saveEntry(makeText(1000, 20));
+    StorageEntry* second = saveEntry(makeText(1000, 21));
+    storage->createNewEntry();  // never saved, so never indexed
+
+    index.Update(*storage, testCaseKey);
+    EXPECT_EQ(index.GetIndexedEntryCount(), 2u);
+
+    StorageEntry* third = saveEntry(makeText(1000, 22));
+    const std::string firstContents(first->getBufferPointer(testCaseKey), 1000);
+    storage->removeEntry(first);
+
+    // Saving one entry and removing another keeps the count, so storage is not walked again within the loop
+    index.Update(*storage, testCaseKey);
+    EXPECT_TRUE(index.FindMatch(firstContents.data(), firstContents.size(), second->getID(), rand).has_value());
+
+    // The next fuzzing loop starts with a fresh set of new entries
+    storage->clearNewAndLocalEntries();
+    storage->createNewEntry();
+    index.Update(*storage, testCaseKey);
+    EXPECT_EQ(index.GetIndexedEntryCount(), 2u);
+
+    const std::string thirdContents(third->getBufferPointer(testCaseKey), 1000);
+    const auto match = index.FindMatch(thirdContents.data(), thirdContents.size(), second->getID(), rand);
+    ASSERT_TRUE(match.has_value());
+    EXPECT_EQ(match->EntryId, third->getID());
+
+    EXPECT_FALSE(index.FindMatch(firstContents.data(), firstContents.size(), third->getID(), rand).has_value());
+}
+
+TEST_F(RadamsaKGramIndexTest, ByteBudget)
+{
+    index.AddEntry(1000, makeText(4000, 30).data(), 4000);
+    const size_t bytesPerEntry = index.GetBytesHeld();
+
+    index.SetByteBudget(bytesPerEntry * 3);
+    for(unsigned int seed{31}; seed < 40; ++seed) {
+      saveEntry(makeText(4000, seed));
+    }
+    index.Update(*storage, testCaseKey);
+    EXPECT_LE(index.GetBytesHeld(), bytesPerEntry * 3 + 1024);
+    EXPECT_LT(index.GetIndexedEntryCount(), 4u);
+
+    // Dropped entries stay known, so another update does not index them again
+    const size_t held = index.GetBytesHeld();
+    storage->clearNewAndLocalEntries();
+    index.Update(*storage, testCaseKey);
+    EXPECT_EQ(index.GetBytesHeld(), held);
+
+    // The newest entries are the ones kept
+    const std::string newest = makeText(4000, 39);
+    EXPECT_TRUE(index.FindMatch(newest.data(), newest.size(), 0, rand).has_value());
+}
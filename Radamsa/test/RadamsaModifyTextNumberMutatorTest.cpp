@@ -32,6 +32,9 @@
 #include "SimpleStorage.hpp"
 #include "RadamsaModifyTextNumberMutator.hpp"
 #include "RuntimeException.hpp"
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 using vmf::StorageModule;
 using vmf::StorageRegistry;
@@ -227,4 +230,94 @@ TEST_F(RadamsaModifyTextNumberMutatorTest, TwoMultiDigitNumbers)
         modString.substr(4, 2) != buffString.substr(4, 2)
     ) << "modString: " + modString + ", buffString: " + buffString;
     EXPECT_GE(modBuff_len, buff_len + 1);
-}
\ No newline at end of file
+}
+TEST_F(RadamsaModifyTextNumberMutatorTest, ExtractsNumberForms)
+{
+    using NumInfo = RadamsaModifyTextNumberMutator::NumInfo;
+
+    const std::string buffString = "a=-12,b=0x1F,c=3.25,d=18446744073709551615,e=18446744073709551616,f=2024-01-02,g=0Xab";
+    const std::vector<NumInfo> nums = theMutator->extractTextualNumbers(buffString.data(), buffString.size());
+
+    // 18446744073709551616 does not fit 64 bits and is skipped
+    ASSERT_EQ(nums.size(), 8u);
+
+    EXPECT_TRUE(nums[0].negative);
+    EXPECT_EQ(nums[0].value, 12u);
+    EXPECT_EQ(buffString.substr(nums[0].offset, nums[0].length), "-12");
+
+    EXPECT_EQ(nums[1].format, NumInfo::Format::Hex);
+    EXPECT_EQ(nums[1].value, 0x1Fu);
+    EXPECT_TRUE(nums[1].upperCase);
+    EXPECT_EQ(buffString.substr(nums[1].offset, nums[1].length), "0x1F");
+
+    EXPECT_EQ(nums[2].format, NumInfo::Format::Fraction);
+    EXPECT_EQ(nums[2].value, 3u);
+    EXPECT_EQ(buffString.substr(nums[2].offset, nums[2].length), "3.25");
+    EXPECT_EQ(nums[2].integerLength, 1u);
+
+    EXPECT_EQ(nums[3].value, UINT64_MAX);
+
+    // The dashes in a date are not signs
+    EXPECT_EQ(nums[4].value, 2024u);
+    EXPECT_FALSE(nums[5].negative);
+    EXPECT_EQ(nums[5].value, 1u);
+    EXPECT_FALSE(nums[6].negative);
+    EXPECT_EQ(nums[6].value, 2u);
+
+    EXPECT_EQ(buffString.substr(nums[7].offset - 2, nums[7].length + 2), "g=0Xab");
+    EXPECT_FALSE(nums[7].upperCase);
+}
+
+TEST_F(RadamsaModifyTextNumberMutatorTest, InterestingNumbers)
+{
+    static_assert(RadamsaModifyTextNumberMutator::InterestingNumbers[0] == 2u, "built at compile time");
+
+    const auto& table = RadamsaModifyTextNumberMutator::InterestingNumbers;
+    EXPECT_NE(std::find(table.begin(), table.end(), uint64_t{0xFFFFFFFFu}), table.end());
+    EXPECT_NE(std::find(table.begin(), table.end(), uint64_t{1} << 32), table.end());
+    EXPECT_NE(std::find(table.begin(), table.end(), (uint64_t{1} << 63) + 1u), table.end());
+}
+
+TEST_F(RadamsaModifyTextNumberMutatorTest, KeepsNotation)
+{
+    // Each input holds a single number, so whatever the mutation, its notation and surroundings are kept
+    const std::vector<std::pair<std::string, std::string>> cases{
+        {"x=0xff;", "0x"}, {"x=0XAB;", "0X"}, {"x=-7;", ""}, {"x=12.5;", ".5;"}};
+
+    for(const auto& [buffString, kept] : cases) {
+        for(int run{0}; run < 20; ++run) {
+            StorageEntry* baseEntry = storage->createNewEntry();
+            StorageEntry* modEntry = storage->createNewEntry();
+            char* buff = baseEntry->allocateBuffer(testCaseKey, buffString.size());
+            std::copy(buffString.begin(), buffString.end(), buff);
+
+            try{
+                theMutator->mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+            }
+            catch (BaseException e)
+            {
+                FAIL() << "Exception thrown: " << e.getReason();
+            }
+
+            const size_t modBuff_len = modEntry->getBufferSize(testCaseKey);
+            const std::string modString(modEntry->getBufferPointer(testCaseKey), modBuff_len - 1);
+            ASSERT_EQ(modEntry->getBufferPointer(testCaseKey)[modBuff_len - 1], '\0');
+
+            EXPECT_EQ(modString.substr(0, 2), "x=");
+            EXPECT_EQ(modString.back(), ';');
+            const std::string number = modString.substr(2, modString.size() - 3);
+            if (kept == "0x" || kept == "0X") {
+                EXPECT_EQ(number.substr(0, 2), kept) << modString;
+                const bool upper = (kept == "0X");
+                EXPECT_EQ(number.find_first_not_of(upper ? "0123456789ABCDEF" : "0123456789abcdef", 2), std::string::npos) << modString;
+            }
+            else if (kept == ".5;") {
+                EXPECT_EQ(modString.substr(modString.size() - 3), kept) << modString;
+            }
+            else {
+                const size_t digits = (number[0] == '-') ? 1 : 0;
+                EXPECT_EQ(number.find_first_not_of("0123456789", digits), std::string::npos) << modString;
+            }
+        }
+    }
+}
@@ -0,0 +1,257 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+
+
+#include "gtest/gtest.h"
+#include "ModuleTestHelper.hpp"
+#include "SimpleStorage.hpp"
+#include "RadamsaMutatorBase.hpp"
+#include "RadamsaInsertByteMutator.hpp"
+#include "RadamsaInsertUnicodeMutator.hpp"
+#include "RadamsaModifyTextNumberMutator.hpp"
+#include "RadamsaFuseThisMutator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using vmf::StorageRegistry;
+using vmf::ModuleTestHelper;
+using vmf::SimpleStorage;
+using vmf::StorageEntry;
+using vmf::MutatorModule;
+using vmf::RadamsaMutatorBase;
+using vmf::RadamsaInsertByteMutator;
+using vmf::RadamsaInsertUnicodeMutator;
+using vmf::RadamsaModifyTextNumberMutator;
+using vmf::RadamsaFuseThisMutator;
+
+class RadamsaMutatorBaseTest : public ::testing::Test {
+  protected:
+    RadamsaMutatorBaseTest()
+    {
+      storage = new SimpleStorage("storage");
+      registry = new StorageRegistry("TEST_INT", StorageRegistry::INT, StorageRegistry::ASCENDING);
+      metadata = new StorageRegistry();
+    }
+
+    ~RadamsaMutatorBaseTest() override {}
+
+    void SetUp() override {
+      testCaseKey = registry->registerKey(
+          "TEST_CASE",
+          StorageRegistry::BUFFER,
+          StorageRegistry::READ_WRITE
+      );
+      storage->configure(registry, metadata);
+    }
+
+    void TearDown() override {
+      delete registry;
+      delete metadata;
+      delete storage;
+    }
+
+    std::string getOutput(StorageEntry* entry) {
+      // The output without its null terminator, which is checked separately
+      const int size = entry->getBufferSize(testCaseKey);
+      EXPECT_GT(size, 0);
+      if (size <= 0) return std::string();
+
+      const char* buffer = entry->getBufferPointer(testCaseKey);
+      EXPECT_EQ(buffer[size - 1], '\0');
+      return std::string(buffer, size - 1);
+    }
+
+    RadamsaMutatorBase base;
+    SimpleStorage* storage;
+    StorageRegistry* registry;
+    StorageRegistry* metadata;
+    int testCaseKey;
+};
+
+TEST_F(RadamsaMutatorBaseTest, SpliceReplacesRange)
+{
+  const std::string original{"0123456789"};
+
+  StorageEntry* entry = storage->createNewEntry();
+  RadamsaMutatorBase::SpliceIntoNewEntry(entry, testCaseKey, original.data(), original.size(), 3, 4, "abc", 3);
+  EXPECT_EQ(getOutput(entry), "012abc789");
+
+  entry = storage->createNewEntry();
+  RadamsaMutatorBase::SpliceIntoNewEntry(entry, testCaseKey, original.data(), original.size(), 0, 0, "ab", 2);
+  EXPECT_EQ(getOutput(entry), "ab0123456789");
+
+  entry = storage->createNewEntry();
+  RadamsaMutatorBase::SpliceIntoNewEntry(entry, testCaseKey, original.data(), original.size(), 10, 0, "ab", 2);
+  EXPECT_EQ(getOutput(entry), "0123456789ab");
+
+  entry = storage->createNewEntry();
+  RadamsaMutatorBase::SpliceIntoNewEntry(entry, testCaseKey, original.data(), original.size(), 2, 8, nullptr, 0);
+  EXPECT_EQ(getOutput(entry), "01");
+
+  entry = storage->createNewEntry();
+  RadamsaMutatorBase::SpliceIntoNewEntry(entry, testCaseKey, original.data(), original.size(), 0, 10, nullptr, 0);
+  EXPECT_EQ(getOutput(entry), "");
+}
+
+TEST_F(RadamsaMutatorBaseTest, CopyIntoNewEntry)
+{
+  const std::string original{"some\0bytes", 10};
+
+  StorageEntry* entry = storage->createNewEntry();
+  char* newBuffer = RadamsaMutatorBase::CopyIntoNewEntry(entry, testCaseKey, original.data(), original.size());
+
+  EXPECT_EQ(newBuffer, entry->getBufferPointer(testCaseKey));
+  EXPECT_EQ(entry->getBufferSize(testCaseKey), 11);
+  EXPECT_EQ(getOutput(entry), original);
+}
+
+TEST_F(RadamsaMutatorBaseTest, SegmentBuilder)
+{
+  const std::string original{"abcdef"};
+
+  StorageEntry* entry = storage->createNewEntry();
+  RadamsaMutatorBase::SegmentBuilder& output = base.BeginOutput();
+  output
+      .Append(original.data(), 2)
+      .AppendRepeated(original.data() + 2, 2, 3)
+      .AppendFill(2, '-')
+      .Append(original.data() + 4, 0)
+      .AppendRepeated(original.data(), 3, 0)
+      .Append(original.data() + 4, 2)
+      .AppendNullTerminator();
+
+  EXPECT_EQ(output.GetSize(), 13u);
+  EXPECT_EQ(output.GetSegments().size(), 5u);
+
+  output.Write(entry, testCaseKey);
+  EXPECT_EQ(getOutput(entry), "abcdcdcd--ef");
+
+  // The builder is shared between mutations, so beginning a new output forgets the previous one
+  EXPECT_EQ(base.BeginOutput().GetSize(), 0u);
+  EXPECT_TRUE(base.BeginOutput().GetSegments().empty());
+}
+
+TEST_F(RadamsaMutatorBaseTest, DISABLED_MutatorOutputBenchmark)
+{
+    // Times mutators that write their output with a single splice into the new entry, on a 1 MiB text input of
+    // numbers and multi-byte characters, and reports the mean size of what they wrote
+    std::string text;
+    for(unsigned int i{0}; text.size() < (1u << 20); ++i) {
+        text += std::to_string(i * 7919u) + " \xc3\xa9t\xc3\xa9 ";
+    }
+
+    StorageEntry* baseEntry = storage->createNewEntry();
+    memcpy(baseEntry->allocateBuffer(testCaseKey, static_cast<int>(text.size())), text.data(), text.size());
+    storage->saveEntry(baseEntry);
+    storage->clearNewAndLocalEntries();
+
+    ModuleTestHelper testHelper;
+    auto report = [&](MutatorModule& mutator, size_t repetitions) {
+        mutator.init(*testHelper.getConfig());
+        mutator.registerStorageNeeds(*registry);
+        mutator.registerMetadataNeeds(*metadata);
+
+        std::chrono::duration<double, std::nano> elapsed{0};
+        size_t bytesWritten{0u};
+        for(size_t i{0}; i < repetitions; ++i) {
+            StorageEntry* newEntry = storage->createNewEntry();
+            const auto begin = std::chrono::steady_clock::now();
+            mutator.mutateTestCase(*storage, baseEntry, newEntry, testCaseKey);
+            elapsed += std::chrono::steady_clock::now() - begin;
+            bytesWritten += std::max(newEntry->getBufferSize(testCaseKey), 0);
+            storage->clearNewAndLocalEntries();
+        }
+        std::cout << mutator.getModuleName() << ": " << elapsed.count() / repetitions << " ns per mutation, "
+                  << bytesWritten / repetitions << " bytes written on average" << std::endl;
+    };
+
+    RadamsaInsertByteMutator insertByte("RadamsaInsertByteMutator");
+    RadamsaInsertUnicodeMutator insertUnicode("RadamsaInsertUnicodeMutator");
+    RadamsaModifyTextNumberMutator modifyTextNumber("RadamsaModifyTextNumberMutator");
+    RadamsaFuseThisMutator fuseThis("RadamsaFuseThisMutator");
+    report(insertByte, 256u);
+    report(insertUnicode, 256u);
+    report(modifyTextNumber, 256u);
+    // builds a suffix array of the whole input on every call
+    report(fuseThis, 8u);
+
+    // Inserts the same 3-byte sequence into the middle of the input the way RadamsaInsertUnicodeMutator did before
+    // the splice (copy into a vector, insert, zero the new buffer, copy the vector into it) and with
+    // SpliceIntoNewEntry, and reports the bytes each path writes, counted as each step runs
+    const char sequence[]{'\xae', '\x80', '\xe2'};
+    const size_t offset{text.size() / 2u};
+    auto compare = [&](const char* path, auto&& insert) {
+        std::chrono::duration<double, std::nano> elapsed{0};
+        size_t bytesWritten{0u};
+        std::string output;
+        for(size_t i{0}; i < 256u; ++i) {
+            StorageEntry* newEntry = storage->createNewEntry();
+            const auto begin = std::chrono::steady_clock::now();
+            bytesWritten += insert(newEntry);
+            elapsed += std::chrono::steady_clock::now() - begin;
+            output.assign(newEntry->getBufferPointer(testCaseKey), newEntry->getBufferSize(testCaseKey));
+            storage->clearNewAndLocalEntries();
+        }
+        std::cout << path << ": " << elapsed.count() / 256u << " ns per insertion, " << bytesWritten / 256u
+                  << " bytes written per insertion" << std::endl;
+        return output;
+    };
+
+    const std::string vectorOutput{compare("Copy into vector", [&](StorageEntry* newEntry) {
+        size_t written{0u};
+        std::vector<char> data(text.begin(), text.end());
+        written += data.size();
+
+        // the tail moves up, or every byte moves to new storage if the vector has to grow
+        const size_t capacity{data.capacity()};
+        const size_t tail{data.size() - offset};
+        data.insert(data.begin() + offset, std::begin(sequence), std::end(sequence));
+        written += (data.capacity() != capacity) ? data.size() : tail + sizeof(sequence);
+
+        const size_t newBufferSize{data.size() + 1u};
+        char* newBuffer{newEntry->allocateBuffer(testCaseKey, static_cast<int>(newBufferSize))};
+        memset(newBuffer, 0u, newBufferSize);
+        written += newBufferSize;
+        memcpy(newBuffer, data.data(), data.size());
+        written += data.size();
+
+        return written;
+    })};
+    const std::string spliceOutput{compare("SpliceIntoNewEntry", [&](StorageEntry* newEntry) {
+        RadamsaMutatorBase::SpliceIntoNewEntry(newEntry, testCaseKey, text.data(), text.size(), offset, 0u, sequence, sizeof(sequence));
+
+        // the splice writes every byte of the new buffer once, and nothing else
+        return static_cast<size_t>(newEntry->getBufferSize(testCaseKey));
+    })};
+    EXPECT_EQ(vectorOutput, spliceOutput);
+}
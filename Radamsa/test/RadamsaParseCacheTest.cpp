@@ -0,0 +1,238 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+
+
+#include "gtest/gtest.h"
+#include "SimpleStorage.hpp"
+#include "RadamsaParseCache.hpp"
+#include <string>
+#include <vector>
+
+using vmf::StorageModule;
+using vmf::StorageRegistry;
+using vmf::SimpleStorage;
+using vmf::StorageEntry;
+using vmf::RadamsaParseCache;
+
+class RadamsaParseCacheTest : public ::testing::Test {
+  protected:
+    RadamsaParseCacheTest()
+    {
+      storage = new SimpleStorage("storage");
+      registry = new StorageRegistry("TEST_INT", StorageRegistry::INT, StorageRegistry::ASCENDING);
+      metadata = new StorageRegistry();
+      cache = RadamsaParseCache::getInstance();
+    }
+
+    ~RadamsaParseCacheTest() override {}
+
+    void SetUp() override {
+      testCaseKey = registry->registerKey(
+          "TEST_CASE",
+          StorageRegistry::BUFFER,
+          StorageRegistry::READ_WRITE
+      );
+      storage->configure(registry, metadata);
+      // The cache is shared by the whole process, so every test starts from an empty one
+      cache->Clear();
+      cache->SetByteBudget(RadamsaParseCache::DefaultByteBudget);
+    }
+
+    void TearDown() override {
+      cache->Clear();
+      cache->SetByteBudget(RadamsaParseCache::DefaultByteBudget);
+      delete registry;
+      delete metadata;
+      delete storage;
+    }
+
+    StorageEntry* makeEntry(const std::string& contents) {
+      StorageEntry* entry = storage->createNewEntry();
+      char* buff = entry->allocateBuffer(testCaseKey, contents.size());
+      for(size_t i{0}; i < contents.size(); ++i) {
+        buff[i] = contents[i];
+      }
+      return entry;
+    }
+
+    // Caches the buffer's length as the "parsed" structure, counting how often it was parsed
+    std::shared_ptr<const size_t> getLength(StorageEntry* entry, size_t footprint = sizeof(size_t)) {
+      const char* buff = entry->getBufferPointer(testCaseKey);
+      const size_t size = entry->getBufferSize(testCaseKey);
+      return cache->GetOrParse<size_t>(
+          *storage, entry, buff, size,
+          [&]() { ++parses; return size; },
+          [&](const size_t&) { return footprint; });
+    }
+
+    RadamsaParseCache* cache;
+    StorageModule* storage;
+    StorageRegistry* registry;
+    StorageRegistry* metadata;
+    int testCaseKey;
+    int parses{0};
+};
+
+TEST_F(RadamsaParseCacheTest, HitsAndMisses)
+{
+    StorageEntry* entry = makeEntry("abcdef");
+
+    EXPECT_EQ(*getLength(entry), 6u);
+    EXPECT_EQ(*getLength(entry), 6u);
+    EXPECT_EQ(*getLength(entry), 6u);
+
+    EXPECT_EQ(parses, 1);
+    EXPECT_EQ(cache->GetStats().Misses, 1u);
+    EXPECT_EQ(cache->GetStats().Hits, 2u);
+    EXPECT_EQ(cache->GetStats().ItemsHeld, 1u);
+    EXPECT_NEAR(cache->GetStats().GetHitRate(), 2.0 / 3.0, 1e-9);
+}
+
+TEST_F(RadamsaParseCacheTest, KindsAreSeparate)
+{
+    StorageEntry* entry = makeEntry("abcdef");
+    const char* buff = entry->getBufferPointer(testCaseKey);
+    const size_t size = entry->getBufferSize(testCaseKey);
+
+    getLength(entry);
+    // Same structure type but a different variant, e.g. a line index built for another delimiter
+    std::shared_ptr<const size_t> other = cache->GetOrParse<size_t, int>(
+        *storage, entry, buff, size,
+        [&]() { ++parses; return size_t{42u}; },
+        [](const size_t&) { return sizeof(size_t); });
+
+    EXPECT_EQ(*other, 42u);
+    EXPECT_EQ(*getLength(entry), 6u);
+    EXPECT_EQ(parses, 2);
+    EXPECT_EQ(cache->GetStats().ItemsHeld, 2u);
+}
+
+TEST_F(RadamsaParseCacheTest, ReallocatedBufferReparses)
+{
+    StorageEntry* entry = makeEntry("abcdef");
+
+    getLength(entry);
+    entry->allocateBuffer(testCaseKey, 9);
+    EXPECT_EQ(*getLength(entry), 9u);
+
+    // A cached structure is validated by the buffer's address and size, not its bytes
+    const std::string copy(entry->getBufferPointer(testCaseKey), 9);
+    const size_t size = 9;
+    cache->GetOrParse<size_t>(
+        *storage, entry, copy.data(), size,
+        [&]() { ++parses; return size; },
+        [](const size_t&) { return sizeof(size_t); });
+
+    EXPECT_EQ(parses, 3);
+    EXPECT_EQ(cache->GetStats().Misses, 3u);
+    EXPECT_EQ(cache->GetStats().ItemsHeld, 1u);
+}
+
+TEST_F(RadamsaParseCacheTest, ByteBudgetEvictsLeastRecentlyUsed)
+{
+    StorageEntry* first = makeEntry("first");
+    StorageEntry* second = makeEntry("second");
+    StorageEntry* third = makeEntry("third");
+
+    cache->SetByteBudget(250u);
+    getLength(first, 100u);
+    getLength(second, 100u);
+    getLength(first, 100u);     // first is now the most recently used
+    getLength(third, 100u);     // over budget, evicts second
+
+    EXPECT_EQ(cache->GetStats().BytesHeld, 200u);
+    EXPECT_EQ(cache->GetStats().Evictions, 1u);
+
+    parses = 0;
+    getLength(first, 100u);
+    EXPECT_EQ(parses, 0);
+    getLength(second, 100u);
+    EXPECT_EQ(parses, 1);
+
+    // Larger than the whole budget: returned but never held
+    StorageEntry* huge = makeEntry("huge");
+    EXPECT_EQ(*getLength(huge, 1000u), 4u);
+    EXPECT_LE(cache->GetStats().BytesHeld, 250u);
+}
+
+TEST_F(RadamsaParseCacheTest, EvictAndReconcile)
+{
+    StorageEntry* kept = makeEntry("kept");
+    StorageEntry* dropped = makeEntry("dropped");
+    StorageEntry* evicted = makeEntry("evicted");
+
+    getLength(kept);
+    getLength(dropped);
+    getLength(evicted);
+    EXPECT_EQ(cache->GetStats().ItemsHeld, 3u);
+
+    cache->Evict(evicted->getID());
+    EXPECT_EQ(cache->GetStats().ItemsHeld, 2u);
+
+    // Only entries still saved in storage survive reconciliation
+    storage->saveEntry(kept);
+    cache->Reconcile(*storage);
+    EXPECT_EQ(cache->GetStats().ItemsHeld, 1u);
+
+    parses = 0;
+    getLength(kept);
+    EXPECT_EQ(parses, 0);
+    getLength(dropped);
+    EXPECT_EQ(parses, 1);
+}
+
+TEST_F(RadamsaParseCacheTest, PublishesStats)
+{
+    StorageEntry* entry = makeEntry("abcdef");
+
+    cache->RegisterStatsKeys(*metadata);
+    const int hitRateKey = metadata->registerKey("RADAMSA_PARSE_CACHE_HIT_RATE", StorageRegistry::FLOAT, StorageRegistry::READ_ONLY);
+    const int bytesKey = metadata->registerKey("RADAMSA_PARSE_CACHE_BYTES", StorageRegistry::UINT, StorageRegistry::READ_ONLY);
+
+    // Lookups do not publish the statistics; the input generator does, once per fuzzing loop
+    getLength(entry, 64u);
+    getLength(entry, 64u);
+    EXPECT_FLOAT_EQ(storage->getMetadata().getFloatValue(hitRateKey), 0.0f);
+    EXPECT_EQ(storage->getMetadata().getUIntValue(bytesKey), 0u);
+
+    cache->PublishStats(*storage);
+    EXPECT_FLOAT_EQ(storage->getMetadata().getFloatValue(hitRateKey), 0.5f);
+    EXPECT_EQ(storage->getMetadata().getUIntValue(bytesKey), 64u);
+
+    // For other input generators, lookups also publish them each time they reconcile the cache,
+    // before the lookup itself is counted
+    const size_t interval = RadamsaParseCache::ReconcileInterval;
+    for (size_t i = 2; i < interval - 1u; ++i)
+      getLength(entry, 64u);
+    EXPECT_FLOAT_EQ(storage->getMetadata().getFloatValue(hitRateKey), 0.5f);
+    getLength(entry, 64u);
+    EXPECT_FLOAT_EQ(storage->getMetadata().getFloatValue(hitRateKey), static_cast<float>(interval - 2u) / (interval - 1u));
+    // The entry was never saved, so reconciling dropped its item first
+    EXPECT_EQ(storage->getMetadata().getUIntValue(bytesKey), 0u);
+}
@@ -228,7 +228,7 @@ TEST_F(RadamsaRepeatByteSequenceMutatorTest, ThreeBytes)
     EXPECT_TRUE(modBuff_len % 2 == 0 || modBuff_len % 3 == 1);
     // test buff contents
     EXPECT_TRUE(
-        (occ[0] > 1  && occ[1] > 1 && occ[2] == 1 && occ[1] == occ[2]) ||    // 45 repeated
+        (occ[0] > 1  && occ[1] > 1 && occ[2] == 1 && occ[0] == occ[1]) ||    // 45 repeated
         (occ[0] == 1 && occ[1] > 1 && occ[2] > 1  && occ[1] == occ[2]) ||    // 56 repeated
         (occ[0] > 1  && occ[1] > 1 && occ[2] > 1  && occ[0] == occ[1] && occ[1] == occ[2])  // 456 repeated
     );
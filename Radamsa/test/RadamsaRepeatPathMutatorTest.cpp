@@ -33,6 +33,7 @@
 #include "RadamsaRepeatPathMutator.hpp"
 #include "RuntimeException.hpp"
 #include "RadamsaTreeMutatorBase.hpp"
+#include <algorithm>
 
 using vmf::StorageModule;
 using vmf::StorageRegistry;
@@ -286,11 +287,11 @@ TEST_F(RadamsaRepeatPathMutatorTest, TwoChildren_OneGrandchild)
     );
     EXPECT_EQ((modBuff_len - 1 - buff_len) % 3, 0); // 3 is the number of additional characters per repitition
     EXPECT_TRUE(
-        (       // g replaced h
+        (       // g replaced h, each copy of g keeping its j
             charFreqMap['g'] > 1 &&  
             charFreqMap['h'] == 1 &&
             charFreqMap['i'] == 1 &&
-            charFreqMap['j'] == 1
+            charFreqMap['j'] > 1
         ) || (  // h replaced i
             charFreqMap['g'] == 1 &&  
             charFreqMap['h'] > 1 &&
@@ -303,4 +304,133 @@ TEST_F(RadamsaRepeatPathMutatorTest, TwoChildren_OneGrandchild)
             charFreqMap['j'] == 1
         )
     ) << "modString: " + modString;
-}
\ No newline at end of file
+}
+TEST_F(RadamsaRepeatPathMutatorTest, MaxOutputSize)
+{
+    // Every repetition adds at least three bytes here, so the ceiling allows at most two
+    std::string buffString = "g(h)(i)";
+    const size_t maxOutputSize = buffString.length() + 6;
+    config->setIntParam("RadamsaRepeatPathMutator", "maxOutputSize", static_cast<int>(maxOutputSize));
+    theMutator->init(*config);
+
+    StorageEntry* baseEntry = storage->createNewEntry();
+    const size_t buff_len = buffString.length();
+    char* buff = baseEntry->allocateBuffer(testCaseKey, buff_len);
+    for(size_t i{0}; i < buff_len; ++i) {
+        buff[i] = buffString[i];
+    }
+
+    for(int run{0}; run < 20; ++run) {
+        StorageEntry* modEntry = storage->createNewEntry();
+
+        try{
+            theMutator->mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+        }
+        catch (BaseException e)
+        {
+            FAIL() << "Exception thrown: " << e.getReason();
+        }
+
+        const size_t modBuff_len = modEntry->getBufferSize(testCaseKey);
+        std::string modString = std::string(modEntry->getBufferPointer(testCaseKey));
+        EXPECT_LE(modBuff_len, maxOutputSize + 1) << "modString: " + modString;
+        EXPECT_EQ(modString.length() + 1, modBuff_len);
+    }
+
+    try{
+        theMutator->SetMaxOutputSize(0);
+        ADD_FAILURE() << "No exception thrown";
+    }
+    catch (RuntimeException e)
+    {
+        EXPECT_EQ(e.getErrorCode(), e.CONFIGURATION_ERROR);
+    }
+}
+
+TEST_F(RadamsaRepeatPathMutatorTest, BracketedSyntax)
+{
+    config->setStringParam("RadamsaRepeatPathMutator", "syntax", "bracketed");
+    theMutator->init(*config);
+
+    std::string buffString = "int f(int x) { return g(x[0]); }";
+    StorageEntry* baseEntry = storage->createNewEntry();
+    const size_t buff_len = buffString.length();
+    char* buff = baseEntry->allocateBuffer(testCaseKey, buff_len);
+    for(size_t i{0}; i < buff_len; ++i) {
+        buff[i] = buffString[i];
+    }
+
+    for(int run{0}; run < 20; ++run) {
+        StorageEntry* modEntry = storage->createNewEntry();
+
+        try{
+            theMutator->mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+        }
+        catch (BaseException e)
+        {
+            FAIL() << "Exception thrown: " << e.getReason();
+        }
+
+        // every repetition nests another copy of a bracket group, so brackets stay balanced
+        std::string modString = std::string(modEntry->getBufferPointer(testCaseKey));
+        EXPECT_GT(modString.length(), buff_len);
+        EXPECT_EQ(std::count(modString.begin(), modString.end(), '('), std::count(modString.begin(), modString.end(), ')'));
+        EXPECT_EQ(std::count(modString.begin(), modString.end(), '{'), std::count(modString.begin(), modString.end(), '}'));
+        EXPECT_EQ(std::count(modString.begin(), modString.end(), '['), std::count(modString.begin(), modString.end(), ']'));
+    }
+}
+
+TEST_F(RadamsaRepeatPathMutatorTest, BracketedSingleChild)
+{
+    config->setStringParam("RadamsaRepeatPathMutator", "syntax", "bracketed");
+    theMutator->init(*config);
+
+    // The root is the only parent here and has no text of its own, so there is nothing to repeat
+    std::string buffString = "abcd";
+    StorageEntry* baseEntry = storage->createNewEntry();
+    const size_t buff_len = buffString.length();
+    char* buff = baseEntry->allocateBuffer(testCaseKey, buff_len);
+    for(size_t i{0}; i < buff_len; ++i) {
+        buff[i] = buffString[i];
+    }
+
+    for(int run{0}; run < 20; ++run) {
+        StorageEntry* modEntry = storage->createNewEntry();
+
+        try{
+            theMutator->mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+        }
+        catch (BaseException e)
+        {
+            FAIL() << "Exception thrown: " << e.getReason();
+        }
+
+        ASSERT_EQ(modEntry->getBufferSize(testCaseKey), static_cast<int>(buff_len));
+        EXPECT_EQ(buffString, std::string(modEntry->getBufferPointer(testCaseKey), buff_len));
+    }
+
+    // A single bracket group under the root is still repeated
+    buffString = "(abcd)";
+    baseEntry = storage->createNewEntry();
+    buff = baseEntry->allocateBuffer(testCaseKey, buffString.length());
+    for(size_t i{0}; i < buffString.length(); ++i) {
+        buff[i] = buffString[i];
+    }
+
+    for(int run{0}; run < 20; ++run) {
+        StorageEntry* modEntry = storage->createNewEntry();
+
+        try{
+            theMutator->mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+        }
+        catch (BaseException e)
+        {
+            FAIL() << "Exception thrown: " << e.getReason();
+        }
+
+        std::string modString = std::string(modEntry->getBufferPointer(testCaseKey));
+        EXPECT_GT(modString.length(), buffString.length());
+        EXPECT_NE(modString.find("((abcd))"), std::string::npos) << "modString: " + modString;
+        EXPECT_EQ(std::count(modString.begin(), modString.end(), '('), std::count(modString.begin(), modString.end(), ')'));
+    }
+}
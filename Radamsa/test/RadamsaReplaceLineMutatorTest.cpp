@@ -236,4 +236,47 @@ TEST_F(RadamsaReplaceLineMutatorTest, ThreeLines)
         modString == "GHI\nL\nJK\n" ||  // 132
         modString == "L\nGHI\nJK\n"     // 312
     ) << "modString = \"" + modString + "\"";
-}
\ No newline at end of file
+}
+
+TEST_F(RadamsaReplaceLineMutatorTest, StreamingThreeLines)
+{
+    // A threshold of one byte puts every input through the streaming mode
+    config->setIntParam("RadamsaReplaceLineMutator", "streamingThreshold", 1);
+    theMutator->init(*config);
+
+    std::string buffString = "GHI\nJK\nL\n";
+    const size_t buff_len = buffString.length();
+    StorageEntry* baseEntry = storage->createNewEntry();
+    char* buff = baseEntry->allocateBuffer(testCaseKey, buff_len);
+    for(size_t i{0}; i < buff_len; ++i) {
+        buff[i] = buffString[i];
+    }
+
+    for(int run{0}; run < 20; ++run) {
+        StorageEntry* modEntry = storage->createNewEntry();
+        char* modBuff;
+
+        try{
+            theMutator->mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+            modBuff = modEntry->getBufferPointer(testCaseKey);
+        } 
+        catch (BaseException e)
+        {
+            FAIL() << "Exception thrown: " << e.getReason();
+        }
+
+        size_t modBuff_len = modEntry->getBufferSize(testCaseKey);
+        std::string modString = std::string(modBuff);
+
+        // test buff len
+        EXPECT_GT(modBuff_len, buff_len + 1);
+        // test buff contents
+        EXPECT_TRUE(
+            modString == "GHI\nJK\nL\n" ||
+            modString == "JK\nGHI\nL\n" ||
+            modString == "JK\nL\nGHI\n" ||
+            modString == "GHI\nL\nJK\n" ||
+            modString == "L\nGHI\nJK\n"
+        ) << "modString = \"" + modString + "\"";
+    }
+}
@@ -0,0 +1,155 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+
+
+#include "gtest/gtest.h"
+#include "RadamsaSuffixArray.hpp"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using vmf::RadamsaSuffixArray;
+
+class RadamsaSuffixArrayTest : public ::testing::Test {
+  protected:
+    RadamsaSuffixArrayTest() = default;
+    ~RadamsaSuffixArrayTest() = default;
+
+    static std::string makeText(size_t size, int alphabet, unsigned int seed) {
+      std::mt19937 gen(seed);
+      std::uniform_int_distribution<int> dist(0, alphabet - 1);
+      std::string text(size, '\0');
+      for(size_t i{0}; i < size; ++i) {
+        text[i] = static_cast<char>('a' + dist(gen));
+      }
+      return text;
+    }
+
+    // Joins the texts with a separator that sorts after every byte, which is what Build is expected to do
+    static std::vector<int> joinSymbols(const std::string& first, const std::string* second) {
+      std::vector<int> symbols;
+      for(char c : first) symbols.push_back(static_cast<unsigned char>(c));
+      if (second != nullptr) {
+        symbols.push_back(256);
+        for(char c : *second) symbols.push_back(static_cast<unsigned char>(c));
+      }
+      return symbols;
+    }
+
+    static void checkAgainstNaive(const std::string& first, const std::string* second) {
+      RadamsaSuffixArray sa;
+      if (second != nullptr) sa.Build(first.data(), first.size(), second->data(), second->size());
+      else sa.Build(first.data(), first.size(), nullptr, 0);
+
+      const std::vector<int> symbols = joinSymbols(first, second);
+      std::vector<size_t> expected(symbols.size());
+      for(size_t i{0}; i < expected.size(); ++i) expected[i] = i;
+      std::sort(expected.begin(), expected.end(), [&](size_t x, size_t y) {
+        return std::lexicographical_compare(symbols.begin() + x, symbols.end(), symbols.begin() + y, symbols.end());
+      });
+
+      ASSERT_EQ(sa.GetSize(), expected.size());
+      for(size_t i{0}; i < expected.size(); ++i) {
+        ASSERT_EQ(sa.GetSuffix(i), expected[i]) << "rank " << i;
+
+        size_t common{0};
+        if (i > 0) {
+          const size_t x = expected[i - 1];
+          const size_t y = expected[i];
+          while(x + common < symbols.size() && y + common < symbols.size() &&
+                symbols[x + common] == symbols[y + common] && symbols[x + common] != 256)
+            ++common;
+        }
+        ASSERT_EQ(sa.GetLcp(i), common) << "rank " << i;
+      }
+    }
+};
+
+TEST_F(RadamsaSuffixArrayTest, Empty)
+{
+    RadamsaSuffixArray sa;
+    sa.Build(nullptr, 0, nullptr, 0);
+    EXPECT_EQ(sa.GetSize(), 0u);
+
+    const std::string empty;
+    checkAgainstNaive(empty, &empty);
+}
+
+TEST_F(RadamsaSuffixArrayTest, Banana)
+{
+    RadamsaSuffixArray sa;
+    const std::string text = "banana";
+    sa.Build(text.data(), text.size(), nullptr, 0);
+
+    const std::vector<uint32_t> suffixes{5, 3, 1, 0, 4, 2};
+    const std::vector<uint32_t> lcp{0, 1, 3, 0, 0, 2};
+    ASSERT_EQ(sa.GetSize(), text.size());
+    for(size_t i{0}; i < text.size(); ++i) {
+        EXPECT_EQ(sa.GetSuffix(i), suffixes[i]);
+        EXPECT_EQ(sa.GetLcp(i), lcp[i]);
+    }
+}
+
+TEST_F(RadamsaSuffixArrayTest, MatchesNaiveSingle)
+{
+    for(unsigned int seed{0}; seed < 50; ++seed) {
+      const std::string text = makeText(1 + seed * 7, (seed % 3 == 0) ? 2 : 26, seed);
+      checkAgainstNaive(text, nullptr);
+    }
+    checkAgainstNaive(std::string(300, 'a'), nullptr);
+    checkAgainstNaive(std::string("\xff\x00\x80\x7f\xff", 5), nullptr);
+}
+
+TEST_F(RadamsaSuffixArrayTest, MatchesNaiveJoined)
+{
+    for(unsigned int seed{0}; seed < 50; ++seed) {
+      const std::string first = makeText(seed * 5, (seed % 2 == 0) ? 2 : 4, seed);
+      const std::string second = makeText(seed * 3 + 1, (seed % 2 == 0) ? 2 : 4, seed + 1000);
+      checkAgainstNaive(first, &second);
+    }
+
+    // A common prefix must stop at the separator rather than run on into the second text
+    const std::string repeated(40, 'a');
+    checkAgainstNaive(repeated, &repeated);
+}
+
+TEST_F(RadamsaSuffixArrayTest, ReusedBetweenBuilds)
+{
+    RadamsaSuffixArray sa;
+    const std::string large = makeText(5000, 3, 7);
+    sa.Build(large.data(), large.size(), nullptr, 0);
+    EXPECT_EQ(sa.GetSize(), large.size());
+
+    const std::string text = "banana";
+    sa.Build(text.data(), text.size(), nullptr, 0);
+    ASSERT_EQ(sa.GetSize(), text.size());
+    EXPECT_EQ(sa.GetSuffix(0), 5u);
+    EXPECT_EQ(sa.GetLcp(2), 3u);
+}
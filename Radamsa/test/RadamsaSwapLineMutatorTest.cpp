@@ -40,6 +40,8 @@ using vmf::TestConfigInterface;
 using vmf::SimpleStorage;
 using vmf::StorageEntry;
 using vmf::RadamsaSwapLineMutator;
+using vmf::RadamsaSwapCrLfRecordMutator;
+using vmf::RadamsaSwapSemicolonRecordMutator;
 using vmf::BaseException;
 using vmf::RuntimeException;
 
@@ -237,3 +239,107 @@ TEST_F(RadamsaSwapLineMutatorTest, ThreeLines)
                );
 }
 
+TEST_F(RadamsaSwapLineMutatorTest, StreamingThreeLines)
+{
+    // A threshold of one byte puts every input through the streaming mode
+    config->setIntParam("RadamsaSwapLineMutator", "streamingThreshold", 1);
+    theMutator->init(*config);
+
+    std::string buffString = "4\n5\n6\n";
+    const size_t buff_len = buffString.length();
+    StorageEntry* baseEntry = storage->createNewEntry();
+    char* buff = baseEntry->allocateBuffer(testCaseKey, buff_len);
+    for(size_t i{0}; i < buff_len; ++i) {
+        buff[i] = buffString[i];
+    }
+
+    for(int run{0}; run < 20; ++run) {
+        StorageEntry* modEntry = storage->createNewEntry();
+        char* modBuff;
+
+        try{
+            theMutator->mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+            modBuff = modEntry->getBufferPointer(testCaseKey);
+        } 
+        catch (BaseException e)
+        {
+            FAIL() << "Exception thrown: " << e.getReason();
+        }
+
+        // test buff len
+        EXPECT_EQ(modEntry->getBufferSize(testCaseKey), buff_len + 1);
+        // test buff contents
+        std::string modString = std::string(modBuff);
+        EXPECT_TRUE(modString == "4\n5\n6\n" ||
+                    modString == "5\n4\n6\n" ||
+                    modString == "4\n6\n5\n") << "modString = \"" + modString + "\"";
+    }
+}
+
+TEST_F(RadamsaSwapLineMutatorTest, CrLfRecords)
+{
+    RadamsaSwapCrLfRecordMutator crLfMutator("RadamsaSwapCrLfRecordMutator");
+    crLfMutator.init(*config);
+
+    // Bare '\n' bytes are not record boundaries for the CRLF policy
+    std::string buffString = "a\nb\r\nc\r\n";
+    const size_t buff_len = buffString.length();
+    StorageEntry* baseEntry = storage->createNewEntry();
+    char* buff = baseEntry->allocateBuffer(testCaseKey, buff_len);
+    for(size_t i{0}; i < buff_len; ++i) {
+        buff[i] = buffString[i];
+    }
+
+    for(int run{0}; run < 20; ++run) {
+        StorageEntry* modEntry = storage->createNewEntry();
+        char* modBuff;
+
+        try{
+            crLfMutator.mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+            modBuff = modEntry->getBufferPointer(testCaseKey);
+        }
+        catch (BaseException e)
+        {
+            FAIL() << "Exception thrown: " << e.getReason();
+        }
+
+        EXPECT_EQ(modEntry->getBufferSize(testCaseKey), buff_len + 1);
+        std::string modString = std::string(modBuff);
+        EXPECT_TRUE(modString == "a\nb\r\nc\r\n" ||
+                    modString == "c\r\na\nb\r\n") << "modString = \"" + modString + "\"";
+    }
+}
+
+TEST_F(RadamsaSwapLineMutatorTest, SemicolonRecords)
+{
+    RadamsaSwapSemicolonRecordMutator semicolonMutator("RadamsaSwapSemicolonRecordMutator");
+    semicolonMutator.init(*config);
+
+    std::string buffString = "4;5;6;";
+    const size_t buff_len = buffString.length();
+    StorageEntry* baseEntry = storage->createNewEntry();
+    char* buff = baseEntry->allocateBuffer(testCaseKey, buff_len);
+    for(size_t i{0}; i < buff_len; ++i) {
+        buff[i] = buffString[i];
+    }
+
+    for(int run{0}; run < 20; ++run) {
+        StorageEntry* modEntry = storage->createNewEntry();
+        char* modBuff;
+
+        try{
+            semicolonMutator.mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+            modBuff = modEntry->getBufferPointer(testCaseKey);
+        }
+        catch (BaseException e)
+        {
+            FAIL() << "Exception thrown: " << e.getReason();
+        }
+
+        EXPECT_EQ(modEntry->getBufferSize(testCaseKey), buff_len + 1);
+        std::string modString = std::string(modBuff);
+        EXPECT_TRUE(modString == "4;5;6;" ||
+                    modString == "5;4;6;" ||
+                    modString == "4;6;5;") << "modString = \"" + modString + "\"";
+    }
+}
@@ -27,6 +27,8 @@
  * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
  * ===========================================================================*/
 
+#include <cstring>
+#include <vector>
 #include "gtest/gtest.h"
 #include "ModuleTestHelper.hpp"
 #include "SimpleStorage.hpp"
@@ -181,4 +183,365 @@ TEST_F(RadamsaTreeMutatorBaseTest, TwoChildren_OneGrandchild)
     }
 
     EXPECT_EQ(treeStr, tr.toString(tr.root));
-}
\ No newline at end of file
+}
+TEST_F(RadamsaTreeMutatorBaseTest, DeleteNode)
+{
+    tr = RadamsaTreeMutatorBase::Tree("A(B(C))(D)");
+    size_t index = 1;
+    tr.deleteNode(tr.findNodeByIndex(tr.root, index));
+
+    EXPECT_EQ("A(D)", tr.toString(tr.root));
+    EXPECT_EQ(2u, tr.countNodes(tr.root));
+}
+
+TEST_F(RadamsaTreeMutatorBaseTest, DuplicateNode)
+{
+    tr = RadamsaTreeMutatorBase::Tree("A(B(C))(D)");
+    size_t index = 1;
+    RadamsaTreeMutatorBase::NodeId b = tr.findNodeByIndex(tr.root, index);
+    tr.duplicateNode(b, tr.getNode(b).parent);
+
+    EXPECT_EQ("A(B(C))(D)(B(C))", tr.toString(tr.root));
+    EXPECT_EQ(6u, tr.countNodes(tr.root));
+}
+
+TEST_F(RadamsaTreeMutatorBaseTest, SwapAndReplaceNodes)
+{
+    tr = RadamsaTreeMutatorBase::Tree("A(B(C))(D)");
+    size_t b = 1;
+    size_t c = 2;
+    size_t d = 3;
+    RadamsaTreeMutatorBase::NodeId nodeB = tr.findNodeByIndex(tr.root, b);
+    RadamsaTreeMutatorBase::NodeId nodeC = tr.findNodeByIndex(tr.root, c);
+    RadamsaTreeMutatorBase::NodeId nodeD = tr.findNodeByIndex(tr.root, d);
+
+    tr.swapNodes(nodeB, nodeD);
+    EXPECT_EQ("A(D(C))(B)", tr.toString(tr.root));
+
+    tr.replaceNode(nodeC, tr.root);
+    EXPECT_EQ("A(D(A))(B)", tr.toString(tr.root));
+}
+
+TEST_F(RadamsaTreeMutatorBaseTest, RepeatPath)
+{
+    tr = RadamsaTreeMutatorBase::Tree("A(B)(C)");
+    tr.repeatPath(tr.root, 1, 2);
+
+    EXPECT_EQ("A(B)(A(B)(A(B)(C)))", tr.toString(tr.root));
+
+    try{
+        tr.repeatPath(tr.root, 2, 1);
+        ADD_FAILURE() << "No exception thrown";
+    }
+    catch (RuntimeException e)
+    {
+        EXPECT_EQ(e.getErrorCode(), e.INDEX_OUT_OF_RANGE);
+    }
+}
+
+TEST_F(RadamsaTreeMutatorBaseTest, LazyRepeatPath)
+{
+    // The repetition is written out by the serializer; node queries expand it into real nodes first,
+    // so the output must match either way
+    const std::string treeStr = "R(X(A)(B(C))(D))(Y)";
+    RadamsaTreeMutatorBase::Tree expanded(treeStr);
+    tr = RadamsaTreeMutatorBase::Tree(treeStr);
+
+    size_t index = 1;
+    const RadamsaTreeMutatorBase::NodeId lazyParent = tr.findNodeByIndex(tr.root, index);
+    index = 1;
+    const RadamsaTreeMutatorBase::NodeId expandedParent = expanded.findNodeByIndex(expanded.root, index);
+
+    EXPECT_EQ(3u, tr.repeatPath(lazyParent, 1, 3));
+    EXPECT_EQ(3u, expanded.repeatPath(expandedParent, 1, 3));
+    EXPECT_EQ(16u, expanded.countNodes(expanded.root));
+
+    const std::string repeated = "R(X(A)(X(A)(X(A)(X(A)(B(C))(D))(D))(D))(D))(Y)";
+    EXPECT_EQ(repeated.size(), tr.getSerializedSize(tr.root));
+    EXPECT_EQ(repeated, tr.toString(tr.root));
+    EXPECT_EQ(repeated, expanded.toString(expanded.root));
+    EXPECT_EQ("X(A)(X(A)(X(A)(X(A)(B(C))(D))(D))(D))(D)", tr.toString(lazyParent));
+
+    // the growth per repetition is the parent's text minus the repeated child's, here 9 bytes
+    tr = RadamsaTreeMutatorBase::Tree(treeStr);
+    index = 1;
+    const RadamsaTreeMutatorBase::NodeId parent = tr.findNodeByIndex(tr.root, index);
+    EXPECT_EQ(2u, tr.repeatPath(parent, 1, 100, treeStr.size() + 20));
+    EXPECT_EQ(treeStr.size() + 18, tr.toString(tr.root).size());
+
+    tr = RadamsaTreeMutatorBase::Tree(treeStr);
+    EXPECT_EQ(0u, tr.repeatPath(tr.root, 0, 100, treeStr.size()));
+    EXPECT_EQ(treeStr, tr.toString(tr.root));
+}
+
+TEST_F(RadamsaTreeMutatorBaseTest, RepeatPathWithoutGrowth)
+{
+    // The bracketed root has no text of its own, so repeating it around its only child adds nothing
+    tr = RadamsaTreeMutatorBase::Tree("abcd", RadamsaTreeMutatorBase::Syntax::Bracketed);
+    ASSERT_EQ(1u, tr.countChildren(tr.root));
+
+    EXPECT_EQ(0u, tr.repeatPath(tr.root, 0, 3));
+    EXPECT_EQ(0u, tr.repeatPath(tr.root, 0, 3, 100));
+    EXPECT_EQ("abcd", tr.toString(tr.root));
+}
+
+TEST_F(RadamsaTreeMutatorBaseTest, RepeatPathCostFollowsOutput)
+{
+    // Eagerly copying a wide subtree 0x20000 times would build tens of millions of nodes; the lazy
+    // repetition only writes the capped output
+    std::string wide = "R(P";
+    for(size_t i{0}; i < 1000; ++i) wide += "(c)";
+    wide += ")";
+    tr = RadamsaTreeMutatorBase::Tree(wide);
+
+    size_t index = 1;
+    const RadamsaTreeMutatorBase::NodeId parent = tr.findNodeByIndex(tr.root, index);
+    const size_t ceiling = 1024u * 1024u;
+    const size_t applied = tr.repeatPath(parent, 500, 0x20000, ceiling);
+
+    EXPECT_GT(applied, 0u);
+    EXPECT_LT(applied, 0x20000u);
+    const std::string out = tr.toString(tr.root);
+    EXPECT_LE(out.size(), ceiling);
+    EXPECT_EQ(out.size(), tr.getSerializedSize(tr.root));
+    EXPECT_EQ(wide.size() + applied * (wide.size() - 4u), out.size());
+}
+
+TEST_F(RadamsaTreeMutatorBaseTest, ReparseAndDeepTree)
+{
+    tr.parse("GH(IJ)", 6);
+    EXPECT_EQ("GH(IJ)", tr.toString(tr.root));
+
+    // Re-parsing replaces the previous tree, and traversal does not recurse per level
+    const size_t depth = 100000;
+    std::string deep = "R";
+    for(size_t i{1}; i < depth; ++i) deep += "(A";
+    deep += std::string(depth - 1, ')');
+    tr.parse(deep.data(), deep.size());
+
+    EXPECT_EQ(depth, tr.countNodes(tr.root));
+    EXPECT_EQ(deep, tr.toString(tr.root));
+}
+
+TEST_F(RadamsaTreeMutatorBaseTest, PreorderIndex)
+{
+    tr = RadamsaTreeMutatorBase::Tree("A(B(C)(D))(E(F))(G)");
+
+    // pre-order lookup of every node, relative to the root and to a subtree
+    const std::string expected = "ABCDEFG";
+    for(size_t i{0}; i < expected.size(); ++i) {
+        size_t index = i;
+        EXPECT_EQ(std::string(1, expected[i]), tr.getValue(tr.findNodeByIndex(tr.root, index)));
+        EXPECT_EQ(0u, index);
+    }
+    size_t b = 1;
+    RadamsaTreeMutatorBase::NodeId nodeB = tr.findNodeByIndex(tr.root, b);
+    size_t index = 2;
+    EXPECT_EQ("D", tr.getValue(tr.findNodeByIndex(nodeB, index)));
+    index = 5;
+    EXPECT_EQ(RadamsaTreeMutatorBase::NoNode, tr.findNodeByIndex(nodeB, index));
+    EXPECT_EQ(2u, index);
+
+    EXPECT_EQ(7u, tr.countNodes(tr.root));
+    EXPECT_EQ(3u, tr.countNodes(nodeB));
+
+    // internal nodes are A, B and E
+    ASSERT_EQ(3u, tr.countInternalNodes());
+    EXPECT_EQ("A", tr.getValue(tr.findInternalNodeByIndex(0)));
+    EXPECT_EQ("B", tr.getValue(tr.findInternalNodeByIndex(1)));
+    EXPECT_EQ("E", tr.getValue(tr.findInternalNodeByIndex(2)));
+
+    // structural changes rebuild the index on the next lookup
+    tr.deleteNode(nodeB);
+    EXPECT_EQ(4u, tr.countNodes(tr.root));
+    EXPECT_EQ(2u, tr.countInternalNodes());
+    index = 1;
+    EXPECT_EQ("E", tr.getValue(tr.findNodeByIndex(tr.root, index)));
+}
+
+TEST_F(RadamsaTreeMutatorBaseTest, ValuesViewParsedBuffer)
+{
+    const std::string treeStr = "GH(I J)(KL)";
+    tr.parse(treeStr.data(), treeStr.size());
+
+    // values without whitespace point straight into the parsed buffer
+    size_t kl = 2;
+    RadamsaTreeMutatorBase::NodeId nodeKL = tr.findNodeByIndex(tr.root, kl);
+    EXPECT_EQ(treeStr.data() + 8, tr.getValue(nodeKL).data());
+    EXPECT_EQ(treeStr.data(), tr.getValue(tr.root).data());
+
+    // values with embedded whitespace and inserted values are owned by the tree
+    size_t ij = 1;
+    EXPECT_EQ("IJ", tr.getValue(tr.findNodeByIndex(tr.root, ij)));
+    tr.insertNode("MN", tr.root);
+    tr.swapNodes(tr.root, nodeKL);
+    EXPECT_EQ("KL(IJ)(GH)(MN)", tr.toString(tr.root));
+}
+
+TEST_F(RadamsaTreeMutatorBaseTest, SerializeSubtree)
+{
+    tr = RadamsaTreeMutatorBase::Tree("A(B(C)(D))(E)");
+    size_t b = 1;
+    RadamsaTreeMutatorBase::NodeId nodeB = tr.findNodeByIndex(tr.root, b);
+
+    ASSERT_EQ(13u, tr.getSerializedSize(tr.root));
+    ASSERT_EQ(7u, tr.getSerializedSize(nodeB));
+    EXPECT_EQ(0u, tr.getSerializedSize(RadamsaTreeMutatorBase::NoNode));
+
+    // the serializer writes exactly getSerializedSize() bytes
+    char buffer[9];
+    std::memset(buffer, '#', sizeof(buffer));
+    char* end = tr.serialize(nodeB, buffer + 1);
+    EXPECT_EQ(buffer + 8, end);
+    EXPECT_EQ("#B(C)(D)#", std::string(buffer, sizeof(buffer)));
+}
+
+TEST_F(RadamsaTreeMutatorBaseTest, BracketedRoundTrip)
+{
+    using Syntax = RadamsaTreeMutatorBase::Syntax;
+
+    // Serializing an unmutated tree reproduces the input byte for byte, balanced or not
+    const std::vector<std::string> inputs = {
+        "{\"a\": [1, 2, {\"b\": \"c)\"}], \"d\": null}\n",
+        "int main(void) {\n    if (a < b && c[i] > 0) { puts(\"}{\\\"\"); }\n    return 'x';\n}\n",
+        "<html><body class=\"x\"><p>it's (not) [closed</p></body></html>",
+        "(define (f x) (if (> x 0) (* x (f (- x 1))) 1))",
+        "(a]b) x) y ( 'unterminated \"also\\\n",
+        "   plain text without any structure   ",
+        "",
+    };
+
+    for(const std::string& input : inputs) {
+        tr = RadamsaTreeMutatorBase::Tree(input, Syntax::Bracketed);
+        EXPECT_EQ(input.size(), tr.getSerializedSize(tr.root)) << input;
+        EXPECT_EQ(input, tr.toString(tr.root));
+    }
+}
+
+TEST_F(RadamsaTreeMutatorBaseTest, BracketedStructure)
+{
+    using Syntax = RadamsaTreeMutatorBase::Syntax;
+    using NodeId = RadamsaTreeMutatorBase::NodeId;
+
+    tr = RadamsaTreeMutatorBase::Tree("f(a, [1, 2]) \"x(y\"", Syntax::Bracketed);
+
+    // root: "f", (...), " ", "x(y" -- the bracket inside the string is not a group
+    ASSERT_EQ(4u, tr.countChildren(tr.root));
+    const NodeId call = tr.getNode(tr.getNode(tr.root).firstChild).nextSibling;
+    EXPECT_EQ("(", tr.getValue(call));
+    EXPECT_EQ(')', tr.getNode(call).close);
+    EXPECT_EQ("(a, [1, 2])", tr.toString(call));
+    EXPECT_EQ("\"x(y\"", tr.getValue(tr.getNode(tr.root).lastChild));
+
+    // (...) holds "a, " and [...], which holds "1, 2"
+    ASSERT_EQ(2u, tr.countChildren(call));
+    const NodeId list = tr.getNode(call).lastChild;
+    EXPECT_EQ("[1, 2]", tr.toString(list));
+    EXPECT_EQ(8u, tr.countNodes(tr.root));
+    EXPECT_EQ(3u, tr.countInternalNodes());
+
+    // groups left open by a closing bracket of an outer group stay in place without a close
+    tr = RadamsaTreeMutatorBase::Tree("f(a < b)", Syntax::Bracketed);
+    const NodeId outer = tr.getNode(tr.root).lastChild;
+    EXPECT_EQ(')', tr.getNode(outer).close);
+    EXPECT_EQ('\0', tr.getNode(tr.getNode(outer).lastChild).close);
+}
+
+TEST_F(RadamsaTreeMutatorBaseTest, BracketedMutations)
+{
+    using Syntax = RadamsaTreeMutatorBase::Syntax;
+    using NodeId = RadamsaTreeMutatorBase::NodeId;
+
+    tr = RadamsaTreeMutatorBase::Tree("f(x) + g[y]", Syntax::Bracketed);
+    size_t index = 2;
+    const NodeId call = tr.findNodeByIndex(tr.root, index);
+    ASSERT_EQ("(x)", tr.toString(call));
+
+    // the repeated group closes once per repetition
+    EXPECT_EQ(2u, tr.repeatPath(call, 0, 2));
+    EXPECT_EQ(std::string("f(((x))) + g[y]").size(), tr.getSerializedSize(tr.root));
+    EXPECT_EQ("f(((x))) + g[y]", tr.toString(tr.root));
+
+    tr = RadamsaTreeMutatorBase::Tree("f(x) + g[y]", Syntax::Bracketed);
+    index = 2;
+    tr.deleteNode(tr.findNodeByIndex(tr.root, index));
+    EXPECT_EQ("f + g[y]", tr.toString(tr.root));
+
+    index = 3;
+    const NodeId list = tr.findNodeByIndex(tr.root, index);
+    tr.duplicateNode(list, tr.root);
+    EXPECT_EQ("f + g[y][y]", tr.toString(tr.root));
+}
+
+TEST_F(RadamsaTreeMutatorBaseTest, BracketedSwapAndReplaceStayBalanced)
+{
+    using Syntax = RadamsaTreeMutatorBase::Syntax;
+    using NodeId = RadamsaTreeMutatorBase::NodeId;
+
+    // groups move with their closing bracket and their children
+    tr = RadamsaTreeMutatorBase::Tree("[1] x", Syntax::Bracketed);
+    size_t group = 1;
+    size_t text = 3;
+    NodeId nodeGroup = tr.findNodeByIndex(tr.root, group);
+    NodeId nodeText = tr.findNodeByIndex(tr.root, text);
+    tr.swapNodes(nodeGroup, nodeText);
+    EXPECT_EQ(" x[1]", tr.toString(tr.root));
+    EXPECT_EQ(5u, tr.getSerializedSize(tr.root));
+
+    tr = RadamsaTreeMutatorBase::Tree("[1] x", Syntax::Bracketed);
+    group = 1;
+    text = 3;
+    nodeGroup = tr.findNodeByIndex(tr.root, group);
+    nodeText = tr.findNodeByIndex(tr.root, text);
+    tr.replaceNode(nodeText, nodeGroup);
+    EXPECT_EQ("[1][1]", tr.toString(tr.root));
+    EXPECT_EQ(5u, tr.countNodes(tr.root));
+
+    // a node is not swapped with its ancestor, but can be replaced with it
+    size_t inner = 2;
+    const NodeId nodeInner = tr.findNodeByIndex(tr.root, inner);
+    tr.swapNodes(nodeGroup, nodeInner);
+    EXPECT_EQ("[1][1]", tr.toString(tr.root));
+    tr.replaceNode(nodeInner, nodeGroup);
+    EXPECT_EQ("[[1]][1]", tr.toString(tr.root));
+
+    // every swap and replace of every pair of nodes keeps the brackets balanced
+    auto isBalanced = [](const std::string& s) {
+        std::string open;
+        for(char ch : s) {
+            if(ch == '(' || ch == '[' || ch == '{' || ch == '<') {
+                open.push_back(ch);
+            }
+            else if(ch == ')' || ch == ']' || ch == '}' || ch == '>') {
+                const char expected{ch == ')' ? '(' : ch == ']' ? '[' : ch == '}' ? '{' : '<'};
+                if(open.empty() || open.back() != expected) return false;
+                open.pop_back();
+            }
+        }
+        return open.empty();
+    };
+
+    const std::string input = "f(a, [1, 2]) {b<c>} d";
+    tr = RadamsaTreeMutatorBase::Tree(input, Syntax::Bracketed);
+    const size_t numNodes = tr.countNodes(tr.root);
+    for(size_t i = 0; i < numNodes; i++) {
+        for(size_t j = 0; j < numNodes; j++) {
+            size_t index1 = i;
+            size_t index2 = j;
+            tr = RadamsaTreeMutatorBase::Tree(input, Syntax::Bracketed);
+            tr.swapNodes(tr.findNodeByIndex(tr.root, index1), tr.findNodeByIndex(tr.root, index2));
+            const std::string swapped = tr.toString(tr.root);
+            EXPECT_TRUE(isBalanced(swapped)) << i << " " << j << ": " << swapped;
+            EXPECT_EQ(input.size(), swapped.size());
+            EXPECT_EQ(numNodes, tr.countNodes(tr.root));
+
+            index1 = i;
+            index2 = j;
+            tr = RadamsaTreeMutatorBase::Tree(input, Syntax::Bracketed);
+            tr.replaceNode(tr.findNodeByIndex(tr.root, index1), tr.findNodeByIndex(tr.root, index2));
+            const std::string replaced = tr.toString(tr.root);
+            EXPECT_TRUE(isBalanced(replaced)) << i << " " << j << ": " << replaced;
+            EXPECT_EQ(replaced.size(), tr.getSerializedSize(tr.root));
+        }
+    }
+}
@@ -0,0 +1,130 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+
+#include "gtest/gtest.h"
+#include "RadamsaUtf8Index.hpp"
+#include "RadamsaByteScan.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using vmf::RadamsaUtf8Index;
+using vmf::RadamsaByteScan;
+
+class RadamsaUtf8IndexTest : public ::testing::Test {
+  protected:
+    RadamsaUtf8IndexTest() = default;
+    ~RadamsaUtf8IndexTest() = default;
+
+    // Checks every rank and select against a direct walk of the buffer
+    static void checkAgainstReference(const std::vector<char>& buffer) {
+      const RadamsaUtf8Index index(buffer.data(), buffer.size());
+      ASSERT_EQ(index.GetSize(), buffer.size());
+
+      std::vector<size_t> starts;
+      std::vector<size_t> printable;
+      for(size_t i{0}; i < buffer.size(); ++i) {
+        const uint8_t byte = static_cast<uint8_t>(buffer[i]);
+
+        EXPECT_EQ(index.RankCodePoints(i), starts.size()) << i;
+        EXPECT_EQ(index.RankPrintable(i), printable.size()) << i;
+
+        if ((byte & 0xC0) != 0x80) starts.push_back(i);
+        if (byte >= ' ' && byte <= '~') printable.push_back(i);
+
+        EXPECT_EQ(index.IsCodePointStart(i), (byte & 0xC0) != 0x80) << i;
+        EXPECT_EQ(index.IsPrintable(i), byte >= ' ' && byte <= '~') << i;
+      }
+      EXPECT_EQ(index.RankCodePoints(buffer.size()), starts.size());
+      EXPECT_EQ(index.RankPrintable(buffer.size()), printable.size());
+
+      ASSERT_EQ(index.GetCodePointCount(), starts.size());
+      ASSERT_EQ(index.GetPrintableCount(), printable.size());
+      for(size_t rank{0}; rank < starts.size(); ++rank)
+        EXPECT_EQ(index.SelectCodePoint(rank), starts[rank]) << rank;
+      for(size_t rank{0}; rank < printable.size(); ++rank)
+        EXPECT_EQ(index.SelectPrintable(rank), printable[rank]) << rank;
+    }
+};
+
+TEST_F(RadamsaUtf8IndexTest, Empty)
+{
+    const RadamsaUtf8Index index(nullptr, 0);
+
+    EXPECT_EQ(index.GetSize(), 0u);
+    EXPECT_EQ(index.GetCodePointCount(), 0u);
+    EXPECT_EQ(index.GetPrintableCount(), 0u);
+    EXPECT_EQ(index.RankCodePoints(0), 0u);
+}
+
+TEST_F(RadamsaUtf8IndexTest, MultibyteText)
+{
+    // "a", U+00E9, U+20AC, U+1F600, "z", a stray continuation byte and a truncated lead byte
+    const std::string text = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80z\x80\xE2";
+    const RadamsaUtf8Index index(text.data(), text.size());
+
+    ASSERT_EQ(index.GetCodePointCount(), 6u);
+    EXPECT_EQ(index.SelectCodePoint(0), 0u);
+    EXPECT_EQ(index.SelectCodePoint(1), 1u);
+    EXPECT_EQ(index.SelectCodePoint(2), 3u);
+    EXPECT_EQ(index.SelectCodePoint(3), 6u);
+    EXPECT_EQ(index.SelectCodePoint(4), 10u);
+    EXPECT_EQ(index.SelectCodePoint(5), 12u);
+    EXPECT_FALSE(index.IsCodePointStart(11));
+
+    ASSERT_EQ(index.GetPrintableCount(), 2u);
+    EXPECT_EQ(index.SelectPrintable(0), 0u);
+    EXPECT_EQ(index.SelectPrintable(1), 10u);
+}
+
+TEST_F(RadamsaUtf8IndexTest, PathsMatchReference)
+{
+    // Sizes straddle the 64-bit words and the select samples; densities range from sparse to full
+    const std::vector<size_t> sizes{1, 63, 64, 65, 1000, 5000};
+    const std::vector<int> densities{0, 1, 50, 200, 256};
+
+    const RadamsaByteScan::Path originalPath = RadamsaByteScan::GetActivePath();
+    for(RadamsaByteScan::Path path : {RadamsaByteScan::Path::Scalar, RadamsaByteScan::Path::SSE2, RadamsaByteScan::Path::AVX2}) {
+        if (!RadamsaByteScan::SetActivePath(path)) continue;
+
+        for(size_t size : sizes) {
+            for(int density : densities) {
+                // density / 256 of the bytes are ASCII letters, the rest continuation bytes
+                std::mt19937 gen(static_cast<unsigned int>(size * 7 + density));
+                std::uniform_int_distribution<int> dist(0, 255);
+                std::vector<char> buffer(size);
+                for(char& c : buffer)
+                    c = (dist(gen) < density) ? 'q' : '\x9A';
+
+                checkAgainstReference(buffer);
+            }
+        }
+    }
+    RadamsaByteScan::SetActivePath(originalPath);
+}
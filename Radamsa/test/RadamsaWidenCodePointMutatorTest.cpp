@@ -32,6 +32,7 @@
 #include "SimpleStorage.hpp"
 #include "RadamsaWidenCodePointMutator.hpp"
 #include "RuntimeException.hpp"
+#include <algorithm>
 
 using vmf::StorageModule;
 using vmf::StorageRegistry;
@@ -207,7 +208,7 @@ TEST_F(RadamsaWidenCodePointMutatorTest, MixedValidInvalid)
     StorageEntry* modEntry = storage->createNewEntry();
     char* modBuff;
 
-    const size_t buff_len = 2;
+    const size_t buff_len = 3;
     char* buff = baseEntry->allocateBuffer(testCaseKey, buff_len);
 
     buff[0] = 127;
@@ -235,4 +236,32 @@ TEST_F(RadamsaWidenCodePointMutatorTest, MixedValidInvalid)
     EXPECT_EQ(modBuff_len, buff_len + 2);
     EXPECT_EQ(modBuff[1], '\xC0');  // 0b11000000
     EXPECT_EQ(modBuff[2], '\xE7');  // 0b11100111
-}
\ No newline at end of file
+}
+
+TEST_F(RadamsaWidenCodePointMutatorTest, SinglePrintableInLargeInput)
+{
+    // The only printable byte is selected directly instead of being searched for at random
+    StorageEntry* baseEntry = storage->createNewEntry();
+    StorageEntry* modEntry = storage->createNewEntry();
+
+    const size_t buff_len = 1u << 20;
+    const size_t printableIndex = 700001;
+    char* buff = baseEntry->allocateBuffer(testCaseKey, buff_len);
+    std::fill(buff, buff + buff_len, '\x80');
+    buff[printableIndex] = 'g';
+
+    try{
+        theMutator->mutateTestCase(*storage, baseEntry, modEntry, testCaseKey);
+    }
+    catch (BaseException e)
+    {
+        FAIL() << "Exception thrown: " << e.getReason();
+    }
+
+    char* modBuff = modEntry->getBufferPointer(testCaseKey);
+    ASSERT_EQ(modEntry->getBufferSize(testCaseKey), buff_len + 2);
+    EXPECT_TRUE(std::equal(buff, buff + printableIndex, modBuff));
+    EXPECT_EQ(modBuff[printableIndex], '\xC0');
+    EXPECT_EQ(modBuff[printableIndex + 1], '\xE7');
+    EXPECT_TRUE(std::equal(buff + printableIndex + 1, buff + buff_len, modBuff + printableIndex + 2));
+}
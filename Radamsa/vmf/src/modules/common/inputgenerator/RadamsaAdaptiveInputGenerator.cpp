@@ -0,0 +1,246 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#include "RadamsaAdaptiveInputGenerator.hpp"
+#include "Logging.hpp"
+#include "RadamsaParseCache.hpp"
+#include <algorithm>
+#include <cstring>
+
+using namespace vmf;
+
+#include "ModuleFactory.hpp"
+REGISTER_MODULE(RadamsaAdaptiveInputGenerator);
+
+/**
+ * @brief Builder method to support the ModuleFactory
+ * Constructs an instance of this class
+ * @return Module* - Pointer to the newly created instance
+ */
+Module* RadamsaAdaptiveInputGenerator::build(std::string name)
+{
+    return new RadamsaAdaptiveInputGenerator(name);
+}
+
+/**
+ * @brief Initialization method
+ * Collects the child mutators and reads the scheduling parameters
+ *
+ * @param config - Configuration object
+ */
+void RadamsaAdaptiveInputGenerator::init(ConfigInterface& config)
+{
+    for(Module* module : config.getSubModules(getModuleName()))
+    {
+        if (MutatorModule::isAnInstance(module))
+            mutators.push_back(MutatorModule::castTo(module));
+        else
+            LOG_WARNING << "RadamsaAdaptiveInputGenerator ignores its child module " << module->getModuleName() << ", which is not a mutator";
+    }
+
+    if (mutators.empty())
+        throw RuntimeException{"RadamsaAdaptiveInputGenerator must be configured with at least one child mutator", RuntimeException::CONFIGURATION_ERROR};
+
+    stats.assign(mutators.size(), MutatorStats{});
+    weights.resize(mutators.size());
+    scoresChanged = true;
+
+    SetDecayInterval(config.getIntParam(getModuleName(), "decayInterval", DefaultDecayInterval));
+    SetMutationsPerCall(config.getIntParam(getModuleName(), "mutationsPerCall", DefaultMutationsPerCall));
+}
+
+/**
+ * @brief Sets the number of executions without new coverage after which a mutator's score is halved
+ */
+void RadamsaAdaptiveInputGenerator::SetDecayInterval(const int interval)
+{
+    if (interval <= 0)
+        throw RuntimeException{"RadamsaAdaptiveInputGenerator decayInterval must be positive", RuntimeException::CONFIGURATION_ERROR};
+
+    decayInterval = static_cast<uint32_t>(interval);
+}
+
+/**
+ * @brief Sets the number of test cases made from the selected base entry on each call
+ */
+void RadamsaAdaptiveInputGenerator::SetMutationsPerCall(const int mutations)
+{
+    if (mutations <= 0)
+        throw RuntimeException{"RadamsaAdaptiveInputGenerator mutationsPerCall must be positive", RuntimeException::CONFIGURATION_ERROR};
+
+    mutationsPerCall = mutations;
+}
+
+/**
+ * @brief Construct a new RadamsaAdaptiveInputGenerator::RadamsaAdaptiveInputGenerator object
+ *
+ * @param name The of the name module
+ */
+RadamsaAdaptiveInputGenerator::RadamsaAdaptiveInputGenerator(std::string name) : InputGeneratorModule(name)
+{
+
+}
+
+/**
+ * @brief Destroy the RadamsaAdaptiveInputGenerator::RadamsaAdaptiveInputGenerator object
+ *
+ */
+RadamsaAdaptiveInputGenerator::~RadamsaAdaptiveInputGenerator()
+{
+
+}
+
+/**
+ * @brief Register the storage needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+void RadamsaAdaptiveInputGenerator::registerStorageNeeds(StorageRegistry& registry)
+{
+    testCaseKey = registry.registerKey("TEST_CASE", StorageRegistry::BUFFER, StorageRegistry::READ_WRITE);
+    hasNewCoverageTag = registry.registerTag("HAS_NEW_COVERAGE", StorageRegistry::READ_ONLY);
+}
+
+StorageEntry* RadamsaAdaptiveInputGenerator::selectBaseEntry(StorageModule& storage)
+{
+    std::unique_ptr<Iterator> entries{storage.getSavedEntries()};
+    const int count{entries->getSize()};
+
+    if (count <= 0)
+        throw RuntimeException{"RadamsaAdaptiveInputGenerator has no saved entry to mutate", RuntimeException::UNEXPECTED_ERROR};
+
+    // Saved entries are sorted by the storage's sort key, fittest first with the usual fitness key. The lower of
+    // two uniform draws picks index i with probability (2 * (count - i) - 1) / count^2, favoring the fittest
+    // entries while every entry keeps a share
+    const int first{rand->randBelow(count)};
+    const int second{rand->randBelow(count)};
+    return entries->setIndexTo(std::min(first, second));
+}
+
+bool RadamsaAdaptiveInputGenerator::isUnchanged(StorageEntry* baseEntry, StorageEntry* newEntry)
+{
+    const int baseSize{baseEntry->getBufferSize(testCaseKey)};
+    const int newSize{newEntry->getBufferSize(testCaseKey)};
+
+    if (baseSize <= 0 || (newSize != baseSize && newSize != baseSize + 1))
+        return false;
+
+    const char* newBuffer{newEntry->getBufferPointer(testCaseKey)};
+
+    // The Radamsa mutators null-terminate what they write, so an input copied as is comes back one byte longer
+    if (newSize != baseSize && newBuffer[baseSize] != '\0')
+        return false;
+
+    return memcmp(baseEntry->getBufferPointer(testCaseKey), newBuffer, static_cast<size_t>(baseSize)) == 0;
+}
+
+void RadamsaAdaptiveInputGenerator::lowerScore(MutatorStats& mutator, const uint32_t score)
+{
+    const uint32_t lowered{std::max(score, MinScore)};
+
+    if (lowered != mutator.Score)
+    {
+        mutator.Score = lowered;
+        scoresChanged = true;
+    }
+}
+
+void RadamsaAdaptiveInputGenerator::recordExecution(const size_t mutatorIndex, const bool unchanged)
+{
+    MutatorStats& mutator{stats[mutatorIndex]};
+
+    ++mutator.Executions;
+    if (unchanged)
+    {
+        ++mutator.Unchanged;
+        lowerScore(mutator, mutator.Score - 1u);
+    }
+
+    if (++mutator.SinceReward >= decayInterval)
+    {
+        mutator.SinceReward = 0u;
+        lowerScore(mutator, mutator.Score / 2u);
+    }
+}
+
+void RadamsaAdaptiveInputGenerator::addNewTestCases(StorageModule& storage)
+{
+    // This is called once per fuzzing loop, so it publishes the statistics of the parse cache the mutators share
+    RadamsaParseCache::getInstance()->PublishStats(storage);
+
+    // A changed score changes the total weight, which rescales the threshold of every column, so the table cannot
+    // be patched column by column. A full build is O(number of mutators) and allocation free, far below the cost of
+    // the mutationsPerCall mutations and executions it is amortized over, and score changes made by the last call
+    // are batched into this single build
+    if (scoresChanged)
+    {
+        for(size_t it{0u}; it < stats.size(); ++it)
+            weights[it] = stats[it].Score;
+
+        aliasTable.Build(weights);
+        scoresChanged = false;
+    }
+
+    StorageEntry* baseEntry{selectBaseEntry(storage)};
+    pendingEntries.clear();
+
+    for(int it{0}; it < mutationsPerCall; ++it)
+    {
+        const size_t mutatorIndex{aliasTable.Sample(rand)};
+        StorageEntry* newEntry{storage.createNewEntry()};
+
+        mutators[mutatorIndex]->mutateTestCase(storage, baseEntry, newEntry, testCaseKey);
+        pendingEntries[newEntry->getID()] = static_cast<uint32_t>(mutatorIndex);
+
+        // Compared after each mutation, while both buffers are still hot in the cache
+        recordExecution(mutatorIndex, isUnchanged(baseEntry, newEntry));
+    }
+}
+
+bool RadamsaAdaptiveInputGenerator::examineTestCaseResults(StorageModule& storage)
+{
+    std::unique_ptr<Iterator> entries{storage.getNewEntriesByTag(hasNewCoverageTag)};
+
+    while (entries->hasNext())
+    {
+        const auto pending = pendingEntries.find(entries->getNext()->getID());
+        if (pending == pendingEntries.end())
+            continue;   // made by another module
+
+        MutatorStats& mutator{stats[pending->second]};
+        ++mutator.NewCoverage;
+        mutator.SinceReward = 0u;
+        mutator.Score = std::min(mutator.Score + CoverageReward, MaxScore);
+        scoresChanged = true;
+    }
+
+    pendingEntries.clear();
+
+    // This generator never runs out of test cases
+    return false;
+}
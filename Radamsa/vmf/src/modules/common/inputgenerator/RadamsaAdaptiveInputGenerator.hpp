@@ -0,0 +1,113 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "InputGeneratorModule.hpp"
+#include "MutatorModule.hpp"
+#include "StorageEntry.hpp"
+#include "RuntimeException.hpp"
+#include "RadamsaAliasTable.hpp"
+#include "VmfRand.hpp"
+
+namespace vmf
+{
+/**
+ * @brief Input generator that picks its child mutators by a self-adjusting score, as radamsa does
+ *
+ * Each call mutates one saved entry a number of times, picked with a bias toward the start of the storage's
+ * sorted saved entries, where the fittest entries are. Every mutation picks a mutator in proportion to its
+ * score, so mutators that keep finding coverage for the SUT are run more often and mutators that never pay
+ * off fade to a small, non-zero share:
+ * - a test case tagged HAS_NEW_COVERAGE raises its mutator's score by CoverageReward
+ * - an output identical to its input, or to its input followed by a null terminator, lowers its mutator's score by one
+ * - a mutator that goes decayInterval executions without new coverage has its score halved
+ * Scores stay within [MinScore, MaxScore]. The mutators are sampled in O(1) from an alias table, which is
+ * rebuilt at the start of a call only if a score changed since the last one.
+ */
+class RadamsaAdaptiveInputGenerator : public InputGeneratorModule
+{
+public:
+    static constexpr uint32_t InitialScore{16u};
+    static constexpr uint32_t MinScore{1u};
+    static constexpr uint32_t MaxScore{256u};
+    static constexpr uint32_t CoverageReward{16u};
+    static constexpr int DefaultDecayInterval{256};
+    static constexpr int DefaultMutationsPerCall{100};
+
+    /**
+     * @brief Per-mutator counters, kept in one array indexed like the mutators
+     */
+    struct MutatorStats
+    {
+        uint32_t Score{InitialScore};
+        uint32_t SinceReward{0u};   // executions since the last new coverage or decay
+        uint64_t Executions{0u};
+        uint64_t Unchanged{0u};     // outputs identical to their input, ignoring an added null terminator
+        uint64_t NewCoverage{0u};
+    };
+
+    static Module* build(std::string name);
+    virtual void init(ConfigInterface& config);
+
+    RadamsaAdaptiveInputGenerator(std::string name);
+    virtual ~RadamsaAdaptiveInputGenerator();
+    virtual void registerStorageNeeds(StorageRegistry& registry);
+    virtual void addNewTestCases(StorageModule& storage);
+    virtual bool examineTestCaseResults(StorageModule& storage);
+
+    void SetDecayInterval(const int interval);
+    void SetMutationsPerCall(const int mutations);
+
+    const std::vector<MutatorStats>& GetMutatorStats() const noexcept { return stats; }
+
+private:
+    StorageEntry* selectBaseEntry(StorageModule& storage);
+    bool isUnchanged(StorageEntry* baseEntry, StorageEntry* newEntry);
+    void recordExecution(const size_t mutatorIndex, const bool unchanged);
+    void lowerScore(MutatorStats& mutator, const uint32_t score);
+
+    VmfRand* rand = VmfRand::getInstance();
+    std::vector<MutatorModule*> mutators;
+    std::vector<MutatorStats> stats;
+    std::vector<uint32_t> weights;
+    RadamsaAliasTable aliasTable;
+    bool scoresChanged{true};
+
+    // Mutator of each test case made by the last call, by entry ID, to credit its coverage
+    std::unordered_map<unsigned long, uint32_t> pendingEntries;
+
+    uint32_t decayInterval{static_cast<uint32_t>(DefaultDecayInterval)};
+    int mutationsPerCall{DefaultMutationsPerCall};
+    int testCaseKey;
+    int hasNewCoverageTag;
+};
+}
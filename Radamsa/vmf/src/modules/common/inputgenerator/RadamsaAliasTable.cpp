@@ -0,0 +1,88 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#include "RadamsaAliasTable.hpp"
+#include "RuntimeException.hpp"
+
+using namespace vmf;
+
+void RadamsaAliasTable::Build(const std::vector<uint32_t>& weights)
+{
+    const size_t n{weights.size()};
+
+    totalWeight = 0u;
+    for(const uint32_t weight : weights)
+        totalWeight += weight;
+
+    if (n == 0u || totalWeight == 0u)
+        throw RuntimeException{"An alias table needs at least one non-zero weight", RuntimeException::USAGE_ERROR};
+
+    thresholds.assign(n, totalWeight);
+    aliases.resize(n);
+    scaled.resize(n);
+    small.clear();
+    large.clear();
+
+    // Scaling by n makes the average column exactly totalWeight, so no division is needed
+    for(size_t it{0u}; it < n; ++it)
+    {
+        scaled[it] = static_cast<uint64_t>(weights[it]) * n;
+        aliases[it] = static_cast<uint32_t>(it);
+        (scaled[it] < totalWeight ? small : large).push_back(static_cast<uint32_t>(it));
+    }
+
+    // Top up every underfull column from an overfull one
+    while (!small.empty() && !large.empty())
+    {
+        const uint32_t under{small.back()};
+        const uint32_t over{large.back()};
+        small.pop_back();
+
+        thresholds[under] = scaled[under];
+        aliases[under] = over;
+
+        scaled[over] -= totalWeight - scaled[under];
+        if (scaled[over] < totalWeight)
+        {
+            large.pop_back();
+            small.push_back(over);
+        }
+    }
+
+    // Whatever is left is full, and keeps the default threshold of totalWeight
+}
+
+size_t RadamsaAliasTable::Sample(VmfRand* rand) const noexcept
+{
+    const size_t column{rand->randBetween(size_t{0u}, thresholds.size() - 1u)};
+
+    if (thresholds[column] == totalWeight)
+        return column;
+
+    return (rand->randBetween(size_t{0u}, static_cast<size_t>(totalWeight - 1u)) < thresholds[column]) ? column : aliases[column];
+}
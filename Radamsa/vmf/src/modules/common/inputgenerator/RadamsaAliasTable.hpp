@@ -0,0 +1,68 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "VmfRand.hpp"
+
+namespace vmf
+{
+/**
+ * @brief Samples an index in proportion to integer weights in O(1), using Vose's alias method
+ *
+ * Every column holds its own index and an alias, and is kept with probability threshold / total weight.
+ * Thresholds are exact integers, so the sampled distribution matches the weights without rounding. Building
+ * is O(n) and reuses the buffers of the previous build, so owners rebuild whenever their weights change.
+ */
+class RadamsaAliasTable
+{
+public:
+    /**
+     * @brief Builds the table for the given weights, of which at least one must be non-zero
+     */
+    void Build(const std::vector<uint32_t>& weights);
+
+    size_t Sample(VmfRand* rand) const noexcept;
+
+    size_t GetSize() const noexcept { return thresholds.size(); }
+    uint64_t GetTotalWeight() const noexcept { return totalWeight; }
+
+private:
+    std::vector<uint64_t> thresholds;
+    std::vector<uint32_t> aliases;
+    uint64_t totalWeight{0u};
+
+    // Work lists of the build
+    std::vector<uint64_t> scaled;
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+};
+}
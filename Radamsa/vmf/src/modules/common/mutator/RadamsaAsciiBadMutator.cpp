@@ -30,18 +30,15 @@
   *
   */
 #include "RadamsaAsciiBadMutator.hpp"
+#include "RadamsaByteScan.hpp"
+#include "RadamsaParseCache.hpp"
 #include "RuntimeException.hpp"
 #include <random>
 #include <algorithm>
-#include <variant>
+#include <array>
+#include <string_view>
 
 using namespace vmf;
-using Byte = uint8_t;
-using std::get;
-using std::get_if;
-using std::holds_alternative;
-using std::string;
-using std::variant;
 
 #include "ModuleFactory.hpp"
 REGISTER_MODULE(RadamsaAsciiBadMutator);
@@ -96,259 +93,85 @@ void RadamsaAsciiBadMutator::registerStorageNeeds(StorageRegistry& registry)
     // by the input generator that calls them
 }
 
-// Helper stuff starts here
-struct Delimited {
-    // Chunk of Data, usually with delimiting quotes enclosing it
-
-    Byte delim;
-    vector<Byte> data;
-
-    static Delimited make(char c, const vector<Byte>& d) {
-        return Delimited{Byte(c), d};
-    }
-
-    void unlex(vector<Byte>& out) const {
-        out.push_back(delim);
-        out.insert(out.end(), data.begin(), data.end());
-        out.push_back(delim);
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+void RadamsaAsciiBadMutator::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
 
-        return;
-    }
+// Helper stuff starts here
+namespace
+{
+// A run of printable ASCII in the input; the bytes between two runs are never mutated
+struct TextRange {
+    size_t offset;
+    size_t length;
 };
 
-struct Text {
-    // Raw text / delimited chunk
-public: 
-    variant<vector<Byte>, Delimited> value;
-
-    static Text texty(const vector<Byte>& s) {
-        return Text{s};
-    }
-    static Text delim(const Delimited& d) {
-        return Text{d};
-    }
-
-    void mutate(VmfRand* rand) {
-        vector<Byte>* targetData;
-        if (vector<Byte>* p = get_if<vector<Byte>>(&value)) {
-            targetData = p;
-        } else {
-            targetData = &get<Delimited>(value).data;
-        }
-        mutateTextData(*targetData, rand);
-
-        return;
-    }
-
-    void unlex(vector<Byte>& out) const {
-        if (holds_alternative<vector<Byte>>(value)) {
-            const vector<Byte>& a = get<vector<Byte>>(value);
-            out.insert(out.end(), a.begin(), a.end());
-        } else {
-            const Delimited& delimChunk = get<Delimited>(value);
-            delimChunk.unlex(out);
-        }
-
-        return;
-    }
-private:
-    explicit Text(const vector<Byte>& s) : value(s) {}
-    explicit Text(const Delimited& d) : value(d) {}
-
-    static const vector<vector<Byte>> getSillyStrings() {
-        // XXX: extend this because many of these strings are incredibly Linux-specific
-        // perhaps add a configurable wordlist
-        static const vector<string> strList = {
-            "%n", "%n", "%s", "%d", "%p", "%#x",
-            "\\00", "aaaa%d%n",
-            "`xcalc`", ";xcalc", "$(xcalc)", "!xcalc", "\"xcalc", "'xcalc",
-            "\\x00", "\\r\\n", "\\r", "\\n", "\\x0a", "\\x0d",
-            "NaN", "+inf",
-            "$PATH",
-            "$!!", "!!", "&#000;", "\\u0000",
-            "$&", "$+", "$`", "$'", "$1"
-        };
-        static vector<vector<Byte>> list;
-        if (list.empty()) {
-            list.reserve(strList.size());
-            for (const string& s : strList) {
-                list.emplace_back(s.begin(), s.end());
-            }
-        }
-        return list;
-    };
-
-    vector<Byte> randomBadness(VmfRand* rand) {
-        // Randomly concatenate 1-19 "silly strings"
-
-        const vector<vector<Byte>> sillyStrings = getSillyStrings();
-        int repeatCount = rand->randBetween(1, 19);
-
-        vector<Byte> out;
-        out.reserve(repeatCount * 8);
-        for (int i = 0; i < repeatCount; ++i) {
-            const vector<Byte>& s = sillyStrings[rand->randBetween(0, int(sillyStrings.size() - 1))];
-            out.insert(out.end(), s.begin(), s.end());
-        }
-        return out;
-    }
-
-    void mutateTextData(vector<Byte>& data, VmfRand* rand) {
-        size_t byteIndex = rand->randBetween(0, int(data.size()));
-        int mutationType = rand->randBetween(0, 2);
-        switch (mutationType) {
-            case 0: {
-                // insert badness
-                vector<Byte> bad = randomBadness(rand);
-                data.insert(data.begin() + byteIndex, bad.begin(), bad.end());
-                break;
-            }
-            case 1: {
-                // replace badness
-                vector<Byte> bad = randomBadness(rand);
-                data.resize(byteIndex);
-                data.insert(data.end(), bad.begin(), bad.end());
-                break;
-            }
-            case 2: {
-                // push random number of newline characters
-                int choice = rand->randBetween(0, 10);
-                size_t newlineCount;
-                switch (choice) {
-                    case 0: newlineCount = 127;   break;
-                    case 1: newlineCount = 128;   break;
-                    case 2: newlineCount = 255;   break;
-                    case 3: newlineCount = 256;   break;
-                    case 4: newlineCount = 16383; break;
-                    case 5: newlineCount = 16384; break;
-                    case 6: newlineCount = 32767; break;
-                    case 7: newlineCount = 32768; break;
-                    case 8: newlineCount = 65535; break;
-                    case 9: newlineCount = 65536; break;
-                    default: newlineCount = rand->randBetween(0, 1023); break;
-                }
-                data.insert(data.begin() + byteIndex, newlineCount, Byte('\n'));
-                break;
-            }
-        }
-
-        return;
-    }
+// The input counts as text only if it starts with a printable run of at least this many bytes
+constexpr size_t minimumLeadingText{6u};
+
+// XXX: extend this because many of these strings are incredibly Linux-specific
+// perhaps add a configurable wordlist
+constexpr std::array<std::string_view, 32> sillyStrings{
+    "%n", "%n", "%s", "%d", "%p", "%#x",
+    "\\00", "aaaa%d%n",
+    "`xcalc`", ";xcalc", "$(xcalc)", "!xcalc", "\"xcalc", "'xcalc",
+    "\\x00", "\\r\\n", "\\r", "\\n", "\\x0a", "\\x0d",
+    "NaN", "+inf",
+    "$PATH",
+    "$!!", "!!", "&#000;", "\\u0000",
+    "$&", "$+", "$`", "$'", "$1"
 };
 
-struct Data {
-    // Chunk data in two flavors: bytes, and texty
-    variant<vector<Byte>, vector<Text>> value;
+vector<TextRange> lexText(const char* bytes, size_t size) {
+    // Lists the printable runs of the input as ranges over it, or nothing if the input does not start with text
 
-    void unlex(vector<Byte>& out) const {
-        if (holds_alternative<vector<Byte>>(value)) {
-            const vector<Byte>& a = get<vector<Byte>>(value);
-            out.insert(out.end(), a.begin(), a.end());
-        } else {
-            const vector<Text>& texts = get<vector<Text>>(value);
-            for (const Text& t : texts) {
-                t.unlex(out);
-            }
-        }
-    }
-};
+    vector<TextRange> ranges;
+    size_t pos = RadamsaByteScan::FindEndOfRun(bytes, size, 0, RadamsaByteScan::ByteClass::Texty);
+    if (pos < minimumLeadingText) return ranges;
 
-struct Ascii {
-public:
-    vector<Data> chunks;
-
-    static optional<Ascii> parse(const vector<Byte>& data) {
-        vector<Data> out;
-        bool success = parseBytes(data, 6, out);
-        if (!success) return nullopt;
-        return Ascii{out};
+    ranges.push_back(TextRange{0, pos});
+    while ((pos = RadamsaByteScan::FindNextInClass(bytes, size, pos, RadamsaByteScan::ByteClass::Texty)) < size) {
+        const size_t end = RadamsaByteScan::FindEndOfRun(bytes, size, pos, RadamsaByteScan::ByteClass::Texty);
+        ranges.push_back(TextRange{pos, end - pos});
+        pos = end;
     }
 
-    void mutate(VmfRand* rand) {
-        vector<size_t> textChunkIndices;
-        for (size_t i = 0; i < chunks.size(); ++i) {
-            if (holds_alternative<vector<Text>>(chunks[i].value))
-                textChunkIndices.push_back(i);
-        }
-        if(textChunkIndices.empty()) return;
-
-        const size_t chunkIndex = rand->randBetween(0, int(textChunkIndices.size() - 1));
-        vector<Text>& textElems = get<vector<Text>>(
-            chunks[textChunkIndices[chunkIndex]].value
-        );
-        const size_t elemIndex = rand->randBetween(0, int(textElems.size() - 1));    
-        textElems[elemIndex].mutate(rand);
-
-        return;
-    }
+    return ranges;
+}
 
-    vector<Byte> unlex() const {
-        vector<Byte> out;
-        out.reserve(chunks.size() * 16);
-        for (const Data& d : chunks) {
-            d.unlex(out);
-        }
-        return out;
-    }
+void appendBadness(RadamsaMutatorBase::SegmentBuilder& output, VmfRand* rand) {
+    // Randomly concatenate 1-19 "silly strings", straight from the table
 
-private:
-    static bool isTexty(Byte b) noexcept {
-        return b == 9 || b == 10 || b == 13 || (b >= 32 && b <= 126);
+    int repeatCount = rand->randBetween(1, 19);
+    for (int i = 0; i < repeatCount; ++i) {
+        const std::string_view s = sillyStrings[rand->randBetween(0, int(sillyStrings.size() - 1))];
+        output.Append(s.data(), s.size());
     }
-    
-    static bool parseBytes(
-        const vector<Byte>& input, 
-        size_t minTexty, 
-        vector<Data>& out
-    ) {
-        // Splits input into Data chunks
-        // The first chunk must be a run of a least "minTexty" printable ASCII bytes
-
-        size_t pos = 0;
-        size_t start = pos;
-        // min size check
-        while (pos < input.size() && Ascii::isTexty(input[pos])) {
-            ++pos;
-        }
-        if ((pos - start) < minTexty) return false;
-
-        // Grab first text chunk
-        vector<Byte> slice(input.begin(), input.begin() + pos);
-        vector<Text> firstRun;
-        firstRun.push_back(Text::texty(slice));
-        out.insert(out.begin(), Data{firstRun});
-
-        // Process remainder
-        start = pos;
-        while (pos < input.size()) {
-            if (Ascii::isTexty(input[pos])) {
-                ++pos;
-            } else {
-                // if we just finished a texty run [start, pos), capture it
-                if (pos > start) {
-                    vector<Byte> nextSlice(input.begin() + start, input.begin() + pos);
-                    vector<Text> t;
-                    t.push_back(Text::texty(nextSlice));
-                    out.push_back(Data{t});
-                }
-                // treat the current non-text byte as its own Data chunk
-                out.push_back(Data{vector<Byte>{input[pos]}});
-                ++pos;
-                start = pos; // reset start for next run
-            }
-        }
-
-        // if input ends in the middle of a texty run [start, input.size()), capture the run
-        if (pos > start) {
-            vector<Byte> finalSlice(input.begin() + start, input.begin() + pos);
-            vector<Text> finalTexty;
-            finalTexty.push_back(Text::texty(finalSlice));
-            out.push_back(Data{finalTexty});
-        }
+}
 
-        return true;
+size_t getNewlineCount(VmfRand* rand) {
+    switch (rand->randBetween(0, 10)) {
+        case 0: return 127;
+        case 1: return 128;
+        case 2: return 255;
+        case 3: return 256;
+        case 4: return 16383;
+        case 5: return 16384;
+        case 6: return 32767;
+        case 7: return 32768;
+        case 8: return 65535;
+        case 9: return 65536;
+        default: return rand->randBetween(0, 1023);
     }
-};
+}
+}
 
 void RadamsaAsciiBadMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
@@ -396,21 +219,44 @@ void RadamsaAsciiBadMutator::mutateTestCase(StorageModule& storage, StorageEntry
         return;
     }
 
-    vector<uint8_t> data(originalBuffer, originalBuffer + originalSize);
+    // The text ranges are lexed once per entry and shared; the output is spliced together from the input
+    const std::shared_ptr<const vector<TextRange>> cachedRanges{RadamsaParseCache::getInstance()->GetOrParse<vector<TextRange>>(
+        storage, baseEntry, originalBuffer, originalSize,
+        [&]() { return lexText(originalBuffer, originalSize); },
+        [](const vector<TextRange>& ranges) { return sizeof(vector<TextRange>) + ranges.capacity() * sizeof(TextRange); })};
+    const vector<TextRange>& textRanges{*cachedRanges};
 
-    optional<Ascii> parsedAscii = Ascii::parse(data);
-    // Check if ASCII parsing was successful
-    if (!parsedAscii)
+    // Check if the buffer starts with text
+    if (textRanges.empty())
     {
         CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
         return;
     }
 
-    parsedAscii->mutate(this->rand);
-    vector<Byte> mutatedBytes = parsedAscii->unlex();
+    const TextRange& text = textRanges[this->rand->randBetween(0, int(textRanges.size() - 1))];
+    const size_t split = text.offset + this->rand->randBetween(0, int(text.length));
+    size_t resume = split;
+
+    SegmentBuilder& output{BeginOutput()};
+    output.Append(originalBuffer, split);
+    switch (this->rand->randBetween(0, 2)) {
+        case 0:
+            // insert badness
+            appendBadness(output, this->rand);
+            break;
+        case 1:
+            // replace the rest of the text with badness
+            appendBadness(output, this->rand);
+            resume = text.offset + text.length;
+            break;
+        case 2:
+            // insert a random number of newline characters
+            output.AppendFill(getNewlineCount(this->rand), '\n');
+            break;
+    }
 
-    const size_t newBufferSize{mutatedBytes.size() + 1}; // +1 to implicitly append a null terminator
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
-    memcpy(newBuffer, mutatedBytes.data(), mutatedBytes.size());
-}
\ No newline at end of file
+    output
+        .Append(originalBuffer + resume, originalSize - resume)
+        .AppendNullTerminator()
+        .Write(newEntry, testCaseKey);
+}
@@ -49,6 +49,7 @@ class RadamsaAsciiBadMutator: public MutatorModule, public RadamsaByteMutatorBas
         RadamsaAsciiBadMutator(std::string name);
         virtual ~RadamsaAsciiBadMutator();
         virtual void registerStorageNeeds(StorageRegistry& registry);
+        virtual void registerMetadataNeeds(StorageRegistry& registry);
         virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
 
     private:
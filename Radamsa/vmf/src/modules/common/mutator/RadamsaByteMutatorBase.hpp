@@ -30,9 +30,14 @@
 
 #pragma once
 
+#include "RadamsaByteScan.hpp"
 #include "RadamsaMutatorBase.hpp"
+#include "RadamsaSuffixArray.hpp"
 #include <set>
 #include <optional>
+#include <array>
+#include <cctype>
+#include <charconv>
 
 using std::vector;
 using std::isdigit;
@@ -51,11 +56,22 @@ class RadamsaByteMutatorBase: public RadamsaMutatorBase
 {
 public:
     struct NumInfo {
-        unsigned int value = 0;
-        size_t offset = 0;
-        size_t length = 0;
+        enum class Format : uint8_t { Decimal, Hex, Fraction };
+
+        uint64_t value = 0;         // magnitude of the integer part
+        size_t offset = 0;          // first byte of the number, including a sign or 0x prefix
+        size_t length = 0;          // bytes the number spans, including a fraction
+        size_t integerLength = 0;   // bytes of the sign or prefix and the integer digits; the fraction follows them
+        bool negative = false;
+        bool upperCase = false;     // hex digits were written in upper case
+        Format format = Format::Decimal;
     };
 
+    /**
+     * @brief Room needed by FormatTextualNumber: a 0x prefix or sign and up to 20 digits
+     */
+    static constexpr size_t MaxFormattedNumberSize{32u};
+
     static size_t GetRandomRepetitionLength(VmfRand* rand) noexcept
     {
         constexpr size_t MINIMUM_UPPER_LIMIT{0x2u};
@@ -99,196 +115,236 @@ public:
         return result;
     }
 
-    vector<NumInfo> extractTextualNumbers(const vector<uint8_t>& data) {
-        // Converts and extracts ASCII numbers given a vector of bytes
+    static constexpr int getHexDigitValue(const char c) noexcept {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    vector<NumInfo> extractTextualNumbers(const char* bytes, size_t size) {
+        // Finds the ASCII numbers in a buffer: decimal integers, optionally negative or with a fraction, and 0x hex
+        // integers. Digit runs are located with the vectorized byte scanner and parsed in place; numbers whose
+        // magnitude does not fit 64 bits (63 bits plus one when negative) are skipped.
 
         vector<NumInfo> result;
-        size_t i = 0;
-        while (i < data.size()) {
-            if (isdigit(data[i])) {
-                size_t start = i;
-                while (i < data.size() && isdigit(data[i])) ++i;   // find length of number
-
-                std::string numStr(data.begin() + start, data.begin() + i);
-                try {
-                    unsigned long long val = std::stoull(numStr);
-                    if (val <= std::numeric_limits<unsigned int>::max()) {
-                        result.push_back({static_cast<unsigned int>(val), start, i - start});
-                    }
-                    // else: too large for ui, skip
-                } 
-                catch(const std::invalid_argument& e) {
-                    // invalid number, skip
-                }   
-                catch(const std::out_of_range& e) {
-                    // too large for ull, skip
+        size_t i = RadamsaByteScan::FindNextInClass(bytes, size, 0, RadamsaByteScan::ByteClass::Digit);
+        while (i < size) {
+            const size_t start = i;
+            i = RadamsaByteScan::FindEndOfRun(bytes, size, i, RadamsaByteScan::ByteClass::Digit);   // find length of number
+
+            NumInfo num;
+            num.offset = start;
+            if (i == start + 1 && bytes[start] == '0' && i + 1 < size && (bytes[i] == 'x' || bytes[i] == 'X') &&
+                getHexDigitValue(bytes[i + 1]) >= 0) {
+                size_t end = i + 1;
+                bool fits = true;
+                for (; end < size; ++end) {
+                    const int digit = getHexDigitValue(bytes[end]);
+                    if (digit < 0) break;
+                    if ((num.value >> 60) != 0) fits = false;
+                    num.value = (num.value << 4) | static_cast<uint64_t>(digit);
+                    num.upperCase = num.upperCase || (bytes[end] >= 'A' && bytes[end] <= 'F');
                 }
+                num.format = NumInfo::Format::Hex;
+                num.length = end - start;
+                num.integerLength = num.length;
+                i = end;
+                if (fits) result.push_back(num);
             }
-            else ++i;
-        }
+            else {
+                bool fits = true;
+                for (size_t it = start; it < i && fits; ++it) {
+                    const uint64_t digit = static_cast<uint64_t>(bytes[it] - '0');
+                    if (num.value > (UINT64_MAX - digit) / 10u) fits = false;
+                    else num.value = num.value * 10u + digit;
+                }
 
-        return result;
-    }
+                // a minus sign counts unless it follows a word or another number, as in a-5 or 2024-01-01
+                if (start > 0 && bytes[start - 1] == '-' && (start == 1 || !std::isalnum(static_cast<unsigned char>(bytes[start - 2])))) {
+                    num.negative = true;
+                    num.offset = start - 1;
+                    fits = fits && num.value <= (uint64_t{1} << 63);
+                }
+                num.integerLength = i - num.offset;
 
-    vector<unsigned int> generateInterestingNumbers() {
-        vector<unsigned int> result;
-        vector<unsigned int> shifts = {1, 7, 8, 15, 16, 31};    // truncating from original rust, as unsigned ints are only 32b
+                if (i + 1 < size && bytes[i] == '.' && RadamsaByteScan::IsInClass(bytes[i + 1], RadamsaByteScan::ByteClass::Digit)) {
+                    num.format = NumInfo::Format::Fraction;
+                    i = RadamsaByteScan::FindEndOfRun(bytes, size, i + 1, RadamsaByteScan::ByteClass::Digit);
+                }
+                num.length = i - num.offset;
+                if (fits) result.push_back(num);
+            }
 
-        for (unsigned int s : shifts) {
-            unsigned int val = 1ULL << s;
-            result.push_back(val);
-            result.push_back(val - 1);
-            result.push_back(val + 1);
+            i = RadamsaByteScan::FindNextInClass(bytes, size, i, RadamsaByteScan::ByteClass::Digit);
         }
 
         return result;
     }
 
-    template<typename T>
-    pair<vector<vector<T>>, vector<vector<T>>> getAlternateSuffixes(
-        const vector<T>& theList, 
-        VmfRand* rand
-    ) {
-        // getSuffixes, but randomize which output list gets each suffix
-        // NOTE: Very likely to return an empty pair for small buffer sizes
-
-        vector<vector<T>> listA, listB;
-        vector<T> subListA, subListB;
-        for (size_t i = 0; i < theList.size(); ++i) {
-            if (rand->randBetween(0, 1) == 0) {
-                subListA.assign(theList.begin() + i, theList.end());
-                if(!subListB.empty()) {
-                    listB.push_back(move(subListB));
-                    subListB.clear();
-                }
-            } else {
-                subListB.assign(theList.begin() + i, theList.end());
-                if(!subListA.empty()) {
-                    listA.push_back(move(subListA));
-                    subListA.clear();
-                }
-            }
+    /**
+     * @brief Writes the sign or 0x prefix and the digits of a new value for number, in number's notation
+     *
+     * The fraction of a Fraction number is not written; it is kept from the original buffer.
+     *
+     * @param original - Buffer number was found in
+     * @param destination - At least MaxFormattedNumberSize bytes
+     * @return size_t - Number of bytes written
+     */
+    static size_t FormatTextualNumber(
+                                      const NumInfo& number,
+                                      const uint64_t magnitude,
+                                      const bool negative,
+                                      const char* const original,
+                                      char* const destination) noexcept
+    {
+        char* position{destination};
+        if (number.format == NumInfo::Format::Hex)
+        {
+            *position++ = original[number.offset];
+            *position++ = original[number.offset + 1u];
+        }
+        else if (negative)
+        {
+            *position++ = '-';
         }
-        return {listA, listB};
-    }
-
-    template<typename T>
-    vector<vector<T>> getSuffixes(const vector<T>& theList) {
-        // Grabs all possible slices that end at theList's end
 
-        vector<vector<T>> result;
-        for(size_t i = 0; i < theList.size(); ++i) {
-            result.push_back(vector<T>(theList.begin() + i, theList.end()));
+        char* const digits{position};
+        position = std::to_chars(position, destination + MaxFormattedNumberSize, magnitude,
+                                 (number.format == NumInfo::Format::Hex) ? 16 : 10).ptr;
+        if (number.upperCase)
+        {
+            for (char* digit{digits}; digit != position; ++digit)
+                *digit = static_cast<char>(std::toupper(static_cast<unsigned char>(*digit)));
         }
-        return result;
-    }
 
-    template<typename T>
-    pair<vector<vector<T>>, vector<vector<T>>> getInitialSuffixes(
-        const vector<T>& a, 
-        const vector<T>& b, 
-        VmfRand* rand
-    ) {
-        if (a == b) return getAlternateSuffixes(a, rand);
-        return {getSuffixes(a), getSuffixes(b)};
+        return static_cast<size_t>(position - destination);
     }
 
-    template<typename T>
-    optional<pair<vector<T>, vector<T>>> getAnyPositionPair(
-        vector<vector<T>>& a, 
-        vector<vector<T>>& b, 
-        VmfRand* rand
-    ) {
-        if (a.empty() || b.empty()) return nullopt;
-
-        size_t aIndex = rand->randBetween(0, int(a.size() - 1)); // -1 because randBetween is max inclusive
-        size_t bIndex = rand->randBetween(0, int(b.size() - 1));
-        vector<T> aElem = a[aIndex];
-        vector<T> bElem = b[bIndex];
-        return pair<vector<T>, vector<T>>(aElem, bElem);
-    }
+    static constexpr size_t InterestingShiftCount{8u};
 
-    template<typename T>
-    pair<vector<vector<T>>, vector<vector<T>>> splitPrefixes(
-        vector<vector<T>>& prefixes, 
-        vector<vector<T>>& suffixes
-    ) {
-        set<T> used;
-        set<vector<T>> hashSuffix;
-        vector<vector<T>> newPrefixes;
-        for (vector<T> prefix : prefixes) {
-            if(!prefix.empty() && used.find(prefix[0]) == used.end()) { // if first char of this prefix hasn't been seen yet...
-                used.insert(prefix[0]);
-                newPrefixes.push_back(prefix);
-                suffixes.erase( // erase-remove idiom. moves all suffixes shorter than prefix to hashSuffix
-                    std::remove_if( // shifts matching elements to the end
-                        suffixes.begin(), 
-                        suffixes.end(), 
-                        [&](const vector<T>& suffix) {
-                            if (suffix.size() < prefix.size()) {
-                                hashSuffix.insert(suffix);  // stores them in hashSuffix prior to removal from suffixes
-                                return true;
-                            }
-                            return false;
-                        }
-                    ),
-                    suffixes.end()  // marks matching elements for erasure
-                );
-            }
+    /**
+     * @brief 2^s - 1, 2^s and 2^s + 1 for each of the shifts 1, 7, 8, 15, 16, 31, 32 and 63, built at compile time
+     */
+    static constexpr std::array<uint64_t, 3u * InterestingShiftCount> InterestingNumbers{[]() {
+        constexpr unsigned int shifts[InterestingShiftCount]{1u, 7u, 8u, 15u, 16u, 31u, 32u, 63u};
+        std::array<uint64_t, 3u * InterestingShiftCount> result{};
+        for (size_t it{0u}; it < InterestingShiftCount; ++it)
+        {
+            const uint64_t value{uint64_t{1} << shifts[it]};
+            result[3u * it] = value;
+            result[3u * it + 1u] = value - 1u;
+            result[3u * it + 2u] = value + 1u;
         }
-        return {
-            newPrefixes, 
-            vector<vector<T>>(hashSuffix.begin(), hashSuffix.end()) // convert set of slices to vector of slices
-        };
-    }
+        return result;
+    }()};
 
-    template<typename T>
-    pair<vector<T>, vector<T>> findJumpPoints(
-        const vector<T>& a, 
-        const vector<T>& b, 
+    pair<size_t, size_t> findJumpPoints(
+        const char* a, 
+        size_t aSize, 
+        const char* b, 
+        size_t bSize, 
         VmfRand* rand
     ) {
-        // NOTE: Very likely to return a and b unmodified for small buffer sizes if a==b
+        // Returns an offset into a and an offset into b that are preceded by the same context, found by walking
+        // down the LCP intervals of a suffix array from the root, each step keeping only the suffixes that also
+        // agree on the next byte. When a == b the suffixes are split between the two sides at random.
+        // NOTE: Returns {0, 0} when one side ends up with no suffixes, which fuses to b unmodified
 
         int fuel = 100000;
         const int searchStopIp = 8;
 
-        auto [listA, listB] = getInitialSuffixes(a, b, rand);
-        if (listA.empty() || listB.empty()) return {a, b};
-
-        while (true) {
-            if (fuel < 0 || rand->randBetween(0, searchStopIp) == 0) {
-                if (auto result = getAnyPositionPair(listA, listB, rand)) return *result;
-                return {a, b};
-            } else {
-                auto [nodeA, nodeB] = splitPrefixes(listA, listB);
-                if (nodeA.empty() || nodeB.empty()) {
-                    if (auto result = getAnyPositionPair(listA, listB, rand)) return *result;
-                    return {a, b};
-                } else {
-                    listA = nodeA;
-                    listB = nodeB;
-                    fuel -= static_cast<int>(listA.size() + listB.size());
+        const bool self = (aSize == bSize) && (a == b || memcmp(a, b, aSize) == 0);
+        if (self) suffixArray.Build(a, aSize, nullptr, 0);
+        else suffixArray.Build(a, aSize, b, bSize);
+
+        const size_t n = suffixArray.GetSize();
+        suffixSides.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            if (self) suffixSides[i] = static_cast<uint8_t>(rand->randBetween(0, 1));
+            else suffixSides[i] = (i < aSize) ? sideA : ((i == aSize) ? sideNone : sideB);
+        }
+
+        size_t low = 0;
+        size_t high = n;
+        size_t depth = 0;
+        while (fuel >= 0 && rand->randBetween(0, searchStopIp) != 0) {
+            // children of [low, high) at depth + 1 start wherever the common prefix drops back to depth
+            childIntervals.clear();
+            size_t childStart = low;
+            uint8_t childSides = 0;
+            for (size_t k = low; k < high; ++k) {
+                if (k > low && suffixArray.GetLcp(k) <= depth) {
+                    if (childSides == (sideMaskA | sideMaskB)) childIntervals.emplace_back(childStart, k);
+                    childStart = k;
+                    childSides = 0;
                 }
+                const uint8_t side = suffixSides[suffixArray.GetSuffix(k)];
+                if (side != sideNone) childSides |= static_cast<uint8_t>(1u << side);
+            }
+            if (childSides == (sideMaskA | sideMaskB)) childIntervals.emplace_back(childStart, high);
+            if (childIntervals.empty()) break;
+
+            const auto& child = childIntervals[rand->randBelow(childIntervals.size())];
+            low = child.first;
+            high = child.second;
+            ++depth;
+            fuel -= static_cast<int>(high - low);
+        }
+
+        // Any suffix in the interval will do, as long as it continues past the shared context
+        const size_t bStart = self ? 0 : aSize + 1;
+        size_t countA = 0;
+        size_t countB = 0;
+        for (size_t k = low; k < high; ++k) {
+            const size_t position = suffixArray.GetSuffix(k);
+            if (suffixSides[position] == sideA && position + depth < aSize) ++countA;
+            else if (suffixSides[position] == sideB && position - bStart + depth < bSize) ++countB;
+        }
+        if (countA == 0 || countB == 0) return {0, 0};
+
+        size_t pickA = rand->randBelow(countA);
+        size_t pickB = rand->randBelow(countB);
+        pair<size_t, size_t> result{0, 0};
+        for (size_t k = low; k < high; ++k) {
+            const size_t position = suffixArray.GetSuffix(k);
+            if (suffixSides[position] == sideA && position + depth < aSize) {
+                if (pickA-- == 0) result.first = position + depth;
+            }
+            else if (suffixSides[position] == sideB && position - bStart + depth < bSize) {
+                if (pickB-- == 0) result.second = position - bStart + depth;
             }
         }
+        return result;
     }
 
-    template<typename T>
-    vector<T> fuse(const vector<T>& a, const vector<T>& b, VmfRand* rand) {
-        // Combines a prefix substring from "a" and a suffix substring from "b"
+    pair<size_t, size_t> getFuseJump(const char* a, size_t aSize, const char* b, size_t bSize, VmfRand* rand) {
+        // Returns where fusing "a" with "b" leaves "a" and enters "b"; an empty input fuses to "a" unmodified
         // NOTE: Very likely to return input unmodified for small buffer sizes if a==b
 
-        if (a.empty() || b.empty()) return a;
+        if (aSize == 0 || bSize == 0) return {aSize, bSize};
+        return findJumpPoints(a, aSize, b, bSize, rand);
+    }
+
+    void fuse(SegmentBuilder& output, const char* a, size_t aSize, const char* b, size_t bSize, VmfRand* rand) {
+        // Appends a prefix substring from "a" and a suffix substring from "b" to output, without copying either
 
-        auto [from, to] = findJumpPoints(a, b, rand);
-        
-        if (std::equal(from.begin(), from.end(), a.end() - from.size())) {
-            vector<T> result(a.begin(), a.end() - from.size()); // keep prefix
-            result.insert(result.end(), to.begin(), to.end());  // append suffix
-            return result;
-        }
-        return a;
+        const auto [from, to] = getFuseJump(a, aSize, b, bSize, rand);
+        output
+            .Append(a, from)            // keep prefix
+            .Append(b + to, bSize - to); // append suffix
     }
+
+private:
+    static constexpr uint8_t sideA{0};
+    static constexpr uint8_t sideB{1};
+    static constexpr uint8_t sideNone{2};
+    static constexpr uint8_t sideMaskA{1u << sideA};
+    static constexpr uint8_t sideMaskB{1u << sideB};
+
+    // Reused between fuses so that the search stops allocating once the largest input has been seen
+    RadamsaSuffixArray suffixArray;
+    vector<uint8_t> suffixSides;
+    vector<pair<size_t, size_t>> childIntervals;
 };
 }
\ No newline at end of file
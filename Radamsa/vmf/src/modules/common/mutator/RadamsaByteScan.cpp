@@ -0,0 +1,510 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#include "RadamsaByteScan.hpp"
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define RADAMSA_BYTE_SCAN_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define RADAMSA_TARGET_AVX2
+#else
+#define RADAMSA_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define RADAMSA_BYTE_SCAN_X86 0
+#endif
+
+using namespace vmf;
+
+namespace
+{
+constexpr size_t blockSize{64u};
+
+/**
+ * @brief Describes what the kernels are looking for: either a single byte value or a byte class
+ */
+struct Matcher
+{
+    bool IsSingleByte;
+    uint8_t Value;
+    RadamsaByteScan::ByteClass Class;
+
+    bool Matches(const uint8_t byte) const noexcept
+    {
+        return IsSingleByte ? (byte == Value) : RadamsaByteScan::IsInClass(byte, Class);
+    }
+};
+
+using BlockMaskFunction = uint64_t (*)(const uint8_t* const block, const Matcher& matcher);
+
+inline size_t PopCount(uint64_t value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_popcountll(value));
+#else
+    value = value - ((value >> 1u) & 0x5555555555555555ull);
+    value = (value & 0x3333333333333333ull) + ((value >> 2u) & 0x3333333333333333ull);
+    value = (value + (value >> 4u)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<size_t>((value * 0x0101010101010101ull) >> 56u);
+#endif
+}
+
+inline size_t CountTrailingZeros(const uint64_t value) noexcept
+{
+    // The value is never zero here
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_ctzll(value));
+#else
+    unsigned long index{0u};
+    _BitScanForward64(&index, value);
+    return static_cast<size_t>(index);
+#endif
+}
+
+template <RadamsaByteScan::ByteClass byteClass>
+uint64_t ScalarClassMask(const uint8_t* const block) noexcept
+{
+    uint64_t mask{0u};
+
+    for(size_t it{0u}; it < blockSize; ++it)
+        mask |= static_cast<uint64_t>(RadamsaByteScan::IsInClass(block[it], byteClass)) << it;
+
+    return mask;
+}
+
+uint64_t ScalarBlockMask(const uint8_t* const block, const Matcher& matcher)
+{
+    // Resolve the matcher once per block so that the per-byte loops stay branch free
+
+    if (matcher.IsSingleByte)
+    {
+        uint64_t mask{0u};
+
+        for(size_t it{0u}; it < blockSize; ++it)
+            mask |= static_cast<uint64_t>(block[it] == matcher.Value) << it;
+
+        return mask;
+    }
+
+    switch(matcher.Class)
+    {
+        case RadamsaByteScan::ByteClass::Newline:
+            return ScalarClassMask<RadamsaByteScan::ByteClass::Newline>(block);
+        case RadamsaByteScan::ByteClass::Digit:
+            return ScalarClassMask<RadamsaByteScan::ByteClass::Digit>(block);
+        case RadamsaByteScan::ByteClass::Printable:
+            return ScalarClassMask<RadamsaByteScan::ByteClass::Printable>(block);
+        case RadamsaByteScan::ByteClass::Texty:
+            return ScalarClassMask<RadamsaByteScan::ByteClass::Texty>(block);
+        case RadamsaByteScan::ByteClass::HighBit:
+            return ScalarClassMask<RadamsaByteScan::ByteClass::HighBit>(block);
+        case RadamsaByteScan::ByteClass::Structural:
+            return ScalarClassMask<RadamsaByteScan::ByteClass::Structural>(block);
+        case RadamsaByteScan::ByteClass::CodePointStart:
+            return ScalarClassMask<RadamsaByteScan::ByteClass::CodePointStart>(block);
+    }
+
+    return 0u;
+}
+
+#if RADAMSA_BYTE_SCAN_X86
+
+// Unsigned "value <= limit" per byte, since SSE2 and AVX2 only provide signed byte comparisons.
+
+inline __m128i LessOrEqual128(const __m128i value, const uint8_t limit) noexcept
+{
+    return _mm_cmpeq_epi8(_mm_min_epu8(value, _mm_set1_epi8(static_cast<char>(limit))), value);
+}
+
+inline __m128i InRange128(const __m128i value, const uint8_t low, const uint8_t high) noexcept
+{
+    return LessOrEqual128(_mm_sub_epi8(value, _mm_set1_epi8(static_cast<char>(low))), static_cast<uint8_t>(high - low));
+}
+
+inline __m128i Equal128(const __m128i value, const uint8_t byte) noexcept
+{
+    return _mm_cmpeq_epi8(value, _mm_set1_epi8(static_cast<char>(byte)));
+}
+
+inline __m128i Classify128(const __m128i value, const Matcher& matcher) noexcept
+{
+    if (matcher.IsSingleByte)
+        return Equal128(value, matcher.Value);
+
+    switch(matcher.Class)
+    {
+        case RadamsaByteScan::ByteClass::Newline:
+            return Equal128(value, '\n');
+        case RadamsaByteScan::ByteClass::Digit:
+            return InRange128(value, '0', '9');
+        case RadamsaByteScan::ByteClass::Printable:
+            return InRange128(value, ' ', '~');
+        case RadamsaByteScan::ByteClass::Texty:
+            return _mm_or_si128(
+                            _mm_or_si128(InRange128(value, ' ', '~'), Equal128(value, '\t')),
+                            _mm_or_si128(Equal128(value, '\n'), Equal128(value, '\r')));
+        case RadamsaByteScan::ByteClass::HighBit:
+            return value;   // movemask only looks at the most significant bit
+        case RadamsaByteScan::ByteClass::Structural:
+            // '\'' '(' ')' and '[' '\\' ']' are contiguous
+            return _mm_or_si128(
+                            _mm_or_si128(
+                                    _mm_or_si128(InRange128(value, '\'', ')'), InRange128(value, '[', ']')),
+                                    _mm_or_si128(Equal128(value, '"'), Equal128(value, '<'))),
+                            _mm_or_si128(
+                                    _mm_or_si128(Equal128(value, '>'), Equal128(value, '{')),
+                                    Equal128(value, '}')));
+        case RadamsaByteScan::ByteClass::CodePointStart:
+            // Continuation bytes are 0x80 - 0xBF
+            return _mm_xor_si128(InRange128(value, 0x80u, 0xBFu), _mm_set1_epi8(-1));
+    }
+
+    return _mm_setzero_si128();
+}
+
+uint64_t Sse2BlockMask(const uint8_t* const block, const Matcher& matcher)
+{
+    uint64_t mask{0u};
+
+    for(size_t it{0u}; it < blockSize; it += 16u)
+    {
+        const __m128i value{_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + it))};
+        const uint32_t laneMask{static_cast<uint32_t>(_mm_movemask_epi8(Classify128(value, matcher))) & 0xFFFFu};
+
+        mask |= static_cast<uint64_t>(laneMask) << it;
+    }
+
+    return mask;
+}
+
+RADAMSA_TARGET_AVX2 inline __m256i LessOrEqual256(const __m256i value, const uint8_t limit) noexcept
+{
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(value, _mm256_set1_epi8(static_cast<char>(limit))), value);
+}
+
+RADAMSA_TARGET_AVX2 inline __m256i InRange256(const __m256i value, const uint8_t low, const uint8_t high) noexcept
+{
+    return LessOrEqual256(_mm256_sub_epi8(value, _mm256_set1_epi8(static_cast<char>(low))), static_cast<uint8_t>(high - low));
+}
+
+RADAMSA_TARGET_AVX2 inline __m256i Equal256(const __m256i value, const uint8_t byte) noexcept
+{
+    return _mm256_cmpeq_epi8(value, _mm256_set1_epi8(static_cast<char>(byte)));
+}
+
+RADAMSA_TARGET_AVX2 inline __m256i Classify256(const __m256i value, const Matcher& matcher) noexcept
+{
+    if (matcher.IsSingleByte)
+        return Equal256(value, matcher.Value);
+
+    switch(matcher.Class)
+    {
+        case RadamsaByteScan::ByteClass::Newline:
+            return Equal256(value, '\n');
+        case RadamsaByteScan::ByteClass::Digit:
+            return InRange256(value, '0', '9');
+        case RadamsaByteScan::ByteClass::Printable:
+            return InRange256(value, ' ', '~');
+        case RadamsaByteScan::ByteClass::Texty:
+            return _mm256_or_si256(
+                                _mm256_or_si256(InRange256(value, ' ', '~'), Equal256(value, '\t')),
+                                _mm256_or_si256(Equal256(value, '\n'), Equal256(value, '\r')));
+        case RadamsaByteScan::ByteClass::HighBit:
+            return value;
+        case RadamsaByteScan::ByteClass::Structural:
+            return _mm256_or_si256(
+                                _mm256_or_si256(
+                                            _mm256_or_si256(InRange256(value, '\'', ')'), InRange256(value, '[', ']')),
+                                            _mm256_or_si256(Equal256(value, '"'), Equal256(value, '<'))),
+                                _mm256_or_si256(
+                                            _mm256_or_si256(Equal256(value, '>'), Equal256(value, '{')),
+                                            Equal256(value, '}')));
+        case RadamsaByteScan::ByteClass::CodePointStart:
+            return _mm256_xor_si256(InRange256(value, 0x80u, 0xBFu), _mm256_set1_epi8(-1));
+    }
+
+    return _mm256_setzero_si256();
+}
+
+RADAMSA_TARGET_AVX2 uint64_t Avx2BlockMask(const uint8_t* const block, const Matcher& matcher)
+{
+    const __m256i low{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block))};
+    const __m256i high{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32u))};
+
+    const uint32_t lowMask{static_cast<uint32_t>(_mm256_movemask_epi8(Classify256(low, matcher)))};
+    const uint32_t highMask{static_cast<uint32_t>(_mm256_movemask_epi8(Classify256(high, matcher)))};
+
+    return (static_cast<uint64_t>(highMask) << 32u) | lowMask;
+}
+
+bool HostSupportsAvx2() noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // AVX2 also needs the OS to save the YMM registers on a context switch
+    __cpuid(info, 1);
+    const bool osSavesYmm{((info[2] & (1 << 27)) != 0) && ((_xgetbv(0) & 0x6u) == 0x6u)};
+
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && ((info[1] & (1 << 5)) != 0);
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+BlockMaskFunction GetBlockMaskFunction(const RadamsaByteScan::Path path) noexcept
+{
+    switch(path)
+    {
+#if RADAMSA_BYTE_SCAN_X86
+        case RadamsaByteScan::Path::AVX2:
+            return Avx2BlockMask;
+        case RadamsaByteScan::Path::SSE2:
+            return Sse2BlockMask;
+#endif
+        default:
+            return ScalarBlockMask;
+    }
+}
+
+RadamsaByteScan::Path GetFastestPath() noexcept
+{
+    if (RadamsaByteScan::IsPathSupported(RadamsaByteScan::Path::AVX2))
+        return RadamsaByteScan::Path::AVX2;
+
+    if (RadamsaByteScan::IsPathSupported(RadamsaByteScan::Path::SSE2))
+        return RadamsaByteScan::Path::SSE2;
+
+    return RadamsaByteScan::Path::Scalar;
+}
+
+std::atomic<RadamsaByteScan::Path>& ActivePath() noexcept
+{
+    static std::atomic<RadamsaByteScan::Path> activePath{GetFastestPath()};
+
+    return activePath;
+}
+
+size_t CountMatches(
+                    const uint8_t* const buffer,
+                    const size_t size,
+                    const Matcher& matcher)
+{
+    const BlockMaskFunction blockMask{GetBlockMaskFunction(ActivePath().load(std::memory_order_relaxed))};
+
+    size_t count{0u};
+    size_t it{0u};
+
+    for(; it + blockSize <= size; it += blockSize)
+        count += PopCount(blockMask(buffer + it, matcher));
+
+    for(; it < size; ++it)
+        count += matcher.Matches(buffer[it]) ? 1u : 0u;
+
+    return count;
+}
+
+size_t FindFirst(
+                 const uint8_t* const buffer,
+                 const size_t size,
+                 const size_t start,
+                 const Matcher& matcher,
+                 const bool matching)
+{
+    const BlockMaskFunction blockMask{GetBlockMaskFunction(ActivePath().load(std::memory_order_relaxed))};
+
+    size_t it{start};
+
+    for(; it + blockSize <= size; it += blockSize)
+    {
+        const uint64_t mask{matching ? blockMask(buffer + it, matcher) : ~blockMask(buffer + it, matcher)};
+
+        if (mask != 0u)
+            return it + CountTrailingZeros(mask);
+    }
+
+    for(; it < size; ++it)
+        if (matcher.Matches(buffer[it]) == matching)
+            return it;
+
+    return size;
+}
+}
+
+size_t RadamsaByteScan::CountByte(
+                                  const char* const buffer,
+                                  const size_t size,
+                                  const uint8_t value)
+{
+    return CountMatches(reinterpret_cast<const uint8_t*>(buffer), size, Matcher{true, value, ByteClass::Newline});
+}
+
+size_t RadamsaByteScan::FindNextByte(
+                                     const char* const buffer,
+                                     const size_t size,
+                                     const size_t start,
+                                     const uint8_t value)
+{
+    return FindFirst(reinterpret_cast<const uint8_t*>(buffer), size, start, Matcher{true, value, ByteClass::Newline}, true);
+}
+
+size_t RadamsaByteScan::CountInClass(
+                                     const char* const buffer,
+                                     const size_t size,
+                                     const ByteClass byteClass)
+{
+    return CountMatches(reinterpret_cast<const uint8_t*>(buffer), size, Matcher{false, 0u, byteClass});
+}
+
+size_t RadamsaByteScan::FindNextInClass(
+                                        const char* const buffer,
+                                        const size_t size,
+                                        const size_t start,
+                                        const ByteClass byteClass)
+{
+    return FindFirst(reinterpret_cast<const uint8_t*>(buffer), size, start, Matcher{false, 0u, byteClass}, true);
+}
+
+size_t RadamsaByteScan::FindEndOfRun(
+                                     const char* const buffer,
+                                     const size_t size,
+                                     const size_t start,
+                                     const ByteClass byteClass)
+{
+    return FindFirst(reinterpret_cast<const uint8_t*>(buffer), size, start, Matcher{false, 0u, byteClass}, false);
+}
+
+void RadamsaByteScan::GetClassBitmask(
+                                      const char* const buffer,
+                                      const size_t size,
+                                      const ByteClass byteClass,
+                                      uint64_t* const bitmask)
+{
+    const BlockMaskFunction blockMask{GetBlockMaskFunction(ActivePath().load(std::memory_order_relaxed))};
+    const uint8_t* const bytes{reinterpret_cast<const uint8_t*>(buffer)};
+    const Matcher matcher{false, 0u, byteClass};
+
+    size_t it{0u};
+
+    for(; it + blockSize <= size; it += blockSize)
+        bitmask[it / blockSize] = blockMask(bytes + it, matcher);
+
+    if (it < size)
+    {
+        uint64_t mask{0u};
+
+        for(size_t bit{0u}; it + bit < size; ++bit)
+            mask |= static_cast<uint64_t>(matcher.Matches(bytes[it + bit])) << bit;
+
+        bitmask[it / blockSize] = mask;
+    }
+}
+
+void RadamsaByteScan::GetClassBitmasks(
+                                       const char* const buffer,
+                                       const size_t size,
+                                       const ByteClass firstClass,
+                                       uint64_t* const firstBitmask,
+                                       const ByteClass secondClass,
+                                       uint64_t* const secondBitmask)
+{
+    const BlockMaskFunction blockMask{GetBlockMaskFunction(ActivePath().load(std::memory_order_relaxed))};
+    const uint8_t* const bytes{reinterpret_cast<const uint8_t*>(buffer)};
+    const Matcher firstMatcher{false, 0u, firstClass};
+    const Matcher secondMatcher{false, 0u, secondClass};
+
+    size_t it{0u};
+
+    // The second classification reads the block back from L1, so the buffer is only streamed from memory once
+    for(; it + blockSize <= size; it += blockSize)
+    {
+        firstBitmask[it / blockSize] = blockMask(bytes + it, firstMatcher);
+        secondBitmask[it / blockSize] = blockMask(bytes + it, secondMatcher);
+    }
+
+    if (it < size)
+    {
+        uint64_t firstMask{0u};
+        uint64_t secondMask{0u};
+
+        for(size_t bit{0u}; it + bit < size; ++bit)
+        {
+            firstMask |= static_cast<uint64_t>(firstMatcher.Matches(bytes[it + bit])) << bit;
+            secondMask |= static_cast<uint64_t>(secondMatcher.Matches(bytes[it + bit])) << bit;
+        }
+
+        firstBitmask[it / blockSize] = firstMask;
+        secondBitmask[it / blockSize] = secondMask;
+    }
+}
+
+bool RadamsaByteScan::IsPathSupported(const Path path) noexcept
+{
+    switch(path)
+    {
+        case Path::Scalar:
+            return true;
+#if RADAMSA_BYTE_SCAN_X86
+        case Path::SSE2:
+            return true;    // SSE2 is part of the x86-64 baseline
+        case Path::AVX2:
+        {
+            static const bool hostSupportsAvx2{HostSupportsAvx2()};
+            return hostSupportsAvx2;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+RadamsaByteScan::Path RadamsaByteScan::GetActivePath() noexcept
+{
+    return ActivePath().load(std::memory_order_relaxed);
+}
+
+bool RadamsaByteScan::SetActivePath(const Path path) noexcept
+{
+    if (!IsPathSupported(path))
+        return false;
+
+    ActivePath().store(path, std::memory_order_relaxed);
+
+    return true;
+}
@@ -0,0 +1,169 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vmf
+{
+/**
+ * @brief Byte-class scanning kernels shared by the Radamsa text helpers
+ *
+ * Each scan is implemented on top of a single primitive that classifies a 64-byte block into a bitmask.
+ * SSE2 and AVX2 versions of that primitive are selected at runtime based on the host CPU, and a portable
+ * scalar version is used everywhere else. All offsets are relative to the start of the buffer, and the
+ * Find* methods return the buffer size when nothing is found.
+ */
+class RadamsaByteScan
+{
+public:
+    enum class ByteClass
+    {
+        Newline,    // '\n'
+        Digit,      // '0' - '9'
+        Printable,  // printable ASCII, ' ' - '~'
+        Texty,      // printable ASCII plus '\t', '\n' and '\r'
+        HighBit,    // bytes with the most significant bit set (UTF-8 lead and continuation bytes)
+        Structural, // brackets ()[]{}<>, the quotes '"' and '\'', and '\\'
+        CodePointStart  // bytes that are not UTF-8 continuation bytes (10xxxxxx), i.e. code point boundaries
+    };
+
+    enum class Path
+    {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    static size_t CountByte(
+                            const char* const buffer,
+                            const size_t size,
+                            const uint8_t value);
+
+    static size_t FindNextByte(
+                               const char* const buffer,
+                               const size_t size,
+                               const size_t start,
+                               const uint8_t value);
+
+    static size_t CountInClass(
+                               const char* const buffer,
+                               const size_t size,
+                               const ByteClass byteClass);
+
+    static size_t FindNextInClass(
+                                  const char* const buffer,
+                                  const size_t size,
+                                  const size_t start,
+                                  const ByteClass byteClass);
+
+    /**
+     * @brief Returns the index of the first byte at or after start that is not in the class,
+     * i.e. the end of the run of class bytes beginning at start
+     */
+    static size_t FindEndOfRun(
+                               const char* const buffer,
+                               const size_t size,
+                               const size_t start,
+                               const ByteClass byteClass);
+
+    /**
+     * @brief Sets bit (i % 64) of bitmask[i / 64] for every byte i in the class
+     *
+     * The bitmask must hold at least GetBitmaskWordCount(size) words.
+     */
+    static void GetClassBitmask(
+                                const char* const buffer,
+                                const size_t size,
+                                const ByteClass byteClass,
+                                uint64_t* const bitmask);
+
+    /**
+     * @brief Fills the bitmasks of two classes in a single pass over the buffer
+     *
+     * Both bitmasks must hold at least GetBitmaskWordCount(size) words.
+     */
+    static void GetClassBitmasks(
+                                 const char* const buffer,
+                                 const size_t size,
+                                 const ByteClass firstClass,
+                                 uint64_t* const firstBitmask,
+                                 const ByteClass secondClass,
+                                 uint64_t* const secondBitmask);
+
+    static constexpr size_t GetBitmaskWordCount(const size_t size) noexcept
+    {
+        return (size + 63u) / 64u;
+    }
+
+    static bool IsInClass(
+                          const uint8_t value,
+                          const ByteClass byteClass) noexcept
+    {
+        switch(byteClass)
+        {
+            case ByteClass::Newline:
+                return value == '\n';
+            case ByteClass::Digit:
+                return static_cast<uint8_t>(value - '0') <= 9u;
+            case ByteClass::Printable:
+                return static_cast<uint8_t>(value - ' ') <= ('~' - ' ');
+            case ByteClass::Texty:
+                return value == '\t' || value == '\n' || value == '\r' || static_cast<uint8_t>(value - ' ') <= ('~' - ' ');
+            case ByteClass::HighBit:
+                return (value & 0x80u) != 0u;
+            case ByteClass::Structural:
+                return static_cast<uint8_t>(value - '\'') <= 2u || value == '"' || value == '<' || value == '>' ||
+                       static_cast<uint8_t>(value - '[') <= 2u || value == '{' || value == '}';
+            case ByteClass::CodePointStart:
+                return (value & 0xC0u) != 0x80u;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Returns true if the host CPU (and the build) supports the given path
+     */
+    static bool IsPathSupported(const Path path) noexcept;
+
+    /**
+     * @brief Returns the path currently used by the scans, which defaults to the fastest supported path
+     */
+    static Path GetActivePath() noexcept;
+
+    /**
+     * @brief Forces the scans onto the given path, which is used to compare paths in tests and benchmarks
+     *
+     * @return false (leaving the active path unchanged) if the path is not supported
+     */
+    static bool SetActivePath(const Path path) noexcept;
+};
+}
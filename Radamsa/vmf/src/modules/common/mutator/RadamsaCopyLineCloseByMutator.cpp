@@ -38,15 +38,21 @@ using namespace vmf;
 
 #include "ModuleFactory.hpp"
 REGISTER_MODULE(RadamsaCopyLineCloseByMutator);
+REGISTER_MODULE(RadamsaCopyCrLfRecordCloseByMutator);
+REGISTER_MODULE(RadamsaCopyNulRecordCloseByMutator);
+REGISTER_MODULE(RadamsaCopySemicolonRecordCloseByMutator);
+REGISTER_MODULE(RadamsaCopyCommaRecordCloseByMutator);
+REGISTER_MODULE(RadamsaCopyFieldRecordCloseByMutator);
 
 /**
  * @brief Builder method to support the ModuleFactory
  * Constructs an instance of this class
  * @return Module* - Pointer to the newly created instance
  */
-Module* RadamsaCopyLineCloseByMutator::build(std::string name)
+template <typename Delimiter>
+Module* RadamsaCopyRecordCloseByMutator<Delimiter>::build(std::string name)
 {
-    return new RadamsaCopyLineCloseByMutator(name);
+    return new RadamsaCopyRecordCloseByMutator<Delimiter>(name);
 }
 
 /**
@@ -54,26 +60,29 @@ Module* RadamsaCopyLineCloseByMutator::build(std::string name)
  *
  * @param config - Configuration object
  */
-void RadamsaCopyLineCloseByMutator::init(ConfigInterface& config)
+template <typename Delimiter>
+void RadamsaCopyRecordCloseByMutator<Delimiter>::init(ConfigInterface& config)
 {
-
+    SetStreamingThreshold(config.getIntParam(getModuleName(), "streamingThreshold", DefaultStreamingThreshold));
 }
 
 /**
- * @brief Construct a new RadamsaCopyLineCloseByMutator::RadamsaCopyLineCloseByMutator object
+ * @brief Construct a new RadamsaCopyRecordCloseByMutator::RadamsaCopyRecordCloseByMutator object
  *
  * @param name The of the name module
  */
-RadamsaCopyLineCloseByMutator::RadamsaCopyLineCloseByMutator(std::string name) : MutatorModule(name)
+template <typename Delimiter>
+RadamsaCopyRecordCloseByMutator<Delimiter>::RadamsaCopyRecordCloseByMutator(std::string name) : MutatorModule(name)
 {
     // rand.randInit();
 }
 
 /**
- * @brief Destroy the RadamsaCopyLineCloseByMutator::RadamsaCopyLineCloseByMutator object
+ * @brief Destroy the RadamsaCopyRecordCloseByMutator::RadamsaCopyRecordCloseByMutator object
  *
  */
-RadamsaCopyLineCloseByMutator::~RadamsaCopyLineCloseByMutator()
+template <typename Delimiter>
+RadamsaCopyRecordCloseByMutator<Delimiter>::~RadamsaCopyRecordCloseByMutator()
 {
 
 }
@@ -83,13 +92,27 @@ RadamsaCopyLineCloseByMutator::~RadamsaCopyLineCloseByMutator()
  *
  * @param registry - StorageRegistry object
  */
-void RadamsaCopyLineCloseByMutator::registerStorageNeeds(StorageRegistry& registry)
+template <typename Delimiter>
+void RadamsaCopyRecordCloseByMutator<Delimiter>::registerStorageNeeds(StorageRegistry& registry)
 {
     // This module does not register for a test case buffer key, because mutators are told which buffer to write in storage
     // by the input generator that calls them
 }
 
-void RadamsaCopyLineCloseByMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+template <typename Delimiter>
+void RadamsaCopyRecordCloseByMutator<Delimiter>::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
+
+template <typename Delimiter>
+void RadamsaCopyRecordCloseByMutator<Delimiter>::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
     // Consume the original buffer by copying a line to a random location and appending a null-terminator to the end.
 
@@ -131,11 +154,40 @@ void RadamsaCopyLineCloseByMutator::mutateTestCase(StorageModule& storage, Stora
         return;
     }
 
-    const size_t numberOfLinesAfterIndex{
-                                    GetNumberOfLinesAfterIndex(
-                                                        originalBuffer,
-                                                        originalSize,
-                                                        characterIndex)};
+    if (IsStreamingSize(originalSize))
+    {
+        // Very large input: sample the source and destination lines independently, one pass each,
+        // instead of indexing every line.
+
+        const Line lineDataSource{SampleLineStreaming<Delimiter>(originalBuffer, originalSize, rand)};
+
+        if (!lineDataSource.IsValid)
+        {
+            CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+            return;
+        }
+
+        const Line lineDataDestination{SampleLineStreaming<Delimiter>(originalBuffer, originalSize, rand)};
+
+        BeginOutput()
+            .Append(originalBuffer, lineDataDestination.StartIndex)
+            .Append(originalBuffer + lineDataSource.StartIndex, lineDataSource.Size)
+            .Append(originalBuffer + lineDataDestination.StartIndex, originalSize - lineDataDestination.StartIndex)
+            .AppendNullTerminator()
+            .Write(newEntry, testCaseKey);
+
+        return;
+    }
+
+    const LineIndex& lineIndex{GetLineIndex<Delimiter>(storage, baseEntry, originalBuffer, originalSize)};
+    const size_t numberOfLinesAfterIndex{lineIndex.GetNumberOfLines()};
+
+    // Check if buffer has minimum required number of lines
+    if (numberOfLinesAfterIndex < 1u)
+    {
+        CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+        return;
+    }
 
     // Select random line to copy from/to.
 
@@ -151,44 +203,27 @@ void RadamsaCopyLineCloseByMutator::mutateTestCase(StorageModule& storage, Stora
                                                     minimumRandomLineOffset,
                                                     numberOfLinesAfterIndex - 1u)};
 
-    const Line lineDataSource{
-                        GetLineData(
-                                originalBuffer,
-                                originalSize,
-                                randomLineIndexSource,
-                                numberOfLinesAfterIndex)};
-
-    const Line lineDataDestination{
-                            GetLineData(
-                                    originalBuffer,
-                                    originalSize,
-                                    randomLineIndexDestination,
-                                    numberOfLinesAfterIndex)};
-
-    // The new buffer will be one line larger than the original buffer;
-    // additionally, it will contain one additional byte since a null-terminator will be appended to the end.
-
-    const size_t newBufferSize{originalSize + lineDataSource.Size + 1u};
-
-    // Allocate the new buffer and set it's elements to zero.
+    // The new buffer holds the original data with the source line inserted in front of the destination line,
+    // followed by a null-terminator.
 
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
+    const LineVector sourceLine{lineIndex.GetLineVector(randomLineIndexSource)};
+    const LineVector linesBefore{lineIndex.GetLines(0u, randomLineIndexDestination)};
+    const LineVector linesAfter{lineIndex.GetLinesToEnd(randomLineIndexDestination)};
 
-    // Copy data from the original buffer into the new buffer, but copy the random line.
-    // The last element in the new buffer is skipped since it was implicitly set to zero during allocation.
-
-    for(size_t sourceIndex{0u}, destinationIndex{0u}; sourceIndex < originalSize; ++sourceIndex)
-    {
-        if(sourceIndex == lineDataDestination.StartIndex)
-        {
-            memcpy(&newBuffer[destinationIndex], &originalBuffer[lineDataSource.StartIndex], lineDataSource.Size);
-
-            destinationIndex += lineDataSource.Size;
-        }
-
-        newBuffer[destinationIndex] = originalBuffer[sourceIndex];
+    BeginOutput()
+        .Append(linesBefore.Data, linesBefore.Size)
+        .Append(sourceLine.Data, sourceLine.Size)
+        .Append(linesAfter.Data, linesAfter.Size)
+        .AppendNullTerminator()
+        .Write(newEntry, testCaseKey);
+}
 
-        ++destinationIndex;
-    }
+namespace vmf
+{
+template class RadamsaCopyRecordCloseByMutator<NewlineDelimiter>;
+template class RadamsaCopyRecordCloseByMutator<CrLfDelimiter>;
+template class RadamsaCopyRecordCloseByMutator<NulDelimiter>;
+template class RadamsaCopyRecordCloseByMutator<SemicolonDelimiter>;
+template class RadamsaCopyRecordCloseByMutator<CommaDelimiter>;
+template class RadamsaCopyRecordCloseByMutator<FieldSeparatorDelimiter>;
 }
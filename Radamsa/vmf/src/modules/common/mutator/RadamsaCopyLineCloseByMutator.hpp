@@ -37,21 +37,30 @@
 namespace vmf
 {
 /**
- *
+ * @tparam Delimiter - Record delimiter policy (see RadamsaDelimiter.hpp)
  */
-class RadamsaCopyLineCloseByMutator: public MutatorModule, public RadamsaLineMutatorBase
+template <typename Delimiter>
+class RadamsaCopyRecordCloseByMutator: public MutatorModule, public RadamsaLineMutatorBase
 {
     public:
 
         static Module* build(std::string name);
         virtual void init(ConfigInterface& config);
 
-        RadamsaCopyLineCloseByMutator(std::string name);
-        virtual ~RadamsaCopyLineCloseByMutator();
+        RadamsaCopyRecordCloseByMutator(std::string name);
+        virtual ~RadamsaCopyRecordCloseByMutator();
         virtual void registerStorageNeeds(StorageRegistry& registry);
+        virtual void registerMetadataNeeds(StorageRegistry& registry);
         virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
 
     private:
         VmfRand* rand = VmfRand::getInstance();
 };
-}
\ No newline at end of file
+
+using RadamsaCopyLineCloseByMutator = RadamsaCopyRecordCloseByMutator<NewlineDelimiter>;
+using RadamsaCopyCrLfRecordCloseByMutator = RadamsaCopyRecordCloseByMutator<CrLfDelimiter>;
+using RadamsaCopyNulRecordCloseByMutator = RadamsaCopyRecordCloseByMutator<NulDelimiter>;
+using RadamsaCopySemicolonRecordCloseByMutator = RadamsaCopyRecordCloseByMutator<SemicolonDelimiter>;
+using RadamsaCopyCommaRecordCloseByMutator = RadamsaCopyRecordCloseByMutator<CommaDelimiter>;
+using RadamsaCopyFieldRecordCloseByMutator = RadamsaCopyRecordCloseByMutator<FieldSeparatorDelimiter>;
+}
@@ -140,20 +140,6 @@ void RadamsaDeleteByteSequenceMutator::mutateTestCase(StorageModule& storage, St
     const size_t end_upper{originalSize - 1u};
     const size_t end_index{rand->randBetween(end_lower, end_upper)};
 
-    // Calculate the size of the modified buffer
-    const size_t newBufferSize{originalSize - (end_index - start_index + 1u) + 1u};  // +1 because we're appending a null-terminator
-
-    // Allocate the new buffer and set it's elements to zero.
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, static_cast<int>(newBufferSize))};
-    memset(newBuffer, 0u, newBufferSize);
-
-    // Copy pre-sequence into modified buffer
-    memcpy(newBuffer, originalBuffer, start_index);
-
-    // Copy post-sequence into modified buffer
-    memcpy(
-        newBuffer, 
-        originalBuffer + end_index + 1u, 
-        originalSize - (end_index + 1u)
-    );
+    // Copy the pre-sequence and the post-sequence into the modified buffer
+    SpliceIntoNewEntry(newEntry, testCaseKey, originalBuffer, originalSize, start_index, end_index - start_index + 1u, nullptr, 0u);
 }
\ No newline at end of file
@@ -36,15 +36,21 @@ using namespace vmf;
 
 #include "ModuleFactory.hpp"
 REGISTER_MODULE(RadamsaDeleteLineMutator);
+REGISTER_MODULE(RadamsaDeleteCrLfRecordMutator);
+REGISTER_MODULE(RadamsaDeleteNulRecordMutator);
+REGISTER_MODULE(RadamsaDeleteSemicolonRecordMutator);
+REGISTER_MODULE(RadamsaDeleteCommaRecordMutator);
+REGISTER_MODULE(RadamsaDeleteFieldRecordMutator);
 
 /**
  * @brief Builder method to support the ModuleFactory
  * Constructs an instance of this class
  * @return Module* - Pointer to the newly created instance
  */
-Module* RadamsaDeleteLineMutator::build(std::string name)
+template <typename Delimiter>
+Module* RadamsaDeleteRecordMutator<Delimiter>::build(std::string name)
 {
-    return new RadamsaDeleteLineMutator(name);
+    return new RadamsaDeleteRecordMutator<Delimiter>(name);
 }
 
 /**
@@ -52,26 +58,29 @@ Module* RadamsaDeleteLineMutator::build(std::string name)
  *
  * @param config - Configuration object
  */
-void RadamsaDeleteLineMutator::init(ConfigInterface& config)
+template <typename Delimiter>
+void RadamsaDeleteRecordMutator<Delimiter>::init(ConfigInterface& config)
 {
-
+    SetStreamingThreshold(config.getIntParam(getModuleName(), "streamingThreshold", DefaultStreamingThreshold));
 }
 
 /**
- * @brief Construct a new RadamsaDeleteLineMutator::RadamsaDeleteLineMutator object
+ * @brief Construct a new RadamsaDeleteRecordMutator::RadamsaDeleteRecordMutator object
  *
  * @param name The of the name module
  */
-RadamsaDeleteLineMutator::RadamsaDeleteLineMutator(std::string name) : MutatorModule(name)
+template <typename Delimiter>
+RadamsaDeleteRecordMutator<Delimiter>::RadamsaDeleteRecordMutator(std::string name) : MutatorModule(name)
 {
     // rand.randInit();
 }
 
 /**
- * @brief Destroy the RadamsaDeleteLineMutator::RadamsaDeleteLineMutator object
+ * @brief Destroy the RadamsaDeleteRecordMutator::RadamsaDeleteRecordMutator object
  *
  */
-RadamsaDeleteLineMutator::~RadamsaDeleteLineMutator()
+template <typename Delimiter>
+RadamsaDeleteRecordMutator<Delimiter>::~RadamsaDeleteRecordMutator()
 {
 
 }
@@ -81,13 +90,27 @@ RadamsaDeleteLineMutator::~RadamsaDeleteLineMutator()
  *
  * @param registry - StorageRegistry object
  */
-void RadamsaDeleteLineMutator::registerStorageNeeds(StorageRegistry& registry)
+template <typename Delimiter>
+void RadamsaDeleteRecordMutator<Delimiter>::registerStorageNeeds(StorageRegistry& registry)
 {
     // This module does not register for a test case buffer key, because mutators are told which buffer to write in storage
     // by the input generator that calls them
 }
 
-void RadamsaDeleteLineMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+template <typename Delimiter>
+void RadamsaDeleteRecordMutator<Delimiter>::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
+
+template <typename Delimiter>
+void RadamsaDeleteRecordMutator<Delimiter>::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
     // Consume the original buffer by deleting a line from it and appending a null-terminator to the end.
 
@@ -130,11 +153,38 @@ void RadamsaDeleteLineMutator::mutateTestCase(StorageModule& storage, StorageEnt
         return;
     }
 
-    const size_t numberOfLinesAfterIndex{
-                                    GetNumberOfLinesAfterIndex(
-                                                            originalBuffer,
-                                                            originalSize,
-                                                            characterIndex)};
+    if (IsStreamingSize(originalSize))
+    {
+        // Very large input: sample the line to delete in one pass instead of indexing every line.
+
+        const Line lineData{SampleLineStreaming<Delimiter>(originalBuffer, originalSize, rand)};
+
+        if (!lineData.IsValid)
+        {
+            CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+            return;
+        }
+
+        const size_t lineEndIndex{lineData.StartIndex + lineData.Size};
+
+        BeginOutput()
+            .Append(originalBuffer, lineData.StartIndex)
+            .Append(originalBuffer + lineEndIndex, originalSize - lineEndIndex)
+            .AppendNullTerminator()
+            .Write(newEntry, testCaseKey);
+
+        return;
+    }
+
+    const LineIndex& lineIndex{GetLineIndex<Delimiter>(storage, baseEntry, originalBuffer, originalSize)};
+    const size_t numberOfLinesAfterIndex{lineIndex.GetNumberOfLines()};
+
+    // Check if buffer has minimum required number of lines
+    if (numberOfLinesAfterIndex < 1u)
+    {
+        CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+        return;
+    }
 
     // Select a random line to delete.
 
@@ -146,38 +196,29 @@ void RadamsaDeleteLineMutator::mutateTestCase(StorageModule& storage, StorageEnt
                                             minimumRandomLineIndex,
                                             maximumRandomLineIndex)};
 
-    const Line lineData{
-                    GetLineData(
-                            originalBuffer,
-                            originalSize,
-                            randomLineIndex,
-                            numberOfLinesAfterIndex)};
+    const Line lineData{lineIndex.GetLine(randomLineIndex)};
 
     // The new buffer will be one line smaller than the original buffer;
     // additionally, it will contain one additional byte since a null-terminator will be appended to the end.
 
     const size_t newBufferSize{originalSize - lineData.Size + 1u};
-    // const std::string message = ("numberOfLinesAfterIndex = " + std::to_string(numberOfLinesAfterIndex)); //deleteme
-    // throw RuntimeException(message.c_str()); //deleteme
-
-    // Allocate the new buffer and set it's elements to zero.
 
     char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
 
-    // Copy data from the original buffer into the new buffer, but skip the elements in the random line that is to be deleted.
-    // The last element in the new buffer is skipped since it was implicitly set to zero during allocation.
+    // Copy the lines before and after the deleted line straight from the original buffer and terminate the result.
 
-    for(size_t sourceIndex{0u}, destinationIndex{0u}; sourceIndex < originalSize; ++sourceIndex)
-    {
-        const size_t lineStartIndex{lineData.StartIndex};
-        const size_t lineEndIndex{lineStartIndex + lineData.Size};
+    char* destination{lineIndex.GetLines(0u, randomLineIndex).CopyTo(newBuffer)};
+    destination = lineIndex.GetLinesToEnd(randomLineIndex + 1u).CopyTo(destination);
 
-        if(sourceIndex < lineStartIndex || sourceIndex >= lineEndIndex)
-        {
-            newBuffer[destinationIndex] = originalBuffer[sourceIndex];
-            ++destinationIndex;
-        }
-    }
+    *destination = '\0';
 }
 
+namespace vmf
+{
+template class RadamsaDeleteRecordMutator<NewlineDelimiter>;
+template class RadamsaDeleteRecordMutator<CrLfDelimiter>;
+template class RadamsaDeleteRecordMutator<NulDelimiter>;
+template class RadamsaDeleteRecordMutator<SemicolonDelimiter>;
+template class RadamsaDeleteRecordMutator<CommaDelimiter>;
+template class RadamsaDeleteRecordMutator<FieldSeparatorDelimiter>;
+}
@@ -37,21 +37,30 @@
 namespace vmf
 {
 /**
- *
+ * @tparam Delimiter - Record delimiter policy (see RadamsaDelimiter.hpp)
  */
-class RadamsaDeleteLineMutator: public MutatorModule, public RadamsaLineMutatorBase
+template <typename Delimiter>
+class RadamsaDeleteRecordMutator: public MutatorModule, public RadamsaLineMutatorBase
 {
     public:
 
         static Module* build(std::string name);
         virtual void init(ConfigInterface& config);
 
-        RadamsaDeleteLineMutator(std::string name);
-        virtual ~RadamsaDeleteLineMutator();
+        RadamsaDeleteRecordMutator(std::string name);
+        virtual ~RadamsaDeleteRecordMutator();
         virtual void registerStorageNeeds(StorageRegistry& registry);
+        virtual void registerMetadataNeeds(StorageRegistry& registry);
         virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
 
     private:
         VmfRand* rand = VmfRand::getInstance();
 };
-}
\ No newline at end of file
+
+using RadamsaDeleteLineMutator = RadamsaDeleteRecordMutator<NewlineDelimiter>;
+using RadamsaDeleteCrLfRecordMutator = RadamsaDeleteRecordMutator<CrLfDelimiter>;
+using RadamsaDeleteNulRecordMutator = RadamsaDeleteRecordMutator<NulDelimiter>;
+using RadamsaDeleteSemicolonRecordMutator = RadamsaDeleteRecordMutator<SemicolonDelimiter>;
+using RadamsaDeleteCommaRecordMutator = RadamsaDeleteRecordMutator<CommaDelimiter>;
+using RadamsaDeleteFieldRecordMutator = RadamsaDeleteRecordMutator<FieldSeparatorDelimiter>;
+}
@@ -56,7 +56,7 @@ Module* RadamsaDeleteNodeMutator::build(std::string name)
  */
 void RadamsaDeleteNodeMutator::init(ConfigInterface& config)
 {
-
+    SetTreeSyntax(config.getStringParam(getModuleName(), "syntax", "parenthesized"));
 }
 
 /**
@@ -89,6 +89,17 @@ void RadamsaDeleteNodeMutator::registerStorageNeeds(StorageRegistry& registry)
     // by the input generator that calls them
 }
 
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+void RadamsaDeleteNodeMutator::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
+
 void RadamsaDeleteNodeMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
     // Delete a random node from the tree without preserving its children
@@ -130,24 +141,22 @@ void RadamsaDeleteNodeMutator::mutateTestCase(StorageModule& storage, StorageEnt
         return;
     }
 
-    const std::string treeStr(originalBuffer, originalSize);
-    Tree tr(treeStr);
+    // loading into the member tree reuses the node and value arenas of the previous mutation
+    LoadTree(tree, storage, baseEntry, originalBuffer, originalSize);
 
-    size_t numNodes = tr.countNodes(tr.root);
+    size_t numNodes = tree.countNodes(tree.root);
 
     const size_t lower{0u};
     const size_t upper{numNodes - 1};
     size_t nodeIndexToDelete{this->rand->randBetween(lower, upper)};    // not const, because findNodeByIndex will modify it
 
-    Node* nodeToDelete = tr.findNodeByIndex(tr.root, nodeIndexToDelete);
-    tr.deleteNode(nodeToDelete);
+    NodeId nodeToDelete = tree.findNodeByIndex(tree.root, nodeIndexToDelete);
+    tree.deleteNode(nodeToDelete);
 
-    string modTreeStr = tr.toString(tr.root);
-
-    const size_t newBufferSize{modTreeStr.length() + 1}; // +1 to implicitly append a null terminator
+    // size the output exactly, then serialize straight into the new buffer
+    const size_t modTreeSize{tree.getSerializedSize(tree.root)};
+    const size_t newBufferSize{modTreeSize + 1}; // +1 to implicitly append a null terminator
 
     char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
-
-    std::strcpy(newBuffer, modTreeStr.c_str());
+    *tree.serialize(tree.root, newBuffer) = '\0';
 }
\ No newline at end of file
@@ -38,15 +38,21 @@ using namespace vmf;
 
 #include "ModuleFactory.hpp"
 REGISTER_MODULE(RadamsaDeleteSequentialLinesMutator);
+REGISTER_MODULE(RadamsaDeleteSequentialCrLfRecordsMutator);
+REGISTER_MODULE(RadamsaDeleteSequentialNulRecordsMutator);
+REGISTER_MODULE(RadamsaDeleteSequentialSemicolonRecordsMutator);
+REGISTER_MODULE(RadamsaDeleteSequentialCommaRecordsMutator);
+REGISTER_MODULE(RadamsaDeleteSequentialFieldRecordsMutator);
 
 /**
  * @brief Builder method to support the ModuleFactory
  * Constructs an instance of this class
  * @return Module* - Pointer to the newly created instance
  */
-Module* RadamsaDeleteSequentialLinesMutator::build(std::string name)
+template <typename Delimiter>
+Module* RadamsaDeleteSequentialRecordsMutator<Delimiter>::build(std::string name)
 {
-    return new RadamsaDeleteSequentialLinesMutator(name);
+    return new RadamsaDeleteSequentialRecordsMutator<Delimiter>(name);
 }
 
 /**
@@ -54,26 +60,29 @@ Module* RadamsaDeleteSequentialLinesMutator::build(std::string name)
  *
  * @param config - Configuration object
  */
-void RadamsaDeleteSequentialLinesMutator::init(ConfigInterface& config)
+template <typename Delimiter>
+void RadamsaDeleteSequentialRecordsMutator<Delimiter>::init(ConfigInterface& config)
 {
-
+    SetStreamingThreshold(config.getIntParam(getModuleName(), "streamingThreshold", DefaultStreamingThreshold));
 }
 
 /**
- * @brief Construct a new RadamsaDeleteSequentialLinesMutator::RadamsaDeleteSequentialLinesMutator object
+ * @brief Construct a new RadamsaDeleteSequentialRecordsMutator::RadamsaDeleteSequentialRecordsMutator object
  *
  * @param name The of the name module
  */
-RadamsaDeleteSequentialLinesMutator::RadamsaDeleteSequentialLinesMutator(std::string name) : MutatorModule(name)
+template <typename Delimiter>
+RadamsaDeleteSequentialRecordsMutator<Delimiter>::RadamsaDeleteSequentialRecordsMutator(std::string name) : MutatorModule(name)
 {
     // rand.randInit();
 }
 
 /**
- * @brief Destroy the RadamsaDeleteSequentialLinesMutator::RadamsaDeleteSequentialLinesMutator object
+ * @brief Destroy the RadamsaDeleteSequentialRecordsMutator::RadamsaDeleteSequentialRecordsMutator object
  *
  */
-RadamsaDeleteSequentialLinesMutator::~RadamsaDeleteSequentialLinesMutator()
+template <typename Delimiter>
+RadamsaDeleteSequentialRecordsMutator<Delimiter>::~RadamsaDeleteSequentialRecordsMutator()
 {
 
 }
@@ -83,13 +92,27 @@ RadamsaDeleteSequentialLinesMutator::~RadamsaDeleteSequentialLinesMutator()
  *
  * @param registry - StorageRegistry object
  */
-void RadamsaDeleteSequentialLinesMutator::registerStorageNeeds(StorageRegistry& registry)
+template <typename Delimiter>
+void RadamsaDeleteSequentialRecordsMutator<Delimiter>::registerStorageNeeds(StorageRegistry& registry)
 {
     // This module does not register for a test case buffer key, because mutators are told which buffer to write in storage
     // by the input generator that calls them
 }
 
-void RadamsaDeleteSequentialLinesMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+template <typename Delimiter>
+void RadamsaDeleteSequentialRecordsMutator<Delimiter>::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
+
+template <typename Delimiter>
+void RadamsaDeleteSequentialRecordsMutator<Delimiter>::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
     // Consume the original buffer by deleting sequential lines from it and appending a null-terminator to the end.
 
@@ -132,11 +155,54 @@ void RadamsaDeleteSequentialLinesMutator::mutateTestCase(StorageModule& storage,
     }
 
 
-    const size_t numberOfLinesAfterIndex{
-                                    GetNumberOfLinesAfterIndex(
-                                                            originalBuffer,
-                                                            originalSize,
-                                                            characterIndex)};
+    if (IsStreamingSize(originalSize))
+    {
+        // Very large input: count the lines, then locate the first and last deleted line in a single pass
+        // instead of indexing every line.
+
+        const size_t numberOfLines{Delimiter::Count(originalBuffer, originalSize, 0u, originalSize)};
+
+        if (numberOfLines < 1u)
+        {
+            CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+            return;
+        }
+
+        const size_t minimumRandomLineOffset{0u};
+
+        const size_t randomLineIndexStart{
+                                    rand->randBetween(
+                                                    minimumRandomLineOffset,
+                                                    numberOfLines - 1u)};
+
+        const size_t randomLineIndexEnd{
+                                    rand->randBetween(
+                                                    minimumRandomLineOffset,
+                                                    (numberOfLines - 1u) - randomLineIndexStart) + randomLineIndexStart};
+
+        const size_t lineIndices[]{randomLineIndexStart, randomLineIndexEnd + 1u};
+        size_t lineOffsets[2];
+
+        GetLineOffsetsStreaming<Delimiter>(originalBuffer, originalSize, lineIndices, lineOffsets, 2u);
+
+        BeginOutput()
+            .Append(originalBuffer, lineOffsets[0])
+            .Append(originalBuffer + lineOffsets[1], originalSize - lineOffsets[1])
+            .AppendNullTerminator()
+            .Write(newEntry, testCaseKey);
+
+        return;
+    }
+
+    const LineIndex& lineIndex{GetLineIndex<Delimiter>(storage, baseEntry, originalBuffer, originalSize)};
+    const size_t numberOfLinesAfterIndex{lineIndex.GetNumberOfLines()};
+
+    // Check if buffer has minimum required number of lines
+    if (numberOfLinesAfterIndex < 1u)
+    {
+        CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+        return;
+    }
 
     // Select a random line to delete.
 
@@ -152,42 +218,31 @@ void RadamsaDeleteSequentialLinesMutator::mutateTestCase(StorageModule& storage,
                                                 minimumRandomLineOffset,
                                                 (numberOfLinesAfterIndex - 1u) - randomLineIndexStart) + randomLineIndexStart};
 
-    const Line startLineData{
-                        GetLineData(
-                                originalBuffer,
-                                originalSize,
-                                randomLineIndexStart,
-                                numberOfLinesAfterIndex)};
+    const Line startLineData{lineIndex.GetLine(randomLineIndexStart)};
 
-    const Line endLineData{
-                        GetLineData(
-                                originalBuffer,
-                                originalSize,
-                                randomLineIndexEnd,
-                                numberOfLinesAfterIndex)};
+    const Line endLineData{lineIndex.GetLine(randomLineIndexEnd)};
 
     // The new buffer will be multiple lines smaller than the original buffer;
     // additionally, it will contain one additional byte since a null-terminator will be appended to the end.
 
     const size_t newBufferSize{(originalSize - ((endLineData.StartIndex + endLineData.Size) - startLineData.StartIndex)) + 1u};
 
-    // Allocate the new buffer and set it's elements to zero.
-
     char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
 
-    // Copy data from the original buffer into the new buffer, but skip the elements in the random lines that are to be deleted.
-    // The last element in the new buffer is skipped since it was implicitly set to zero during allocation.
+    // Copy the lines before and after the deleted lines straight from the original buffer and terminate the result.
 
-    for(size_t sourceIndex{0u}, destinationIndex{0u}; sourceIndex < originalSize; ++sourceIndex)
-    {
-        const size_t lineStartIndex{startLineData.StartIndex};
-        const size_t lineEndIndex{endLineData.StartIndex + endLineData.Size};
+    char* destination{lineIndex.GetLines(0u, randomLineIndexStart).CopyTo(newBuffer)};
+    destination = lineIndex.GetLinesToEnd(randomLineIndexEnd + 1u).CopyTo(destination);
 
-        if(sourceIndex < lineStartIndex || sourceIndex >= lineEndIndex)
-        {
-            newBuffer[destinationIndex] = originalBuffer[sourceIndex];
-            ++destinationIndex;
-        }
-    }
+    *destination = '\0';
+}
+
+namespace vmf
+{
+template class RadamsaDeleteSequentialRecordsMutator<NewlineDelimiter>;
+template class RadamsaDeleteSequentialRecordsMutator<CrLfDelimiter>;
+template class RadamsaDeleteSequentialRecordsMutator<NulDelimiter>;
+template class RadamsaDeleteSequentialRecordsMutator<SemicolonDelimiter>;
+template class RadamsaDeleteSequentialRecordsMutator<CommaDelimiter>;
+template class RadamsaDeleteSequentialRecordsMutator<FieldSeparatorDelimiter>;
 }
@@ -37,21 +37,30 @@
 namespace vmf
 {
 /**
- *
+ * @tparam Delimiter - Record delimiter policy (see RadamsaDelimiter.hpp)
  */
-class RadamsaDeleteSequentialLinesMutator: public MutatorModule, public RadamsaLineMutatorBase
+template <typename Delimiter>
+class RadamsaDeleteSequentialRecordsMutator: public MutatorModule, public RadamsaLineMutatorBase
 {
     public:
 
         static Module* build(std::string name);
         virtual void init(ConfigInterface& config);
 
-        RadamsaDeleteSequentialLinesMutator(std::string name);
-        virtual ~RadamsaDeleteSequentialLinesMutator();
+        RadamsaDeleteSequentialRecordsMutator(std::string name);
+        virtual ~RadamsaDeleteSequentialRecordsMutator();
         virtual void registerStorageNeeds(StorageRegistry& registry);
+        virtual void registerMetadataNeeds(StorageRegistry& registry);
         virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
 
     private:
         VmfRand* rand = VmfRand::getInstance();
 };
-}
\ No newline at end of file
+
+using RadamsaDeleteSequentialLinesMutator = RadamsaDeleteSequentialRecordsMutator<NewlineDelimiter>;
+using RadamsaDeleteSequentialCrLfRecordsMutator = RadamsaDeleteSequentialRecordsMutator<CrLfDelimiter>;
+using RadamsaDeleteSequentialNulRecordsMutator = RadamsaDeleteSequentialRecordsMutator<NulDelimiter>;
+using RadamsaDeleteSequentialSemicolonRecordsMutator = RadamsaDeleteSequentialRecordsMutator<SemicolonDelimiter>;
+using RadamsaDeleteSequentialCommaRecordsMutator = RadamsaDeleteSequentialRecordsMutator<CommaDelimiter>;
+using RadamsaDeleteSequentialFieldRecordsMutator = RadamsaDeleteSequentialRecordsMutator<FieldSeparatorDelimiter>;
+}
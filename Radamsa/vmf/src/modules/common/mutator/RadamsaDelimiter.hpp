@@ -0,0 +1,161 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#pragma once
+
+#include "RadamsaByteScan.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace vmf
+{
+/**
+ * @brief Record delimiter policies for the line (record) mutators
+ *
+ * A record is a run of bytes terminated by a delimiter; bytes after the last delimiter do not belong to a record.
+ * Every policy provides:
+ *   Length                               - the number of bytes in a delimiter
+ *   FindNext(buffer, size, start)        - index of the first byte of the first delimiter that starts at or after
+ *                                          start and lies entirely within the buffer, or size if there is none
+ *   Count(buffer, size, start, end)      - number of such delimiters that start in [start, end)
+ * The mutators are templates on the policy, so each delimiter test compiles to its own inner loop.
+ */
+template <char Delimiter>
+struct SingleByteDelimiter
+{
+    static constexpr size_t Length{1u};
+
+    static size_t FindNext(
+                           const char* const buffer,
+                           const size_t size,
+                           const size_t start)
+    {
+        return RadamsaByteScan::FindNextByte(buffer, size, start, static_cast<uint8_t>(Delimiter));
+    }
+
+    static size_t Count(
+                        const char* const buffer,
+                        const size_t size,
+                        const size_t start,
+                        const size_t end)
+    {
+        return RadamsaByteScan::CountByte(buffer + start, end - start, static_cast<uint8_t>(Delimiter));
+    }
+};
+
+/**
+ * @brief Two-byte "\r\n" delimiter, as used by line-based network protocols
+ *
+ * A lone '\r' or '\n' is ordinary record content.
+ */
+struct CrLfDelimiter
+{
+    static constexpr size_t Length{2u};
+
+    static size_t FindNext(
+                           const char* const buffer,
+                           const size_t size,
+                           const size_t start)
+    {
+        // Look for the '\n' and check the byte in front of it, since '\n' is the rarer byte in text
+        for(size_t newlineIndex{RadamsaByteScan::FindNextByte(buffer, size, start + 1u, '\n')};
+            newlineIndex < size;
+            newlineIndex = RadamsaByteScan::FindNextByte(buffer, size, newlineIndex + 1u, '\n'))
+        {
+            if (buffer[newlineIndex - 1u] == '\r')
+                return newlineIndex - 1u;
+        }
+
+        return size;
+    }
+
+    static size_t Count(
+                        const char* const buffer,
+                        const size_t size,
+                        const size_t start,
+                        const size_t end)
+    {
+        // A delimiter starting at end - 1 ends just past the window, so it may read one byte beyond end
+        const size_t searchSize{(end < size) ? end + 1u : size};
+        size_t numberOfDelimiters{0u};
+
+        for(size_t it{FindNext(buffer, searchSize, start)}; it < searchSize; it = FindNext(buffer, searchSize, it + Length))
+            ++numberOfDelimiters;
+
+        return numberOfDelimiters;
+    }
+};
+
+/**
+ * @brief Single-byte delimiter that may be any byte of a fixed set, e.g. the field separators of a tabular format
+ */
+template <char... Delimiters>
+struct ByteSetDelimiter
+{
+    static_assert(sizeof...(Delimiters) != 0u, "A byte set delimiter needs at least one byte");
+
+    static constexpr size_t Length{1u};
+
+    static constexpr bool IsDelimiter(const char value) noexcept
+    {
+        return ((value == Delimiters) || ...);
+    }
+
+    static size_t FindNext(
+                           const char* const buffer,
+                           const size_t size,
+                           const size_t start)
+    {
+        for(size_t it{start}; it < size; ++it)
+            if (IsDelimiter(buffer[it]))
+                return it;
+
+        return size;
+    }
+
+    static size_t Count(
+                        const char* const buffer,
+                        const size_t size,
+                        const size_t start,
+                        const size_t end)
+    {
+        size_t numberOfDelimiters{0u};
+
+        for(size_t it{start}; it < end; ++it)
+            numberOfDelimiters += IsDelimiter(buffer[it]) ? 1u : 0u;
+
+        return numberOfDelimiters;
+    }
+};
+
+using NewlineDelimiter = SingleByteDelimiter<'\n'>;
+using NulDelimiter = SingleByteDelimiter<'\0'>;
+using SemicolonDelimiter = SingleByteDelimiter<';'>;
+using CommaDelimiter = SingleByteDelimiter<','>;
+using FieldSeparatorDelimiter = ByteSetDelimiter<',', ';', '\t', '|'>;
+}
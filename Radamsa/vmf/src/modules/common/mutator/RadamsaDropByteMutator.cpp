@@ -130,15 +130,6 @@ void RadamsaDropByteMutator::mutateTestCase(StorageModule& storage, StorageEntry
         return;
     }
 
-    // The new buffer will contain one less byte, but a null-terminator will be appended to the end; therefore, the sizes will be equal.
-
-    const size_t newBufferSize{originalSize};
-
-    // Allocate the new buffer and set it's elements to zero.
-
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
-
     // Select a random byte to drop from the original buffer.
 
     const size_t lower{0u};
@@ -152,16 +143,8 @@ void RadamsaDropByteMutator::mutateTestCase(StorageModule& storage, StorageEntry
                                                         lower,
                                                         upper)};
 
-    // Copy data from the original buffer into the new buffer, but exclude the random byte.
-    // The last element in the new buffer is skipped since it was implicitly set to zero during allocation.
-    
-    for (size_t sourceIndex{0u}, destinationIndex{0u}; sourceIndex < originalSize; ++sourceIndex)
-    {
-        if (sourceIndex != randomIndexToDrop)
-        {
-            newBuffer[destinationIndex] = originalBuffer[sourceIndex];
+    // Copy data from the original buffer into a new buffer, but exclude the random byte.
+    // The new buffer will contain one less byte, but a null-terminator will be appended to the end; therefore, the sizes will be equal.
 
-            ++destinationIndex;
-        }
-    }
+    SpliceIntoNewEntry(newEntry, testCaseKey, originalBuffer, originalSize, randomIndexToDrop, 1u, nullptr, 0u);
 }
@@ -38,15 +38,21 @@ using namespace vmf;
 
 #include "ModuleFactory.hpp"
 REGISTER_MODULE(RadamsaDuplicateLineMutator);
+REGISTER_MODULE(RadamsaDuplicateCrLfRecordMutator);
+REGISTER_MODULE(RadamsaDuplicateNulRecordMutator);
+REGISTER_MODULE(RadamsaDuplicateSemicolonRecordMutator);
+REGISTER_MODULE(RadamsaDuplicateCommaRecordMutator);
+REGISTER_MODULE(RadamsaDuplicateFieldRecordMutator);
 
 /**
  * @brief Builder method to support the ModuleFactory
  * Constructs an instance of this class
  * @return Module* - Pointer to the newly created instance
  */
-Module* RadamsaDuplicateLineMutator::build(std::string name)
+template <typename Delimiter>
+Module* RadamsaDuplicateRecordMutator<Delimiter>::build(std::string name)
 {
-    return new RadamsaDuplicateLineMutator(name);
+    return new RadamsaDuplicateRecordMutator<Delimiter>(name);
 }
 
 /**
@@ -54,26 +60,29 @@ Module* RadamsaDuplicateLineMutator::build(std::string name)
  *
  * @param config - Configuration object
  */
-void RadamsaDuplicateLineMutator::init(ConfigInterface& config)
+template <typename Delimiter>
+void RadamsaDuplicateRecordMutator<Delimiter>::init(ConfigInterface& config)
 {
-
+    SetStreamingThreshold(config.getIntParam(getModuleName(), "streamingThreshold", DefaultStreamingThreshold));
 }
 
 /**
- * @brief Construct a new RadamsaDuplicateLineMutator::RadamsaDuplicateLineMutator object
+ * @brief Construct a new RadamsaDuplicateRecordMutator::RadamsaDuplicateRecordMutator object
  *
  * @param name The of the name module
  */
-RadamsaDuplicateLineMutator::RadamsaDuplicateLineMutator(std::string name) : MutatorModule(name)
+template <typename Delimiter>
+RadamsaDuplicateRecordMutator<Delimiter>::RadamsaDuplicateRecordMutator(std::string name) : MutatorModule(name)
 {
     // rand.randInit();
 }
 
 /**
- * @brief Destroy the RadamsaDuplicateLineMutator::RadamsaDuplicateLineMutator object
+ * @brief Destroy the RadamsaDuplicateRecordMutator::RadamsaDuplicateRecordMutator object
  *
  */
-RadamsaDuplicateLineMutator::~RadamsaDuplicateLineMutator()
+template <typename Delimiter>
+RadamsaDuplicateRecordMutator<Delimiter>::~RadamsaDuplicateRecordMutator()
 {
 
 }
@@ -83,13 +92,27 @@ RadamsaDuplicateLineMutator::~RadamsaDuplicateLineMutator()
  *
  * @param registry - StorageRegistry object
  */
-void RadamsaDuplicateLineMutator::registerStorageNeeds(StorageRegistry& registry)
+template <typename Delimiter>
+void RadamsaDuplicateRecordMutator<Delimiter>::registerStorageNeeds(StorageRegistry& registry)
 {
     // This module does not register for a test case buffer key, because mutators are told which buffer to write in storage
     // by the input generator that calls them
 }
 
-void RadamsaDuplicateLineMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+template <typename Delimiter>
+void RadamsaDuplicateRecordMutator<Delimiter>::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
+
+template <typename Delimiter>
+void RadamsaDuplicateRecordMutator<Delimiter>::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
     // Consume the original buffer by duplicating a line from it and appending a null-terminator to the end.
 
@@ -131,70 +154,70 @@ void RadamsaDuplicateLineMutator::mutateTestCase(StorageModule& storage, Storage
         return;
     }
 
-    const size_t numberOfLinesAfterIndex{
-                                    GetNumberOfLinesAfterIndex(
-                                                        originalBuffer,
-                                                        originalSize,
-                                                        characterIndex)};
-
-    // Select a random line to duplicate.
+    if (IsStreamingSize(originalSize))
+    {
+        // Very large input: sample the line to duplicate in one pass instead of indexing every line.
 
-    constexpr size_t minimumRandomLineIndex{0u};
-    const size_t maximumRandomLineIndex{numberOfLinesAfterIndex - 1u};
+        const Line lineData{SampleLineStreaming<Delimiter>(originalBuffer, originalSize, rand)};
 
-    const size_t randomLineIndex{
-                            rand->randBetween(
-                                            minimumRandomLineIndex,
-                                            maximumRandomLineIndex)};
+        if (!lineData.IsValid)
+        {
+            CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+            return;
+        }
 
-    const Line lineData{
-                    GetLineData(
-                            originalBuffer,
-                            originalSize,
-                            randomLineIndex,
-                            numberOfLinesAfterIndex)};
+        const size_t lineEndIndex{lineData.StartIndex + lineData.Size};
 
-    // The new buffer will be one line larger than the original buffer;
-    // additionally, it will contain one additional byte since a null-terminator will be appended to the end.
+        BeginOutput()
+            .Append(originalBuffer, lineEndIndex)
+            .Append(originalBuffer + lineData.StartIndex, lineData.Size)
+            .Append(originalBuffer + lineEndIndex, originalSize - lineEndIndex)
+            .AppendNullTerminator()
+            .Write(newEntry, testCaseKey);
 
-    const size_t newBufferSize{originalSize + lineData.Size + 1u};
-
-    // Allocate the new buffer and set it's elements to zero.
+        return;
+    }
 
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
+    const LineIndex& lineIndex{GetLineIndex<Delimiter>(storage, baseEntry, originalBuffer, originalSize)};
+    const size_t numberOfLinesAfterIndex{lineIndex.GetNumberOfLines()};
 
-    // Copy data from the original buffer into the new buffer, but duplicate the random line.
-    // The last element in the new buffer is skipped since it was implicitly set to zero during allocation.
+    // Check if buffer has minimum required number of lines
+    if (numberOfLinesAfterIndex < 1u)
     {
-        // Copy all of the elements including the line that is to be duplicated.
-
-        const size_t numberOfBytes{lineData.StartIndex + lineData.Size};
-
-        char* destination{newBuffer};
-        const char* source{originalBuffer};
-        memcpy(destination, source, numberOfBytes);
+        CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+        return;
     }
 
-    {
-        // Duplicate the line.
-
-        const size_t numberOfBytes{lineData.Size};
+    // Select a random line to duplicate.
 
-        char* destination{newBuffer + lineData.StartIndex + lineData.Size};
-        const char* source{originalBuffer + lineData.StartIndex};
+    constexpr size_t minimumRandomLineIndex{0u};
+    const size_t maximumRandomLineIndex{numberOfLinesAfterIndex - 1u};
 
-        memcpy(destination, source, numberOfBytes);
-    }
+    const size_t randomLineIndex{
+                            rand->randBetween(
+                                            minimumRandomLineIndex,
+                                            maximumRandomLineIndex)};
 
-    {
-        // Copy all of the elements after the line that was duplicated.
+    // The new buffer holds the original data with the random line written twice, followed by a null-terminator.
 
-        const size_t numberOfBytes{originalSize - (lineData.StartIndex + lineData.Size)};
+    const LineVector line{lineIndex.GetLineVector(randomLineIndex)};
+    const LineVector linesBefore{lineIndex.GetLines(0u, randomLineIndex + 1u)};
+    const LineVector linesAfter{lineIndex.GetLinesToEnd(randomLineIndex + 1u)};
 
-        char* destination{newBuffer + lineData.StartIndex + 2 * lineData.Size};
-        const char* source{originalBuffer + lineData.StartIndex + lineData.Size};
+    BeginOutput()
+        .Append(linesBefore.Data, linesBefore.Size)
+        .Append(line.Data, line.Size)
+        .Append(linesAfter.Data, linesAfter.Size)
+        .AppendNullTerminator()
+        .Write(newEntry, testCaseKey);
+}
 
-        memcpy(destination, source, numberOfBytes);
-    }
+namespace vmf
+{
+template class RadamsaDuplicateRecordMutator<NewlineDelimiter>;
+template class RadamsaDuplicateRecordMutator<CrLfDelimiter>;
+template class RadamsaDuplicateRecordMutator<NulDelimiter>;
+template class RadamsaDuplicateRecordMutator<SemicolonDelimiter>;
+template class RadamsaDuplicateRecordMutator<CommaDelimiter>;
+template class RadamsaDuplicateRecordMutator<FieldSeparatorDelimiter>;
 }
@@ -37,21 +37,30 @@
 namespace vmf
 {
 /**
- *
+ * @tparam Delimiter - Record delimiter policy (see RadamsaDelimiter.hpp)
  */
-class RadamsaDuplicateLineMutator: public MutatorModule, public RadamsaLineMutatorBase
+template <typename Delimiter>
+class RadamsaDuplicateRecordMutator: public MutatorModule, public RadamsaLineMutatorBase
 {
     public:
 
         static Module* build(std::string name);
         virtual void init(ConfigInterface& config);
 
-        RadamsaDuplicateLineMutator(std::string name);
-        virtual ~RadamsaDuplicateLineMutator();
+        RadamsaDuplicateRecordMutator(std::string name);
+        virtual ~RadamsaDuplicateRecordMutator();
         virtual void registerStorageNeeds(StorageRegistry& registry);
+        virtual void registerMetadataNeeds(StorageRegistry& registry);
         virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
 
     private:
         VmfRand* rand = VmfRand::getInstance();
 };
-}
\ No newline at end of file
+
+using RadamsaDuplicateLineMutator = RadamsaDuplicateRecordMutator<NewlineDelimiter>;
+using RadamsaDuplicateCrLfRecordMutator = RadamsaDuplicateRecordMutator<CrLfDelimiter>;
+using RadamsaDuplicateNulRecordMutator = RadamsaDuplicateRecordMutator<NulDelimiter>;
+using RadamsaDuplicateSemicolonRecordMutator = RadamsaDuplicateRecordMutator<SemicolonDelimiter>;
+using RadamsaDuplicateCommaRecordMutator = RadamsaDuplicateRecordMutator<CommaDelimiter>;
+using RadamsaDuplicateFieldRecordMutator = RadamsaDuplicateRecordMutator<FieldSeparatorDelimiter>;
+}
@@ -56,7 +56,7 @@ Module* RadamsaDuplicateNodeMutator::build(std::string name)
  */
 void RadamsaDuplicateNodeMutator::init(ConfigInterface& config)
 {
-
+    SetTreeSyntax(config.getStringParam(getModuleName(), "syntax", "parenthesized"));
 }
 
 /**
@@ -89,6 +89,17 @@ void RadamsaDuplicateNodeMutator::registerStorageNeeds(StorageRegistry& registry
     // by the input generator that calls them
 }
 
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+void RadamsaDuplicateNodeMutator::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
+
 void RadamsaDuplicateNodeMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
     // Duplicates existing node, including its children, and adds it to the same parent as the original
@@ -131,10 +142,10 @@ void RadamsaDuplicateNodeMutator::mutateTestCase(StorageModule& storage, Storage
         return;
     }
 
-    const std::string treeStr(originalBuffer, originalSize);
-    Tree tr(treeStr);
+    // loading into the member tree reuses the node and value arenas of the previous mutation
+    LoadTree(tree, storage, baseEntry, originalBuffer, originalSize);
 
-    size_t numNodes = tr.countNodes(tr.root);
+    size_t numNodes = tree.countNodes(tree.root);
     // Check if tree has minimum required number of nodes
     if (numNodes < minimumNodes)
     {
@@ -145,15 +156,14 @@ void RadamsaDuplicateNodeMutator::mutateTestCase(StorageModule& storage, Storage
     const size_t lower{1u};
     const size_t upper{numNodes - 2};
     size_t nodeIndexToDuplicate{this->rand->randBetween(lower, upper)}; // not const, because findNodeByIndex will modify it
-    Node* nodeToDuplicate = tr.findNodeByIndex(tr.root, nodeIndexToDuplicate); 
+    NodeId nodeToDuplicate = tree.findNodeByIndex(tree.root, nodeIndexToDuplicate); 
 
-    tr.duplicateNode(nodeToDuplicate, nodeToDuplicate->parent);
+    tree.duplicateNode(nodeToDuplicate, tree.getNode(nodeToDuplicate).parent);
 
-    const string modTreeStr = tr.toString(tr.root);
-    const size_t newBufferSize{modTreeStr.length() + 1}; // +1 to implicitly append a null terminator
+    // size the output exactly, then serialize straight into the new buffer
+    const size_t modTreeSize{tree.getSerializedSize(tree.root)};
+    const size_t newBufferSize{modTreeSize + 1}; // +1 to implicitly append a null terminator
 
     char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
-
-    std::strcpy(newBuffer, modTreeStr.c_str());
+    *tree.serialize(tree.root, newBuffer) = '\0';
 }
\ No newline at end of file
@@ -49,9 +49,11 @@ class RadamsaDuplicateNodeMutator: public MutatorModule, public RadamsaTreeMutat
         RadamsaDuplicateNodeMutator(std::string name);
         virtual ~RadamsaDuplicateNodeMutator();
         virtual void registerStorageNeeds(StorageRegistry& registry);
+        virtual void registerMetadataNeeds(StorageRegistry& registry);
         virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
 
     private:
         VmfRand* rand = VmfRand::getInstance();
+        Tree tree;
 };
 }
\ No newline at end of file
@@ -130,15 +130,9 @@ void RadamsaFlipByteMutator::mutateTestCase(StorageModule& storage, StorageEntry
         return;
     }
 
-    // The new buffer size will contain one additional element since we are appending a null-terminator to the end.
+    // Copy the original buffer into a new buffer with a null-terminator appended to the end; bytes are then changed in place.
 
-    const size_t newBufferSize{originalSize + 1u};
-
-    // Allocate the new buffer, set it's elements to those of the original buffer, and append a null-terminator to the end.
-
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, static_cast<int>(newBufferSize))};
-    memset(newBuffer, 0u, newBufferSize);
-    memcpy(newBuffer, originalBuffer, originalSize);
+    char* newBuffer{CopyIntoNewEntry(newEntry, testCaseKey, originalBuffer, originalSize)};
 
     // Select a random byte to drop from the original buffer.
 
@@ -0,0 +1,198 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2024 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+ /**
+  *
+  */
+#include "RadamsaFuseCorpusMutator.hpp"
+#include "RuntimeException.hpp"
+#include <algorithm>
+
+using namespace vmf;
+
+#include "ModuleFactory.hpp"
+REGISTER_MODULE(RadamsaFuseCorpusMutator);
+
+/**
+ * @brief Builder method to support the ModuleFactory
+ * Constructs an instance of this class
+ * @return Module* - Pointer to the newly created instance
+ */
+Module* RadamsaFuseCorpusMutator::build(std::string name)
+{
+    return new RadamsaFuseCorpusMutator(name);
+}
+
+/**
+ * @brief Initialization method
+ *
+ * @param config - Configuration object
+ */
+void RadamsaFuseCorpusMutator::init(ConfigInterface& config)
+{
+    SetMaxIndexSize(config.getIntParam(getModuleName(), "maxIndexSize", DefaultMaxIndexSize));
+}
+
+/**
+ * @brief Sets the number of bytes the k-gram index may hold
+ *
+ * @param size - Index budget in bytes; the oldest entries are dropped from the index beyond it
+ */
+void RadamsaFuseCorpusMutator::SetMaxIndexSize(const int size)
+{
+    if (size <= 0)
+        throw RuntimeException{"The maximum index size must be positive", RuntimeException::CONFIGURATION_ERROR};
+
+    index.SetByteBudget(static_cast<size_t>(size));
+}
+
+/**
+ * @brief Construct a new RadamsaFuseCorpusMutator::RadamsaFuseCorpusMutator object
+ *
+ * @param name The of the name module
+ */
+RadamsaFuseCorpusMutator::RadamsaFuseCorpusMutator(std::string name) : MutatorModule(name)
+{
+    // rand->randInit();
+}
+
+/**
+ * @brief Destroy the RadamsaFuseCorpusMutator::RadamsaFuseCorpusMutator object
+ *
+ */
+RadamsaFuseCorpusMutator::~RadamsaFuseCorpusMutator()
+{
+
+}
+
+/**
+ * @brief Register the storage needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+void RadamsaFuseCorpusMutator::registerStorageNeeds(StorageRegistry& registry)
+{
+    // This module does not register for a test case buffer key, because mutators are told which buffer to write in storage
+    // by the input generator that calls them
+}
+
+void RadamsaFuseCorpusMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
+{
+    // Combines a prefix of the buffer with a suffix of another corpus entry, joined where the two share bytes
+
+    const size_t minimumSize{1u};
+    const size_t minimumSeedIndex{0u};
+    size_t originalSize;
+    char* originalBuffer;
+
+    // Try to get buffer size and pointer, return early if buffer is not allocated
+    try
+    {
+        originalBuffer = baseEntry->getBufferPointer(testCaseKey);
+        originalSize = baseEntry->getBufferSize(testCaseKey);
+    }
+    catch(const RuntimeException e)
+    {
+        // Buffer not allocated
+        return;
+    }
+
+    // Check if buffer pointer is valid (not null)
+    if (originalBuffer == nullptr)
+    {
+        return;
+    }
+
+    // Check if buffer size meets minimum requirement
+    if (originalSize < minimumSize)
+    {
+        CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+        return;
+    }
+
+    // Check if minimum seed index is within valid range
+    if (minimumSeedIndex > originalSize - 1u)
+    {
+        CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+        return;
+    }
+
+    // The index holds the bytes of one buffer key; bring it up to date with the saved entries
+    if (testCaseKey != indexedKey)
+    {
+        index.Clear();
+        indexedKey = testCaseKey;
+    }
+    index.Update(storage, testCaseKey);
+
+    const unsigned long baseId{baseEntry->getID()};
+    if (const auto match = index.FindMatch(originalBuffer, originalSize, baseId, rand))
+    {
+        StorageEntry* partner{storage.getEntryByID(match->EntryId)};
+        const char* partnerBuffer{(partner != nullptr) ? partner->getBufferPointer(testCaseKey) : nullptr};
+        const int partnerSize{(partner != nullptr) ? partner->getBufferSize(testCaseKey) : -1};
+
+        // the index only compares hashes, so check that the k-gram really is shared before jumping inside it
+        const size_t basePosition{match->BaseOffset};
+        const size_t partnerPosition{match->PartnerOffset};
+        if (partnerBuffer != nullptr && partnerSize > 0 &&
+            partnerPosition + RadamsaKGramIndex::GramLength <= static_cast<size_t>(partnerSize) &&
+            std::equal(originalBuffer + basePosition, originalBuffer + basePosition + RadamsaKGramIndex::GramLength, partnerBuffer + partnerPosition))
+        {
+            const size_t partnerLength{static_cast<size_t>(partnerSize)};
+            const size_t spanLimit{std::min({MaxJumpSpan, originalSize - basePosition, partnerLength - partnerPosition})};
+            size_t span{RadamsaKGramIndex::GramLength};
+            while (span < spanLimit && originalBuffer[basePosition + span] == partnerBuffer[partnerPosition + span])
+                ++span;
+
+            // any point inside the shared run keeps the bytes around the jump consistent with both inputs
+            const size_t jump{rand->randBelow(span + 1u)};
+
+            BeginOutput()
+                .Append(originalBuffer, basePosition + jump)
+                .Append(partnerBuffer + partnerPosition + jump, partnerLength - partnerPosition - jump)
+                .AppendNullTerminator()
+                .Write(newEntry, testCaseKey);
+            return;
+        }
+    }
+
+    // No shared context was found, so search for one between the buffer and a random partner, or the buffer itself
+    StorageEntry* partner{nullptr};
+    if (const auto partnerId = index.GetRandomEntry(baseId, rand))
+        partner = storage.getEntryByID(*partnerId);
+
+    const char* partnerBuffer{(partner != nullptr) ? partner->getBufferPointer(testCaseKey) : nullptr};
+    const int partnerSize{(partner != nullptr) ? partner->getBufferSize(testCaseKey) : -1};
+    SegmentBuilder& output{BeginOutput()};
+    if (partnerBuffer != nullptr && partnerSize > 0)
+        fuse(output, originalBuffer, originalSize, partnerBuffer, static_cast<size_t>(partnerSize), this->rand);
+    else
+        fuse(output, originalBuffer, originalSize, originalBuffer, originalSize, this->rand);
+    output.AppendNullTerminator().Write(newEntry, testCaseKey);
+}
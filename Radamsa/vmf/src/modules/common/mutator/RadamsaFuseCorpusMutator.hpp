@@ -0,0 +1,78 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2024 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#pragma once
+
+#include "MutatorModule.hpp"
+#include "StorageEntry.hpp"
+#include "RuntimeException.hpp"
+#include "RadamsaByteMutatorBase.hpp"
+#include "RadamsaKGramIndex.hpp"
+#include "VmfRand.hpp"
+
+namespace vmf
+{
+/**
+ * @brief Fuses the test case with another entry of the corpus at a context the two share
+ *
+ * Partners are found through a k-gram index over the saved entries, which is brought up to date by the first
+ * mutation of each fuzzing loop, or when the number of saved entries changes. When no saved entry shares an indexed k-gram with the test case, a random saved entry is
+ * fused with it through the suffix array search of the other fuse mutators, and with an empty corpus the test
+ * case is fused with itself.
+ */
+class RadamsaFuseCorpusMutator: public MutatorModule, public RadamsaByteMutatorBase
+{
+    public:
+
+        static Module* build(std::string name);
+        virtual void init(ConfigInterface& config);
+
+        RadamsaFuseCorpusMutator(std::string name);
+        virtual ~RadamsaFuseCorpusMutator();
+        virtual void registerStorageNeeds(StorageRegistry& registry);
+        virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
+
+        /**
+         * @brief Default number of bytes the k-gram index may hold
+         */
+        static constexpr int DefaultMaxIndexSize{64 * 1024 * 1024};
+
+        /**
+         * @brief Longest run of shared bytes, from the matched k-gram on, that the jump point is chosen in
+         */
+        static constexpr size_t MaxJumpSpan{256u};
+
+        void SetMaxIndexSize(const int size);
+        const RadamsaKGramIndex& GetIndex() const noexcept { return index; }
+
+    private:
+        VmfRand* rand = VmfRand::getInstance();
+        RadamsaKGramIndex index;
+        int indexedKey{-1};
+};
+}
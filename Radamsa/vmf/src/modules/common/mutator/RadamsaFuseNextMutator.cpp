@@ -130,17 +130,15 @@ void RadamsaFuseNextMutator::mutateTestCase(StorageModule& storage, StorageEntry
         return;
     }
 
-    vector<char> data(originalBuffer, originalBuffer + originalSize);
+    const size_t midpoint = originalSize / 2;
 
-    const size_t midpoint = data.size() / 2;
-    const vector<char> data_firstHalf(data.begin(), data.begin() + midpoint);
-    const vector<char> data_secondHalf(data.begin() + midpoint, data.end());
+    // The second fuse searches the first one's result, so that result is the only intermediate copy
+    const auto [from, to] = getFuseJump(originalBuffer, midpoint, originalBuffer, originalSize, this->rand);
+    fusedPrefix.clear();
+    fusedPrefix.insert(fusedPrefix.end(), originalBuffer, originalBuffer + from);
+    fusedPrefix.insert(fusedPrefix.end(), originalBuffer + to, originalBuffer + originalSize);
 
-    const vector<char> ab = fuse(data_firstHalf, data, this->rand);
-    const vector<char> aba = fuse(ab, data_secondHalf, this->rand);
-
-    const size_t newBufferSize{aba.size() + 1}; // +1 to implicitly append a null terminator
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
-    memcpy(newBuffer, aba.data(), aba.size());
+    SegmentBuilder& output{BeginOutput()};
+    fuse(output, fusedPrefix.data(), fusedPrefix.size(), originalBuffer + midpoint, originalSize - midpoint, this->rand);
+    output.AppendNullTerminator().Write(newEntry, testCaseKey);
 }
\ No newline at end of file
@@ -53,5 +53,6 @@ class RadamsaFuseNextMutator: public MutatorModule, public RadamsaByteMutatorBas
 
     private:
         VmfRand* rand = VmfRand::getInstance();
+        std::vector<char> fusedPrefix;
 };
 }
\ No newline at end of file
@@ -133,18 +133,13 @@ void RadamsaFuseOldMutator::mutateTestCase(StorageModule& storage, StorageEntry*
         return;
     }
 
-    vector<char> data(originalBuffer, originalBuffer + originalSize);
-
-    const size_t midpoint = data.size() / 2;
-    const vector<char> data_firstHalf(data.begin(), data.begin() + midpoint);
-    const vector<char> data_secondHalf(data.begin() + midpoint, data.end());
-
-    vector<char> a = fuse(data_firstHalf, data_secondHalf, this->rand);
-    const vector<char> b = fuse(data_firstHalf, data_secondHalf, this->rand);
-    a.insert(a.end(), b.begin(), b.end());
-
-    const size_t newBufferSize{a.size() + 1}; // +1 to implicitly append a null terminator
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
-    memcpy(newBuffer, a.data(), a.size());
+    const size_t midpoint = originalSize / 2;
+    const char* const secondHalf{originalBuffer + midpoint};
+    const size_t secondHalfSize{originalSize - midpoint};
+
+    // Both fuses only describe ranges of the original buffer, so the result is written in one pass
+    SegmentBuilder& output{BeginOutput()};
+    fuse(output, originalBuffer, midpoint, secondHalf, secondHalfSize, this->rand);
+    fuse(output, originalBuffer, midpoint, secondHalf, secondHalfSize, this->rand);
+    output.AppendNullTerminator().Write(newEntry, testCaseKey);
 }
\ No newline at end of file
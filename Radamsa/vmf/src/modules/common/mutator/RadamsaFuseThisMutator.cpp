@@ -131,11 +131,7 @@ void RadamsaFuseThisMutator::mutateTestCase(StorageModule& storage, StorageEntry
         return;
     }
 
-    vector<char> data(originalBuffer, originalBuffer + originalSize);
-    vector<char> new_data = fuse(data, data, this->rand);
-
-    const size_t newBufferSize{new_data.size() + 1}; // +1 to implicitly append a null terminator
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
-    memcpy(newBuffer, new_data.data(), new_data.size());
+    SegmentBuilder& output{BeginOutput()};
+    fuse(output, originalBuffer, originalSize, originalBuffer, originalSize, this->rand);
+    output.AppendNullTerminator().Write(newEntry, testCaseKey);
 }
\ No newline at end of file
@@ -130,15 +130,8 @@ void RadamsaIncrementByteMutator::mutateTestCase(StorageModule& storage, Storage
         return;
     }
 
-    // The new buffer size will contain one additional element since we are appending a null-terminator to the end.
-
-    const size_t newBufferSize{originalSize + 1u};
-
-    // Allocate the new buffer, set it's elements to those of the original buffer, and append a null-terminator to the end.
-
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, static_cast<int>(newBufferSize))};
-    memset(newBuffer, 0u, newBufferSize);
-    memcpy(newBuffer, originalBuffer, originalSize);
+    // Copy the original buffer into a new buffer with a null-terminator appended to the end; the byte is then changed in place.
+    char* newBuffer{CopyIntoNewEntry(newEntry, testCaseKey, originalBuffer, originalSize)};
 
     // Select a random byte to circularly increment.
 
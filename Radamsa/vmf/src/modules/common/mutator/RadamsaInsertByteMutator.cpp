@@ -130,15 +130,6 @@ void RadamsaInsertByteMutator::mutateTestCase(StorageModule& storage, StorageEnt
         return;
     }
 
-    // The new buffer size will contain two additional elements since we are inserting a random byte and appending a null-terminator to the end.
-
-    const size_t newBufferSize{originalSize + 2u};
-
-    // Allocate the new buffer and set it's elements to zero.
-
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, static_cast<int>(newBufferSize))};
-    memset(newBuffer, 0u, newBufferSize);
-
     // Select a random index from which the new byte will be inserted.
 
     const size_t lower{0u};
@@ -155,16 +146,10 @@ void RadamsaInsertByteMutator::mutateTestCase(StorageModule& storage, StorageEnt
                                 )
     };
 
-    // Copy data from the original buffer into the new buffer, but insert a random byte.
-    // The last element in the new buffer is skipped since it was implicitly set to zero during allocation.
+    // Copy data from the original buffer into a new buffer, but insert a random byte after the selected one.
+    // The new buffer will contain two additional elements since we are inserting a random byte and appending a null-terminator to the end.
 
-    for (size_t sourceIndex{0u}, destinationIndex{0u}; sourceIndex < originalSize; ++sourceIndex)
-    {
-        newBuffer[destinationIndex] = originalBuffer[sourceIndex];
-
-        if (sourceIndex == randomInsertionIndex)
-            newBuffer[++destinationIndex] = static_cast<char>(rand->randBetween(0u, std::numeric_limits<char>::max()));
+    const char randomByte{static_cast<char>(rand->randBetween(0u, std::numeric_limits<char>::max()))};
 
-        ++destinationIndex;
-    }
+    SpliceIntoNewEntry(newEntry, testCaseKey, originalBuffer, originalSize, randomInsertionIndex + 1u, 0u, &randomByte, 1u);
 }
\ No newline at end of file
@@ -38,15 +38,21 @@ using namespace vmf;
 
 #include "ModuleFactory.hpp"
 REGISTER_MODULE(RadamsaInsertLineMutator);
+REGISTER_MODULE(RadamsaInsertCrLfRecordMutator);
+REGISTER_MODULE(RadamsaInsertNulRecordMutator);
+REGISTER_MODULE(RadamsaInsertSemicolonRecordMutator);
+REGISTER_MODULE(RadamsaInsertCommaRecordMutator);
+REGISTER_MODULE(RadamsaInsertFieldRecordMutator);
 
 /**
  * @brief Builder method to support the ModuleFactory
  * Constructs an instance of this class
  * @return Module* - Pointer to the newly created instance
  */
-Module* RadamsaInsertLineMutator::build(std::string name)
+template <typename Delimiter>
+Module* RadamsaInsertRecordMutator<Delimiter>::build(std::string name)
 {
-    return new RadamsaInsertLineMutator(name);
+    return new RadamsaInsertRecordMutator<Delimiter>(name);
 }
 
 /**
@@ -54,9 +60,10 @@ Module* RadamsaInsertLineMutator::build(std::string name)
  *
  * @param config - Configuration object
  */
-void RadamsaInsertLineMutator::init(ConfigInterface& config)
+template <typename Delimiter>
+void RadamsaInsertRecordMutator<Delimiter>::init(ConfigInterface& config)
 {
-
+    SetStreamingThreshold(config.getIntParam(getModuleName(), "streamingThreshold", DefaultStreamingThreshold));
 }
 
 /**
@@ -64,7 +71,8 @@ void RadamsaInsertLineMutator::init(ConfigInterface& config)
  *
  * @param name The of the name module
  */
-RadamsaInsertLineMutator::RadamsaInsertLineMutator(std::string name) : MutatorModule(name)
+template <typename Delimiter>
+RadamsaInsertRecordMutator<Delimiter>::RadamsaInsertRecordMutator(std::string name) : MutatorModule(name)
 {
     // rand->randInit();
 }
@@ -73,7 +81,8 @@ RadamsaInsertLineMutator::RadamsaInsertLineMutator(std::string name) : MutatorMo
  * @brief Destroy the RadamsaInsertLineFromElsewhereMutator::RadamsaInsertLineFromElsewhereMutator object
  *
  */
-RadamsaInsertLineMutator::~RadamsaInsertLineMutator()
+template <typename Delimiter>
+RadamsaInsertRecordMutator<Delimiter>::~RadamsaInsertRecordMutator()
 {
 
 }
@@ -83,13 +92,27 @@ RadamsaInsertLineMutator::~RadamsaInsertLineMutator()
  *
  * @param registry - StorageRegistry object
  */
-void RadamsaInsertLineMutator::registerStorageNeeds(StorageRegistry& registry)
+template <typename Delimiter>
+void RadamsaInsertRecordMutator<Delimiter>::registerStorageNeeds(StorageRegistry& registry)
 {
     // This module does not register for a test case buffer key, because mutators are told which buffer to write in storage
     // by the input generator that calls them
 }
 
-void RadamsaInsertLineMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+template <typename Delimiter>
+void RadamsaInsertRecordMutator<Delimiter>::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
+
+template <typename Delimiter>
+void RadamsaInsertRecordMutator<Delimiter>::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
     // Insert a random existing line into a random place
 
@@ -132,11 +155,43 @@ void RadamsaInsertLineMutator::mutateTestCase(StorageModule& storage, StorageEnt
         return;
     }
 
-    const size_t numLines{
-                    GetNumberOfLinesAfterIndex(
-                                        originalBuffer,
-                                        originalSize,
-                                        characterIndex)};
+    if (IsStreamingSize(originalSize)) {
+        // Very large input: count the lines, then locate the lines involved in a single pass instead of indexing every line
+
+        const size_t numLines{Delimiter::Count(originalBuffer, originalSize, 0u, originalSize)};
+
+        if (numLines < minimumLines) {
+            CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+            return;
+        }
+
+        const size_t original_lineIndex = this->rand->randBetween(characterIndex, numLines - 1);
+        const size_t new_lineIndex = this->rand->randBetween(characterIndex, numLines);
+
+        const Line insertedLine{GetLineStreaming<Delimiter>(originalBuffer, originalSize, original_lineIndex)};
+
+        const size_t lineIndices[]{new_lineIndex, numLines};
+        size_t lineOffsets[2];
+
+        GetLineOffsetsStreaming<Delimiter>(originalBuffer, originalSize, lineIndices, lineOffsets, 2u);
+
+        const size_t insertionOffset{lineOffsets[0]};
+        const size_t linesEndOffset{lineOffsets[1]};
+
+        // anything after the last newline is not part of a line, so it is replaced with zeros
+        BeginOutput()
+            .Append(originalBuffer, insertionOffset)
+            .Append(originalBuffer + insertedLine.StartIndex, insertedLine.Size)
+            .Append(originalBuffer + insertionOffset, linesEndOffset - insertionOffset)
+            .AppendFill(originalSize - linesEndOffset, '\0')
+            .AppendNullTerminator()
+            .Write(newEntry, testCaseKey);
+
+        return;
+    }
+
+    const LineIndex& lineIndex{GetLineIndex<Delimiter>(storage, baseEntry, originalBuffer, originalSize)};
+    const size_t numLines{lineIndex.GetNumberOfLines()};
 
     // Check if buffer has minimum required number of lines
     if (numLines < minimumLines) {
@@ -144,35 +199,31 @@ void RadamsaInsertLineMutator::mutateTestCase(StorageModule& storage, StorageEnt
         return;
     }
 
-    std::vector<size_t> lineOrder(numLines);
-    std::vector<Line> lines(numLines);
-    for(size_t i{0}; i < numLines; ++i) {
-        lineOrder[i] = i;
-        lines[i] = GetLineData(
-                            originalBuffer,
-                            originalSize,
-                            i,
-                            numLines);
-    }
-
     const size_t original_lineIndex = this->rand->randBetween(characterIndex, numLines - 1);
     const size_t new_lineIndex = this->rand->randBetween(characterIndex, numLines);
 
-    lineOrder.insert(lineOrder.begin() + new_lineIndex, original_lineIndex);
-
-    // create new buffer with modified order
-    const size_t newBufferSize{originalSize + lines[original_lineIndex].Size + 1u};  // +1 to implicitly append null terminator
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, static_cast<int>(newBufferSize))};
-    memset(newBuffer, 0u, newBufferSize);
-    for(
-        size_t i{0}, nextBufferIndex{0}; 
-        i < lineOrder.size(); 
-        nextBufferIndex += lines[lineOrder[i]].Size, ++i
-    ) {
-        memcpy(
-            newBuffer + nextBufferIndex, 
-            originalBuffer + lines[lineOrder[i]].StartIndex, 
-            lines[lineOrder[i]].Size
-        );
-    }
-}
\ No newline at end of file
+    const LineVector insertedLine{lineIndex.GetLineVector(original_lineIndex)};
+
+    const LineVector linesBefore{lineIndex.GetLines(0u, new_lineIndex)};
+    const LineVector linesAfter{lineIndex.GetLines(new_lineIndex, numLines)};
+
+    // the copy of the original line goes in front of line new_lineIndex; anything after the last newline is not part of
+    // a line, so it is replaced with zeros
+    BeginOutput()
+        .Append(linesBefore.Data, linesBefore.Size)
+        .Append(insertedLine.Data, insertedLine.Size)
+        .Append(linesAfter.Data, linesAfter.Size)
+        .AppendFill(originalSize - linesBefore.Size - linesAfter.Size, '\0')
+        .AppendNullTerminator()
+        .Write(newEntry, testCaseKey);
+}
+
+namespace vmf
+{
+template class RadamsaInsertRecordMutator<NewlineDelimiter>;
+template class RadamsaInsertRecordMutator<CrLfDelimiter>;
+template class RadamsaInsertRecordMutator<NulDelimiter>;
+template class RadamsaInsertRecordMutator<SemicolonDelimiter>;
+template class RadamsaInsertRecordMutator<CommaDelimiter>;
+template class RadamsaInsertRecordMutator<FieldSeparatorDelimiter>;
+}
@@ -37,21 +37,30 @@
 namespace vmf
 {
 /**
- *
+ * @tparam Delimiter - Record delimiter policy (see RadamsaDelimiter.hpp)
  */
-class RadamsaInsertLineMutator: public MutatorModule, public RadamsaLineMutatorBase
+template <typename Delimiter>
+class RadamsaInsertRecordMutator: public MutatorModule, public RadamsaLineMutatorBase
 {
     public:
 
         static Module* build(std::string name);
         virtual void init(ConfigInterface& config);
 
-        RadamsaInsertLineMutator(std::string name);
-        virtual ~RadamsaInsertLineMutator();
+        RadamsaInsertRecordMutator(std::string name);
+        virtual ~RadamsaInsertRecordMutator();
         virtual void registerStorageNeeds(StorageRegistry& registry);
+        virtual void registerMetadataNeeds(StorageRegistry& registry);
         virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
 
     private:
         VmfRand* rand = VmfRand::getInstance();
 };
-}
\ No newline at end of file
+
+using RadamsaInsertLineMutator = RadamsaInsertRecordMutator<NewlineDelimiter>;
+using RadamsaInsertCrLfRecordMutator = RadamsaInsertRecordMutator<CrLfDelimiter>;
+using RadamsaInsertNulRecordMutator = RadamsaInsertRecordMutator<NulDelimiter>;
+using RadamsaInsertSemicolonRecordMutator = RadamsaInsertRecordMutator<SemicolonDelimiter>;
+using RadamsaInsertCommaRecordMutator = RadamsaInsertRecordMutator<CommaDelimiter>;
+using RadamsaInsertFieldRecordMutator = RadamsaInsertRecordMutator<FieldSeparatorDelimiter>;
+}
@@ -30,6 +30,8 @@
   *
   */
 #include "RadamsaInsertUnicodeMutator.hpp"
+#include "RadamsaParseCache.hpp"
+#include "RadamsaUtf8Index.hpp"
 #include "RuntimeException.hpp"
 #include <random>
 #include <algorithm>
@@ -56,7 +58,17 @@ Module* RadamsaInsertUnicodeMutator::build(std::string name)
  */
 void RadamsaInsertUnicodeMutator::init(ConfigInterface& config)
 {
+    SetCodePointBoundariesOnly(config.getBoolParam(getModuleName(), "codePointBoundariesOnly", false));
+}
 
+/**
+ * @brief Sets whether sequences are only inserted between UTF-8 code points
+ *
+ * @param enabled - When false, sequences may be inserted inside a multibyte sequence
+ */
+void RadamsaInsertUnicodeMutator::SetCodePointBoundariesOnly(const bool enabled) noexcept
+{
+    codePointBoundariesOnly = enabled;
 }
 
 /**
@@ -127,6 +139,17 @@ void RadamsaInsertUnicodeMutator::registerStorageNeeds(StorageRegistry& registry
     // by the input generator that calls them
 }
 
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+void RadamsaInsertUnicodeMutator::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
+
 void RadamsaInsertUnicodeMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
     // Insert a "funny" unicode sequence into a random index
@@ -168,25 +191,33 @@ void RadamsaInsertUnicodeMutator::mutateTestCase(StorageModule& storage, Storage
         return;
     }
 
-    std::vector<uint8_t> data(originalBuffer, originalBuffer + originalSize);
-
     const size_t lower{0};
-    size_t upper{data.size() - 1};
-    const size_t insert_index = this->rand->randBetween(lower, upper);
+    size_t upper{originalSize - 1};
+    size_t insert_index;
+    if (codePointBoundariesOnly)
+    {
+        // The code point boundaries are indexed once per entry and shared, so one is selected directly
+        const std::shared_ptr<const RadamsaUtf8Index> utf8Index{RadamsaParseCache::getInstance()->GetOrParse<RadamsaUtf8Index>(
+            storage, baseEntry, originalBuffer, originalSize,
+            [&]() { return RadamsaUtf8Index(originalBuffer, originalSize); },
+            [](const RadamsaUtf8Index& index) { return index.GetFootprint(); })};
+
+        // Input made only of continuation bytes has no boundary inside it, so the sequence goes in front of it
+        const size_t boundaryCount{utf8Index->GetCodePointCount()};
+        insert_index = (boundaryCount == 0u) ? 0u : utf8Index->SelectCodePoint(this->rand->randBetween(lower, boundaryCount - 1));
+    }
+    else
+    {
+        insert_index = this->rand->randBetween(lower, upper);
+    }
 
     upper = this->funnyUnicode.size() - 1;
-    const std::vector<uint8_t> toInsert = this->funnyUnicode[this->rand->randBetween(lower, upper)];
-
-    data.insert(
-        data.begin() + insert_index,
-        toInsert.rbegin(),
-        toInsert.rend()
-    );
-    
-    const size_t newBufferSize{data.size() + 1}; // +1 to implicitly append a null terminator
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
-    memcpy(newBuffer, data.data(), data.size());
+    const std::vector<uint8_t>& toInsert = this->funnyUnicode[this->rand->randBetween(lower, upper)];
+
+    // The sequence is inserted in reverse byte order; the scratch buffer keeps its capacity between mutations
+    reversedSequence.assign(toInsert.rbegin(), toInsert.rend());
+
+    SpliceIntoNewEntry(newEntry, testCaseKey, originalBuffer, originalSize, insert_index, 0u, reversedSequence.data(), reversedSequence.size());
 
     return;
 }
\ No newline at end of file
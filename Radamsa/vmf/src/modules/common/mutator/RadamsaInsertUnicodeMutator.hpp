@@ -49,10 +49,16 @@ class RadamsaInsertUnicodeMutator: public MutatorModule, public RadamsaByteMutat
         RadamsaInsertUnicodeMutator(std::string name);
         virtual ~RadamsaInsertUnicodeMutator();
         virtual void registerStorageNeeds(StorageRegistry& registry);
+        virtual void registerMetadataNeeds(StorageRegistry& registry);
         virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
 
+        void SetCodePointBoundariesOnly(const bool enabled) noexcept;
+        bool GetCodePointBoundariesOnly() const noexcept { return codePointBoundariesOnly; }
+
     private:
         VmfRand* rand = VmfRand::getInstance();
         std::vector<std::vector<uint8_t>> funnyUnicode;
+        std::vector<char> reversedSequence;
+        bool codePointBoundariesOnly{false};
 };
 }
\ No newline at end of file
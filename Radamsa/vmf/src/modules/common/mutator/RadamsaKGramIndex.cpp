@@ -0,0 +1,321 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#include "RadamsaKGramIndex.hpp"
+#include "Iterator.hpp"
+#include "RuntimeException.hpp"
+#include <algorithm>
+
+using namespace vmf;
+
+namespace
+{
+constexpr uint64_t GetLeadingPower(uint64_t base, size_t length) noexcept
+{
+    uint64_t power{1u};
+    for (size_t it{1u}; it < length; ++it)
+        power *= base;
+    return power;
+}
+
+size_t GetEntryFootprint() noexcept
+{
+    return sizeof(unsigned long) + 64u + 3u * sizeof(void*);
+}
+}
+
+/**
+ * @brief Indexes the saved entries that are new since the last comparison and drops the ones no longer saved
+ *
+ * Storage clears its new entries at the end of each fuzzing loop, after saving and removing entries, and entry
+ * IDs only grow, so the first new entry marks the loop. The saved entries are only walked when that marker or
+ * their count has changed since the last walk, which keeps this O(1) for all but the first call of a loop.
+ *
+ * @param testCaseKey - Handle of the buffer whose bytes are indexed
+ */
+void RadamsaKGramIndex::Update(StorageModule& storage, int testCaseKey)
+{
+    std::unique_ptr<Iterator> savedEntries{storage.getSavedEntries()};
+    std::unique_ptr<Iterator> newEntries{storage.getNewEntries()};
+    const int savedCount{savedEntries->getSize()};
+    const unsigned long loopMarker{newEntries->hasNext() ? newEntries->getNext()->getID() : 0u};
+    if (synced && savedCount == syncedSavedCount && loopMarker == syncedLoopMarker)
+        return;
+
+    synced = true;
+    syncedSavedCount = savedCount;
+    syncedLoopMarker = loopMarker;
+    ++generation;
+
+    size_t seen{0u};
+    while (savedEntries->hasNext())
+    {
+        StorageEntry* entry{savedEntries->getNext()};
+        auto known = entries.find(entry->getID());
+        if (known != entries.end())
+        {
+            known->second.Generation = generation;
+            ++seen;
+            continue;
+        }
+
+        const char* buffer{nullptr};
+        int size{-1};
+        try
+        {
+            buffer = entry->getBufferPointer(testCaseKey);
+            size = entry->getBufferSize(testCaseKey);
+        }
+        catch (const RuntimeException&)
+        {
+            // Entries without a test case buffer are still recorded, so they are not looked at again
+        }
+
+        AddEntry(entry->getID(), buffer, (buffer != nullptr && size > 0) ? static_cast<size_t>(size) : 0u);
+        ++seen;
+    }
+
+    if (seen == entries.size())
+        return;
+
+    std::vector<unsigned long> removed;
+    for (const auto& [entryId, info] : entries)
+    {
+        if (info.Generation != generation)
+            removed.push_back(entryId);
+    }
+
+    for (unsigned long entryId : removed)
+        RemoveEntry(entryId);
+}
+
+/**
+ * @brief Indexes the sampled k-grams of an entry, at most one posting per entry and k-gram
+ */
+void RadamsaKGramIndex::AddEntry(unsigned long entryId, const char* buffer, size_t size)
+{
+    if (entries.count(entryId) != 0u)
+        RemoveEntry(entryId);
+
+    EntryInfo& info{entries[entryId]};
+    info.Generation = generation;
+    bytesHeld += GetEntryFootprint();
+
+    if (buffer == nullptr || size < GramLength || size > UINT32_MAX)
+        return;
+
+    constexpr uint64_t leadingPower{GetLeadingPower(HashBase, GramLength)};
+    const unsigned char* bytes{reinterpret_cast<const unsigned char*>(buffer)};
+
+    uint64_t hash{0u};
+    for (size_t it{0u}; it < GramLength; ++it)
+        hash = hash * HashBase + bytes[it];
+
+    for (size_t offset{0u};; ++offset)
+    {
+        const uint64_t key{Mix(hash)};
+        if (IsSampled(key))
+        {
+            auto gram = grams.find(key);
+            if (gram == grams.end())
+            {
+                gram = grams.emplace(key, std::vector<Posting>{}).first;
+                bytesHeld += GetGramFootprint();
+            }
+
+            std::vector<Posting>& postings{gram->second};
+            const bool alreadyPosted{!postings.empty() && postings.back().EntryId == entryId};
+            if (!alreadyPosted && postings.size() < MaxPostingsPerGram)
+            {
+                postings.push_back(Posting{entryId, static_cast<uint32_t>(offset)});
+                info.Grams.push_back(key);
+                bytesHeld += GetPostingFootprint();
+            }
+        }
+
+        if (offset + GramLength >= size)
+            break;
+
+        hash = (hash - bytes[offset] * leadingPower) * HashBase + bytes[offset + GramLength];
+    }
+
+    info.Indexed = true;
+    indexedOrder.push_back(entryId);
+    EnforceBudget();
+}
+
+/**
+ * @brief Forgets an entry entirely, e.g. because it was removed from storage
+ */
+void RadamsaKGramIndex::RemoveEntry(unsigned long entryId)
+{
+    auto known = entries.find(entryId);
+    if (known == entries.end())
+        return;
+
+    if (known->second.Indexed)
+    {
+        DropPostings(entryId, known->second);
+        indexedOrder.erase(std::find(indexedOrder.begin(), indexedOrder.end(), entryId));
+    }
+
+    entries.erase(known);
+    bytesHeld -= GetEntryFootprint();
+}
+
+/**
+ * @brief Drops every entry and k-gram
+ */
+void RadamsaKGramIndex::Clear()
+{
+    grams.clear();
+    entries.clear();
+    indexedOrder.clear();
+    bytesHeld = 0u;
+    synced = false;
+}
+
+std::optional<RadamsaKGramIndex::Match> RadamsaKGramIndex::FindMatch(
+                                                                     const char* buffer,
+                                                                     size_t size,
+                                                                     unsigned long excludedId,
+                                                                     VmfRand* rand) const
+{
+    if (buffer == nullptr || size < GramLength || grams.empty())
+        return std::nullopt;
+
+    constexpr uint64_t leadingPower{GetLeadingPower(HashBase, GramLength)};
+    const unsigned char* bytes{reinterpret_cast<const unsigned char*>(buffer)};
+    const size_t positions{size - GramLength + 1u};
+
+    // Roll forward from a random position to the end, then from the start back up to it
+    const size_t start{rand->randBelow(positions)};
+    const size_t ranges[2][2]{{start, positions}, {0u, start}};
+    for (const auto& range : ranges)
+    {
+        if (range[0] >= range[1])
+            continue;
+
+        uint64_t hash{0u};
+        for (size_t it{0u}; it < GramLength; ++it)
+            hash = hash * HashBase + bytes[range[0] + it];
+
+        for (size_t offset{range[0]};; ++offset)
+        {
+            const uint64_t key{Mix(hash)};
+            if (IsSampled(key))
+            {
+                auto gram = grams.find(key);
+                if (gram != grams.end())
+                {
+                    const std::vector<Posting>& postings{gram->second};
+                    const size_t candidates{static_cast<size_t>(std::count_if(postings.begin(), postings.end(),
+                        [excludedId](const Posting& posting) { return posting.EntryId != excludedId; }))};
+                    if (candidates != 0u)
+                    {
+                        size_t pick{rand->randBelow(candidates)};
+                        for (const Posting& posting : postings)
+                        {
+                            if (posting.EntryId != excludedId && pick-- == 0u)
+                                return Match{posting.EntryId, offset, posting.Offset};
+                        }
+                    }
+                }
+            }
+
+            if (offset + 1u >= range[1])
+                break;
+
+            hash = (hash - bytes[offset] * leadingPower) * HashBase + bytes[offset + GramLength];
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<unsigned long> RadamsaKGramIndex::GetRandomEntry(unsigned long excludedId, VmfRand* rand) const
+{
+    if (indexedOrder.empty() || (indexedOrder.size() == 1u && indexedOrder.front() == excludedId))
+        return std::nullopt;
+
+    const size_t pick{rand->randBelow(indexedOrder.size())};
+    if (indexedOrder[pick] != excludedId)
+        return indexedOrder[pick];
+
+    return indexedOrder[(pick + 1u) % indexedOrder.size()];
+}
+
+/**
+ * @brief Sets the number of bytes the index may hold, dropping the oldest entries as needed
+ */
+void RadamsaKGramIndex::SetByteBudget(size_t bytes)
+{
+    byteBudget = bytes;
+    EnforceBudget();
+}
+
+void RadamsaKGramIndex::DropPostings(unsigned long entryId, EntryInfo& info)
+{
+    for (uint64_t key : info.Grams)
+    {
+        auto gram = grams.find(key);
+        if (gram == grams.end())
+            continue;
+
+        std::vector<Posting>& postings{gram->second};
+        postings.erase(std::remove_if(postings.begin(), postings.end(),
+            [entryId](const Posting& posting) { return posting.EntryId == entryId; }), postings.end());
+        bytesHeld -= GetPostingFootprint();
+
+        if (postings.empty())
+        {
+            grams.erase(gram);
+            bytesHeld -= GetGramFootprint();
+        }
+    }
+
+    info.Grams.clear();
+    info.Grams.shrink_to_fit();
+    info.Indexed = false;
+}
+
+/**
+ * @brief Drops the postings of the oldest indexed entries until the index fits its budget
+ *
+ * The entries stay known, so Update() does not index them again. The newest entry is never dropped, so it is
+ * indexed even when it alone exceeds the budget.
+ */
+void RadamsaKGramIndex::EnforceBudget()
+{
+    while (bytesHeld > byteBudget && indexedOrder.size() > 1u)
+    {
+        const unsigned long oldest{indexedOrder.front()};
+        indexedOrder.pop_front();
+        DropPostings(oldest, entries[oldest]);
+    }
+}
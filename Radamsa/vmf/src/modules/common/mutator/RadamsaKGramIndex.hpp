@@ -0,0 +1,140 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "StorageModule.hpp"
+#include "VmfRand.hpp"
+
+namespace vmf
+{
+/**
+ * @brief Memory-bounded index of the k-grams of the saved corpus entries, for finding fuse partners
+ *
+ * Only content-sampled k-grams are indexed (those whose hash falls in a fixed residue class), so two inputs that
+ * share a region of a few dozen bytes almost always share an indexed k-gram, at a fraction of the memory of
+ * indexing every position. Each indexed k-gram maps to a few (entry, offset) postings, and a lookup rolls a hash
+ * over the base input from a random position until it reaches a k-gram another entry also contains.
+ *
+ * Storage has no callback for saved or removed entries, so Update() compares the index against the saved
+ * entries; only entries that are new since the last comparison are hashed. Entries are saved and removed between
+ * fuzzing loops, so the comparison is made once per loop, or sooner if the number of saved entries changes. When
+ * the byte budget is exceeded the oldest entries are dropped from the index, but remain known so that they are
+ * not indexed again.
+ */
+class RadamsaKGramIndex
+{
+public:
+    static constexpr size_t GramLength{8u};
+    static constexpr uint64_t SampleMask{0x7u};         // indexes about one k-gram in eight
+    static constexpr size_t MaxPostingsPerGram{8u};
+    static constexpr size_t DefaultByteBudget{64u * 1024u * 1024u};
+
+    struct Match
+    {
+        unsigned long EntryId;
+        size_t BaseOffset;      // start of the shared k-gram in the base input
+        size_t PartnerOffset;   // start of the shared k-gram in the partner entry
+    };
+
+    void Update(StorageModule& storage, int testCaseKey);
+    void AddEntry(unsigned long entryId, const char* buffer, size_t size);
+    void RemoveEntry(unsigned long entryId);
+    void Clear();
+
+    /**
+     * @brief Finds a k-gram of buffer that an indexed entry other than excludedId also contains
+     *
+     * The match is only as good as the hash; callers should compare the bytes before relying on it.
+     */
+    std::optional<Match> FindMatch(
+                                   const char* buffer,
+                                   size_t size,
+                                   unsigned long excludedId,
+                                   VmfRand* rand) const;
+
+    /**
+     * @brief Returns a random indexed entry other than excludedId, or nullopt if there is none
+     */
+    std::optional<unsigned long> GetRandomEntry(unsigned long excludedId, VmfRand* rand) const;
+
+    void SetByteBudget(size_t bytes);
+    size_t GetByteBudget() const noexcept { return byteBudget; }
+    size_t GetBytesHeld() const noexcept { return bytesHeld; }
+    size_t GetIndexedEntryCount() const noexcept { return indexedOrder.size(); }
+    size_t GetGramCount() const noexcept { return grams.size(); }
+
+private:
+    struct Posting
+    {
+        unsigned long EntryId;
+        uint32_t Offset;
+    };
+
+    struct EntryInfo
+    {
+        std::vector<uint64_t> Grams;    // sampled k-gram keys this entry has postings under; empty once dropped
+        size_t Generation{0u};
+        bool Indexed{false};
+    };
+
+    static constexpr uint64_t HashBase{0x100000001b3ull};
+
+    static uint64_t Mix(uint64_t hash) noexcept
+    {
+        hash ^= hash >> 33u;
+        hash *= 0xff51afd7ed558ccdull;
+        hash ^= hash >> 33u;
+        return hash;
+    }
+
+    static bool IsSampled(uint64_t key) noexcept { return (key & SampleMask) == 0u; }
+
+    static size_t GetPostingFootprint() noexcept { return sizeof(Posting) + sizeof(uint64_t); }
+    static size_t GetGramFootprint() noexcept { return sizeof(uint64_t) + sizeof(std::vector<Posting>) + 2u * sizeof(void*); }
+
+    void DropPostings(unsigned long entryId, EntryInfo& info);
+    void EnforceBudget();
+
+    std::unordered_map<uint64_t, std::vector<Posting>> grams;
+    std::unordered_map<unsigned long, EntryInfo> entries;
+    std::deque<unsigned long> indexedOrder;     // oldest indexed entry first
+    size_t generation{0u};
+    bool synced{false};                 // whether Update() has compared the index against storage since Clear()
+    int syncedSavedCount{0};            // the number of saved entries at that comparison
+    unsigned long syncedLoopMarker{0u}; // the ID of the first new entry then, which changes with each fuzzing loop
+    size_t byteBudget{DefaultByteBudget};
+    size_t bytesHeld{0u};
+};
+}
@@ -20,8 +20,16 @@
 
 #pragma once
 
+#include "RadamsaByteScan.hpp"
+#include "RadamsaDelimiter.hpp"
 #include "RadamsaMutatorBase.hpp"
+#include "RadamsaParseCache.hpp"
+#include "StorageEntry.hpp"
 #include "VmfRand.hpp"
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
 
 namespace vmf
 {
@@ -54,333 +62,552 @@ public:
         size_t Size{0u};
     };
 
+    /**
+     * @brief Non-owning view of a line (or a run of adjacent lines) inside a buffer
+     *
+     * Views are only valid while the buffer they point into is alive, i.e. for the duration of a mutation.
+     */
     struct LineVector
     {
-        ~LineVector() = default;
         LineVector() = default;
+        ~LineVector() = default;
 
         LineVector(
             const char* const buffer,
-            const Line& lineData)
+            const Line& lineData) noexcept :
+            Data{buffer + lineData.StartIndex},
+            Size{lineData.Size}
         {
-            Data = std::make_unique<char[]>(lineData.Size);
-            memcpy(Data.get(), &buffer[lineData.StartIndex], lineData.Size);
-
-            Size = lineData.Size;
         }
 
-        LineVector(const LineVector &other) noexcept
+        LineVector(
+            const char* const data,
+            const size_t size) noexcept :
+            Data{data},
+            Size{size}
         {
-            // Copy Data
+        }
 
-            const size_t& size{other.Size};
+        LineVector(LineVector&&) = default;
+        LineVector(const LineVector&) = default;
 
-            Data = std::make_unique<char[]>(size);
-            memcpy(Data.get(), other.Data.get(), size);
+        LineVector& operator=(LineVector&&) = default;
+        LineVector& operator=(const LineVector&) = default;
 
-            Size = size;
+        bool operator==(const LineVector &other) const { 
+            return (Size == other.Size && 
+                    (Size == 0u || memcmp(Data, other.Data, Size) == 0)); 
         }
 
-        LineVector(LineVector&& other) noexcept
+        bool operator!=(const LineVector &other) const { return !(*this == other); }
+
+        /**
+         * @brief Copies the viewed bytes to the destination and returns the position just past them
+         */
+        char* CopyTo(char* const destination) const noexcept
         {
-            // Copy Data
+            if (Size != 0u)
+                memcpy(destination, Data, Size);
 
-            const size_t& size{other.Size};
+            return destination + Size;
+        }
 
-            Data = std::make_unique<char[]>(size);
-            memcpy(Data.get(), other.Data.get(), size);
+        const char* Data{nullptr};
+        size_t Size{0u};
+    };
 
-            Size = size;
+    /**
+     * @brief Non-owning list of line views into a single buffer
+     *
+     * Building the list costs one allocation for the view table; no line bytes are copied.
+     */
+    struct LineList
+    {
+        LineList() = default;
+        ~LineList() = default;
 
-            // Release ownership
+        LineList(
+            const char* const buffer,
+            const std::vector<Line>& lineData)
+        {
+            Lines.reserve(lineData.size());
 
-            other.Data.release();
-            other.Size = 0u;
+            for(const Line& line : lineData)
+            {
+                Lines.emplace_back(buffer, line);
+
+                Capacity += line.Size;
+            }
         }
 
-        LineVector& operator=(const LineVector& other)
+        LineList(LineList&&) = default;
+        LineList(const LineList&) = default;
+
+        LineList& operator=(LineList&&) = default;
+        LineList& operator=(const LineList&) = default;
+
+        bool operator==(const LineList& other) const
         {
-            // Copy Data
+            return (Capacity == other.Capacity && Lines == other.Lines);
+        }
 
-            const size_t& size{other.Size};
+        bool operator!=(const LineList& other) const { return !(*this == other); }
 
-            Data = std::make_unique<char[]>(size);
-            memcpy(Data.get(), other.Data.get(), size);
+        size_t GetNumberOfElements() const noexcept { return Lines.size(); }
 
-            Size = size;
+        /**
+         * @brief Copies every line, in order, to the destination and returns the position just past them
+         *
+         * The destination must hold at least Capacity bytes.
+         */
+        char* CopyTo(char* destination) const noexcept
+        {
+            for(const LineVector& line : Lines)
+                destination = line.CopyTo(destination);
 
-            return *this;
+            return destination;
         }
 
-        LineVector& operator=(LineVector&& other)
+        std::vector<LineVector> Lines;
+        size_t Capacity{0u};
+    };
+
+    /**
+     * @brief Owning counterpart of LineVector, for lines that must outlive the buffer they came from
+     *
+     * Copies duplicate the bytes; moves only transfer ownership.
+     */
+    struct OwningLineVector
+    {
+        OwningLineVector() = default;
+        ~OwningLineVector() = default;
+
+        explicit OwningLineVector(const LineVector& line) :
+            Data{std::make_unique<char[]>(line.Size)},
+            Size{line.Size}
         {
-            // Copy Data
+            line.CopyTo(Data.get());
+        }
 
-            const size_t& size{other.Size};
+        OwningLineVector(const OwningLineVector& other) :
+            OwningLineVector{other.View()}
+        {
+        }
 
-            Data = std::make_unique<char[]>(size);
-            memcpy(Data.get(), other.Data.get(), size);
+        OwningLineVector(OwningLineVector&& other) noexcept :
+            Data{std::move(other.Data)},
+            Size{other.Size}
+        {
+            other.Size = 0u;
+        }
 
-            Size = size;
+        OwningLineVector& operator=(const OwningLineVector& other)
+        {
+            if (this != &other)
+                *this = OwningLineVector{other};
 
-            // Release ownership
+            return *this;
+        }
+
+        OwningLineVector& operator=(OwningLineVector&& other) noexcept
+        {
+            Data = std::move(other.Data);
+            Size = other.Size;
 
-            other.Data.release();
             other.Size = 0u;
 
             return *this;
         }
 
-        bool operator==(const LineVector &other) const { 
-            return (Size == other.Size && 
-                    (memcmp(Data.get(), other.Data.get(), other.Size) == 0)); 
-        }
+        bool operator==(const OwningLineVector& other) const { return View() == other.View(); }
+        bool operator!=(const OwningLineVector& other) const { return !(*this == other); }
 
-        bool operator!=(const LineVector &other) const { return !(*this == other); } // we may want to change this to test for equality instead of identity
+        LineVector View() const noexcept { return LineVector{Data.get(), Size}; }
 
         std::unique_ptr<char[]> Data{nullptr};
         size_t Size{0u};
     };
 
-    struct LineList
+    /**
+     * @brief Owning counterpart of LineList
+     *
+     * All line bytes live in one contiguous allocation that the views in List point into. Moving the
+     * storage does not relocate the bytes, so moves are O(1) and leave the views valid.
+     */
+    struct OwningLineList
     {
-        ~LineList() = default;
-        LineList() = default;
+        OwningLineList() = default;
+        ~OwningLineList() = default;
 
-        LineList(
-            const char* const buffer,
-            const std::vector<Line>& lineData) noexcept
+        explicit OwningLineList(const LineList& lines) :
+            Data{std::make_unique<char[]>(lines.Capacity)}
         {
-            const size_t numberOfElements{lineData.size()};
+            List.Lines.reserve(lines.GetNumberOfElements());
+            List.Capacity = lines.Capacity;
 
-            auto data{std::make_unique<LineVector[]>(numberOfElements)};
+            char* destination{Data.get()};
 
-            for(size_t it{0u}; it < numberOfElements; ++it)
+            for(const LineVector& line : lines.Lines)
             {
-                const Line& line{lineData.at(it)};
+                List.Lines.emplace_back(destination, line.Size);
 
-                data[it] = std::move(LineVector{buffer,line});
-
-                Capacity += line.Size;
+                destination = line.CopyTo(destination);
             }
+        }
 
-            NumberOfElements = numberOfElements;
-            Data = std::move(data);
+        OwningLineList(const OwningLineList& other) :
+            OwningLineList{other.List}
+        {
         }
 
-        LineList(const LineList& other) noexcept
+        OwningLineList(OwningLineList&&) noexcept = default;
+
+        OwningLineList& operator=(const OwningLineList& other)
         {
-            // Copy Data
+            if (this != &other)
+                *this = OwningLineList{other};
 
-            const size_t& numberOfElements{other.NumberOfElements};
+            return *this;
+        }
 
-            NumberOfElements = numberOfElements;
-            Capacity = other.Capacity;
+        OwningLineList& operator=(OwningLineList&&) noexcept = default;
 
-            Data = std::make_unique<LineVector[]>(numberOfElements);
+        bool operator==(const OwningLineList& other) const { return List == other.List; }
+        bool operator!=(const OwningLineList& other) const { return !(*this == other); }
 
-            for (size_t it{0u}; it < numberOfElements; ++it)
-            {
-                Data[it] = other.Data[it];
-            }
-        }
+        std::unique_ptr<char[]> Data{nullptr};
+        LineList List;
+    };
 
-        LineList(LineList&& other) noexcept
+    /**
+     * @brief Offsets of every delimiter-terminated line (record) in a buffer, built in a single pass
+     *
+     * Offsets[i] is the index of the first byte of line i and Offsets[i + 1] is the index just past its
+     * terminating delimiter ('\n' unless Build is given another policy from RadamsaDelimiter.hpp), so any
+     * line can be looked up in constant time. Bytes after the last delimiter do not belong to a line.
+     */
+    struct LineIndex
+    {
+        template <typename Delimiter = NewlineDelimiter>
+        void Build(
+                   const char* const buffer,
+                   const size_t size)
         {
-            // Copy Data
+            Buffer = buffer;
+            Size = size;
 
-            const size_t& numberOfElements{other.NumberOfElements};
+            Offsets.clear();
+            Offsets.push_back(0u);
 
-            NumberOfElements = numberOfElements;
-            Capacity = other.Capacity;
+            size_t delimiterIndex{Delimiter::FindNext(buffer, size, 0u)};
 
-            Data = std::make_unique<LineVector[]>(numberOfElements);
-            //memcpy(Data.get(), other.Data.get(), numberOfElements); //not legal
-            int count = numberOfElements;
-            for(int i=0; i<count; i++)
+            while(delimiterIndex < size)
             {
-                Data[i] = other.Data[i];
-            }
+                Offsets.push_back(delimiterIndex + Delimiter::Length);
 
-
-            // Release ownership
-
-            other.Data.release();
-            other.Capacity = 0u;
-            other.NumberOfElements = 0u;
+                delimiterIndex = Delimiter::FindNext(buffer, size, delimiterIndex + Delimiter::Length);
+            }
         }
 
-        LineList& operator=(const LineList& other)
+        size_t GetNumberOfLines() const noexcept
         {
-            // Copy Data
+            return Offsets.empty() ? 0u : Offsets.size() - 1u;
+        }
 
-            const size_t& numberOfElements{other.NumberOfElements};
+        Line GetLine(const size_t lineIndex) const
+        {
+            if (lineIndex >= GetNumberOfLines())
+                throw RuntimeException{"Line index exceeds the maximum number of lines", RuntimeException::INDEX_OUT_OF_RANGE};
 
-            NumberOfElements = numberOfElements;
-            Capacity = other.Capacity;
+            Line lineData;
 
-            Data = std::make_unique<LineVector[]>(numberOfElements);
-            //memcpy(Data.get(), other.Data.get(), numberOfElements); //not legal
-            int count = numberOfElements;
-            for(int i=0; i<count; i++)
-            {
-                Data[i] = other.Data[i];
-            }
+            lineData.IsValid = true;
+            lineData.StartIndex = Offsets[lineIndex];
+            lineData.Size = Offsets[lineIndex + 1u] - Offsets[lineIndex];
 
-            return *this;
+            return lineData;
         }
 
-        LineList& operator=(LineList&& other)
+        /**
+         * @brief Returns a view of lines [firstLine, lastLine) of the indexed buffer, which are adjacent in memory
+         */
+        LineVector GetLines(
+                            const size_t firstLine,
+                            const size_t lastLine) const
         {
-            // Copy Data
-
-            const size_t& numberOfElements{other.NumberOfElements};
+            if (firstLine > lastLine || lastLine > GetNumberOfLines())
+                throw RuntimeException{"Line range exceeds the maximum number of lines", RuntimeException::INDEX_OUT_OF_RANGE};
 
-            NumberOfElements = numberOfElements;
-            Capacity = other.Capacity;
-
-            Data = std::make_unique<LineVector[]>(numberOfElements);
-            //memcpy(Data.get(), other.Data.get(), numberOfElements); //not legal
-            int count = numberOfElements;
-            for(int i=0; i<count; i++)
-            {
-                Data[i] = other.Data[i];
-            }
-
-            // Release ownership
+            return LineVector{Buffer + Offsets[firstLine], Offsets[lastLine] - Offsets[firstLine]};
+        }
 
-            other.Data.release();
-            other.Capacity = 0u;
-            other.NumberOfElements = 0u;
+        /**
+         * @brief Returns a view from the start of firstLine to the end of the buffer, including any bytes after the last newline
+         */
+        LineVector GetLinesToEnd(const size_t firstLine) const
+        {
+            if (firstLine > GetNumberOfLines())
+                throw RuntimeException{"Line index exceeds the maximum number of lines", RuntimeException::INDEX_OUT_OF_RANGE};
 
-            return *this;
+            return LineVector{Buffer + Offsets[firstLine], Size - Offsets[firstLine]};
         }
 
-        bool operator==(const LineList& other) const
+        LineVector GetLineVector(const size_t lineIndex) const
         {
-            auto compareLineVectors{
-                [&](const LineVector* const lhs, const LineVector* const rhs) -> bool
-                {
-                    if (lhs != nullptr && rhs != nullptr)
-                    {
-                        for (size_t it{0u}; it < lhs->Size; ++it)
-                            if (lhs->Data[it] != rhs->Data[it])
-                                return false;
-
-                        return true;
-                    }
-                    else if (lhs == nullptr && rhs == nullptr)
-                    {
-                        return true;
-                    }
-                    else
-                    {
-                        return false;
-                    }
-                }
-            };
-
-            return ((NumberOfElements == other.NumberOfElements) &&
-                    (Capacity == other.Capacity) &&
-                    (compareLineVectors(Data.get(), other.Data.get())));
+            return GetLines(lineIndex, lineIndex + 1u);
         }
 
-        bool operator!=(const LineList& other) const { return !(*this == other); }
+        size_t GetMemoryFootprint() const noexcept
+        {
+            return Offsets.capacity() * sizeof(size_t);
+        }
 
-        std::unique_ptr<LineVector[]> Data{nullptr};
-        size_t NumberOfElements{0u};
-        size_t Capacity{0u};
+        std::vector<size_t> Offsets;
+        const char* Buffer{nullptr};
+        size_t Size{0u};
     };
 
     RadamsaLineMutatorBase() = default;
     virtual ~RadamsaLineMutatorBase() = default;
 
-    Line GetLineData(
-                     const char* const buffer,
-                     const size_t size,
-                     const size_t lineIndex,
-                     const size_t numberOfLinesAfterIndex)
+    /**
+     * @brief Returns the line index of the given base entry's buffer
+     *
+     * The index is shared through RadamsaParseCache, so repeated mutations of the same base entry, by any line
+     * mutator using the same delimiter, only scan its buffer once. The returned reference stays valid until the
+     * next call.
+     */
+    template <typename Delimiter = NewlineDelimiter>
+    const LineIndex& GetLineIndex(
+                                  StorageModule& storage,
+                                  StorageEntry* baseEntry,
+                                  const char* const buffer,
+                                  const size_t size)
     {
-        constexpr size_t minimumSize{1u};
-
-        if (size < minimumSize)
-            throw RuntimeException{"The buffer's minimum size must be greater than or equal to 1", RuntimeException::USAGE_ERROR};
-
         if (buffer == nullptr)
             throw RuntimeException{"Input buffer is null", RuntimeException::UNEXPECTED_ERROR};
 
-        const size_t totalNumberOfLines{
-                                    GetNumberOfLinesAfterIndex(
-                                                            buffer,
-                                                            size,
-                                                            0u)};
+        sharedLineIndex = RadamsaParseCache::getInstance()->GetOrParse<LineIndex, Delimiter>(
+            storage, baseEntry, buffer, size,
+            [&]() { LineIndex index; index.Build<Delimiter>(buffer, size); return index; },
+            [](const LineIndex& index) { return index.GetMemoryFootprint(); });
 
-        if (lineIndex > totalNumberOfLines - 1u)
-            throw RuntimeException{"Line index exceeds the maximum number of lines", RuntimeException::UNEXPECTED_ERROR};
+        if (sharedLineIndex->Buffer == buffer)
+            return *sharedLineIndex;
 
-        if (numberOfLinesAfterIndex > totalNumberOfLines)
-            throw RuntimeException{"Number of lines after index exceeds the maximum number of lines", RuntimeException::UNEXPECTED_ERROR};
+        // Same bytes at a different address: the offsets still hold, the views need the current buffer
+        reboundLineIndex = *sharedLineIndex;
+        reboundLineIndex.Buffer = buffer;
 
-        const size_t lineOffset{totalNumberOfLines - numberOfLinesAfterIndex};
+        return reboundLineIndex;
+    }
 
-        constexpr size_t lower{0u};
-        const size_t upper{totalNumberOfLines - 1u};
-        const size_t maximumLineIndex{
-                                std::clamp(
-                                        lineIndex + lineOffset,
-                                        lower,
-                                        upper)};
+    /**
+     * @brief Default input size, in bytes, from which the line mutators switch to their streaming mode
+     *
+     * In streaming mode the mutators do not build a LineIndex. They locate and sample lines by scanning the input
+     * in fixed-size windows and copy untouched regions straight from the input into the output, so the extra
+     * memory per mutation stays constant whatever the size of the input.
+     */
+    static constexpr int DefaultStreamingThreshold{64 * 1024 * 1024};
+    static constexpr size_t StreamingWindowSize{1024u * 1024u};
+
+    /**
+     * @brief Sets the input size from which streaming mode is used; 0 disables streaming mode
+     */
+    void SetStreamingThreshold(const int threshold)
+    {
+        if (threshold < 0)
+            throw RuntimeException{"The streaming threshold must not be negative", RuntimeException::CONFIGURATION_ERROR};
 
-        Line lineData;
+        streamingThreshold = static_cast<size_t>(threshold);
+    }
 
-        for(size_t it{0u}, reverseLineIndex{maximumLineIndex}; it < size; ++it)
-        {
-            if(reverseLineIndex == 0u)
-            {
-                if(!lineData.IsValid)
-                {
-                    lineData.StartIndex = it;
-                    lineData.IsValid = true;
-                }
+    bool IsStreamingSize(const size_t size) const noexcept
+    {
+        return (streamingThreshold != 0u && size >= streamingThreshold);
+    }
 
-                ++lineData.Size;
+    /**
+     * @brief Advances position past the next numberOfLines newlines, one window at a time
+     *
+     * Windows that cannot contain the target newline are only counted, not walked newline by newline.
+     *
+     * @return false if the buffer runs out of newlines first
+     */
+    template <typename Delimiter = NewlineDelimiter>
+    static bool SkipLinesStreaming(
+                                   const char* const buffer,
+                                   const size_t size,
+                                   size_t& position,
+                                   size_t numberOfLines)
+    {
+        while(numberOfLines != 0u && position < size)
+        {
+            const size_t windowEnd{std::min(size, position + StreamingWindowSize)};
+            const size_t numberOfDelimiters{Delimiter::Count(buffer, size, position, windowEnd)};
 
-                if(buffer[it] == '\n')
-                    break;
-            }
-            else
+            if (numberOfDelimiters < numberOfLines)
             {
-                if(buffer[it] == '\n')
-                    --reverseLineIndex;
+                numberOfLines -= numberOfDelimiters;
+                position = windowEnd;
+
+                continue;
             }
+
+            for(; numberOfLines != 0u; --numberOfLines)
+                position = Delimiter::FindNext(buffer, size, position) + Delimiter::Length;
+        }
+
+        return numberOfLines == 0u;
+    }
+
+    /**
+     * @brief Returns the line starting at position, which is invalid if no newline terminates it
+     */
+    template <typename Delimiter = NewlineDelimiter>
+    static Line GetLineAtStreaming(
+                                   const char* const buffer,
+                                   const size_t size,
+                                   const size_t position)
+    {
+        Line lineData;
+
+        const size_t delimiterIndex{Delimiter::FindNext(buffer, size, position)};
+
+        if (delimiterIndex < size)
+        {
+            lineData.IsValid = true;
+            lineData.StartIndex = position;
+            lineData.Size = delimiterIndex + Delimiter::Length - position;
         }
 
         return lineData;
     }
 
-    size_t GetNumberOfLinesAfterIndex(
-                                      const char* const buffer,
-                                      const size_t size,
-                                      const size_t index)
+    /**
+     * @brief Returns the offset of the first byte of a line without indexing the buffer
+     *
+     * A lineIndex equal to the number of lines returns the offset just past the last newline.
+     */
+    template <typename Delimiter = NewlineDelimiter>
+    static size_t GetLineOffsetStreaming(
+                                         const char* const buffer,
+                                         const size_t size,
+                                         const size_t lineIndex)
     {
-        constexpr size_t minimumSize{1u};
+        size_t position{0u};
 
-        if (size < minimumSize)
-            throw RuntimeException{"The buffer's minimum size must be greater than or equal to 1", RuntimeException::USAGE_ERROR};
+        if (!SkipLinesStreaming<Delimiter>(buffer, size, position, lineIndex))
+            throw RuntimeException{"Line index exceeds the maximum number of lines", RuntimeException::INDEX_OUT_OF_RANGE};
 
-        if (index > size - 1u)
-            throw RuntimeException{"Index is out of bounds", RuntimeException::INDEX_OUT_OF_RANGE};
+        return position;
+    }
 
-        if (buffer == nullptr)
-            throw RuntimeException{"Input buffer is null", RuntimeException::UNEXPECTED_ERROR};
+    /**
+     * @brief Looks up the offsets of several lines in a single pass
+     *
+     * lineIndices must be in ascending order; offsets receives one offset per index, as GetLineOffsetStreaming would return it.
+     */
+    template <typename Delimiter = NewlineDelimiter>
+    static void GetLineOffsetsStreaming(
+                                        const char* const buffer,
+                                        const size_t size,
+                                        const size_t* const lineIndices,
+                                        size_t* const offsets,
+                                        const size_t numberOfIndices)
+    {
+        size_t position{0u};
+        size_t positionLineIndex{0u};
+
+        for(size_t it{0u}; it < numberOfIndices; ++it)
+        {
+            if (lineIndices[it] < positionLineIndex)
+                throw RuntimeException{"Line indices must be in ascending order", RuntimeException::USAGE_ERROR};
+
+            if (!SkipLinesStreaming<Delimiter>(buffer, size, position, lineIndices[it] - positionLineIndex))
+                throw RuntimeException{"Line index exceeds the maximum number of lines", RuntimeException::INDEX_OUT_OF_RANGE};
+
+            positionLineIndex = lineIndices[it];
+            offsets[it] = position;
+        }
+    }
+
+    template <typename Delimiter = NewlineDelimiter>
+    static Line GetLineStreaming(
+                                 const char* const buffer,
+                                 const size_t size,
+                                 const size_t lineIndex)
+    {
+        const Line lineData{GetLineAtStreaming<Delimiter>(buffer, size, GetLineOffsetStreaming<Delimiter>(buffer, size, lineIndex))};
+
+        if (!lineData.IsValid)
+            throw RuntimeException{"Line index exceeds the maximum number of lines", RuntimeException::INDEX_OUT_OF_RANGE};
+
+        return lineData;
+    }
 
-        size_t numberOfLines{0u};
+    /**
+     * @brief Picks a uniformly random line in a single pass over the newline stream
+     *
+     * This is reservoir sampling with a reservoir of one line, using geometric skips between replacements
+     * (Li's Algorithm L) so that the number of random draws grows with the logarithm of the number of lines.
+     *
+     * @return Line - the sampled line, which is invalid if the buffer does not contain a complete line
+     */
+    template <typename Delimiter = NewlineDelimiter>
+    static Line SampleLineStreaming(
+                                    const char* const buffer,
+                                    const size_t size,
+                                    VmfRand* rand)
+    {
+        Line sample{GetLineAtStreaming<Delimiter>(buffer, size, 0u)};
+
+        if (!sample.IsValid)
+            return sample;
+
+        size_t sampleLineIndex{0u};
+        size_t position{0u};
+        size_t positionLineIndex{0u};
+        double weight{GetRandomUnitValue(rand)};
+
+        while(true)
+        {
+            const double skip{std::floor(std::log(GetRandomUnitValue(rand)) / std::log1p(-weight))};
+
+            // There cannot be more lines than bytes; this also stops on an infinite skip
+            if (!(skip < static_cast<double>(size)))
+                break;
+
+            const size_t nextLineIndex{sampleLineIndex + static_cast<size_t>(skip) + 1u};
+
+            if (!SkipLinesStreaming<Delimiter>(buffer, size, position, nextLineIndex - positionLineIndex))
+                break;
+
+            positionLineIndex = nextLineIndex;
+
+            const Line candidate{GetLineAtStreaming<Delimiter>(buffer, size, position)};
 
-        for(size_t it{index}; it < size; ++it)
-            if(buffer[it] == '\n')
-                ++numberOfLines;
+            if (!candidate.IsValid)
+                break;
 
-        return numberOfLines;
+            sample = candidate;
+            sampleLineIndex = nextLineIndex;
+            weight *= GetRandomUnitValue(rand);
+        }
+
+        return sample;
+    }
+
+    /**
+     * @brief Returns a random value in the open interval (0, 1)
+     */
+    static double GetRandomUnitValue(VmfRand* rand)
+    {
+        constexpr unsigned long resolution{1ul << 53u};
+        constexpr unsigned long minimumValue{1ul};
+
+        return static_cast<double>(rand->randBetween(minimumValue, resolution - 1ul)) / static_cast<double>(resolution);
     }
 
     bool IsBinarish(
@@ -397,19 +624,15 @@ public:
 
     constexpr size_t binarishPeekSize{8u};
 
-    for(size_t it{0}; it < binarishPeekSize; ++it)
-    {
-        // Peek into the data and return true if it contains UTF-8 or \0.
+    // Peek into the data and return true if it contains UTF-8 or \0.
 
-        if(it == size)
-            break;
+    const size_t peekSize{std::min(size, binarishPeekSize)};
 
-        if(buffer[it] == '\0')
-            return true;
+    if(RadamsaByteScan::FindNextByte(buffer, peekSize, 0u, '\0') != peekSize)
+        return true;
 
-        if((buffer[it] & (std::numeric_limits<char>::max() + 0x01)) != 0u)
-            return true;
-    }
+    if(RadamsaByteScan::FindNextInClass(buffer, peekSize, 0u, RadamsaByteScan::ByteClass::HighBit) != peekSize)
+        return true;
 
     return false;
 }
@@ -434,5 +657,10 @@ public:
 
         return nBitValue;
     }
+
+private:
+    std::shared_ptr<const LineIndex> sharedLineIndex;
+    LineIndex reboundLineIndex;
+    size_t streamingThreshold{static_cast<size_t>(DefaultStreamingThreshold)};
 };
 }
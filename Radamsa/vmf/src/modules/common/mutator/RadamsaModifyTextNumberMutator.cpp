@@ -30,6 +30,7 @@
   *
   */
 #include "RadamsaModifyTextNumberMutator.hpp"
+#include "RadamsaParseCache.hpp"
 #include "RuntimeException.hpp"
 #include <random>
 #include <algorithm>
@@ -90,6 +91,17 @@ void RadamsaModifyTextNumberMutator::registerStorageNeeds(StorageRegistry& regis
     // by the input generator that calls them
 }
 
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+void RadamsaModifyTextNumberMutator::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
+
 void RadamsaModifyTextNumberMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
     // Mutate a random ASCII number via a randomly selected numerical mutation
@@ -132,8 +144,12 @@ void RadamsaModifyTextNumberMutator::mutateTestCase(StorageModule& storage, Stor
         return;
     }
 
-    vector<uint8_t> data(originalBuffer, originalBuffer + originalSize);
-    vector<NumInfo> dataNums = this->extractTextualNumbers(data);
+    // The numbers found in an entry only change with its bytes, so they are scanned once per entry
+    const std::shared_ptr<const vector<NumInfo>> cachedNums{RadamsaParseCache::getInstance()->GetOrParse<vector<NumInfo>>(
+        storage, baseEntry, originalBuffer, originalSize,
+        [&]() { return this->extractTextualNumbers(originalBuffer, originalSize); },
+        [](const vector<NumInfo>& nums) { return nums.capacity() * sizeof(NumInfo); })};
+    const vector<NumInfo>& dataNums{*cachedNums};
 
     // Check if buffer contains at least one ASCII number
     if (dataNums.size() < minimumNumbers)
@@ -142,15 +158,21 @@ void RadamsaModifyTextNumberMutator::mutateTestCase(StorageModule& storage, Stor
         return;
     }
 
-    NumInfo toMutate = dataNums[this->rand->randBetween(0, int(dataNums.size() - 1))];
+    const NumInfo& toMutate = dataNums[this->rand->randBetween(0, int(dataNums.size() - 1))];
+    const int lastInteresting{int(InterestingNumbers.size() - 1)};
+
+    // Negative numbers are worked on as two's complement 64-bit values, the others as unsigned values that
+    // stop at zero when decremented
+    const bool isSigned{toMutate.negative};
+    const uint64_t value{isSigned ? uint64_t{0} - toMutate.value : toMutate.value};
+    const auto canSubtract = [isSigned, value](const uint64_t amount) { return isSigned || value > amount; };
 
-    const vector<unsigned int> interestingNums = this->generateInterestingNumbers();
-    unsigned int newValue;
+    uint64_t newValue;
     switch (this->rand->randBetween(0, 11)) {
         case 0:
-            newValue = toMutate.value + 1; break;
+            newValue = value + 1; break;
         case 1:
-            newValue = (toMutate.value > 0) ? toMutate.value - 1 : 0; break;
+            newValue = canSubtract(0) ? value - 1 : 0; break;
         case 2:
             newValue = 0; break;
         case 3:
@@ -158,50 +180,30 @@ void RadamsaModifyTextNumberMutator::mutateTestCase(StorageModule& storage, Stor
         case 4:
         case 5:
         case 6:
-            newValue = interestingNums[
-                this->rand->randBetween(0, int(interestingNums.size() - 1))
-            ]; break;
+            newValue = InterestingNumbers[this->rand->randBetween(0, lastInteresting)]; break;
         case 7:
-            newValue = toMutate.value + interestingNums[
-                this->rand->randBetween(0, int(interestingNums.size() - 1))
-            ]; break;
+            newValue = value + InterestingNumbers[this->rand->randBetween(0, lastInteresting)]; break;
         case 8: {
-            unsigned int val = interestingNums[
-                this->rand->randBetween(0, int(interestingNums.size() - 1))
-            ];
-            newValue = (toMutate.value > val) ? toMutate.value - val : 0;
+            const uint64_t val = InterestingNumbers[this->rand->randBetween(0, lastInteresting)];
+            newValue = canSubtract(val) ? value - val : 0;
             break;
         }
         case 9:
-            newValue = 2 * toMutate.value; break;
+            newValue = 2 * value; break;
         default: {
-            unsigned int n = this->rand->randBetween(1, 128);
+            uint64_t n = this->rand->randBetween(1, 128);
             unsigned int s = this->rand->randBetween(0, 2);
-            newValue = (s == 0 && toMutate.value > n) ? (toMutate.value - n) : (toMutate.value + n);
+            newValue = (s == 0 && canSubtract(n)) ? (value - n) : (value + n);
             break;
         }
     }
 
-    std::string newValueStr = std::to_string(newValue);
-    vector<uint8_t> new_data;
-    new_data.insert(    // everything before the original value
-        new_data.end(), 
-        data.begin(), 
-        data.begin() + toMutate.offset
-    );
-    new_data.insert(    // the new value
-        new_data.end(),
-        newValueStr.begin(),
-        newValueStr.end()
-    );
-    new_data.insert(    // everything after the original value
-        new_data.end(),
-        data.begin() + toMutate.offset + toMutate.length,
-        data.end()
-    );
-
-    const size_t newBufferSize{new_data.size() + 1}; // +1 to implicitly append a null terminator
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
-    memcpy(newBuffer, new_data.data(), new_data.size());
-}
\ No newline at end of file
+    const bool newNegative{isSigned && static_cast<int64_t>(newValue) < 0};
+    const uint64_t newMagnitude{newNegative ? uint64_t{0} - newValue : newValue};
+
+    // Only the number's own text is formatted; everything around it, including a fraction, is copied as is
+    char newValueText[MaxFormattedNumberSize];
+    const size_t newValueSize{FormatTextualNumber(toMutate, newMagnitude, newNegative, originalBuffer, newValueText)};
+
+    SpliceIntoNewEntry(newEntry, testCaseKey, originalBuffer, originalSize, toMutate.offset, toMutate.integerLength, newValueText, newValueSize);
+}
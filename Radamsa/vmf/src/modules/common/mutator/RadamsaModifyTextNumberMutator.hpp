@@ -49,6 +49,7 @@ class RadamsaModifyTextNumberMutator: public MutatorModule, public RadamsaByteMu
         RadamsaModifyTextNumberMutator(std::string name);
         virtual ~RadamsaModifyTextNumberMutator();
         virtual void registerStorageNeeds(StorageRegistry& registry);
+        virtual void registerMetadataNeeds(StorageRegistry& registry);
         virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
 
     private:
@@ -33,6 +33,9 @@
 #include <random>
 #include <algorithm>
 #include <iostream>
+#include <cstring>
+#include <vector>
+#include "StorageEntry.hpp"
 #include "VmfRand.hpp"
 
 namespace vmf
@@ -40,6 +43,110 @@ namespace vmf
 class RadamsaMutatorBase
 {
 public:
+/**
+ * @brief Describes a mutator's output as an ordered list of segments and writes it in a single pass
+ *
+ * A segment either copies bytes from a source buffer (optionally several times in a row) or fills bytes
+ * with a literal value. The output size is the sum of the segment sizes, so mutators do not have to work
+ * it out by hand, and Write() allocates the new buffer once and fills every byte of it exactly once.
+ */
+class SegmentBuilder
+{
+public:
+    struct Segment
+    {
+        const char* Source{nullptr};    // nullptr for literal fill segments
+        size_t Size{0u};
+        size_t Repetitions{1u};
+        char Fill{'\0'};
+    };
+
+    void Clear() noexcept
+    {
+        segments.clear();
+        size = 0u;
+    }
+
+    SegmentBuilder& Append(
+                           const char* const source,
+                           const size_t segmentSize)
+    {
+        return AppendRepeated(source, segmentSize, 1u);
+    }
+
+    SegmentBuilder& AppendRepeated(
+                                   const char* const source,
+                                   const size_t segmentSize,
+                                   const size_t repetitions)
+    {
+        if (segmentSize != 0u && repetitions != 0u)
+        {
+            segments.push_back(Segment{source, segmentSize, repetitions, '\0'});
+            size += segmentSize * repetitions;
+        }
+
+        return *this;
+    }
+
+    SegmentBuilder& AppendFill(
+                               const size_t segmentSize,
+                               const char fill)
+    {
+        if (segmentSize != 0u)
+        {
+            segments.push_back(Segment{nullptr, segmentSize, 1u, fill});
+            size += segmentSize;
+        }
+
+        return *this;
+    }
+
+    SegmentBuilder& AppendNullTerminator()
+    {
+        return AppendFill(1u, '\0');
+    }
+
+    size_t GetSize() const noexcept { return size; }
+
+    const std::vector<Segment>& GetSegments() const noexcept { return segments; }
+
+    /**
+     * @brief Allocates the test case buffer of the new entry and streams every segment into it
+     *
+     * @return char* - Pointer to the new buffer
+     */
+    char* Write(
+                StorageEntry* newEntry,
+                const int testCaseKey) const
+    {
+        char* const newBuffer{newEntry->allocateBuffer(testCaseKey, size)};
+        char* destination{newBuffer};
+
+        for(const Segment& segment : segments)
+        {
+            if (segment.Source == nullptr)
+            {
+                memset(destination, segment.Fill, segment.Size);
+                destination += segment.Size;
+
+                continue;
+            }
+
+            for(size_t it{0u}; it < segment.Repetitions; ++it)
+            {
+                memcpy(destination, segment.Source, segment.Size);
+                destination += segment.Size;
+            }
+        }
+
+        return newBuffer;
+    }
+
+private:
+    std::vector<Segment> segments;
+    size_t size{0u};
+};
+
 size_t GetRandomRepetitionLength(VmfRand* rand) noexcept
 {
     constexpr size_t MINIMUM_UPPER_LIMIT{0x2u};
@@ -68,5 +175,70 @@ void CopyBufferAsIs(StorageEntry* baseEntry, StorageEntry* newEntry, int testCas
     memcpy(newBuffer, originalBuffer, originalSize);
     return;
 }
+
+/**
+ * @brief Writes base[0, offset) + insertion + base[offset + removed, baseSize) and a null terminator to the new entry
+ *
+ * The new buffer is allocated once at its final size and every byte of it is written exactly once; only the
+ * null terminator is written as a zero. Mutators that change bytes in place splice in nothing and patch the
+ * returned buffer.
+ *
+ * @param insertion - Bytes written in place of the removed ones; may be nullptr if insertionSize is zero
+ * @return char* - Pointer to the new buffer
+ */
+static char* SpliceIntoNewEntry(
+                                StorageEntry* newEntry,
+                                const int testCaseKey,
+                                const char* const base,
+                                const size_t baseSize,
+                                const size_t offset,
+                                const size_t removed,
+                                const char* const insertion,
+                                const size_t insertionSize)
+{
+    const size_t resume{offset + removed};
+    const size_t newBufferSize{offset + insertionSize + (baseSize - resume) + 1u};  // +1 for the null terminator
+
+    char* const newBuffer{newEntry->allocateBuffer(testCaseKey, static_cast<int>(newBufferSize))};
+    char* destination{newBuffer};
+
+    memcpy(destination, base, offset);
+    destination += offset;
+    if (insertionSize != 0u)
+        memcpy(destination, insertion, insertionSize);
+    destination += insertionSize;
+    memcpy(destination, base + resume, baseSize - resume);
+    destination[baseSize - resume] = '\0';
+
+    return newBuffer;
+}
+
+/**
+ * @brief Copies base and a null terminator to the new entry, for mutators that then change bytes in place
+ */
+static char* CopyIntoNewEntry(
+                              StorageEntry* newEntry,
+                              const int testCaseKey,
+                              const char* const base,
+                              const size_t baseSize)
+{
+    return SpliceIntoNewEntry(newEntry, testCaseKey, base, baseSize, baseSize, 0u, nullptr, 0u);
+}
+
+/**
+ * @brief Returns an empty segment builder for the output of the current mutation
+ *
+ * For outputs made of more pieces than a single splice. The builder is reused between mutations so that
+ * describing the output does not allocate once warmed up.
+ */
+SegmentBuilder& BeginOutput() noexcept
+{
+    outputSegments.Clear();
+
+    return outputSegments;
+}
+
+private:
+    SegmentBuilder outputSegments;
 };
 }
\ No newline at end of file
@@ -0,0 +1,196 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#include "RadamsaParseCache.hpp"
+#include "Iterator.hpp"
+#include <unordered_set>
+
+using namespace vmf;
+
+/**
+ * @brief Returns the cache shared by every Radamsa mutator in this process
+ */
+RadamsaParseCache* RadamsaParseCache::getInstance()
+{
+    static RadamsaParseCache instance;
+    return &instance;
+}
+
+/**
+ * @brief Drops every cached structure parsed from the given entry
+ */
+void RadamsaParseCache::Evict(unsigned long entryId)
+{
+    for (auto item = items.begin(); item != items.end();)
+    {
+        auto next = std::next(item);
+        if (item->ItemKey.EntryId == entryId)
+            Erase(item);
+        item = next;
+    }
+}
+
+/**
+ * @brief Drops cached structures whose entry is no longer among the storage's saved entries
+ */
+void RadamsaParseCache::Reconcile(StorageModule& storage)
+{
+    lookupsSinceReconcile = 0u;
+    if (items.empty())
+        return;
+
+    std::unordered_set<unsigned long> savedIds;
+    std::unique_ptr<Iterator> savedEntries{storage.getSavedEntries()};
+    while (savedEntries->hasNext())
+        savedIds.insert(savedEntries->getNext()->getID());
+
+    for (auto item = items.begin(); item != items.end();)
+    {
+        auto next = std::next(item);
+        if (savedIds.count(item->ItemKey.EntryId) == 0u)
+            Erase(item);
+        item = next;
+    }
+}
+
+/**
+ * @brief Drops every cached structure, resets the statistics and forgets their metadata keys
+ */
+void RadamsaParseCache::Clear()
+{
+    items.clear();
+    itemsByKey.clear();
+    lookupsSinceReconcile = 0u;
+    stats = Stats{};
+    statsRegistered = false;
+}
+
+/**
+ * @brief Sets the number of bytes the cached structures may hold, evicting as needed
+ */
+void RadamsaParseCache::SetByteBudget(size_t bytes)
+{
+    byteBudget = bytes;
+    EnforceBudget();
+}
+
+/**
+ * @brief Registers the metadata keys the cache statistics are published under
+ *
+ * @param registry - Metadata StorageRegistry object
+ */
+void RadamsaParseCache::RegisterStatsKeys(StorageRegistry& registry)
+{
+    hitRateKey = registry.registerKey("RADAMSA_PARSE_CACHE_HIT_RATE", StorageRegistry::FLOAT, StorageRegistry::WRITE_ONLY);
+    bytesHeldKey = registry.registerKey("RADAMSA_PARSE_CACHE_BYTES", StorageRegistry::UINT, StorageRegistry::WRITE_ONLY);
+    statsRegistered = true;
+}
+
+std::shared_ptr<const void> RadamsaParseCache::Lookup(StorageModule& storage, const Key& key, const char* buffer, size_t size)
+{
+    // Input generators other than RadamsaAdaptiveInputGenerator do not publish the statistics, so they are
+    // published here as well, alongside the walk of the saved entries
+    if (++lookupsSinceReconcile >= ReconcileInterval)
+    {
+        Reconcile(storage);
+        PublishStats(storage);
+    }
+
+    std::shared_ptr<const void> value{nullptr};
+
+    const auto found = itemsByKey.find(key);
+    if (found != itemsByKey.end())
+    {
+        const auto item = found->second;
+        if (item->Buffer == buffer && item->Size == size)
+        {
+            items.splice(items.begin(), items, item);
+            value = item->Value;
+        }
+        else
+        {
+            // The entry's buffer was reallocated since it was parsed
+            Erase(item);
+        }
+    }
+
+    if (value != nullptr)
+        ++stats.Hits;
+    else
+        ++stats.Misses;
+
+    return value;
+}
+
+void RadamsaParseCache::Insert(const Key& key, const char* buffer, size_t size, std::shared_ptr<const void> value, size_t footprint)
+{
+    // A structure larger than the whole budget is returned to the caller but never held
+    if (footprint > byteBudget)
+        return;
+
+    const auto existing = itemsByKey.find(key);
+    if (existing != itemsByKey.end())
+        Erase(existing->second);
+
+    items.push_front(Item{key, buffer, size, footprint, std::move(value)});
+    itemsByKey[key] = items.begin();
+    stats.BytesHeld += footprint;
+    stats.ItemsHeld = items.size();
+
+    EnforceBudget();
+}
+
+void RadamsaParseCache::Erase(std::list<Item>::iterator item)
+{
+    stats.BytesHeld -= item->Footprint;
+    ++stats.Evictions;
+    itemsByKey.erase(item->ItemKey);
+    items.erase(item);
+    stats.ItemsHeld = items.size();
+}
+
+void RadamsaParseCache::EnforceBudget()
+{
+    while (stats.BytesHeld > byteBudget && !items.empty())
+        Erase(std::prev(items.end()));
+}
+
+/**
+ * @brief Writes the statistics so far to the storage metadata, if the stats keys are registered
+ *
+ * This does not look at the storage's entries, so it is cheap enough to call once per fuzzing loop.
+ */
+void RadamsaParseCache::PublishStats(StorageModule& storage)
+{
+    if (!statsRegistered)
+        return;
+
+    StorageEntry& metadata{storage.getMetadata()};
+    metadata.setValue(hitRateKey, static_cast<float>(stats.GetHitRate()));
+    metadata.setValue(bytesHeldKey, static_cast<unsigned int>(stats.BytesHeld));
+}
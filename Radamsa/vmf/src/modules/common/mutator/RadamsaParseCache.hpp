@@ -0,0 +1,174 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include "StorageEntry.hpp"
+#include "StorageModule.hpp"
+#include "StorageRegistry.hpp"
+
+namespace vmf
+{
+/**
+ * @brief Memory-bounded LRU cache of structures parsed from corpus entries, shared by the Radamsa mutators
+ *
+ * Input generators tend to hand the same base entry to many mutations in a row. Mutators that parse their
+ * input (trees, line indices, textual numbers, ASCII text ranges) look the parse up here first, keyed by the entry
+ * ID and the kind of structure, and validated against the address and size of the entry's buffer, so a lookup
+ * never reads the bytes. Corpus entries are not written after they are saved, so a buffer only changes by being
+ * reallocated. Cached structures are immutable and must not hold pointers into the entry buffer that outlive the
+ * mutation; any views they keep are rebound by the caller.
+ *
+ * Items are evicted least recently used first once the byte budget is exceeded, and periodically when their
+ * entry is no longer among the storage's saved entries. Hit rate and bytes held are published to the
+ * storage metadata by PublishStats, for every module that registered the stats keys: RadamsaAdaptiveInputGenerator
+ * calls it once per fuzzing loop, and lookups call it each time they reconcile the cache with the storage.
+ */
+class RadamsaParseCache
+{
+public:
+    static constexpr size_t DefaultByteBudget{64u * 1024u * 1024u};
+    static constexpr size_t ReconcileInterval{4096u};
+
+    struct Stats
+    {
+        size_t Hits{0u};
+        size_t Misses{0u};
+        size_t Evictions{0u};
+        size_t BytesHeld{0u};
+        size_t ItemsHeld{0u};
+
+        double GetHitRate() const noexcept
+        {
+            const size_t lookups{Hits + Misses};
+            return lookups == 0u ? 0.0 : static_cast<double>(Hits) / static_cast<double>(lookups);
+        }
+    };
+
+    static RadamsaParseCache* getInstance();
+
+    /**
+     * @brief Returns the structure parsed from the given entry's buffer, parsing and caching it on a miss
+     *
+     * @tparam Structure - Type of the parsed structure
+     * @tparam Variant - Distinguishes differently parsed structures of the same type (e.g. per delimiter)
+     * @param parse - Callable returning the Structure parsed from buffer
+     * @param measure - Callable returning the number of bytes a Structure holds, for the byte budget
+     */
+    template <typename Structure, typename Variant = Structure, typename Parse, typename Measure>
+    std::shared_ptr<const Structure> GetOrParse(
+                                                StorageModule& storage,
+                                                StorageEntry* entry,
+                                                const char* buffer,
+                                                size_t size,
+                                                Parse&& parse,
+                                                Measure&& measure)
+    {
+        const Key key{entry->getID(), std::type_index(typeid(Kind<Structure, Variant>))};
+
+        std::shared_ptr<const void> cached{Lookup(storage, key, buffer, size)};
+        if (cached != nullptr)
+            return std::static_pointer_cast<const Structure>(cached);
+
+        std::shared_ptr<const Structure> parsed{std::make_shared<const Structure>(parse())};
+        Insert(key, buffer, size, parsed, measure(*parsed));
+
+        return parsed;
+    }
+
+    void Evict(unsigned long entryId);
+    void Reconcile(StorageModule& storage);
+    void Clear();
+
+    void SetByteBudget(size_t bytes);
+    size_t GetByteBudget() const noexcept { return byteBudget; }
+    const Stats& GetStats() const noexcept { return stats; }
+
+    /**
+     * @brief Registers the metadata keys the cache statistics are published under
+     */
+    void RegisterStatsKeys(StorageRegistry& registry);
+
+    /**
+     * @brief Writes the statistics so far to the storage metadata, if the stats keys are registered
+     */
+    void PublishStats(StorageModule& storage);
+
+private:
+    // Names a kind of cached structure, so Key can tell e.g. line indices built for different delimiters apart
+    template <typename Structure, typename Variant>
+    struct Kind {};
+
+    struct Key
+    {
+        unsigned long EntryId;
+        std::type_index StructureKind;
+
+        bool operator==(const Key& other) const noexcept { return EntryId == other.EntryId && StructureKind == other.StructureKind; }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const noexcept
+        {
+            return std::hash<unsigned long>{}(key.EntryId) ^ (key.StructureKind.hash_code() * 31u);
+        }
+    };
+
+    struct Item
+    {
+        Key ItemKey;
+        const char* Buffer;
+        size_t Size;
+        size_t Footprint;
+        std::shared_ptr<const void> Value;
+    };
+
+    RadamsaParseCache() = default;
+
+    std::shared_ptr<const void> Lookup(StorageModule& storage, const Key& key, const char* buffer, size_t size);
+    void Insert(const Key& key, const char* buffer, size_t size, std::shared_ptr<const void> value, size_t footprint);
+    void Erase(std::list<Item>::iterator item);
+    void EnforceBudget();
+
+    std::list<Item> items;  // most recently used first
+    std::unordered_map<Key, std::list<Item>::iterator, KeyHash> itemsByKey;
+    size_t byteBudget{DefaultByteBudget};
+    size_t lookupsSinceReconcile{0u};
+    Stats stats;
+    bool statsRegistered{false};
+    int hitRateKey{-1};
+    int bytesHeldKey{-1};
+};
+}
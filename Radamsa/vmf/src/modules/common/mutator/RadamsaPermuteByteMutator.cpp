@@ -130,18 +130,12 @@ void RadamsaPermuteByteMutator::mutateTestCase(StorageModule& storage, StorageEn
         return;
     }
 
-    // The new buffer size will contain one additional element since we are appending a null-terminator to the end.
+    // Copy the original buffer into a new buffer with a null-terminator appended to the end; bytes are then changed in place.
 
-    const size_t newBufferSize{originalSize + 1u};
+    char* newBuffer{CopyIntoNewEntry(newEntry, testCaseKey, originalBuffer, originalSize)};
 
-    // Allocate the new buffer, set it's elements to those of the original buffer, and append a null-terminator to the end.
-
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, static_cast<int>(newBufferSize))};
-    memset(newBuffer, 0u, newBufferSize);
-    memcpy(newBuffer, originalBuffer, originalSize);
-
-    // Copy data from the original buffer into the new buffer, but swap random bytes.
-    // The last element in the new buffer is skipped since it was implicitly set to zero during allocation.
+    // Swap each byte of the new buffer with a random one.
+    // The null-terminator at the end of the new buffer is never swapped.
 
     for (size_t sourceIndex{minimumSeedIndex}; sourceIndex < originalSize; ++sourceIndex)
     {
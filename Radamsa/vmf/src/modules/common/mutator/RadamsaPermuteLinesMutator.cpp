@@ -38,15 +38,21 @@ using namespace vmf;
 
 #include "ModuleFactory.hpp"
 REGISTER_MODULE(RadamsaPermuteLinesMutator);
+REGISTER_MODULE(RadamsaPermuteCrLfRecordsMutator);
+REGISTER_MODULE(RadamsaPermuteNulRecordsMutator);
+REGISTER_MODULE(RadamsaPermuteSemicolonRecordsMutator);
+REGISTER_MODULE(RadamsaPermuteCommaRecordsMutator);
+REGISTER_MODULE(RadamsaPermuteFieldRecordsMutator);
 
 /**
  * @brief Builder method to support the ModuleFactory
  * Constructs an instance of this class
  * @return Module* - Pointer to the newly created instance
  */
-Module* RadamsaPermuteLinesMutator::build(std::string name)
+template <typename Delimiter>
+Module* RadamsaPermuteRecordsMutator<Delimiter>::build(std::string name)
 {
-    return new RadamsaPermuteLinesMutator(name);
+    return new RadamsaPermuteRecordsMutator<Delimiter>(name);
 }
 
 /**
@@ -54,26 +60,29 @@ Module* RadamsaPermuteLinesMutator::build(std::string name)
  *
  * @param config - Configuration object
  */
-void RadamsaPermuteLinesMutator::init(ConfigInterface& config)
+template <typename Delimiter>
+void RadamsaPermuteRecordsMutator<Delimiter>::init(ConfigInterface& config)
 {
 
 }
 
 /**
- * @brief Construct a new RadamsaPermuteLinesMutator::RadamsaPermuteLinesMutator object
+ * @brief Construct a new RadamsaPermuteRecordsMutator::RadamsaPermuteRecordsMutator object
  *
  * @param name The of the name module
  */
-RadamsaPermuteLinesMutator::RadamsaPermuteLinesMutator(std::string name) : MutatorModule(name)
+template <typename Delimiter>
+RadamsaPermuteRecordsMutator<Delimiter>::RadamsaPermuteRecordsMutator(std::string name) : MutatorModule(name)
 {
     // rand->randInit();
 }
 
 /**
- * @brief Destroy the RadamsaPermuteLinesMutator::RadamsaPermuteLinesMutator object
+ * @brief Destroy the RadamsaPermuteRecordsMutator::RadamsaPermuteRecordsMutator object
  *
  */
-RadamsaPermuteLinesMutator::~RadamsaPermuteLinesMutator()
+template <typename Delimiter>
+RadamsaPermuteRecordsMutator<Delimiter>::~RadamsaPermuteRecordsMutator()
 {
 
 }
@@ -83,20 +92,33 @@ RadamsaPermuteLinesMutator::~RadamsaPermuteLinesMutator()
  *
  * @param registry - StorageRegistry object
  */
-void RadamsaPermuteLinesMutator::registerStorageNeeds(StorageRegistry& registry)
+template <typename Delimiter>
+void RadamsaPermuteRecordsMutator<Delimiter>::registerStorageNeeds(StorageRegistry& registry)
 {
     // This module does not register for a test case buffer key, because mutators are told which buffer to write in storage
     // by the input generator that calls them
 }
 
-void RadamsaPermuteLinesMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+template <typename Delimiter>
+void RadamsaPermuteRecordsMutator<Delimiter>::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
+
+template <typename Delimiter>
+void RadamsaPermuteRecordsMutator<Delimiter>::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
     // Randomize the order of given lines
 
     const size_t minimumSize{3u};   // minimal case consists of three newlines
     const size_t minimumLines{3u};  // for two lines, just use SwapLine
     const size_t minimumSeedIndex{0u};
-    const size_t characterIndex{0u};
     size_t originalSize;
     char* originalBuffer;
 
@@ -132,11 +154,8 @@ void RadamsaPermuteLinesMutator::mutateTestCase(StorageModule& storage, StorageE
         return;
     }
 
-    const size_t numLines{
-                    GetNumberOfLinesAfterIndex(
-                            originalBuffer,
-                            originalSize,
-                                        characterIndex)};
+    const LineIndex& lineIndex{GetLineIndex<Delimiter>(storage, baseEntry, originalBuffer, originalSize)};
+    const size_t numLines{lineIndex.GetNumberOfLines()};
 
     // Check if buffer has minimum required number of lines
     if (numLines < minimumLines) {
@@ -144,21 +163,14 @@ void RadamsaPermuteLinesMutator::mutateTestCase(StorageModule& storage, StorageE
         return;
     }
 
-    // create and initialize vectors of indeces and lines
-    std::vector<size_t> lineOrder(numLines);
-    std::vector<Line> lines(numLines);
+    // initialize the line order, reusing the scratch vector between mutations
+    lineOrder.resize(numLines);
     for(size_t i{0}; i < numLines; ++i) {
         lineOrder[i] = i;
-        lines[i] = GetLineData(
-                            originalBuffer,
-                            originalSize,
-                            i,
-                            numLines);
     }
 
     // randomize the line order
     // homebrew Fisher-Yates shuffle because std::shuffle can't use VmfRand
-    std::vector<Line> shuffledLines(numLines);
     for(size_t i{numLines - 1}; i > 0; --i) {
         long unsigned int min = 0;
         long unsigned int max = static_cast<long unsigned int>(i);
@@ -168,24 +180,28 @@ void RadamsaPermuteLinesMutator::mutateTestCase(StorageModule& storage, StorageE
         const size_t temp = lineOrder[i];
         lineOrder[i] = lineOrder[randIndex];
         lineOrder[randIndex] = temp;
-
-        // copy into shuffled order
-        shuffledLines[i] = lines[lineOrder[i]];
     }    
 
-    // create new buffer with modified order
-    const size_t newBufferSize{originalSize + 1u};  // +1 to implicitly append null terminator
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, static_cast<int>(newBufferSize))};
-    memset(newBuffer, 0u, newBufferSize);
-    for(
-        size_t i{0}, nextBufferIndex{0}; 
-        i < numLines; 
-        nextBufferIndex += lines[lineOrder[i]].Size, ++i
-    ) {
-        memcpy(
-            newBuffer + nextBufferIndex, 
-            originalBuffer + lines[lineOrder[i]].StartIndex, 
-            lines[lineOrder[i]].Size
-        );
+    // describe the new buffer: the lines in their new order, zeros in place of anything after the last newline
+    // (which is not part of a line) and a null terminator
+    SegmentBuilder& output{BeginOutput()};
+    for(size_t i{0}; i < numLines; ++i) {
+        const LineVector line{lineIndex.GetLineVector(lineOrder[i])};
+        output.Append(line.Data, line.Size);
     }
-}
\ No newline at end of file
+
+    output
+        .AppendFill(originalSize - lineIndex.GetLines(0u, numLines).Size, '\0')
+        .AppendNullTerminator()
+        .Write(newEntry, testCaseKey);
+}
+
+namespace vmf
+{
+template class RadamsaPermuteRecordsMutator<NewlineDelimiter>;
+template class RadamsaPermuteRecordsMutator<CrLfDelimiter>;
+template class RadamsaPermuteRecordsMutator<NulDelimiter>;
+template class RadamsaPermuteRecordsMutator<SemicolonDelimiter>;
+template class RadamsaPermuteRecordsMutator<CommaDelimiter>;
+template class RadamsaPermuteRecordsMutator<FieldSeparatorDelimiter>;
+}
@@ -37,21 +37,31 @@
 namespace vmf
 {
 /**
- *
+ * @tparam Delimiter - Record delimiter policy (see RadamsaDelimiter.hpp)
  */
-class RadamsaPermuteLinesMutator: public MutatorModule, public RadamsaLineMutatorBase
+template <typename Delimiter>
+class RadamsaPermuteRecordsMutator: public MutatorModule, public RadamsaLineMutatorBase
 {
     public:
 
         static Module* build(std::string name);
         virtual void init(ConfigInterface& config);
 
-        RadamsaPermuteLinesMutator(std::string name);
-        virtual ~RadamsaPermuteLinesMutator();
+        RadamsaPermuteRecordsMutator(std::string name);
+        virtual ~RadamsaPermuteRecordsMutator();
         virtual void registerStorageNeeds(StorageRegistry& registry);
+        virtual void registerMetadataNeeds(StorageRegistry& registry);
         virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
 
     private:
         VmfRand* rand = VmfRand::getInstance();
+        std::vector<size_t> lineOrder;
 };
-}
\ No newline at end of file
+
+using RadamsaPermuteLinesMutator = RadamsaPermuteRecordsMutator<NewlineDelimiter>;
+using RadamsaPermuteCrLfRecordsMutator = RadamsaPermuteRecordsMutator<CrLfDelimiter>;
+using RadamsaPermuteNulRecordsMutator = RadamsaPermuteRecordsMutator<NulDelimiter>;
+using RadamsaPermuteSemicolonRecordsMutator = RadamsaPermuteRecordsMutator<SemicolonDelimiter>;
+using RadamsaPermuteCommaRecordsMutator = RadamsaPermuteRecordsMutator<CommaDelimiter>;
+using RadamsaPermuteFieldRecordsMutator = RadamsaPermuteRecordsMutator<FieldSeparatorDelimiter>;
+}
@@ -130,16 +130,10 @@ void RadamsaRepeatByteMutator::mutateTestCase(StorageModule& storage, StorageEnt
         return;
     }
 
-    // The new buffer size will contain a random number of additional elements since we are repeating a random byte.
+    // The new buffer will contain a random number of additional elements since we are repeating a random byte.
     // Furthermore, it will contain one more element since we are appending a null-terminator to the end.
 
     const size_t numberOfRandomByteRepetitions{GetRandomRepetitionLength(rand)};
-    const size_t newBufferSize{originalSize + numberOfRandomByteRepetitions + 1u};
-
-    // Allocate the new buffer and set it's elements to zero.
-
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, static_cast<int>(newBufferSize))};
-    memset(newBuffer, 0u, newBufferSize);
 
     // Select a random index from which the new bytes will be repeated.
 
@@ -157,21 +151,11 @@ void RadamsaRepeatByteMutator::mutateTestCase(StorageModule& storage, StorageEnt
     };
 
     // Copy data from the original buffer into the new buffer, but repeat the target byte.
-    // The last element in the new buffer is skipped since it was implicitly set to zero during allocation.
 
-    for (size_t sourceIndex{0u}, destinationIndex{0u}; sourceIndex < originalSize; ++sourceIndex)
-    {
-        if (sourceIndex == randomByteRepetitionIndex)
-        {
-            memset(&newBuffer[destinationIndex], originalBuffer[sourceIndex], numberOfRandomByteRepetitions + 1u);
-
-            ++destinationIndex += numberOfRandomByteRepetitions;
-        }
-        else
-        {
-            newBuffer[destinationIndex] = originalBuffer[sourceIndex];
-
-            ++destinationIndex;
-        }
-    }
+    BeginOutput()
+        .Append(originalBuffer, randomByteRepetitionIndex)
+        .AppendFill(numberOfRandomByteRepetitions, originalBuffer[randomByteRepetitionIndex])
+        .Append(originalBuffer + randomByteRepetitionIndex, originalSize - randomByteRepetitionIndex)
+        .AppendNullTerminator()
+        .Write(newEntry, testCaseKey);
 }
\ No newline at end of file
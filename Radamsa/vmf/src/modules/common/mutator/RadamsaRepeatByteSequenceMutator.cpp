@@ -144,30 +144,13 @@ void RadamsaRepeatByteSequenceMutator::mutateTestCase(StorageModule& storage, St
     // Get random number of sequence repetitions
     const size_t numberOfRepetitions{GetRandomRepetitionLength(rand)};
 
-    // Calculate the size of the modified buffer
+    // The sequence is written once more than the number of repetitions: the original, then the repeats
     const size_t seq_len{end_index - start_index + 1u};
-    const size_t newBufferSize{originalSize + (seq_len * numberOfRepetitions) + 1u}; // +1 because we're appending a null-terminator
-
-    // Allocate the new buffer and set it's elements to zero.
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, static_cast<int>(newBufferSize))};
-    memset(newBuffer, 0u, newBufferSize);
-
-    // Copy pre-sequence into modified buffer
-    memcpy(newBuffer, originalBuffer, start_index);
-
-    // Copy post-sequence into modified buffer
-    memcpy(
-        newBuffer, 
-        originalBuffer + start_index + (seq_len * numberOfRepetitions), 
-        originalSize - end_index - 1u
-    );
-
-    // Fill the rest with the byte sequence
-    for (size_t i = 1; i < numberOfRepetitions; ++i) {
-        memcpy(
-            newBuffer + start_index + (i * seq_len), 
-            originalBuffer + start_index, 
-            seq_len
-        );
-    }
+
+    BeginOutput()
+        .Append(originalBuffer, start_index)                                            // pre-sequence
+        .AppendRepeated(originalBuffer + start_index, seq_len, numberOfRepetitions + 1u)  // repeated sequence
+        .Append(originalBuffer + end_index + 1u, originalSize - end_index - 1u)         // post-sequence
+        .AppendNullTerminator()
+        .Write(newEntry, testCaseKey);
 }
\ No newline at end of file
@@ -38,15 +38,21 @@ using namespace vmf;
 
 #include "ModuleFactory.hpp"
 REGISTER_MODULE(RadamsaRepeatLineMutator);
+REGISTER_MODULE(RadamsaRepeatCrLfRecordMutator);
+REGISTER_MODULE(RadamsaRepeatNulRecordMutator);
+REGISTER_MODULE(RadamsaRepeatSemicolonRecordMutator);
+REGISTER_MODULE(RadamsaRepeatCommaRecordMutator);
+REGISTER_MODULE(RadamsaRepeatFieldRecordMutator);
 
 /**
  * @brief Builder method to support the ModuleFactory
  * Constructs an instance of this class
  * @return Module* - Pointer to the newly created instance
  */
-Module* RadamsaRepeatLineMutator::build(std::string name)
+template <typename Delimiter>
+Module* RadamsaRepeatRecordMutator<Delimiter>::build(std::string name)
 {
-    return new RadamsaRepeatLineMutator(name);
+    return new RadamsaRepeatRecordMutator<Delimiter>(name);
 }
 
 /**
@@ -54,26 +60,29 @@ Module* RadamsaRepeatLineMutator::build(std::string name)
  *
  * @param config - Configuration object
  */
-void RadamsaRepeatLineMutator::init(ConfigInterface& config)
+template <typename Delimiter>
+void RadamsaRepeatRecordMutator<Delimiter>::init(ConfigInterface& config)
 {
-
+    SetStreamingThreshold(config.getIntParam(getModuleName(), "streamingThreshold", DefaultStreamingThreshold));
 }
 
 /**
- * @brief Construct a new RadamsaRepeatLineMutator::RadamsaRepeatLineMutator object
+ * @brief Construct a new RadamsaRepeatRecordMutator::RadamsaRepeatRecordMutator object
  *
  * @param name The of the name module
  */
-RadamsaRepeatLineMutator::RadamsaRepeatLineMutator(std::string name) : MutatorModule(name)
+template <typename Delimiter>
+RadamsaRepeatRecordMutator<Delimiter>::RadamsaRepeatRecordMutator(std::string name) : MutatorModule(name)
 {
     // rand.randInit();
 }
 
 /**
- * @brief Destroy the RadamsaRepeatLineMutator::RadamsaRepeatLineMutator object
+ * @brief Destroy the RadamsaRepeatRecordMutator::RadamsaRepeatRecordMutator object
  *
  */
-RadamsaRepeatLineMutator::~RadamsaRepeatLineMutator()
+template <typename Delimiter>
+RadamsaRepeatRecordMutator<Delimiter>::~RadamsaRepeatRecordMutator()
 {
 
 }
@@ -83,13 +92,27 @@ RadamsaRepeatLineMutator::~RadamsaRepeatLineMutator()
  *
  * @param registry - StorageRegistry object
  */
-void RadamsaRepeatLineMutator::registerStorageNeeds(StorageRegistry& registry)
+template <typename Delimiter>
+void RadamsaRepeatRecordMutator<Delimiter>::registerStorageNeeds(StorageRegistry& registry)
 {
     // This module does not register for a test case buffer key, because mutators are told which buffer to write in storage
     // by the input generator that calls them
 }
 
-void RadamsaRepeatLineMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+template <typename Delimiter>
+void RadamsaRepeatRecordMutator<Delimiter>::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
+
+template <typename Delimiter>
+void RadamsaRepeatRecordMutator<Delimiter>::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
     // Consume the original buffer by repeating a random line multiple times and appending a null-terminator to the end.
 
@@ -131,11 +154,39 @@ void RadamsaRepeatLineMutator::mutateTestCase(StorageModule& storage, StorageEnt
         return;
     }
 
-    const size_t numberOfLinesAfterIndex{
-                                    GetNumberOfLinesAfterIndex(
-                                                        originalBuffer,
-                                                        originalSize,
-                                                        characterIndex)};
+    if (IsStreamingSize(originalSize))
+    {
+        // Very large input: sample the line to repeat in one pass instead of indexing every line.
+
+        const Line lineData{SampleLineStreaming<Delimiter>(originalBuffer, originalSize, rand)};
+
+        if (!lineData.IsValid)
+        {
+            CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+            return;
+        }
+
+        const size_t lineEndIndex{lineData.StartIndex + lineData.Size};
+
+        BeginOutput()
+            .Append(originalBuffer, lineEndIndex)
+            .AppendRepeated(originalBuffer + lineData.StartIndex, lineData.Size, GetRandomRepetitionLength(this->rand))
+            .Append(originalBuffer + lineEndIndex, originalSize - lineEndIndex)
+            .AppendNullTerminator()
+            .Write(newEntry, testCaseKey);
+
+        return;
+    }
+
+    const LineIndex& lineIndex{GetLineIndex<Delimiter>(storage, baseEntry, originalBuffer, originalSize)};
+    const size_t numberOfLinesAfterIndex{lineIndex.GetNumberOfLines()};
+
+    // Check if buffer has minimum required number of lines
+    if (numberOfLinesAfterIndex < 1u)
+    {
+        CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+        return;
+    }
 
     // Select a random line to duplicate.
 
@@ -147,44 +198,29 @@ void RadamsaRepeatLineMutator::mutateTestCase(StorageModule& storage, StorageEnt
                                             minimumRandomLineIndex,
                                             maximumRandomLineIndex)};
 
-    const Line lineData{
-                    GetLineData(
-                            originalBuffer,
-                            originalSize,
-                            randomLineIndex,
-                            numberOfLinesAfterIndex)};
-
     const size_t numberOfRandomLineRepetitions{GetRandomRepetitionLength(this->rand)};
 
-    // The new buffer will be multiple lines larger than the original buffer;
-    // additionally, it will contain one additional byte since a null-terminator will be appended to the end.
-
-    const size_t newBufferSize{originalSize + (lineData.Size * numberOfRandomLineRepetitions) + 1u};
-
-    // Allocate the new buffer and set it's elements to zero.
+    // The new buffer holds the original data with the random line repeated numberOfRandomLineRepetitions more times,
+    // followed by a null-terminator.
 
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
+    const LineVector line{lineIndex.GetLineVector(randomLineIndex)};
+    const LineVector linesBefore{lineIndex.GetLines(0u, randomLineIndex + 1u)};
+    const LineVector linesAfter{lineIndex.GetLinesToEnd(randomLineIndex + 1u)};
 
-    // Copy data from the original buffer into the new buffer, but repeat the random line.
-    // The last element in the new buffer is skipped since it was implicitly set to zero during allocation.
-
-    for(size_t sourceIndex{0u}, destinationIndex{0u}; sourceIndex < originalSize; ++sourceIndex)
-    {
-        if(sourceIndex == lineData.StartIndex)
-        {
-            for (size_t k{0u}; k < (numberOfRandomLineRepetitions + 1u); ++k)
-            {
-                memcpy(&newBuffer[destinationIndex], &originalBuffer[sourceIndex], lineData.Size);
-
-                destinationIndex += lineData.Size;
-            }
-
-            sourceIndex += lineData.Size;
-        }
-
-        newBuffer[destinationIndex] = originalBuffer[sourceIndex];
+    BeginOutput()
+        .Append(linesBefore.Data, linesBefore.Size)
+        .AppendRepeated(line.Data, line.Size, numberOfRandomLineRepetitions)
+        .Append(linesAfter.Data, linesAfter.Size)
+        .AppendNullTerminator()
+        .Write(newEntry, testCaseKey);
+}
 
-        ++destinationIndex;
-    }
-}
\ No newline at end of file
+namespace vmf
+{
+template class RadamsaRepeatRecordMutator<NewlineDelimiter>;
+template class RadamsaRepeatRecordMutator<CrLfDelimiter>;
+template class RadamsaRepeatRecordMutator<NulDelimiter>;
+template class RadamsaRepeatRecordMutator<SemicolonDelimiter>;
+template class RadamsaRepeatRecordMutator<CommaDelimiter>;
+template class RadamsaRepeatRecordMutator<FieldSeparatorDelimiter>;
+}
@@ -37,21 +37,30 @@
 namespace vmf
 {
 /**
- *
+ * @tparam Delimiter - Record delimiter policy (see RadamsaDelimiter.hpp)
  */
-class RadamsaRepeatLineMutator: public MutatorModule, public RadamsaLineMutatorBase
+template <typename Delimiter>
+class RadamsaRepeatRecordMutator: public MutatorModule, public RadamsaLineMutatorBase
 {
     public:
 
         static Module* build(std::string name);
         virtual void init(ConfigInterface& config);
 
-        RadamsaRepeatLineMutator(std::string name);
-        virtual ~RadamsaRepeatLineMutator();
+        RadamsaRepeatRecordMutator(std::string name);
+        virtual ~RadamsaRepeatRecordMutator();
         virtual void registerStorageNeeds(StorageRegistry& registry);
+        virtual void registerMetadataNeeds(StorageRegistry& registry);
         virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
 
     private:
         VmfRand* rand = VmfRand::getInstance();
 };
-}
\ No newline at end of file
+
+using RadamsaRepeatLineMutator = RadamsaRepeatRecordMutator<NewlineDelimiter>;
+using RadamsaRepeatCrLfRecordMutator = RadamsaRepeatRecordMutator<CrLfDelimiter>;
+using RadamsaRepeatNulRecordMutator = RadamsaRepeatRecordMutator<NulDelimiter>;
+using RadamsaRepeatSemicolonRecordMutator = RadamsaRepeatRecordMutator<SemicolonDelimiter>;
+using RadamsaRepeatCommaRecordMutator = RadamsaRepeatRecordMutator<CommaDelimiter>;
+using RadamsaRepeatFieldRecordMutator = RadamsaRepeatRecordMutator<FieldSeparatorDelimiter>;
+}
@@ -56,7 +56,21 @@ Module* RadamsaRepeatPathMutator::build(std::string name)
  */
 void RadamsaRepeatPathMutator::init(ConfigInterface& config)
 {
+    SetTreeSyntax(config.getStringParam(getModuleName(), "syntax", "parenthesized"));
+    SetMaxOutputSize(config.getIntParam(getModuleName(), "maxOutputSize", DefaultMaxOutputSize));
+}
+
+/**
+ * @brief Sets the ceiling on the size of a mutated test case, in bytes
+ *
+ * @param size - Maximum output size, excluding the null terminator
+ */
+void RadamsaRepeatPathMutator::SetMaxOutputSize(const int size)
+{
+    if (size <= 0)
+        throw RuntimeException{"The maximum output size must be positive", RuntimeException::CONFIGURATION_ERROR};
 
+    maxOutputSize = static_cast<size_t>(size);
 }
 
 /**
@@ -89,6 +103,17 @@ void RadamsaRepeatPathMutator::registerStorageNeeds(StorageRegistry& registry)
     // by the input generator that calls them
 }
 
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+void RadamsaRepeatPathMutator::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
+
 void RadamsaRepeatPathMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
     // Replace a random node's random child with a random amount of recursive copies of itself
@@ -131,10 +156,10 @@ void RadamsaRepeatPathMutator::mutateTestCase(StorageModule& storage, StorageEnt
         return;
     }
 
-    const std::string treeStr(originalBuffer, originalSize);
-    Tree tr(treeStr);
+    // loading into the member tree reuses the node and value arenas of the previous mutation
+    LoadTree(tree, storage, baseEntry, originalBuffer, originalSize);
 
-    size_t numNodes = tr.countNodes(tr.root);
+    size_t numNodes = tree.countNodes(tree.root);
     // Check if tree has minimum required number of nodes
     if (numNodes < minimumNodes)
     {
@@ -142,27 +167,33 @@ void RadamsaRepeatPathMutator::mutateTestCase(StorageModule& storage, StorageEnt
         return;
     }
 
+    // pick a parent that actually has children; the root has at least one, since numNodes >= minimumNodes.
+    // The bracketed root has no text of its own; it comes first in pre-order, so skip it.
+    const size_t firstParentIndex{(GetTreeSyntax() == Syntax::Bracketed) ? 1u : 0u};
+    const size_t numParents{tree.countInternalNodes()};
+    if (numParents <= firstParentIndex)
+    {
+        CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+        return;
+    }
+
     const size_t lower{0u};
-    size_t upper{numNodes - 1};
-    size_t parentIndex;
-    Node* parent;
-    do {
-        parentIndex = this->rand->randBetween(lower, upper);
-        parent =  tr.findNodeByIndex(tr.root, parentIndex);
-    } while (parent->children.size() <= 0);   // find a parent that actually has children
-
-    upper = parent->children.size() - 1;
+    size_t upper{numParents - 1};
+    const size_t parentIndex{this->rand->randBetween(firstParentIndex, upper)};
+    const NodeId parent{tree.findInternalNodeByIndex(parentIndex)};
+
+    upper = tree.countChildren(parent) - 1;
     size_t childIndex{this->rand->randBetween(lower, upper)};
     size_t numReps = this->GetRandomRepetitionLength(this->rand);
 
-    tr.repeatPath(parent, childIndex, numReps);
+    // the repetition is recorded rather than built, and capped so that the output stays within maxOutputSize
+    tree.repeatPath(parent, childIndex, numReps, maxOutputSize);
 
-    const string modTreeStr = tr.toString(tr.root);
-    const size_t newBufferSize{modTreeStr.length() + 1}; // +1 to implicitly append a null terminator
+    // size the output exactly, then serialize straight into the new buffer
+    const size_t modTreeSize{tree.getSerializedSize(tree.root)};
+    const size_t newBufferSize{modTreeSize + 1}; // +1 to implicitly append a null terminator
 
     char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
-
-    std::strcpy(newBuffer, modTreeStr.c_str());
+    *tree.serialize(tree.root, newBuffer) = '\0';
     return;
 }
\ No newline at end of file
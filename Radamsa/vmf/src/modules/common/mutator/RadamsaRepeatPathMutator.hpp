@@ -49,9 +49,22 @@ class RadamsaRepeatPathMutator: public MutatorModule, public RadamsaTreeMutatorB
         RadamsaRepeatPathMutator(std::string name);
         virtual ~RadamsaRepeatPathMutator();
         virtual void registerStorageNeeds(StorageRegistry& registry);
+        virtual void registerMetadataNeeds(StorageRegistry& registry);
         virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
 
+        /**
+         * @brief Default ceiling on the size of a mutated test case, in bytes
+         *
+         * The number of repetitions is reduced so that the output stays within the ceiling; the repeated path
+         * is never expanded beyond it.
+         */
+        static constexpr int DefaultMaxOutputSize{16 * 1024 * 1024};
+
+        void SetMaxOutputSize(const int size);
+
     private:
         VmfRand* rand = VmfRand::getInstance();
+        Tree tree;
+        size_t maxOutputSize{static_cast<size_t>(DefaultMaxOutputSize)};
 };
 }
\ No newline at end of file
@@ -38,15 +38,21 @@ using namespace vmf;
 
 #include "ModuleFactory.hpp"
 REGISTER_MODULE(RadamsaReplaceLineMutator);
+REGISTER_MODULE(RadamsaReplaceCrLfRecordMutator);
+REGISTER_MODULE(RadamsaReplaceNulRecordMutator);
+REGISTER_MODULE(RadamsaReplaceSemicolonRecordMutator);
+REGISTER_MODULE(RadamsaReplaceCommaRecordMutator);
+REGISTER_MODULE(RadamsaReplaceFieldRecordMutator);
 
 /**
  * @brief Builder method to support the ModuleFactory
  * Constructs an instance of this class
  * @return Module* - Pointer to the newly created instance
  */
-Module* RadamsaReplaceLineMutator::build(std::string name)
+template <typename Delimiter>
+Module* RadamsaReplaceRecordMutator<Delimiter>::build(std::string name)
 {
-    return new RadamsaReplaceLineMutator(name);
+    return new RadamsaReplaceRecordMutator<Delimiter>(name);
 }
 
 /**
@@ -54,26 +60,29 @@ Module* RadamsaReplaceLineMutator::build(std::string name)
  *
  * @param config - Configuration object
  */
-void RadamsaReplaceLineMutator::init(ConfigInterface& config)
+template <typename Delimiter>
+void RadamsaReplaceRecordMutator<Delimiter>::init(ConfigInterface& config)
 {
-
+    SetStreamingThreshold(config.getIntParam(getModuleName(), "streamingThreshold", DefaultStreamingThreshold));
 }
 
 /**
- * @brief Construct a new RadamsaReplaceLineMutator::RadamsaReplaceLineMutator object
+ * @brief Construct a new RadamsaReplaceRecordMutator::RadamsaReplaceRecordMutator object
  *
  * @param name The of the name module
  */
-RadamsaReplaceLineMutator::RadamsaReplaceLineMutator(std::string name) : MutatorModule(name)
+template <typename Delimiter>
+RadamsaReplaceRecordMutator<Delimiter>::RadamsaReplaceRecordMutator(std::string name) : MutatorModule(name)
 {
     // rand->randInit();
 }
 
 /**
- * @brief Destroy the RadamsaReplaceLineMutator::RadamsaReplaceLineMutator object
+ * @brief Destroy the RadamsaReplaceRecordMutator::RadamsaReplaceRecordMutator object
  *
  */
-RadamsaReplaceLineMutator::~RadamsaReplaceLineMutator()
+template <typename Delimiter>
+RadamsaReplaceRecordMutator<Delimiter>::~RadamsaReplaceRecordMutator()
 {
 
 }
@@ -83,13 +92,27 @@ RadamsaReplaceLineMutator::~RadamsaReplaceLineMutator()
  *
  * @param registry - StorageRegistry object
  */
-void RadamsaReplaceLineMutator::registerStorageNeeds(StorageRegistry& registry)
+template <typename Delimiter>
+void RadamsaReplaceRecordMutator<Delimiter>::registerStorageNeeds(StorageRegistry& registry)
 {
     // This module does not register for a test case buffer key, because mutators are told which buffer to write in storage
     // by the input generator that calls them
 }
 
-void RadamsaReplaceLineMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+template <typename Delimiter>
+void RadamsaReplaceRecordMutator<Delimiter>::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
+
+template <typename Delimiter>
+void RadamsaReplaceRecordMutator<Delimiter>::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
     // Move a random line to a random place in the line ordering
 
@@ -132,11 +155,64 @@ void RadamsaReplaceLineMutator::mutateTestCase(StorageModule& storage, StorageEn
         return;
     }
 
-    const size_t numLines{
-                    GetNumberOfLinesAfterIndex(
-                                        originalBuffer,
-                                        originalSize,
-                                        characterIndex)};
+    if (IsStreamingSize(originalSize)) {
+        // Very large input: count the lines, then locate the lines involved in a single pass instead of indexing every line
+
+        const size_t numLines{Delimiter::Count(originalBuffer, originalSize, 0u, originalSize)};
+
+        if (numLines < minimumLines) {
+            CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+            return;
+        }
+
+        const size_t original_lineIndex = this->rand->randBetween(characterIndex, numLines - 1);
+        const size_t new_lineIndex = this->rand->randBetween(characterIndex, numLines - 2);
+
+        // offsets of the lines bounding the moved line and its new position, in ascending order
+        const bool movesUp{new_lineIndex < original_lineIndex};
+        const size_t lineIndices[]{
+            movesUp ? new_lineIndex : original_lineIndex,
+            movesUp ? original_lineIndex : original_lineIndex + 1u,
+            movesUp ? original_lineIndex + 1u : new_lineIndex + 1u,
+            numLines};
+        size_t lineOffsets[4];
+
+        GetLineOffsetsStreaming<Delimiter>(originalBuffer, originalSize, lineIndices, lineOffsets, 4u);
+
+        const size_t linesEndOffset{lineOffsets[3]};
+        SegmentBuilder& output{BeginOutput()};
+        size_t movedLineSize;
+
+        if (movesUp) {
+            // [0, new) + moved + [new, original) + [original + 1, end)
+            movedLineSize = lineOffsets[2] - lineOffsets[1];
+            output
+                .Append(originalBuffer, lineOffsets[0])
+                .Append(originalBuffer + lineOffsets[1], movedLineSize)
+                .Append(originalBuffer + lineOffsets[0], lineOffsets[1] - lineOffsets[0])
+                .Append(originalBuffer + lineOffsets[2], linesEndOffset - lineOffsets[2]);
+        }
+        else {
+            // [0, original) + [original + 1, new + 1) + moved + [new + 1, end)
+            movedLineSize = lineOffsets[1] - lineOffsets[0];
+            output
+                .Append(originalBuffer, lineOffsets[0])
+                .Append(originalBuffer + lineOffsets[1], lineOffsets[2] - lineOffsets[1])
+                .Append(originalBuffer + lineOffsets[0], movedLineSize)
+                .Append(originalBuffer + lineOffsets[2], linesEndOffset - lineOffsets[2]);
+        }
+
+        // same size as the indexed path; anything after the last newline is not part of a line and is zero-filled
+        output
+            .AppendFill(originalSize + movedLineSize - linesEndOffset, '\0')
+            .AppendNullTerminator()
+            .Write(newEntry, testCaseKey);
+
+        return;
+    }
+
+    const LineIndex& lineIndex{GetLineIndex<Delimiter>(storage, baseEntry, originalBuffer, originalSize)};
+    const size_t numLines{lineIndex.GetNumberOfLines()};
 
     // Check if buffer has minimum required number of lines
     if (numLines < minimumLines) {
@@ -144,39 +220,51 @@ void RadamsaReplaceLineMutator::mutateTestCase(StorageModule& storage, StorageEn
         return;
     }
 
-    // parse line info
-    std::vector<size_t> lineOrder(numLines);
-    std::vector<Line> lines(numLines);
-    for(size_t i{0}; i < numLines; ++i) {
-        lineOrder[i] = i;
-        lines[i] = GetLineData(
-                            originalBuffer,
-                            originalSize,
-                            i,
-                            numLines);
+    const size_t original_lineIndex = this->rand->randBetween(characterIndex, numLines - 1);
+    const size_t new_lineIndex = this->rand->randBetween(characterIndex, numLines - 2); // extra -1 because the line order is one shorter after the original is removed
+
+    const LineVector movedLine{lineIndex.GetLineVector(original_lineIndex)};
+
+    // the original line moves to position new_lineIndex
+    SegmentBuilder& output{BeginOutput()};
+
+    if (new_lineIndex < original_lineIndex) {
+        const LineVector linesBefore{lineIndex.GetLines(0u, new_lineIndex)};
+        const LineVector linesBetween{lineIndex.GetLines(new_lineIndex, original_lineIndex)};
+        const LineVector linesAfter{lineIndex.GetLines(original_lineIndex + 1u, numLines)};
+
+        output
+            .Append(linesBefore.Data, linesBefore.Size)
+            .Append(movedLine.Data, movedLine.Size)
+            .Append(linesBetween.Data, linesBetween.Size)
+            .Append(linesAfter.Data, linesAfter.Size);
     }
+    else {
+        const LineVector linesBefore{lineIndex.GetLines(0u, original_lineIndex)};
+        const LineVector linesBetween{lineIndex.GetLines(original_lineIndex + 1u, new_lineIndex + 1u)};
+        const LineVector linesAfter{lineIndex.GetLines(new_lineIndex + 1u, numLines)};
 
-    const size_t original_lineIndex = this->rand->randBetween(characterIndex, numLines - 1);
-    const size_t new_lineIndex = this->rand->randBetween(characterIndex, numLines - 2); // extra -1 because vector size is one less after orignal is removed
-
-    // swap original with new
-    const size_t original_value = lineOrder[original_lineIndex];
-    lineOrder.erase(lineOrder.begin() + original_lineIndex);
-    lineOrder.insert(lineOrder.begin() + new_lineIndex, original_value);
-
-    // create new buffer with modified order
-    const size_t newBufferSize{originalSize + lines[original_lineIndex].Size + 1u};  // +1 to implicitly append null terminator
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, static_cast<int>(newBufferSize))};
-    memset(newBuffer, 0u, newBufferSize);
-    for(
-        size_t i{0}, nextBufferIndex{0}; 
-        i < lineOrder.size(); 
-        nextBufferIndex += lines[lineOrder[i]].Size, ++i
-    ) {
-        memcpy(
-            newBuffer + nextBufferIndex, 
-            originalBuffer + lines[lineOrder[i]].StartIndex, 
-            lines[lineOrder[i]].Size
-        );
+        output
+            .Append(linesBefore.Data, linesBefore.Size)
+            .Append(linesBetween.Data, linesBetween.Size)
+            .Append(movedLine.Data, movedLine.Size)
+            .Append(linesAfter.Data, linesAfter.Size);
     }
-}
\ No newline at end of file
+
+    // same size as the original plus the moved line; anything after the last newline is not part of a line and is
+    // zero-filled
+    output
+        .AppendFill(originalSize + movedLine.Size - output.GetSize(), '\0')
+        .AppendNullTerminator()
+        .Write(newEntry, testCaseKey);
+}
+
+namespace vmf
+{
+template class RadamsaReplaceRecordMutator<NewlineDelimiter>;
+template class RadamsaReplaceRecordMutator<CrLfDelimiter>;
+template class RadamsaReplaceRecordMutator<NulDelimiter>;
+template class RadamsaReplaceRecordMutator<SemicolonDelimiter>;
+template class RadamsaReplaceRecordMutator<CommaDelimiter>;
+template class RadamsaReplaceRecordMutator<FieldSeparatorDelimiter>;
+}
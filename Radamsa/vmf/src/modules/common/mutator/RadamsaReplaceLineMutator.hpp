@@ -37,21 +37,30 @@
 namespace vmf
 {
 /**
- *
+ * @tparam Delimiter - Record delimiter policy (see RadamsaDelimiter.hpp)
  */
-class RadamsaReplaceLineMutator: public MutatorModule, public RadamsaLineMutatorBase
+template <typename Delimiter>
+class RadamsaReplaceRecordMutator: public MutatorModule, public RadamsaLineMutatorBase
 {
     public:
 
         static Module* build(std::string name);
         virtual void init(ConfigInterface& config);
 
-        RadamsaReplaceLineMutator(std::string name);
-        virtual ~RadamsaReplaceLineMutator();
+        RadamsaReplaceRecordMutator(std::string name);
+        virtual ~RadamsaReplaceRecordMutator();
         virtual void registerStorageNeeds(StorageRegistry& registry);
+        virtual void registerMetadataNeeds(StorageRegistry& registry);
         virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
 
     private:
         VmfRand* rand = VmfRand::getInstance();
 };
-}
\ No newline at end of file
+
+using RadamsaReplaceLineMutator = RadamsaReplaceRecordMutator<NewlineDelimiter>;
+using RadamsaReplaceCrLfRecordMutator = RadamsaReplaceRecordMutator<CrLfDelimiter>;
+using RadamsaReplaceNulRecordMutator = RadamsaReplaceRecordMutator<NulDelimiter>;
+using RadamsaReplaceSemicolonRecordMutator = RadamsaReplaceRecordMutator<SemicolonDelimiter>;
+using RadamsaReplaceCommaRecordMutator = RadamsaReplaceRecordMutator<CommaDelimiter>;
+using RadamsaReplaceFieldRecordMutator = RadamsaReplaceRecordMutator<FieldSeparatorDelimiter>;
+}
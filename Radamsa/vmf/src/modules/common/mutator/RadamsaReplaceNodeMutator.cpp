@@ -56,7 +56,7 @@ Module* RadamsaReplaceNodeMutator::build(std::string name)
  */
 void RadamsaReplaceNodeMutator::init(ConfigInterface& config)
 {
-
+    SetTreeSyntax(config.getStringParam(getModuleName(), "syntax", "parenthesized"));
 }
 
 /**
@@ -89,6 +89,17 @@ void RadamsaReplaceNodeMutator::registerStorageNeeds(StorageRegistry& registry)
     // by the input generator that calls them
 }
 
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+void RadamsaReplaceNodeMutator::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
+
 void RadamsaReplaceNodeMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
     // Replaces an random node with another random node
@@ -131,10 +142,10 @@ void RadamsaReplaceNodeMutator::mutateTestCase(StorageModule& storage, StorageEn
         return;
     }
 
-    const std::string treeStr(originalBuffer, originalSize);
-    Tree tr(treeStr);
+    // loading into the member tree reuses the node and value arenas of the previous mutation
+    LoadTree(tree, storage, baseEntry, originalBuffer, originalSize);
 
-    size_t numNodes = tr.countNodes(tr.root);
+    size_t numNodes = tree.countNodes(tree.root);
     // Check if tree has minimum required number of nodes
     if (numNodes < minimumNodes)
     {
@@ -148,16 +159,15 @@ void RadamsaReplaceNodeMutator::mutateTestCase(StorageModule& storage, StorageEn
     size_t nodeIndexToCopy{this->rand->randBetween(lower, upper)};      // ^
 
     if(nodeIndexToReplace != nodeIndexToCopy) {
-        Node* toReplace = tr.findNodeByIndex(tr.root, nodeIndexToReplace); 
-        Node* toCopy = tr.findNodeByIndex(tr.root, nodeIndexToCopy);
-        tr.replaceNode(toReplace, toCopy);
+        NodeId toReplace = tree.findNodeByIndex(tree.root, nodeIndexToReplace); 
+        NodeId toCopy = tree.findNodeByIndex(tree.root, nodeIndexToCopy);
+        tree.replaceNode(toReplace, toCopy);
     }
 
-    const string modTreeStr = tr.toString(tr.root);
-    const size_t newBufferSize{modTreeStr.length() + 1}; // +1 to implicitly append a null terminator
+    // size the output exactly, then serialize straight into the new buffer
+    const size_t modTreeSize{tree.getSerializedSize(tree.root)};
+    const size_t newBufferSize{modTreeSize + 1}; // +1 to implicitly append a null terminator
 
     char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
-
-    std::strcpy(newBuffer, modTreeStr.c_str());
+    *tree.serialize(tree.root, newBuffer) = '\0';
 }
\ No newline at end of file
@@ -0,0 +1,145 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#include "RadamsaSuffixArray.hpp"
+#include "RuntimeException.hpp"
+#include <algorithm>
+
+using namespace vmf;
+
+namespace
+{
+constexpr uint32_t separatorSymbol{257u};
+constexpr uint32_t alphabetSize{separatorSymbol + 1u};
+}
+
+void RadamsaSuffixArray::Build(
+                               const char* const first,
+                               const size_t firstSize,
+                               const char* const second,
+                               const size_t secondSize)
+{
+    const size_t size{(second != nullptr) ? firstSize + 1u + secondSize : firstSize};
+    if (size >= UINT32_MAX)
+        throw RuntimeException{"Input is too large for a suffix array", RuntimeException::USAGE_ERROR};
+
+    const uint32_t n{static_cast<uint32_t>(size)};
+
+    symbols.resize(n);
+    for(size_t it{0u}; it < firstSize; ++it)
+        symbols[it] = static_cast<uint16_t>(static_cast<uint8_t>(first[it]) + 1u);
+    if (second != nullptr)
+    {
+        symbols[firstSize] = separatorSymbol;
+        for(size_t it{0u}; it < secondSize; ++it)
+            symbols[firstSize + 1u + it] = static_cast<uint16_t>(static_cast<uint8_t>(second[it]) + 1u);
+    }
+
+    suffixes.resize(n);
+    ranks.resize(n);
+    scratch.resize(n);
+    lcp.assign(n, 0u);
+    if (n == 0u)
+        return;
+
+    // Sort by the first symbol
+    counts.assign(std::max<size_t>(alphabetSize, n), 0u);
+    for(uint32_t it{0u}; it < n; ++it)
+        ++counts[symbols[it]];
+    for(size_t it{1u}; it < alphabetSize; ++it)
+        counts[it] += counts[it - 1u];
+    for(uint32_t it{n}; it-- > 0u;)
+        suffixes[--counts[symbols[it]]] = it;
+
+    uint32_t classes{1u};
+    ranks[suffixes[0]] = 0u;
+    for(uint32_t it{1u}; it < n; ++it)
+    {
+        if (symbols[suffixes[it]] != symbols[suffixes[it - 1u]])
+            ++classes;
+        ranks[suffixes[it]] = classes - 1u;
+    }
+
+    // Each round sorts by the first 2k symbols, as pairs of ranks of k symbols
+    for(uint32_t k{1u}; classes < n; k <<= 1u)
+    {
+        // order by the second half: suffixes too short to have one come first
+        uint32_t position{0u};
+        for(uint32_t it{n - std::min(k, n)}; it < n; ++it)
+            scratch[position++] = it;
+        for(uint32_t it{0u}; it < n; ++it)
+            if (suffixes[it] >= k)
+                scratch[position++] = suffixes[it] - k;
+
+        // then stably by the first half
+        std::fill(counts.begin(), counts.begin() + classes, 0u);
+        for(uint32_t it{0u}; it < n; ++it)
+            ++counts[ranks[it]];
+        for(uint32_t it{1u}; it < classes; ++it)
+            counts[it] += counts[it - 1u];
+        for(uint32_t it{n}; it-- > 0u;)
+            suffixes[--counts[ranks[scratch[it]]]] = scratch[it];
+
+        auto secondRank = [&](const uint32_t suffix) {
+            return (suffix + k < n) ? ranks[suffix + k] : UINT32_MAX;
+        };
+
+        scratch[suffixes[0]] = 0u;
+        classes = 1u;
+        for(uint32_t it{1u}; it < n; ++it)
+        {
+            const uint32_t current{suffixes[it]};
+            const uint32_t previous{suffixes[it - 1u]};
+            if (ranks[current] != ranks[previous] || secondRank(current) != secondRank(previous))
+                ++classes;
+            scratch[current] = classes - 1u;
+        }
+        ranks.swap(scratch);
+    }
+
+    // Kasai: the LCP of a suffix with its predecessor drops by at most one from one text position to the next
+    uint32_t common{0u};
+    for(uint32_t it{0u}; it < n; ++it)
+    {
+        const uint32_t rank{ranks[it]};
+        if (rank == 0u)
+        {
+            common = 0u;
+            continue;
+        }
+
+        const uint32_t previous{suffixes[rank - 1u]};
+        while(it + common < n && previous + common < n &&
+              symbols[it + common] == symbols[previous + common] && symbols[it + common] != separatorSymbol)
+            ++common;
+
+        lcp[rank] = common;
+        if (common > 0u)
+            --common;
+    }
+}
@@ -0,0 +1,83 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vmf
+{
+/**
+ * @brief Suffix array and LCP array of one byte string, or of two joined by a unique separator
+ *
+ * Built by prefix doubling with radix sorts in O(n log n) time and O(n) memory, and the LCP array by
+ * Kasai's algorithm in O(n). Suffixes that share a prefix of length d form a contiguous interval of the suffix
+ * array in which every inner LCP value is at least d, which is what the fuse mutators walk to find positions
+ * with a shared context. The buffers are kept between builds, so a mutator that owns one stops allocating
+ * once it has seen its largest input.
+ */
+class RadamsaSuffixArray
+{
+public:
+    /**
+     * @brief Builds the arrays for first, followed by a separator and second if second is not null
+     *
+     * A shared prefix never extends across the separator or past the end of the text.
+     */
+    void Build(
+               const char* const first,
+               const size_t firstSize,
+               const char* const second,
+               const size_t secondSize);
+
+    /**
+     * @brief Number of suffixes, including the one starting at the separator
+     */
+    size_t GetSize() const noexcept { return suffixes.size(); }
+
+    /**
+     * @brief Start of the i-th smallest suffix, in the joined text
+     */
+    uint32_t GetSuffix(const size_t i) const noexcept { return suffixes[i]; }
+
+    /**
+     * @brief Length of the common prefix of the (i-1)-th and i-th smallest suffixes; 0 for i == 0
+     */
+    uint32_t GetLcp(const size_t i) const noexcept { return lcp[i]; }
+
+private:
+    std::vector<uint16_t> symbols;      // bytes shifted to 1 - 256, the separator is 257
+    std::vector<uint32_t> suffixes;
+    std::vector<uint32_t> ranks;
+    std::vector<uint32_t> scratch;
+    std::vector<uint32_t> counts;
+    std::vector<uint32_t> lcp;
+};
+}
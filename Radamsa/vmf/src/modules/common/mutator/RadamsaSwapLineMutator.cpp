@@ -38,15 +38,21 @@ using namespace vmf;
 
 #include "ModuleFactory.hpp"
 REGISTER_MODULE(RadamsaSwapLineMutator);
+REGISTER_MODULE(RadamsaSwapCrLfRecordMutator);
+REGISTER_MODULE(RadamsaSwapNulRecordMutator);
+REGISTER_MODULE(RadamsaSwapSemicolonRecordMutator);
+REGISTER_MODULE(RadamsaSwapCommaRecordMutator);
+REGISTER_MODULE(RadamsaSwapFieldRecordMutator);
 
 /**
  * @brief Builder method to support the ModuleFactory
  * Constructs an instance of this class
  * @return Module* - Pointer to the newly created instance
  */
-Module* RadamsaSwapLineMutator::build(std::string name)
+template <typename Delimiter>
+Module* RadamsaSwapRecordMutator<Delimiter>::build(std::string name)
 {
-    return new RadamsaSwapLineMutator(name);
+    return new RadamsaSwapRecordMutator<Delimiter>(name);
 }
 
 /**
@@ -54,26 +60,29 @@ Module* RadamsaSwapLineMutator::build(std::string name)
  *
  * @param config - Configuration object
  */
-void RadamsaSwapLineMutator::init(ConfigInterface& config)
+template <typename Delimiter>
+void RadamsaSwapRecordMutator<Delimiter>::init(ConfigInterface& config)
 {
-
+    SetStreamingThreshold(config.getIntParam(getModuleName(), "streamingThreshold", DefaultStreamingThreshold));
 }
 
 /**
- * @brief Construct a new RadamsaSwapLineMutator::RadamsaSwapLineMutator object
+ * @brief Construct a new RadamsaSwapRecordMutator::RadamsaSwapRecordMutator object
  *
  * @param name The of the name module
  */
-RadamsaSwapLineMutator::RadamsaSwapLineMutator(std::string name) : MutatorModule(name)
+template <typename Delimiter>
+RadamsaSwapRecordMutator<Delimiter>::RadamsaSwapRecordMutator(std::string name) : MutatorModule(name)
 {
     // rand.randInit();
 }
 
 /**
- * @brief Destroy the RadamsaSwapLineMutator::RadamsaSwapLineMutator object
+ * @brief Destroy the RadamsaSwapRecordMutator::RadamsaSwapRecordMutator object
  *
  */
-RadamsaSwapLineMutator::~RadamsaSwapLineMutator()
+template <typename Delimiter>
+RadamsaSwapRecordMutator<Delimiter>::~RadamsaSwapRecordMutator()
 {
 
 }
@@ -83,13 +92,27 @@ RadamsaSwapLineMutator::~RadamsaSwapLineMutator()
  *
  * @param registry - StorageRegistry object
  */
-void RadamsaSwapLineMutator::registerStorageNeeds(StorageRegistry& registry)
+template <typename Delimiter>
+void RadamsaSwapRecordMutator<Delimiter>::registerStorageNeeds(StorageRegistry& registry)
 {
     // This module does not register for a test case buffer key, because mutators are told which buffer to write in storage
     // by the input generator that calls them
 }
 
-void RadamsaSwapLineMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+template <typename Delimiter>
+void RadamsaSwapRecordMutator<Delimiter>::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
+
+template <typename Delimiter>
+void RadamsaSwapRecordMutator<Delimiter>::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
     // Consume the original buffer by copying a line to a random location and appending a null-terminator to the end.
 
@@ -131,11 +154,56 @@ void RadamsaSwapLineMutator::mutateTestCase(StorageModule& storage, StorageEntry
         return;
     }
 
-    const size_t numberOfLinesAfterIndex{
-                                    GetNumberOfLinesAfterIndex(
-                                                        originalBuffer,
-                                                        originalSize,
-                                                        characterIndex)};
+    if (IsStreamingSize(originalSize))
+    {
+        // Very large input: sample the first line in one pass instead of indexing every line;
+        // the second line is the one that follows it.
+
+        const Line firstLineData{SampleLineStreaming<Delimiter>(originalBuffer, originalSize, rand)};
+
+        if (!firstLineData.IsValid)
+        {
+            CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+            return;
+        }
+
+        const size_t firstLineEndIndex{firstLineData.StartIndex + firstLineData.Size};
+        const Line secondLineData{GetLineAtStreaming<Delimiter>(originalBuffer, originalSize, firstLineEndIndex)};
+
+        // A single line can not be swapped
+        if (!secondLineData.IsValid && firstLineData.StartIndex == 0u)
+        {
+            CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+            return;
+        }
+
+        SegmentBuilder& output{BeginOutput()};
+
+        if (!secondLineData.IsValid)
+        {
+            // The last line was picked, so there is nothing to swap it with
+            output.Append(originalBuffer, originalSize);
+        }
+        else
+        {
+            const size_t secondLineEndIndex{secondLineData.StartIndex + secondLineData.Size};
+
+            output
+                .Append(originalBuffer, firstLineData.StartIndex)
+                .Append(originalBuffer + secondLineData.StartIndex, secondLineData.Size)
+                .Append(originalBuffer + firstLineData.StartIndex, firstLineData.Size)
+                .Append(originalBuffer + secondLineEndIndex, originalSize - secondLineEndIndex);
+        }
+
+        output
+            .AppendNullTerminator()
+            .Write(newEntry, testCaseKey);
+
+        return;
+    }
+
+    const LineIndex& lineIndex{GetLineIndex<Delimiter>(storage, baseEntry, originalBuffer, originalSize)};
+    const size_t numberOfLinesAfterIndex{lineIndex.GetNumberOfLines()};
 
     // Check if buffer has minimum required number of lines
     if (numberOfLinesAfterIndex < 2) {
@@ -152,11 +220,7 @@ void RadamsaSwapLineMutator::mutateTestCase(StorageModule& storage, StorageEntry
                                                     minimumRandomLineOffset,
                                                     numberOfLinesAfterIndex - 1u)};
 
-    const size_t totalNumberOfLines{
-                                GetNumberOfLinesAfterIndex(
-                                                        originalBuffer,
-                                                        originalSize,
-                                                        0u)};
+    const size_t totalNumberOfLines{numberOfLinesAfterIndex};
 
     constexpr size_t lower{0u};
     const size_t upper{totalNumberOfLines - 1u};
@@ -166,68 +230,40 @@ void RadamsaSwapLineMutator::mutateTestCase(StorageModule& storage, StorageEntry
                                             lower,
                                             upper)};
 
-    const Line firstRandomLineData{
-                            GetLineData(
-                                    originalBuffer,
-                                    originalSize,
-                                    firstRandomLineIndex,
-                                    numberOfLinesAfterIndex)};
-
-    const Line secondRandomLineData{
-                            GetLineData(
-                                    originalBuffer,
-                                    originalSize,
-                                    secondRandomLineIndex,
-                                    numberOfLinesAfterIndex)};
-
-    // The new buffer will be one line larger than the original buffer;
-    // additionally, it will contain one additional byte since a null-terminator will be appended to the end.
-
-    const size_t newBufferSize{originalSize + 1u};
-
-    // Allocate the new buffer and set it's elements to zero.
+    // The new buffer holds the original data with the two lines swapped, followed by a null-terminator.
+    // The second line always directly follows the first one unless both are the last line, in which case nothing is swapped.
 
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
-
-    // Copy data from the original buffer into the new buffer, but duplicate the random line.
-    // The last element in the new buffer is skipped since it was implicitly set to zero during allocation.
+    SegmentBuilder& output{BeginOutput()};
 
+    if (firstRandomLineIndex == secondRandomLineIndex)
     {
-        // Copy all of the elements including the line that is to be duplicated.
-
-        const size_t numberOfBytes{originalSize};
-
-        char* destination{newBuffer};
-        const char* source{originalBuffer};
-
-        memcpy(destination, source, numberOfBytes);
+        output.Append(originalBuffer, originalSize);
     }
-
+    else
     {
-        // Duplicate the line.
-
-        const size_t numberOfBytes{secondRandomLineData.Size};
-
-        char* destination{newBuffer + firstRandomLineData.StartIndex};
-        const char* source{originalBuffer + secondRandomLineData.StartIndex};
-
-        memcpy(destination, source, numberOfBytes);
+        const LineVector firstLine{lineIndex.GetLineVector(firstRandomLineIndex)};
+        const LineVector secondLine{lineIndex.GetLineVector(secondRandomLineIndex)};
+        const LineVector linesBefore{lineIndex.GetLines(0u, firstRandomLineIndex)};
+        const LineVector linesAfter{lineIndex.GetLinesToEnd(secondRandomLineIndex + 1u)};
+
+        output
+            .Append(linesBefore.Data, linesBefore.Size)
+            .Append(secondLine.Data, secondLine.Size)
+            .Append(firstLine.Data, firstLine.Size)
+            .Append(linesAfter.Data, linesAfter.Size);
     }
 
-    {
-        // Copy all of the elements after the line that was duplicated.
-
-        const size_t numberOfBytes{firstRandomLineData.Size};
-
-        char* destination{
-                    (firstRandomLineData == secondRandomLineData) ?
-                    (newBuffer + firstRandomLineData.StartIndex) :
-                    (newBuffer + firstRandomLineData.StartIndex + secondRandomLineData.Size)};
-
-        const char* source{originalBuffer + firstRandomLineData.StartIndex};
-
-        memcpy(destination, source, numberOfBytes);
-    }
+    output
+        .AppendNullTerminator()
+        .Write(newEntry, testCaseKey);
 }
 
+namespace vmf
+{
+template class RadamsaSwapRecordMutator<NewlineDelimiter>;
+template class RadamsaSwapRecordMutator<CrLfDelimiter>;
+template class RadamsaSwapRecordMutator<NulDelimiter>;
+template class RadamsaSwapRecordMutator<SemicolonDelimiter>;
+template class RadamsaSwapRecordMutator<CommaDelimiter>;
+template class RadamsaSwapRecordMutator<FieldSeparatorDelimiter>;
+}
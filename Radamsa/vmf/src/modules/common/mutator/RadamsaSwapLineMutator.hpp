@@ -37,21 +37,30 @@
 namespace vmf
 {
 /**
- *
+ * @tparam Delimiter - Record delimiter policy (see RadamsaDelimiter.hpp)
  */
-class RadamsaSwapLineMutator: public MutatorModule, public RadamsaLineMutatorBase
+template <typename Delimiter>
+class RadamsaSwapRecordMutator: public MutatorModule, public RadamsaLineMutatorBase
 {
     public:
 
         static Module* build(std::string name);
         virtual void init(ConfigInterface& config);
 
-        RadamsaSwapLineMutator(std::string name);
-        virtual ~RadamsaSwapLineMutator();
+        RadamsaSwapRecordMutator(std::string name);
+        virtual ~RadamsaSwapRecordMutator();
         virtual void registerStorageNeeds(StorageRegistry& registry);
+        virtual void registerMetadataNeeds(StorageRegistry& registry);
         virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
 
     private:
         VmfRand* rand = VmfRand::getInstance();
 };
-}
\ No newline at end of file
+
+using RadamsaSwapLineMutator = RadamsaSwapRecordMutator<NewlineDelimiter>;
+using RadamsaSwapCrLfRecordMutator = RadamsaSwapRecordMutator<CrLfDelimiter>;
+using RadamsaSwapNulRecordMutator = RadamsaSwapRecordMutator<NulDelimiter>;
+using RadamsaSwapSemicolonRecordMutator = RadamsaSwapRecordMutator<SemicolonDelimiter>;
+using RadamsaSwapCommaRecordMutator = RadamsaSwapRecordMutator<CommaDelimiter>;
+using RadamsaSwapFieldRecordMutator = RadamsaSwapRecordMutator<FieldSeparatorDelimiter>;
+}
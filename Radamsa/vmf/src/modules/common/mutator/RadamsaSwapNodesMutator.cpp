@@ -56,7 +56,7 @@ Module* RadamsaSwapNodesMutator::build(std::string name)
  */
 void RadamsaSwapNodesMutator::init(ConfigInterface& config)
 {
-
+    SetTreeSyntax(config.getStringParam(getModuleName(), "syntax", "parenthesized"));
 }
 
 /**
@@ -89,6 +89,17 @@ void RadamsaSwapNodesMutator::registerStorageNeeds(StorageRegistry& registry)
     // by the input generator that calls them
 }
 
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+void RadamsaSwapNodesMutator::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
+
 void RadamsaSwapNodesMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
     // Swaps two random nodes pairwise
@@ -131,10 +142,10 @@ void RadamsaSwapNodesMutator::mutateTestCase(StorageModule& storage, StorageEntr
         return;
     }
 
-    const std::string treeStr(originalBuffer, originalSize);
-    Tree tr(treeStr);
+    // loading into the member tree reuses the node and value arenas of the previous mutation
+    LoadTree(tree, storage, baseEntry, originalBuffer, originalSize);
 
-    size_t numNodes = tr.countNodes(tr.root);
+    size_t numNodes = tree.countNodes(tree.root);
     // Check if tree has minimum required number of nodes
     if (numNodes < minimumNodes)
     {
@@ -148,17 +159,16 @@ void RadamsaSwapNodesMutator::mutateTestCase(StorageModule& storage, StorageEntr
     size_t nodeIndex2{this->rand->randBetween(lower, upper)};   // ^
     
     if(nodeIndex1 != nodeIndex2) {
-        Node* node1 = tr.findNodeByIndex(tr.root, nodeIndex1); 
-        Node* node2 = tr.findNodeByIndex(tr.root, nodeIndex2);
-        tr.swapNodes(node1, node2);
+        NodeId node1 = tree.findNodeByIndex(tree.root, nodeIndex1); 
+        NodeId node2 = tree.findNodeByIndex(tree.root, nodeIndex2);
+        tree.swapNodes(node1, node2);
     }
     
-    const string modTreeStr = tr.toString(tr.root);
-    const size_t newBufferSize{modTreeStr.length() + 1}; // +1 to implicitly append a null terminator
+    // size the output exactly, then serialize straight into the new buffer
+    const size_t modTreeSize{tree.getSerializedSize(tree.root)};
+    const size_t newBufferSize{modTreeSize + 1}; // +1 to implicitly append a null terminator
 
     char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
-
-    std::strcpy(newBuffer, modTreeStr.c_str());
+    *tree.serialize(tree.root, newBuffer) = '\0';
     return;
 }
\ No newline at end of file
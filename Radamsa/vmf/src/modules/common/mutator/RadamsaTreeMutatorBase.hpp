@@ -30,9 +30,21 @@
 
 #pragma once
 
-#include <stack>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "RadamsaByteScan.hpp"
 #include "RadamsaMutatorBase.hpp"
+#include "RadamsaParseCache.hpp"
 #include "RuntimeException.hpp"
+#include "StorageEntry.hpp"
+#include "StorageModule.hpp"
 #include "VmfRand.hpp"
 
 using std::string;
@@ -48,88 +60,420 @@ public:
     RadamsaTreeMutatorBase() = default;
     virtual ~RadamsaTreeMutatorBase() = default;
 
+    // Index of a node in Tree::nodes
+    using NodeId = uint32_t;
+    static constexpr NodeId NoNode{UINT32_MAX};
+
+    // Text format a Tree is parsed from and serialized to
+    enum class Syntax
+    {
+        Parenthesized,  // synthetic "A(B(C))(D)" notation: a value, then every child in parentheses
+        Bracketed       // arbitrary text structured by balanced ()[]{}<> and quoted strings, kept byte for byte
+    };
+
+    // Flat tree node. Nodes refer to each other by index and to their value by a span (see Tree::getValue),
+    // so copying or swapping a node never touches the value bytes.
     struct Node
     {
-        string value;
-        Node* parent;
-        std::vector<Node*> children;
+        NodeId parent;
+        NodeId firstChild;
+        NodeId lastChild;
+        NodeId nextSibling;
+        size_t valueStart;
+        size_t valueSize;
+        char close;     // written after the node's children: the closing bracket of a bracketed group, else '\0'
+    };
 
-        Node(string v, Node* p = nullptr) : value(v), parent(p) {};
+    // Tree stored in two arenas: one array of nodes and one string holding the values the tree owns.
+    // Parsed values are views into the parsed buffer, so only inserted values and values with embedded whitespace
+    // are copied into the text arena. A value span is an offset into the parsed buffer followed by the text arena.
+    // Nodes are never freed individually; deleted or replaced subtrees are unlinked and stay in the arena
+    // until clear() or parse() resets it. Both keep the arenas' capacity, so a Tree that is re-parsed for every
+    // mutation stops allocating once it has seen its largest input.
+    //
+    // In the bracketed syntax the root spans the whole input. Its children, and those of every group, are the
+    // runs of plain text, the quoted strings and the bracket groups it contains, in order. A group's value is its
+    // opening bracket and its close is the matching closing bracket, so serializing an unmutated tree
+    // reproduces the input exactly.
+    struct Tree
+    {
+    private:
+        std::vector<Node> nodes;
+        Syntax syntax = Syntax::Parenthesized;
+        string text;
+        const char* source = nullptr;
+        size_t sourceSize = 0u;
+        std::vector<char> ownedSource;
+        std::vector<NodeId> parseStack;
+
+        // Pre-order view of the nodes reachable from root. Built by the parser and rebuilt on first use after
+        // a structural change; value-only changes (swapNodes, replaceNode in the parenthesized syntax) keep it valid.
+        struct PreorderIndex
+        {
+            bool isValid = false;
+            std::vector<NodeId> order;          // reachable nodes in pre-order
+            std::vector<NodeId> positions;      // position of each node in order, NoNode if unreachable
+            std::vector<NodeId> subtreeSizes;   // number of nodes in each node's subtree, including itself
+            std::vector<NodeId> internalNodes;  // reachable nodes that have children, in pre-order
+        } preorder;
+
+        // A repeatPath() that is not expanded into nodes: child's slot under parent holds count nested copies of
+        // parent, the innermost one keeping child. Serialization writes it out directly; the other non-const
+        // operations expand it into real nodes first, while getNode(), getValue() and countChildren() see the
+        // tree as it was before the repetition.
+        struct Repetition
+        {
+            NodeId parent = NoNode;
+            NodeId child = NoNode;
+            size_t childIndex = 0u;
+            size_t count = 0u;
+        } pendingRepetition;
+
+        void buildIndex() {
+            preorder.order.clear();
+            preorder.internalNodes.clear();
+            preorder.positions.assign(nodes.size(), NoNode);
+            preorder.subtreeSizes.assign(nodes.size(), 0u);
+
+            if(this->root != NoNode) {
+                NodeId current{this->root};
+                while(true) {
+                    preorder.positions[current] = static_cast<NodeId>(preorder.order.size());
+                    preorder.order.push_back(current);
+
+                    if(nodes[current].firstChild != NoNode) {
+                        preorder.internalNodes.push_back(current);
+                        current = nodes[current].firstChild;
+                        continue;
+                    }
 
-        // Disable copy constructor and copy assignment
-        Node(const Node&) = delete;
-        Node& operator=(const Node&) = delete;
+                    while(current != this->root && nodes[current].nextSibling == NoNode) {
+                        current = nodes[current].parent;
+                    }
+                    if(current == this->root) break;
 
-        ~Node() {
-            // DO NOT delete parent; parent owns this node, not the other way around
+                    current = nodes[current].nextSibling;
+                }
 
-            // copying to avoid iterator invalidation via deleting an element while still looping over the vector
-            std::vector<Node*> childrenCopy = this->children;
-            for(Node* child : childrenCopy) {
-                delete child;
+                // children follow their parent in pre-order, so a reverse sweep sees every subtree complete
+                for(auto it = preorder.order.rbegin(); it != preorder.order.rend(); ++it) {
+                    preorder.subtreeSizes[*it] += 1u;
+                    if(nodes[*it].parent != NoNode) {
+                        preorder.subtreeSizes[nodes[*it].parent] += preorder.subtreeSizes[*it];
+                    }
+                }
             }
 
-            return;
+            preorder.isValid = true;
+        }
+
+        const PreorderIndex& getIndex() {
+            if(!preorder.isValid) buildIndex();
+            return preorder;
         }
 
-        Node* deepCopy(Node* newParent = nullptr) const {
-            // Create copy of self and children, but as separate objects, and attach to newParent
-            
-            Node* selfCopy = new Node(this->value, newParent);
-            for(Node* child : this->children) {
-                selfCopy->children.push_back(child->deepCopy(selfCopy));
+        NodeId newNode(size_t valueStart, size_t valueSize, NodeId parent, char close = '\0') {
+            if(nodes.size() >= NoNode) {
+                throw RuntimeException{"Tree exceeds the maximum number of nodes", RuntimeException::USAGE_ERROR};
             }
 
-            // if (newParent) newParent->children.push_back(selfCopy);
+            const NodeId id{static_cast<NodeId>(nodes.size())};
+            preorder.isValid = false;
+            nodes.push_back(Node{NoNode, NoNode, NoNode, NoNode, valueStart, valueSize, close});
+            if(parent != NoNode) appendChild(parent, id);
+            return id;
+        }
 
-            return selfCopy;
+        void appendChild(NodeId parent, NodeId child) {
+            Node& p{nodes[parent]};
+            if(p.lastChild == NoNode) {
+                p.firstChild = child;
+            }
+            else {
+                nodes[p.lastChild].nextSibling = child;
+            }
+            p.lastChild = child;
+            nodes[child].parent = parent;
+        }
+
+        NodeId copySubtree(NodeId original) {
+            // Copies the subtree rooted at original, returning the detached root of the copy.
+            // Walks the original in pre-order through the sibling links, so deep trees do not recurse.
+
+            const NodeId copyRoot{newNode(nodes[original].valueStart, nodes[original].valueSize, NoNode, nodes[original].close)};
+            NodeId s{original};
+            NodeId c{copyRoot};
+            while(true) {
+                if(nodes[s].firstChild != NoNode) {
+                    s = nodes[s].firstChild;
+                    c = newNode(nodes[s].valueStart, nodes[s].valueSize, c, nodes[s].close);
+                    continue;
+                }
+
+                while(s != original && nodes[s].nextSibling == NoNode) {
+                    s = nodes[s].parent;
+                    c = nodes[c].parent;
+                }
+                if(s == original) break;
+
+                s = nodes[s].nextSibling;
+                c = newNode(nodes[s].valueStart, nodes[s].valueSize, nodes[c].parent, nodes[s].close);
+            }
+            return copyRoot;
+        }
+
+        bool isInSubtree(NodeId n, NodeId subtree) const {
+            for(; n != NoNode; n = nodes[n].parent) {
+                if(n == subtree) return true;
+            }
+            return false;
+        }
+
+        void swapContents(NodeId node1, NodeId node2) {
+            // Swap the values, closes and children of two nodes, so each takes the other's place with its whole
+            // subtree. Neither node may be in the other's subtree.
+
+            preorder.isValid = false;
+            Node& n1{nodes[node1]};
+            Node& n2{nodes[node2]};
+            std::swap(n1.valueStart, n2.valueStart);
+            std::swap(n1.valueSize, n2.valueSize);
+            std::swap(n1.close, n2.close);
+            std::swap(n1.firstChild, n2.firstChild);
+            std::swap(n1.lastChild, n2.lastChild);
+            for(NodeId child = n1.firstChild; child != NoNode; child = nodes[child].nextSibling) nodes[child].parent = node1;
+            for(NodeId child = n2.firstChild; child != NoNode; child = nodes[child].nextSibling) nodes[child].parent = node2;
+        }
+
+        void unlinkChild(NodeId parent, NodeId child, NodeId replacement) {
+            // Remove child from parent's child list, putting replacement (if any) in its place
+
+            Node& p{nodes[parent]};
+            NodeId previous{NoNode};
+            NodeId current{p.firstChild};
+            while(current != NoNode && current != child) {
+                previous = current;
+                current = nodes[current].nextSibling;
+            }
+            if(current == NoNode) return;
+
+            preorder.isValid = false;
+            const NodeId next{nodes[child].nextSibling};
+            NodeId linked{next};
+            if(replacement != NoNode) {
+                nodes[replacement].parent = parent;
+                nodes[replacement].nextSibling = next;
+                linked = replacement;
+            }
+
+            if(previous == NoNode) {
+                p.firstChild = linked;
+            }
+            else {
+                nodes[previous].nextSibling = linked;
+            }
+            if(p.lastChild == child) {
+                p.lastChild = (replacement != NoNode) ? replacement : previous;
+            }
+            nodes[child].parent = NoNode;
+            nodes[child].nextSibling = NoNode;
+        }
+
+        void expandRepetition() {
+            // Build the nodes of the pending repetition, one copy of the parent per repetition
+
+            if(pendingRepetition.parent == NoNode) return;
+            const Repetition repetition{pendingRepetition};
+            pendingRepetition = Repetition{};
+
+            // each repetition copies the current node, including its original child, into that child's slot
+            NodeId current{repetition.parent};
+            for(size_t rep = 0; rep < repetition.count; ++rep) {
+                const NodeId currentCopy{copySubtree(current)};
+
+                NodeId toReplace{nodes[current].firstChild};
+                for(size_t i = 0; i < repetition.childIndex; ++i) toReplace = nodes[toReplace].nextSibling;
+                unlinkChild(current, toReplace, currentCopy);
+
+                current = currentCopy;
+            }
+        }
+
+        size_t getPlainSerializedSize(NodeId n) {
+            // serialized size of subtree n without the pending repetition
+
+            const PreorderIndex& idx{getIndex()};
+            const size_t first{idx.positions[n]};
+            const size_t last{first + idx.subtreeSizes[n]};
+            size_t size{(syntax == Syntax::Parenthesized) ? 2u * (idx.subtreeSizes[n] - 1u) : 0u};
+            for(size_t i = first; i < last; ++i) {
+                const Node& node{nodes[idx.order[i]]};
+                size += node.valueSize + (node.close != '\0' ? 1u : 0u);
+            }
+
+            return size;
+        }
+
+        char* writeValue(NodeId n, char* destination) const {
+            const std::string_view value{getValue(n)};
+            std::memcpy(destination, value.data(), value.size());
+            return destination + value.size();
+        }
+
+        char* openChild(char* destination) const {
+            if(syntax == Syntax::Parenthesized) *destination++ = '(';
+            return destination;
+        }
+
+        char* closeChild(NodeId n, char* destination, NodeId expandAt) const {
+            // the close of the pending repetition's parent is part of its repeated suffix
+            if(n != expandAt && nodes[n].close != '\0') *destination++ = nodes[n].close;
+            if(syntax == Syntax::Parenthesized) *destination++ = ')';
+            return destination;
+        }
+
+        static char* repeatSpan(const char* begin, char* end, size_t count) {
+            // append count more copies of [begin, end), doubling the copied span each time
+
+            const size_t length{static_cast<size_t>(end - begin)};
+            const size_t total{length * (count + 1u)};
+            size_t written{length};
+            while(written < total) {
+                const size_t chunk{std::min(written, total - written)};
+                std::memcpy(end, begin, chunk);
+                end += chunk;
+                written += chunk;
+            }
+            return end;
+        }
+
+        char* serializeSubtree(NodeId n, char* destination, NodeId expandAt) const {
+            // write subtree n, writing node expandAt (if it is in the subtree) as the pending repetition
+
+            if(n == expandAt) return serializeRepetition(destination);
+            destination = writeValue(n, destination);
+
+            NodeId current{n};
+            while(true) {
+                if(current != expandAt && nodes[current].firstChild != NoNode) {
+                    current = nodes[current].firstChild;
+                    destination = openChild(destination);
+                    destination = (current == expandAt) ? serializeRepetition(destination) : writeValue(current, destination);
+                    continue;
+                }
+
+                while(current != n && nodes[current].nextSibling == NoNode) {
+                    destination = closeChild(current, destination, expandAt);
+                    current = nodes[current].parent;
+                }
+                if(current == n) break;
+
+                destination = closeChild(current, destination, expandAt);
+                current = nodes[current].nextSibling;
+                destination = openChild(destination);
+                destination = (current == expandAt) ? serializeRepetition(destination) : writeValue(current, destination);
+            }
+
+            if(nodes[n].close != '\0') *destination++ = nodes[n].close;
+            return destination;
+        }
+
+        char* serializeRepetition(char* destination) const {
+            // The repeated parent reads prefix^(count+1) child suffix^(count+1), where prefix is the parent's value
+            // and the children before the slot, and suffix is the children after it and the parent's close.
+            // Each is written once and then copied, so the cost is that of the output.
+
+            const Repetition& repetition{pendingRepetition};
+
+            char* const prefix{destination};
+            destination = writeValue(repetition.parent, destination);
+            NodeId sibling{nodes[repetition.parent].firstChild};
+            for(; sibling != repetition.child; sibling = nodes[sibling].nextSibling) {
+                destination = openChild(destination);
+                destination = serializeSubtree(sibling, destination, NoNode);
+                if(syntax == Syntax::Parenthesized) *destination++ = ')';
+            }
+            destination = openChild(destination);
+            destination = repeatSpan(prefix, destination, repetition.count);
+
+            destination = serializeSubtree(repetition.child, destination, NoNode);
+
+            char* const suffix{destination};
+            if(syntax == Syntax::Parenthesized) *destination++ = ')';
+            for(sibling = nodes[repetition.child].nextSibling; sibling != NoNode; sibling = nodes[sibling].nextSibling) {
+                destination = openChild(destination);
+                destination = serializeSubtree(sibling, destination, NoNode);
+                if(syntax == Syntax::Parenthesized) *destination++ = ')';
+            }
+            if(nodes[repetition.parent].close != '\0') *destination++ = nodes[repetition.parent].close;
+            return repeatSpan(suffix, destination, repetition.count);
         }
-    };
 
-    struct Tree
-    {
-    private:
         // parses a Tree from a string in the form ""A(B(C)(D))(E)""
-        void buildTree(string treeStr) {
-            if(treeStr.empty()) {
+        void buildTree(const char* treeStr, size_t length) {
+            if(length == 0u) {
                 throw RuntimeException{"Tree string is empty", RuntimeException::UNEXPECTED_ERROR};
             }
 
-            std::stack<Node*> stk;
-            string value;
-            for(size_t i = 0; i < treeStr.length(); ++i) {
+            source = treeStr;
+            sourceSize = length;
+
+            std::vector<NodeId>& stk{parseStack};
+            stk.clear();
+            // the pending value runs from valueBegin up to valueEnd, skipping any whitespace inside it
+            const size_t noValue{SIZE_MAX};
+            size_t valueBegin{noValue};
+            size_t valueEnd{0u};
+            bool valueHasSpace{false};
+            auto takeValue = [&](NodeId parent) {
+                NodeId n;
+                if(!valueHasSpace) {
+                    n = newNode(valueBegin, valueEnd - valueBegin, parent);
+                }
+                else {
+                    const size_t textStart{text.size()};
+                    for(size_t j = valueBegin; j < valueEnd; ++j) {
+                        if(!std::isspace(static_cast<unsigned char>(treeStr[j]))) text += treeStr[j];
+                    }
+                    n = newNode(sourceSize + textStart, text.size() - textStart, parent);
+                }
+                valueBegin = noValue;
+                valueHasSpace = false;
+                return n;
+            };
+
+            for(size_t i = 0; i < length; ++i) {
                 char ch = treeStr[i];
 
-                if(std::isspace(ch)) {
+                if(std::isspace(static_cast<unsigned char>(ch))) {
                     continue;
                 }
                 else if(ch == '(') {
-                    if(!value.empty()) {
-                        Node* n;
+                    if(valueBegin != noValue) {
+                        NodeId n;
                         if(stk.empty()) {
-                            n = insertNode(value);
+                            n = takeValue(NoNode);
                             this->root = n;
                         }
                         else {
-                            n = insertNode(value, stk.top());
+                            n = takeValue(stk.back());
                         }
 
-                        stk.push(n);
-                        value.clear();
+                        stk.push_back(n);
                     }
                     else {
-                        Node* toPush = nullptr;
+                        NodeId toPush = NoNode;
                         // upcomming additional child, re-push root
-                        if(stk.empty() && this->root != nullptr) {
+                        if(stk.empty() && this->root != NoNode) {
                             toPush = this->root;
                         }
                         // upcomming additional child, re-push the most recently popped node
-                        else if(!stk.empty() && !stk.top()->children.empty()) {
-                            toPush = stk.top()->children.back();
+                        else if(!stk.empty()) {
+                            toPush = nodes[stk.back()].lastChild;
                         }
 
-                        if(toPush != nullptr) {
-                            stk.push(toPush);
+                        if(toPush != NoNode) {
+                            stk.push_back(toPush);
                         }
                         else {
                             throw RuntimeException{"Unexpected open bracket without a parent node", RuntimeException::UNEXPECTED_ERROR};
@@ -141,16 +485,20 @@ public:
                         throw RuntimeException{"Unmatched open bracket in tree string", RuntimeException::UNEXPECTED_ERROR};
                     }
 
-                    if(!value.empty()) {
-                        insertNode(value, stk.top());
-
-                        value.clear();
+                    if(valueBegin != noValue) {
+                        takeValue(stk.back());
                     }
 
-                    stk.pop();
+                    stk.pop_back();
                 }
                 else {
-                    value += ch;
+                    if(valueBegin == noValue) {
+                        valueBegin = i;
+                    }
+                    else if(valueEnd != i) {
+                        valueHasSpace = true;
+                    }
+                    valueEnd = i + 1;
                 }
             }
 
@@ -160,185 +508,488 @@ public:
 
 
             // case for TreeStr consisting of a single root node
-            if(!value.empty() && this->root == nullptr) {
-                this->root = insertNode(value);
+            if(valueBegin != noValue && this->root == NoNode) {
+                this->root = takeValue(NoNode);
             }
 
+            buildIndex();
             return;
         }
+
+        static char getClosingBracket(char open) {
+            switch(open) {
+                case '(': return ')';
+                case '[': return ']';
+                case '{': return '}';
+                case '<': return '>';
+                default: return '\0';
+            }
+        }
+
+        static size_t getBracketKind(char bracket) {
+            switch(bracket) {
+                case '(': case ')': return 0u;
+                case '[': case ']': return 1u;
+                case '{': case '}': return 2u;
+                default: return 3u;
+            }
+        }
+
+        static size_t findQuoteEnd(const char* treeStr, size_t length, size_t quote, size_t& lineEnd) {
+            // end of the string opened by the quote at treeStr[quote], or 0 if it is not closed on the same line.
+            // Quotes are not expected to span lines, which keeps apostrophes in prose from swallowing the input.
+
+            if(lineEnd <= quote) lineEnd = RadamsaByteScan::FindNextByte(treeStr, length, quote, '\n');
+
+            size_t i{quote + 1u};
+            while(true) {
+                i = RadamsaByteScan::FindNextInClass(treeStr, lineEnd, i, RadamsaByteScan::ByteClass::Structural);
+                if(i >= lineEnd) return 0u;
+                if(treeStr[i] == '\\') {
+                    i += 2u;    // skip the escaped byte
+                }
+                else if(treeStr[i] == treeStr[quote]) {
+                    return i + 1u;
+                }
+                else {
+                    ++i;
+                }
+            }
+        }
+
+        // parses a Tree from arbitrary text, structured by balanced ()[]{}<> and by quoted strings
+        void buildBracketedTree(const char* treeStr, size_t length) {
+            // Jumps from one bracket or quote candidate to the next with the vectorized byte scan. Everything
+            // else is kept as runs of text. A closing bracket closes the innermost group it matches; groups left
+            // open inside it, and at the end of the input, keep no close, and unmatched closing brackets stay in
+            // the text, so no byte is ever lost or added.
+
+            source = treeStr;
+            sourceSize = length;
+
+            std::vector<NodeId>& stk{parseStack};
+            stk.clear();
+            this->root = newNode(0u, 0u, NoNode);
+            stk.push_back(this->root);
+
+            size_t openGroups[4]{0u, 0u, 0u, 0u};
+            size_t textStart{0u};
+            size_t lineEnd{0u};
+            auto takeText = [&](size_t end) {
+                if(end > textStart) newNode(textStart, end - textStart, stk.back());
+            };
+
+            size_t i{RadamsaByteScan::FindNextInClass(treeStr, length, 0u, RadamsaByteScan::ByteClass::Structural)};
+            while(i < length) {
+                const char ch{treeStr[i]};
+
+                if(getClosingBracket(ch) != '\0') {
+                    takeText(i);
+                    stk.push_back(newNode(i, 1u, stk.back()));
+                    ++openGroups[getBracketKind(ch)];
+                    textStart = i + 1u;
+                }
+                else if((ch == ')' || ch == ']' || ch == '}' || ch == '>') && openGroups[getBracketKind(ch)] != 0u) {
+                    takeText(i);
+                    // groups opened inside the one being closed stay unclosed
+                    while(getClosingBracket(treeStr[nodes[stk.back()].valueStart]) != ch) {
+                        --openGroups[getBracketKind(treeStr[nodes[stk.back()].valueStart])];
+                        stk.pop_back();
+                    }
+                    nodes[stk.back()].close = ch;
+                    --openGroups[getBracketKind(ch)];
+                    stk.pop_back();
+                    textStart = i + 1u;
+                }
+                else if(ch == '"' || ch == '\'') {
+                    const size_t end{findQuoteEnd(treeStr, length, i, lineEnd)};
+                    if(end != 0u) {
+                        takeText(i);
+                        newNode(i, end - i, stk.back());
+                        textStart = end;
+                        i = end - 1u;
+                    }
+                }
+                // anything else (a backslash or an unmatched closing bracket) is plain text
+
+                i = RadamsaByteScan::FindNextInClass(treeStr, length, i + 1u, RadamsaByteScan::ByteClass::Structural);
+            }
+            takeText(length);
+
+            buildIndex();
+        }
+
+        void build(const char* treeStr, size_t length) {
+            if(syntax == Syntax::Bracketed) {
+                buildBracketedTree(treeStr, length);
+            }
+            else {
+                buildTree(treeStr, length);
+            }
+        }
     
     public:
-        Node* root = nullptr;
+        NodeId root = NoNode;
 
         Tree() {};
-        Tree(string treeStr) { buildTree(treeStr); }
+        Tree(const string& treeStr, Syntax treeSyntax = Syntax::Parenthesized)
+            : syntax(treeSyntax), ownedSource(treeStr.begin(), treeStr.end()) { build(ownedSource.data(), ownedSource.size()); }
         
-        // deleting copy constructor and copy assignment to avoid shallow copies
+        // deleting copy constructor and copy assignment to avoid accidental copies of the arenas
         Tree(const Tree&) = delete;
         Tree& operator=(const Tree&) = delete;
 
         // Move constructor
-        Tree(Tree&& other) noexcept {
-            root = other.root;
-            other.root = nullptr;
+        Tree(Tree&& other) noexcept
+            : nodes(std::move(other.nodes)), syntax(other.syntax), text(std::move(other.text)), source(other.source), sourceSize(other.sourceSize),
+              ownedSource(std::move(other.ownedSource)), parseStack(std::move(other.parseStack)),
+              preorder(std::move(other.preorder)), pendingRepetition(other.pendingRepetition), root(other.root) {
+            other.pendingRepetition = Repetition{};
+            other.source = nullptr;
+            other.sourceSize = 0u;
+            other.root = NoNode;
         }
 
         // Move assignment operator
         Tree& operator=(Tree&& other) noexcept {
             if(this != &other) {    // prevents self-assignment
-                deleteNode(root);
+                nodes = std::move(other.nodes);
+                syntax = other.syntax;
+                text = std::move(other.text);
+                source = other.source;
+                sourceSize = other.sourceSize;
+                ownedSource = std::move(other.ownedSource);
+                other.source = nullptr;
+                other.sourceSize = 0u;
+                parseStack = std::move(other.parseStack);
+                preorder = std::move(other.preorder);
+                pendingRepetition = other.pendingRepetition;
+                other.pendingRepetition = Repetition{};
 
                 root = other.root;
-                other.root = nullptr;
+                other.root = NoNode;
             }
             return *this;
         }
 
-        ~Tree() { deleteNode(this->root); }
+        ~Tree() = default;
 
-        string toString(Node* n) {
-            // create a parenthesis-delimited string from subtree n
+        void clear() {
+            // Reset both arenas, keeping their capacity for the next tree
 
-            if(!n) return "";
+            nodes.clear();
+            text.clear();
+            source = nullptr;
+            sourceSize = 0u;
+            ownedSource.clear();
+            root = NoNode;
+            preorder.isValid = false;
+            pendingRepetition = Repetition{};
+        }
+
+        void parse(const char* treeStr, size_t length, Syntax treeSyntax = Syntax::Parenthesized) {
+            // Replace the contents of this tree with the tree parsed from treeStr.
+            // Node values refer into treeStr, so it must outlive any use of the tree until the next parse() or clear().
 
-            string treeStr(n->value);
+            clear();
+            syntax = treeSyntax;
+            build(treeStr, length);
+        }
 
-            for(Node* child : n->children) {
-                treeStr += "(";
-                treeStr += toString(child);
-                treeStr += ")";
+        void assign(const Tree& parsed, const char* treeStr, size_t length) {
+            // Replace the contents of this tree with a copy of parsed, a tree parsed from the same bytes as treeStr.
+            // Only the arenas are copied; values are rebound to treeStr, as parse() would have left them.
+
+            nodes = parsed.nodes;
+            syntax = parsed.syntax;
+            text = parsed.text;
+            preorder = parsed.preorder;
+            pendingRepetition = parsed.pendingRepetition;
+            root = parsed.root;
+            source = treeStr;
+            sourceSize = length;
+            ownedSource.clear();
+        }
+
+        size_t getMemoryFootprint() const {
+            // bytes held by the arenas and the pre-order index
+
+            return nodes.capacity() * sizeof(Node) + text.capacity() +
+                   (preorder.order.capacity() + preorder.positions.capacity() +
+                    preorder.subtreeSizes.capacity() + preorder.internalNodes.capacity()) * sizeof(NodeId);
+        }
+
+        Syntax getSyntax() const {
+            return syntax;
+        }
+
+        const Node& getNode(NodeId n) const {
+            return nodes[n];
+        }
+
+        std::string_view getValue(NodeId n) const {
+            const Node& node{nodes[n]};
+            if(node.valueStart < sourceSize) {
+                return std::string_view(source + node.valueStart, node.valueSize);
             }
+            return std::string_view(text.data() + (node.valueStart - sourceSize), node.valueSize);
+        }
+
+        size_t countChildren(NodeId n) const {
+            size_t count = 0;
+            for(NodeId child = nodes[n].firstChild; child != NoNode; child = nodes[child].nextSibling) ++count;
+
+            return count;
+        }
+
+        size_t getSerializedSize(NodeId n) {
+            // exact length of the parenthesis-delimited string for subtree n:
+            // every value, plus a pair of brackets around every node below n, plus the growth of a pending
+            // repetition inside the subtree
+
+            if(n == NoNode) return 0u;
+
+            size_t size{getPlainSerializedSize(n)};
+
+            const Repetition& repetition{pendingRepetition};
+            if(repetition.parent != NoNode) {
+                const PreorderIndex& idx{getIndex()};
+                const size_t position{idx.positions[repetition.parent]};
+                if(position >= idx.positions[n] && position < idx.positions[n] + idx.subtreeSizes[n]) {
+                    size += repetition.count * (getPlainSerializedSize(repetition.parent) - getPlainSerializedSize(repetition.child));
+                }
+            }
+
+            return size;
+        }
+
+        char* serialize(NodeId n, char* destination) const {
+            // write the parenthesis-delimited string for subtree n to destination, returning the end of the output.
+            // destination must hold getSerializedSize(n) bytes.
+
+            if(n == NoNode) return destination;
+
+            return serializeSubtree(n, destination, pendingRepetition.parent);
+        }
+
+        string toString(NodeId n) {
+            // create a parenthesis-delimited string from subtree n
+
+            string treeStr(getSerializedSize(n), '\0');
+            serialize(n, treeStr.data());
 
             return treeStr;
         }
 
-        size_t countNodes(Node* n) {
-            if(!n) return 0u;
+        size_t countNodes(NodeId n) {
+            // number of nodes in the subtree of n; nodes no longer reachable from root count as empty
 
-            size_t count = 1; // count n itself
-            for(Node* child : n->children) count += countNodes(child);
+            if(n == NoNode) return 0u;
 
-            return count;
+            expandRepetition();
+            return getIndex().subtreeSizes[n];
         }
     
-        Node* findNodeByIndex(Node* n, size_t& index) {
-            // traverse tree in-order, returning index-th node
+        NodeId findNodeByIndex(NodeId n, size_t& index) {
+            // return the index-th node of subtree n in pre-order.
+            // As with a walk of the subtree, index is left at 0 on success and reduced by the subtree size otherwise.
+
+            if(n == NoNode) return NoNode;
+
+            expandRepetition();
+            const PreorderIndex& idx{getIndex()};
+            const size_t subtreeSize{idx.subtreeSizes[n]};
+            if(index >= subtreeSize) {
+                index -= subtreeSize;
+                return NoNode;
+            }
 
-            if(n == nullptr) return nullptr;
-            if(index == 0) return n;
+            const NodeId found{idx.order[idx.positions[n] + index]};
+            index = 0;
+            return found;
+        }
 
-            --index;
-            for(Node* child : n->children) {
-                Node* result = findNodeByIndex(child, index);
-                if(result != nullptr) return result;
+        size_t countInternalNodes() {
+            // number of nodes reachable from root that have at least one child
+
+            expandRepetition();
+            return getIndex().internalNodes.size();
+        }
+
+        NodeId findInternalNodeByIndex(size_t index) {
+            // return the index-th node with children, in pre-order
+
+            expandRepetition();
+            const PreorderIndex& idx{getIndex()};
+            if(index >= idx.internalNodes.size()) {
+                throw RuntimeException{"Internal node index is out of bounds", RuntimeException::INDEX_OUT_OF_RANGE};
             }
 
-            return nullptr;
+            return idx.internalNodes[index];
         }
 
-        Node* insertNode(string value, Node* parent = nullptr) {
+        NodeId insertNode(const string& value, NodeId parent = NoNode) {
             // Insert a new node as a child of "parent"
 
-            Node* newNode = new Node(value, parent);
-            if(parent) parent->children.push_back(newNode);
-            return newNode;
+            expandRepetition();
+            const size_t textStart{text.size()};
+            text += value;
+            return newNode(sourceSize + textStart, value.size(), parent);
         }
 
-        Node* duplicateNode(Node* original, Node* newParent) {
+        NodeId duplicateNode(NodeId original, NodeId newParent) {
             // Duplicates a node and all of its children
 
-            if(!original) {
+            if(original == NoNode) {
                 throw RuntimeException{"Node to be duplicated must not be nullptr", RuntimeException::USAGE_ERROR};
             }
             if(original == this->root) {
                 throw RuntimeException{"Node to be duplicated must not be root", RuntimeException::USAGE_ERROR};
             }
-            if(!newParent) {
+            if(newParent == NoNode) {
                 throw RuntimeException{"Parent of the Node to be duplicated must not be nullptr", RuntimeException::USAGE_ERROR};
             }
 
-            Node* duplicate = insertNode(original->value, newParent);
-
-            for(Node* child : original->children) {
-                duplicate->children.push_back(duplicateNode(child, duplicate));
-            }
+            expandRepetition();
+            const NodeId duplicate{copySubtree(original)};
+            appendChild(newParent, duplicate);
 
             return duplicate;
         }
 
-        void replaceNode(Node* toReplace, Node* toCopy) {
-            // Replace one node's value with another's
+        void replaceNode(NodeId toReplace, NodeId toCopy) {
+            // Replace one node's value with another's. A bracketed group's value is only its opening bracket,
+            // so in the bracketed syntax the whole subtree is replaced with a copy of the other's, keeping the
+            // brackets balanced.
 
-            if(!toReplace || !toCopy) {
+            if(toReplace == NoNode || toCopy == NoNode) {
                 throw RuntimeException{"Both nodes must not be nullptr", RuntimeException::USAGE_ERROR};
             }
 
-            toReplace->value = toCopy->value;
+            expandRepetition();
+            if(syntax == Syntax::Bracketed) {
+                // the replaced subtree is left detached in the copy's arena slots
+                swapContents(toReplace, copySubtree(toCopy));
+                return;
+            }
+
+            nodes[toReplace].valueStart = nodes[toCopy].valueStart;
+            nodes[toReplace].valueSize = nodes[toCopy].valueSize;
 
             return;
         }
 
-        void swapNodes(Node* node1, Node* node2) {
-            // Swap the values of two nodes
+        void swapNodes(NodeId node1, NodeId node2) {
+            // Swap the values of two nodes. In the bracketed syntax whole subtrees are swapped instead, as
+            // radamsa's tree swap does, and a node is never swapped with its own ancestor.
 
-            if(!node1 || !node2) {
+            if(node1 == NoNode || node2 == NoNode) {
                 throw RuntimeException{"Both nodes to be swapped must not be nullptr", RuntimeException::USAGE_ERROR};
             }
 
-            const string temp = node1->value;
-            node1->value = node2->value;
-            node2->value = temp;
+            expandRepetition();
+            if(syntax == Syntax::Bracketed) {
+                if(!isInSubtree(node1, node2) && !isInSubtree(node2, node1)) swapContents(node1, node2);
+                return;
+            }
+
+            std::swap(nodes[node1].valueStart, nodes[node2].valueStart);
+            std::swap(nodes[node1].valueSize, nodes[node2].valueSize);
 
             return;
         }
 
-        void deleteNode(Node* n) {
-            // deallocate n and its children, and remove n from n->parent->children
+        void deleteNode(NodeId n) {
+            // remove n and its children from the tree; their arena slots are reclaimed by the next clear()
 
-            if(n == nullptr) return;
+            if(n == NoNode) return;
 
-            // copying to avoid iterator invalidation via deleting an element while still looping over the vector
-            std::vector<Node*> childrenCopy = n->children;
-            for(Node* child : childrenCopy) {
-                deleteNode(child);
+            expandRepetition();
+            if(nodes[n].parent != NoNode) {
+                unlinkChild(nodes[n].parent, n, NoNode);
             }
 
-            // erase self from parent's children
-            if(n->parent) {
-                auto& parentChildren = n->parent->children;
-                auto it = std::find(parentChildren.begin(), parentChildren.end(), n);
-                if(it != parentChildren.end()) {
-                    parentChildren.erase(it);
-                }
+            if(n == this->root) {
+                this->root = NoNode;
+                preorder.isValid = false;
             }
-
-            if(n == this->root) this->root = nullptr;
-
-            delete n;
         }
     
-        void repeatPath(Node* parent, size_t childIndex, size_t numReps) {
-            // Replace a child of "parent" with recursive copies of "parent"
+        size_t repeatPath(NodeId parent, size_t childIndex, size_t numReps, size_t maxSerializedSize = SIZE_MAX) {
+            // Replace a child of "parent" with numReps nested copies of "parent", the innermost one keeping the child.
+            // The copies are not built: the repetition is recorded and serialize() expands it straight into the
+            // output. numReps is reduced so that the serialized tree stays within maxSerializedSize bytes.
+            // Returns the number of repetitions applied.
 
-            if (numReps <= 0) return;
+            if (numReps == 0u) return 0u;
 
-            if (parent == nullptr) throw RuntimeException{"Node to be repeated must not be nullptr", RuntimeException::USAGE_ERROR};
-            if (childIndex >= parent->children.size()) throw RuntimeException{"childIndex is out of bounds", RuntimeException::INDEX_OUT_OF_RANGE};
+            if (parent == NoNode) throw RuntimeException{"Node to be repeated must not be nullptr", RuntimeException::USAGE_ERROR};
+            if (childIndex >= countChildren(parent)) throw RuntimeException{"childIndex is out of bounds", RuntimeException::INDEX_OUT_OF_RANGE};
 
-            // custom delete here because we want to preserve the child's entry in parent->children
-            Node* parentCopy = parent->deepCopy(parent);
-            Node* toReplace = parent->children[childIndex];
-            std::vector<Node*> childrenCopy = toReplace->children;
-            for(Node* child : childrenCopy) {
-                this->deleteNode(child);
-            }
-            delete toReplace;
+            expandRepetition();
 
-            parent->children[childIndex] = parentCopy;
+            NodeId child{nodes[parent].firstChild};
+            for(size_t i = 0; i < childIndex; ++i) child = nodes[child].nextSibling;
 
-            this->repeatPath(parent->children[childIndex], childIndex, numReps - 1);
-            return;
+            // every repetition adds the parent's text minus the child's
+            const size_t treeSize{getSerializedSize(this->root)};
+            const size_t growth{getSerializedSize(parent) - getSerializedSize(child)};
+            // a parent with no text besides the child would repeat into the same output
+            if (growth == 0u || treeSize >= maxSerializedSize) return 0u;
+            numReps = std::min(numReps, (maxSerializedSize - treeSize) / growth);
+            if (numReps == 0u) return 0u;
+
+            pendingRepetition = Repetition{parent, child, childIndex, numReps};
+            return numReps;
         }
     };
+
+    /**
+     * @brief Selects the syntax the test cases are parsed in, by its configuration name
+     *
+     * @param name - "parenthesized" (the default) or "bracketed"
+     */
+    void SetTreeSyntax(const std::string& name)
+    {
+        if (name == "parenthesized")
+            treeSyntax = Syntax::Parenthesized;
+        else if (name == "bracketed")
+            treeSyntax = Syntax::Bracketed;
+        else
+            throw RuntimeException{"Unknown tree syntax, expected parenthesized or bracketed", RuntimeException::CONFIGURATION_ERROR};
+    }
+
+    Syntax GetTreeSyntax() const noexcept
+    {
+        return treeSyntax;
+    }
+
+    /**
+     * @brief Loads the tree in the given entry's buffer into tree, parsed in the selected syntax
+     *
+     * The parse is shared through RadamsaParseCache, so mutating the same base entry again only copies the
+     * cached node arrays into tree instead of re-parsing the buffer.
+     */
+    void LoadTree(Tree& tree, StorageModule& storage, StorageEntry* entry, const char* buffer, size_t size)
+    {
+        const std::shared_ptr<const Tree> parsed{(treeSyntax == Syntax::Bracketed) ?
+            GetParsedTree<Syntax::Bracketed>(storage, entry, buffer, size) :
+            GetParsedTree<Syntax::Parenthesized>(storage, entry, buffer, size)};
+
+        tree.assign(*parsed, buffer, size);
+    }
+
+private:
+    Syntax treeSyntax{Syntax::Parenthesized};
+
+    // the same bytes parse into different trees in each syntax, so each is cached as a different kind
+    template <Syntax syntax>
+    static std::shared_ptr<const Tree> GetParsedTree(StorageModule& storage, StorageEntry* entry, const char* buffer, size_t size)
+    {
+        return RadamsaParseCache::getInstance()->GetOrParse<Tree, std::integral_constant<Syntax, syntax>>(
+            storage, entry, buffer, size,
+            [&]() { Tree t; t.parse(buffer, size, syntax); return t; },
+            [](const Tree& t) { return t.getMemoryFootprint(); });
+    }
 };
-}
\ No newline at end of file
+}
@@ -0,0 +1,134 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#include "RadamsaUtf8Index.hpp"
+#include "RadamsaByteScan.hpp"
+#include <algorithm>
+#include <bitset>
+
+using namespace vmf;
+
+namespace
+{
+size_t PopCount(const uint64_t word) noexcept
+{
+    return std::bitset<64>(word).count();
+}
+
+// Returns the position of the set bit of the given rank within word, in six popcounts
+size_t SelectInWord(
+                    const uint64_t word,
+                    size_t rank) noexcept
+{
+    size_t offset{0u};
+
+    for(size_t width{32u}; width != 0u; width /= 2u)
+    {
+        const size_t lowCount{PopCount((word >> offset) & ((uint64_t{1} << width) - 1u))};
+        if (rank >= lowCount)
+        {
+            rank -= lowCount;
+            offset += width;
+        }
+    }
+
+    return offset;
+}
+}
+
+RadamsaUtf8Index::RadamsaUtf8Index(
+                                   const char* const buffer,
+                                   const size_t size) : size{size}
+{
+    const size_t wordCount{RadamsaByteScan::GetBitmaskWordCount(size)};
+
+    codePointStarts.words.resize(wordCount);
+    printable.words.resize(wordCount);
+    RadamsaByteScan::GetClassBitmasks(
+                                      buffer, size,
+                                      RadamsaByteScan::ByteClass::CodePointStart, codePointStarts.words.data(),
+                                      RadamsaByteScan::ByteClass::Printable, printable.words.data());
+
+    codePointStarts.Index();
+    printable.Index();
+}
+
+size_t RadamsaUtf8Index::GetFootprint() const noexcept
+{
+    return sizeof(RadamsaUtf8Index) + codePointStarts.GetFootprint() + printable.GetFootprint();
+}
+
+void RadamsaUtf8Index::RankedBitmap::Index()
+{
+    ranks.resize(words.size() + 1u);
+    selectSamples.clear();
+
+    size_t count{0u};
+    for(size_t it{0u}; it < words.size(); ++it)
+    {
+        ranks[it] = count;
+
+        const size_t wordCount{PopCount(words[it])};
+
+        // Record this word for every sampled rank that falls inside it
+        for(size_t sampled{selectSamples.size() * SelectSampleRate}; sampled < count + wordCount; sampled += SelectSampleRate)
+            selectSamples.push_back(it);
+
+        count += wordCount;
+    }
+    ranks[words.size()] = count;
+}
+
+size_t RadamsaUtf8Index::RankedBitmap::Rank(const size_t position) const noexcept
+{
+    const size_t word{position / 64u};
+    const size_t bit{position % 64u};
+
+    if (bit == 0u)
+        return ranks[word];
+
+    return ranks[word] + PopCount(words[word] & ((uint64_t{1} << bit) - 1u));
+}
+
+size_t RadamsaUtf8Index::RankedBitmap::Select(const size_t rank) const noexcept
+{
+    // The word holding the set bit is the last one with fewer set bits before it than rank + 1
+    const size_t sample{rank / SelectSampleRate};
+    const size_t first{selectSamples[sample]};
+    const size_t last{(sample + 1u < selectSamples.size()) ? selectSamples[sample + 1u] : words.size() - 1u};
+
+    const auto after = std::upper_bound(ranks.begin() + first + 1u, ranks.begin() + last + 1u, rank);
+    const size_t word{static_cast<size_t>(after - ranks.begin()) - 1u};
+
+    return word * 64u + SelectInWord(words[word], rank - ranks[word]);
+}
+
+size_t RadamsaUtf8Index::RankedBitmap::GetFootprint() const noexcept
+{
+    return words.capacity() * sizeof(uint64_t) + (ranks.capacity() + selectSamples.capacity()) * sizeof(size_t);
+}
@@ -0,0 +1,105 @@
+/* =============================================================================
+ * Vader Modular Fuzzer (VMF)
+ * Copyright (c) 2021-2025 The Charles Stark Draper Laboratory, Inc.
+ * <vmf@draper.com>
+ *  
+ * Effort sponsored by the U.S. Government under Other Transaction number
+ * W9124P-19-9-0001 between AMTC and the Government. The U.S. Government
+ * Is authorized to reproduce and distribute reprints for Governmental purposes
+ * notwithstanding any copyright notation thereon.
+ *  
+ * The views and conclusions contained herein are those of the authors and
+ * should not be interpreted as necessarily representing the official policies
+ * or endorsements, either expressed or implied, of the U.S. Government.
+ *  
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 (only) as 
+ * published by the Free Software Foundation.
+ *  
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *  
+ * @license GPL-2.0-only <https://spdx.org/licenses/GPL-2.0-only.html>
+ * ===========================================================================*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vmf
+{
+/**
+ * @brief Positions of the UTF-8 code point boundaries and printable ASCII bytes of a buffer, with rank and select
+ *
+ * Both bitmaps are filled in a single vectorized pass by RadamsaByteScan. A code point boundary is any byte
+ * that is not a continuation byte (10xxxxxx), so malformed input still has one wherever a new sequence could
+ * start. Each bitmap keeps the number of set bits before every 64-bit word and the word of every
+ * SelectSampleRate-th set bit, so rank is a lookup and a popcount, and select narrows to the word with a short
+ * search between two samples and then to the bit with a few popcounts. Mutators use select to pick a target
+ * uniformly among the valid positions without rejection sampling.
+ */
+class RadamsaUtf8Index
+{
+public:
+    static constexpr size_t SelectSampleRate{256u};
+
+    RadamsaUtf8Index(
+                     const char* const buffer,
+                     const size_t size);
+
+    size_t GetSize() const noexcept { return size; }
+
+    size_t GetCodePointCount() const noexcept { return codePointStarts.GetCount(); }
+    size_t GetPrintableCount() const noexcept { return printable.GetCount(); }
+
+    bool IsCodePointStart(const size_t position) const noexcept { return codePointStarts.Test(position); }
+    bool IsPrintable(const size_t position) const noexcept { return printable.Test(position); }
+
+    /**
+     * @brief Returns the number of code point boundaries before position
+     */
+    size_t RankCodePoints(const size_t position) const noexcept { return codePointStarts.Rank(position); }
+    size_t RankPrintable(const size_t position) const noexcept { return printable.Rank(position); }
+
+    /**
+     * @brief Returns the offset of the code point boundary of the given rank, which must be below GetCodePointCount()
+     */
+    size_t SelectCodePoint(const size_t rank) const noexcept { return codePointStarts.Select(rank); }
+    size_t SelectPrintable(const size_t rank) const noexcept { return printable.Select(rank); }
+
+    /**
+     * @brief Returns the number of bytes the index holds, for the parse cache budget
+     */
+    size_t GetFootprint() const noexcept;
+
+private:
+    class RankedBitmap
+    {
+    public:
+        // Fills the rank and select samples once the words are set
+        void Index();
+
+        size_t GetCount() const noexcept { return ranks.back(); }
+        bool Test(const size_t position) const noexcept { return ((words[position / 64u] >> (position % 64u)) & 1u) != 0u; }
+        size_t Rank(const size_t position) const noexcept;
+        size_t Select(const size_t rank) const noexcept;
+        size_t GetFootprint() const noexcept;
+
+        std::vector<uint64_t> words;
+
+    private:
+        std::vector<size_t> ranks;          // set bits before each word, plus the total
+        std::vector<size_t> selectSamples;  // word holding each SelectSampleRate-th set bit
+    };
+
+    size_t size;
+    RankedBitmap codePointStarts;
+    RankedBitmap printable;
+};
+}
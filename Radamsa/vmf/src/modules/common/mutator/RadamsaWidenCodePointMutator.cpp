@@ -30,6 +30,8 @@
   *
   */
 #include "RadamsaWidenCodePointMutator.hpp"
+#include "RadamsaParseCache.hpp"
+#include "RadamsaUtf8Index.hpp"
 #include "RuntimeException.hpp"
 #include <random>
 #include <algorithm>
@@ -89,6 +91,17 @@ void RadamsaWidenCodePointMutator::registerStorageNeeds(StorageRegistry& registr
     // by the input generator that calls them
 }
 
+/**
+ * @brief Register the metadata needs for this module
+ *
+ * @param registry - StorageRegistry object
+ */
+void RadamsaWidenCodePointMutator::registerMetadataNeeds(StorageRegistry& registry)
+{
+    // Publishes the statistics of the parse cache shared by the Radamsa mutators
+    RadamsaParseCache::getInstance()->RegisterStatsKeys(registry);
+}
+
 void RadamsaWidenCodePointMutator::mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey)
 {
     // Replace a random 6-bit ASCII character with an equivalent 2-byte UTF-8-like sequence
@@ -130,34 +143,30 @@ void RadamsaWidenCodePointMutator::mutateTestCase(StorageModule& storage, Storag
         return;
     }
 
-    std::vector<uint8_t> data(originalBuffer, originalBuffer + originalSize);
+    // The printable ASCII bytes are indexed once per entry and shared, so the target is selected directly
+    const std::shared_ptr<const RadamsaUtf8Index> utf8Index{RadamsaParseCache::getInstance()->GetOrParse<RadamsaUtf8Index>(
+        storage, baseEntry, originalBuffer, originalSize,
+        [&]() { return RadamsaUtf8Index(originalBuffer, originalSize); },
+        [](const RadamsaUtf8Index& utf8Index) { return utf8Index.GetFootprint(); })};
+
+    // Check if there is a printable ASCII byte to widen
+    if (utf8Index->GetPrintableCount() == 0u)
+    {
+        CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
+        return;
+    }
 
     const size_t lower{0};
-    const size_t upper{data.size() - 1};
-    size_t index;
-    uint8_t codePoint;
-    size_t attempts = 0;
-    const size_t max_attempts = data.size();
-    do {
-        attempts++;
-        // Check if unable to find valid ASCII byte after maximum attempts
-        if (attempts > max_attempts)
-        {
-            CopyBufferAsIs(baseEntry, newEntry, testCaseKey);
-            return;
-        }
-
-        index = this->rand->randBetween(lower, upper);
-        codePoint = data[index];
-    } while (codePoint < 32 || codePoint > 126); // ensure codePoint is printable ascii
-
-    data[index] = 0b11000000;   // set 2-byte utf prefix (110xxxxx)
-    data.insert(data.begin() + index + 1, codePoint | 0b10000000); // set continuation byte prefix (10xxxxxx)
-
-    const size_t newBufferSize{data.size() + 1}; // +1 to implicitly append a null terminator
-    char* newBuffer{newEntry->allocateBuffer(testCaseKey, newBufferSize)};
-    memset(newBuffer, 0u, newBufferSize);
-    memcpy(newBuffer, data.data(), data.size());
+    const size_t upper{utf8Index->GetPrintableCount() - 1};
+    const size_t index{utf8Index->SelectPrintable(this->rand->randBetween(lower, upper))};
+    const uint8_t codePoint{static_cast<uint8_t>(originalBuffer[index])};
+
+    const char widened[2]{
+        static_cast<char>(0b11000000),              // set 2-byte utf prefix (110xxxxx)
+        static_cast<char>(codePoint | 0b10000000)   // set continuation byte prefix (10xxxxxx)
+    };
+
+    SpliceIntoNewEntry(newEntry, testCaseKey, originalBuffer, originalSize, index, 1u, widened, sizeof(widened));
 
     return;
 }
\ No newline at end of file
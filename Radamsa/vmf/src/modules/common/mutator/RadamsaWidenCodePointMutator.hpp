@@ -49,6 +49,7 @@ class RadamsaWidenCodePointMutator: public MutatorModule, public RadamsaByteMuta
         RadamsaWidenCodePointMutator(std::string name);
         virtual ~RadamsaWidenCodePointMutator();
         virtual void registerStorageNeeds(StorageRegistry& registry);
+        virtual void registerMetadataNeeds(StorageRegistry& registry);
         virtual void mutateTestCase(StorageModule& storage, StorageEntry* baseEntry, StorageEntry* newEntry, int testCaseKey);
 
     private: